@@ -53,6 +53,27 @@ bpf_link_get_fd_by_id(__u32 id);
 int
 bpf_link_get_next_id(__u32 start_id, __u32* next_id);
 
+/**
+ * @brief Atomically replace the program attached to a link. The link stays
+ * attached to its hook throughout, so no invocation is missed.
+ *
+ * @param[in] link_fd File descriptor of link to update.
+ * @param[in] new_prog_fd File descriptor of the program to attach.
+ * @param[in] opts Optional update options. If opts->flags contains BPF_F_REPLACE,
+ * the update only succeeds if the link is currently attached to opts->old_prog_fd.
+ *
+ * @retval 0 The operation was successful.
+ * @retval <0 An error occured, and errno was set.
+ *
+ * @exception EBADF A file descriptor was not found.
+ * @exception EINVAL The link is not attached, the program type does not match,
+ * or the link is not attached to the expected program.
+ *
+ * @sa bpf_link__update_program
+ */
+int
+bpf_link_update(int link_fd, int new_prog_fd, const struct bpf_link_update_opts* opts);
+
 /** @} */
 
 /**
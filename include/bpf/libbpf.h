@@ -78,6 +78,22 @@ bpf_link__pin(struct bpf_link* link, const char* path);
 int
 bpf_link__unpin(struct bpf_link* link);
 
+/**
+ * @brief Atomically replace the program attached to a link.
+ *
+ * @param[in] link Link to update.
+ * @param[in] prog Program to attach to the link.
+ *
+ * @retval 0 The operation was successful.
+ * @retval <0 An error occured, and errno was set.
+ *
+ * @exception EINVAL The link is not attached or the program type does not match.
+ *
+ * @sa bpf_link_update
+ */
+int
+bpf_link__update_program(struct bpf_link* link, struct bpf_program* prog);
+
 /**
  * @brief **libbpf_bpf_link_type_str()** converts the provided link type value
  * into a textual representation.
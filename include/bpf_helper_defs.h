@@ -419,6 +419,85 @@ EBPF_HELPER(int64_t, bpf_get_socket_cookie, (const void* ctx));
 #define bpf_get_socket_cookie ((bpf_get_socket_cookie_t)BPF_FUNC_get_socket_cookie)
 #endif
 
+/**
+ * @brief Get the 64-bit application ID of the application that owns the socket.
+ * The ID is a keyed hash of the full application image path (the UTF-16 NT
+ * path reported by WFP). The key is random and changes each time the network
+ * extension is loaded, so the ID is stable across processes but not across
+ * reboots. User mode gets the ID of an application with \ref ebpf_get_app_id
+ * and can use it as a hash map key for per-application policy. Distinct
+ * applications can map to the same ID, so the ID is not a security boundary.
+ * The context can be *bind_md* struct, *bpf_sock_addr* struct, or *bpf_sock_ops* struct.
+ *
+ * @param[in] ctx Context passed to the eBPF program.
+ *
+ * @returns The application ID, or 0 if no application is associated with the socket.
+ */
+EBPF_HELPER(uint64_t, bpf_get_current_app_id, (const void* ctx));
+#ifndef __doxygen
+#define bpf_get_current_app_id ((bpf_get_current_app_id_t)BPF_FUNC_get_current_app_id)
+#endif
+
+/**
+ * @brief Get the storage that a BPF_MAP_TYPE_SK_STORAGE map holds for the flow
+ * associated with the program context. The storage lives until the flow is
+ * deleted or until \ref bpf_sk_storage_delete is called.
+ * The context must be a *bpf_sock_ops* struct.
+ *
+ * @param[in] map Pointer to a map of type BPF_MAP_TYPE_SK_STORAGE.
+ * @param[in] ctx Context passed to the eBPF program.
+ * @param[in] value Initial value of the storage, used when it is created.
+ * @param[in] flags BPF_SK_STORAGE_GET_F_CREATE to create the storage if it
+ * does not already exist, or 0.
+ *
+ * @returns Pointer to the storage, or NULL if it does not exist and could not
+ * be created.
+ */
+EBPF_HELPER(void*, bpf_sk_storage_get, (void* map, void* ctx, void* value, uint64_t flags));
+#ifndef __doxygen
+#define bpf_sk_storage_get ((bpf_sk_storage_get_t)BPF_FUNC_sk_storage_get)
+#endif
+
+/**
+ * @brief Delete the storage that a BPF_MAP_TYPE_SK_STORAGE map holds for the
+ * flow associated with the program context.
+ *
+ * @param[in] map Pointer to a map of type BPF_MAP_TYPE_SK_STORAGE.
+ * @param[in] ctx Context passed to the eBPF program.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval -EBPF_KEY_NOT_FOUND No storage exists for the flow.
+ */
+EBPF_HELPER(long, bpf_sk_storage_delete, (void* map, void* ctx));
+#ifndef __doxygen
+#define bpf_sk_storage_delete ((bpf_sk_storage_delete_t)BPF_FUNC_sk_storage_delete)
+#endif
+
+/**
+ * @brief Return time elapsed since boot in nanoseconds excluding time while suspended,
+ * as of the most recent clock tick. This is much cheaper than \ref bpf_ktime_get_ns
+ * but only advances once per clock tick (typically every 15.625 ms or less).
+ *
+ * @return Time elapsed since boot in nanosecond units.
+ */
+EBPF_HELPER(uint64_t, bpf_ktime_get_coarse_ns, ());
+#ifndef __doxygen
+#define bpf_ktime_get_coarse_ns ((bpf_ktime_get_coarse_ns_t)BPF_FUNC_ktime_get_coarse_ns)
+#endif
+
+/**
+ * @brief Return time elapsed since boot in nanoseconds excluding time while suspended,
+ * computed from the CPU cycle counter. This has the same time base as \ref bpf_ktime_get_ns
+ * and nanosecond resolution, but is cheaper to read. The counter is calibrated once for all
+ * CPUs, so values are monotonic across CPUs.
+ *
+ * @return Time elapsed since boot in nanosecond units.
+ */
+EBPF_HELPER(uint64_t, bpf_ktime_get_fast_ns, ());
+#ifndef __doxygen
+#define bpf_ktime_get_fast_ns ((bpf_ktime_get_fast_ns_t)BPF_FUNC_ktime_get_fast_ns)
+#endif
+
 #if __clang__
 #define memcpy(dest, src, dest_size) bpf_memcpy(dest, dest_size, src, dest_size)
 #define memcmp(mem1, mem2, mem1_size) bpf_memcmp(mem1, mem1_size, mem2, mem1_size)
@@ -39,6 +39,11 @@
  */
 #define SEC(NAME) __attribute__((section(NAME)))
 
+/**
+ * @brief LLVM attribute to keep a function out of line, so that it is called as a BPF-to-BPF subprogram.
+ */
+#define __noinline __attribute__((noinline))
+
 #define bpf_map_def _ebpf_map_definition_in_file
 #include "ebpf_nethooks.h"
 
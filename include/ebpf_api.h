@@ -521,6 +521,171 @@ extern "C"
     ebpf_get_next_pinned_program_path(
         _In_z_ const char* start_path, _Out_writes_z_(EBPF_MAX_PIN_PATH_LENGTH) char* next_path) EBPF_NO_EXCEPT;
 
+    /**
+     * @brief Get bpf_link_info records for links with IDs greater than a given ID,
+     * in ascending ID order, using a single request to the execution context.
+     *
+     * @param[in] start_id ID to look for links after, or 0 to start from the beginning.
+     * @param[out] infos Array that receives the link info records.
+     * @param[in, out] count On input, the capacity of infos. On output, the
+     * number of records returned, which may be 0 if the links found were
+     * deleted before their info could be read.
+     * @param[out] next_id Cursor to pass as start_id to continue the enumeration.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MORE_KEYS No more links found.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are wrong.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_link_info_batch(
+        ebpf_id_t start_id,
+        _Out_writes_to_(*count, *count) struct bpf_link_info* infos,
+        _Inout_ uint32_t* count,
+        _Out_ ebpf_id_t* next_id) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Get bpf_map_info records for maps with IDs greater than a given ID,
+     * in ascending ID order, using a single request to the execution context.
+     *
+     * @param[in] start_id ID to look for maps after, or 0 to start from the beginning.
+     * @param[out] infos Array that receives the map info records.
+     * @param[in, out] count On input, the capacity of infos. On output, the
+     * number of records returned.
+     * @param[out] next_id Cursor to pass as start_id to continue the enumeration.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MORE_KEYS No more maps found.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are wrong.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_map_info_batch(
+        ebpf_id_t start_id,
+        _Out_writes_to_(*count, *count) struct bpf_map_info* infos,
+        _Inout_ uint32_t* count,
+        _Out_ ebpf_id_t* next_id) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Get bpf_prog_info records for programs with IDs greater than a given ID,
+     * in ascending ID order, using a single request to the execution context.
+     * The map_ids field of the returned records is not populated.
+     *
+     * @param[in] start_id ID to look for programs after, or 0 to start from the beginning.
+     * @param[out] infos Array that receives the program info records.
+     * @param[in, out] count On input, the capacity of infos. On output, the
+     * number of records returned.
+     * @param[out] next_id Cursor to pass as start_id to continue the enumeration.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MORE_KEYS No more programs found.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are wrong.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_program_info_batch(
+        ebpf_id_t start_id,
+        _Out_writes_to_(*count, *count) struct bpf_prog_info* infos,
+        _Inout_ uint32_t* count,
+        _Out_ ebpf_id_t* next_id) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Look up the values of a list of keys in an eBPF map, using one
+     * request to the execution context per batch of keys rather than one per key.
+     * For a per-cpu map, each value holds the values for all CPUs, as returned
+     * by bpf_map_lookup_elem.
+     *
+     * @param[in] map_fd File descriptor for the eBPF map.
+     * @param[in] keys Concatenation of count keys.
+     * @param[out] values Buffer that receives count values. The value of a key
+     * whose result is not EBPF_SUCCESS is zero filled.
+     * @param[out] results Result of the lookup for each key, e.g.,
+     * EBPF_OBJECT_NOT_FOUND if the key is not present in the map.
+     * @param[in] count Number of keys to look up.
+     * @param[in] flags Must be 0.
+     *
+     * @retval EBPF_SUCCESS The operation was successful. The result of each
+     * individual key is reported in results.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are wrong.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map type does not support lookup.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_lookup_elements_by_keys(
+        fd_t map_fd,
+        _In_ const void* keys,
+        _Out_ void* values,
+        _Out_writes_(count) ebpf_result_t* results,
+        uint32_t count,
+        uint64_t flags) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Look up and delete the values of a list of keys in an eBPF map,
+     * using one request to the execution context per batch of keys.
+     *
+     * @param[in] map_fd File descriptor for the eBPF map.
+     * @param[in] keys Concatenation of count keys.
+     * @param[out] values Buffer that receives count values. The value of a key
+     * whose result is not EBPF_SUCCESS is zero filled.
+     * @param[out] results Result of the lookup for each key.
+     * @param[in] count Number of keys to look up and delete.
+     * @param[in] flags Must be 0.
+     *
+     * @retval EBPF_SUCCESS The operation was successful. The result of each
+     * individual key is reported in results.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are wrong.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map type does not support lookup.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_lookup_and_delete_elements_by_keys(
+        fd_t map_fd,
+        _In_ const void* keys,
+        _Out_ void* values,
+        _Out_writes_(count) ebpf_result_t* results,
+        uint32_t count,
+        uint64_t flags) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Atomically replace the entire contents of an eBPF map. The new
+     * contents are built by the execution context without modifying the map
+     * and then published in one step, so programs see either the old or the
+     * new contents and never a mix of the two.
+     *
+     * @param[in] map_fd File descriptor for the eBPF map.
+     * @param[in] keys Concatenation of count keys.
+     * @param[in] values Concatenation of count values. For per-CPU maps each
+     * value holds one 8-byte aligned value per possible CPU.
+     * @param[in] count Number of key and value pairs. Zero empties the map.
+     * @param[in] flags Must be 0.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT One or more parameters are wrong, or the
+     * map was concurrently replaced by another caller.
+     * @retval EBPF_OUT_OF_SPACE count exceeds the maximum entries of the map.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map type does not support
+     * replacing its contents.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_replace_contents(
+        fd_t map_fd,
+        _In_opt_ const void* keys,
+        _In_opt_ const void* values,
+        uint32_t count,
+        uint64_t flags) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Enable or disable collection of access statistics on an eBPF
+     * map. Statistics can also be enabled when the map is created by passing
+     * BPF_F_STATISTICS in bpf_map_create_opts.map_flags, and are reported in
+     * the bpf_map_info returned by bpf_obj_get_info_by_fd.
+     *
+     * @param[in] map_fd File descriptor for the eBPF map.
+     * @param[in] enabled True to collect statistics. False stops collecting
+     * statistics and discards the current counts.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_FD The file descriptor is not valid.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for the statistics.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_set_statistics(fd_t map_fd, bool enabled) EBPF_NO_EXCEPT;
+
     typedef struct _ebpf_program_info ebpf_program_info_t;
 
     /**
@@ -564,6 +729,51 @@ extern "C"
     _Must_inspect_result_ ebpf_result_t
     ebpf_program_test_run(fd_t program_fd, _Inout_ ebpf_test_run_options_t* options) EBPF_NO_EXCEPT;
 
+    /**
+     * @brief Format a deferred bpf_trace_printk record.
+     *
+     * When only the EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED trace keyword is enabled, bpf_trace_printk
+     * logs an EbpfPrintkFormat event the first time a format string is used. Each call then logs an
+     * EbpfPrintk event that holds only the format identifier and the raw 64-bit arguments. A trace
+     * consumer calls this function with the format from the first event and the arguments from the
+     * second to get the text the kernel would have produced.
+     *
+     * @param[in] format Null-terminated format string from the EbpfPrintkFormat event.
+     * @param[in] argument_count Number of arguments from the EbpfPrintk event.
+     * @param[in] arguments Arguments from the EbpfPrintk event.
+     * @param[out] output Buffer to receive the null-terminated formatted string.
+     * @param[in] output_size Size in bytes of the output buffer.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The format string is invalid or does not
+     *  match the number of arguments.
+     * @retval EBPF_INSUFFICIENT_BUFFER The output buffer is too small.
+     * @retval EBPF_NO_MEMORY Out of memory.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_format_deferred_printk(
+        _In_z_ const char* format,
+        uint32_t argument_count,
+        _In_reads_(argument_count) const uint64_t* arguments,
+        _Out_writes_z_(output_size) char* output,
+        size_t output_size) EBPF_NO_EXCEPT;
+
+    /**
+     * @brief Get the application ID that bpf_get_current_app_id returns for an application.
+     *
+     * The ID is a keyed hash of the application's image path. The key is only known to the
+     * network extension and changes each time it is loaded, so IDs must be resolved again
+     * after the extension restarts. Distinct applications can share an ID, so the ID is not
+     * a security boundary. Requires administrator privileges.
+     *
+     * @param[in] file_name Path of the application's image file.
+     * @param[out] app_id Application ID.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_FILE_NOT_FOUND The file or the network extension device was not found.
+     * @retval EBPF_ACCESS_DENIED The caller is not an administrator.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_get_app_id(_In_z_ const wchar_t* file_name, _Out_ uint64_t* app_id) EBPF_NO_EXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
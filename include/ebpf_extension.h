@@ -70,16 +70,30 @@ typedef ebpf_result_t (*ebpf_program_batch_invoke_function_t)(
  */
 typedef ebpf_result_t (*ebpf_program_batch_end_invoke_function_t)(_Inout_ void* state);
 
+/**
+ * @brief Get the state generation of the eBPF program. The generation changes whenever the program attached to the
+ * link is replaced or a map is modified from user mode, so an extension may reuse a verdict it cached for identical
+ * input only while the generation is unchanged.
+ *
+ * @param[in] extension_client_binding_context The context provided by the extension client when the binding was
+ * created.
+ *
+ * @returns The current state generation.
+ */
+typedef uint64_t (*ebpf_program_get_state_generation_function_t)(_In_ const void* extension_client_binding_context);
+
 typedef enum _ebpf_link_dispatch_table_version
 {
     EBPF_LINK_DISPATCH_TABLE_VERSION_1 = 1, ///< Initial version of the dispatch table.
+    EBPF_LINK_DISPATCH_TABLE_VERSION_2 = 2, ///< Adds ebpf_program_get_state_generation_function.
     EBPF_LINK_DISPATCH_TABLE_VERSION_CURRENT =
-        EBPF_LINK_DISPATCH_TABLE_VERSION_1, ///< Current version of the dispatch table.
+        EBPF_LINK_DISPATCH_TABLE_VERSION_2, ///< Current version of the dispatch table.
 } ebpf_link_dispatch_table_version_t;
 
 #define EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_1 4
+#define EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_2 5
 #define EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_CURRENT \
-    EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_1 ///< Current number of functions in the dispatch table.
+    EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_2 ///< Current number of functions in the dispatch table.
 
 typedef struct _ebpf_extension_program_dispatch_table
 {
@@ -89,6 +103,7 @@ typedef struct _ebpf_extension_program_dispatch_table
     ebpf_program_batch_begin_invoke_function_t ebpf_program_batch_begin_invoke_function;
     ebpf_program_batch_invoke_function_t ebpf_program_batch_invoke_function;
     ebpf_program_batch_end_invoke_function_t ebpf_program_batch_end_invoke_function;
+    ebpf_program_get_state_generation_function_t ebpf_program_get_state_generation_function;
 } ebpf_extension_program_dispatch_table_t;
 
 typedef struct _ebpf_extension_data
@@ -11,13 +11,59 @@ typedef struct xdp_md_
 {
     void* data;               ///< Pointer to start of packet data.
     void* data_end;           ///< Pointer to end of packet data.
-    uint64_t data_meta;       ///< Packet metadata.
+    uint64_t data_meta;       ///< Pointer to start of metadata, which ends at data.
     uint32_t ingress_ifindex; ///< Ingress interface index.
+    uint32_t rx_hash;         ///< Receive hash computed by the NIC, or 0 if not available.
+    uint32_t rx_hash_type;    ///< Combination of xdp_rss_hash_type_t flags describing rx_hash.
+    uint32_t rx_queue_index;  ///< Index of the receive queue the packet arrived on.
 
-    /* size: 26, cachelines: 1, members: 4 */
-    /* last cacheline: 26 bytes */
+    /* size: 40, cachelines: 1, members: 7 */
+    /* last cacheline: 40 bytes */
 } xdp_md_t;
 
+// Flags describing the input of the receive hash, matching the Linux values.
+typedef enum _xdp_rss_hash_type
+{
+    XDP_RSS_TYPE_NONE = 0,   ///< No receive hash is available.
+    XDP_RSS_L3_IPV4 = 0x1,   ///< The hash covers IPv4 addresses.
+    XDP_RSS_L3_IPV6 = 0x2,   ///< The hash covers IPv6 addresses.
+    XDP_RSS_L3_DYNHDR = 0x4, ///< The hash covers IPv6 extension headers.
+    XDP_RSS_L4 = 0x8,        ///< The hash covers transport ports.
+    XDP_RSS_L4_TCP = 0x10,   ///< The transport protocol is TCP.
+    XDP_RSS_L4_UDP = 0x20,   ///< The transport protocol is UDP.
+} xdp_rss_hash_type_t;
+
+// Maximum number of metadata bytes that bpf_xdp_adjust_meta can reserve in front of the packet data.
+#define XDP_METADATA_MAX 32
+
+// Flags describing the headers returned by bpf_xdp_parse_headers.
+typedef enum _xdp_headers_flags
+{
+    XDP_HEADERS_FLAG_VLAN = 0x1,              ///< The frame carries a VLAN tag; vlan_id is valid.
+    XDP_HEADERS_FLAG_VLAN_OFFLOADED = 0x2,    ///< The VLAN tag was stripped by the NIC and is not in the packet data.
+    XDP_HEADERS_FLAG_FRAGMENT = 0x4,          ///< The IP packet is a fragment.
+    XDP_HEADERS_FLAG_L3_CHECKSUM_VALID = 0x8, ///< The NIC validated the IPv4 header checksum.
+    XDP_HEADERS_FLAG_L4_CHECKSUM_VALID = 0x10 ///< The NIC validated the TCP or UDP checksum.
+} xdp_headers_flags_t;
+
+// Layer 2 to layer 4 header information filled in by bpf_xdp_parse_headers.
+// Offsets are relative to xdp_md_t::data and are 0 when the corresponding header was not found.
+typedef struct _xdp_headers
+{
+    uint16_t l3_offset;              ///< Offset of the IPv4 or IPv6 header.
+    uint16_t l4_offset;              ///< Offset of the TCP or UDP header.
+    uint16_t payload_offset;         ///< Offset of the transport payload.
+    uint16_t ether_type;             ///< EtherType following any VLAN tags, in host byte order.
+    uint16_t vlan_id;                ///< Outermost VLAN ID, valid if XDP_HEADERS_FLAG_VLAN is set.
+    uint8_t ip_version;              ///< 4 or 6, or 0 if there is no IP header.
+    uint8_t protocol;                ///< IP protocol number of the transport header (e.g., IPPROTO_UDP).
+    uint32_t flags;                  ///< Combination of xdp_headers_flags_t values.
+    uint16_t source_port;            ///< Source port, in network byte order.
+    uint16_t destination_port;       ///< Destination port, in network byte order.
+    uint8_t source_address[16];      ///< Source IP address; IPv4 addresses use the first 4 bytes.
+    uint8_t destination_address[16]; ///< Destination IP address; IPv4 addresses use the first 4 bytes.
+} xdp_headers_t;
+
 typedef enum _xdp_action
 {
     XDP_PASS = 1, ///< Allow the packet to pass.
@@ -48,6 +94,8 @@ xdp_hook_t(xdp_md_t* context);
 typedef enum
 {
     BPF_FUNC_xdp_adjust_head = XDP_EXT_HELPER_FN_BASE + 1,
+    BPF_FUNC_xdp_adjust_meta = XDP_EXT_HELPER_FN_BASE + 2,
+    BPF_FUNC_xdp_parse_headers = XDP_EXT_HELPER_FN_BASE + 3,
 } ebpf_nethook_helper_id_t;
 
 /**
@@ -64,6 +112,46 @@ EBPF_HELPER(int, bpf_xdp_adjust_head, (xdp_md_t * ctx, int delta));
 #define bpf_xdp_adjust_head ((bpf_xdp_adjust_head_t)BPF_FUNC_xdp_adjust_head)
 #endif
 
+/**
+ * @brief Adjust XDP_TEST context metadata pointer. The metadata sits between
+ * data_meta and data, is preserved across tail calls and bpf_xdp_adjust_head,
+ * and lets a program pass computed values to later stages without rewriting
+ * the packet.
+ *
+ * @param[in] ctx XDP_TEST context.
+ * @param[in] delta Number of bytes to move the metadata pointer by. A negative
+ * value grows the metadata.
+ *
+ * @retval 0 The operation was successful.
+ * @retval <0 The metadata would exceed XDP_METADATA_MAX bytes, would not be a
+ * multiple of 4 bytes, or there is not enough headroom in front of the packet.
+ */
+EBPF_HELPER(int, bpf_xdp_adjust_meta, (xdp_md_t * ctx, int delta));
+#ifndef __doxygen
+#define bpf_xdp_adjust_meta ((bpf_xdp_adjust_meta_t)BPF_FUNC_xdp_adjust_meta)
+#endif
+
+/**
+ * @brief Parse the Ethernet, VLAN, IP and TCP/UDP headers of the packet in one
+ * call. Out-of-band information from the NIC (stripped VLAN tag, checksum
+ * validation) is reported when available. The verifier does not track the
+ * values written to headers, so programs must still bounds check the packet
+ * before dereferencing data + offset; the offsets returned are guaranteed to
+ * lie within the packet.
+ *
+ * @param[in] ctx XDP_TEST context.
+ * @param[out] headers Parsed header information. Fields for headers that are
+ * not present or are truncated are set to 0.
+ * @param[in] size Size of headers, which must be sizeof(xdp_headers_t).
+ *
+ * @retval 0 The operation was successful.
+ * @retval <0 The packet is shorter than an Ethernet header, or size is invalid.
+ */
+EBPF_HELPER(int, bpf_xdp_parse_headers, (xdp_md_t * ctx, xdp_headers_t* headers, uint32_t size));
+#ifndef __doxygen
+#define bpf_xdp_parse_headers ((bpf_xdp_parse_headers_t)BPF_FUNC_xdp_parse_headers)
+#endif
+
 // BIND hook
 
 typedef enum _bind_operation
@@ -111,6 +199,16 @@ bind_hook_t(bind_md_t* context);
 #define BPF_SOCK_ADDR_VERDICT_REJECT 0
 #define BPF_SOCK_ADDR_VERDICT_PROCEED 1
 
+// Flags that a program may OR into its verdict to let the extension reuse it for later connections with the same
+// tuple, until the program is replaced or a map is updated from user mode. A program must only set them when the
+// verdict depends on nothing but the context fields named below and map contents that only user mode modifies.
+// Verdicts for connections that the program redirected are never cached.
+
+// The verdict depends on the compartment, family, addresses, destination port, protocol and interface.
+#define BPF_SOCK_ADDR_VERDICT_CACHE 0x100
+// As BPF_SOCK_ADDR_VERDICT_CACHE, but the verdict also depends on the process ID.
+#define BPF_SOCK_ADDR_VERDICT_CACHE_PER_PROCESS 0x200
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4201)
@@ -208,7 +306,8 @@ EBPF_HELPER(int, bpf_sock_addr_set_redirect_context, (bpf_sock_addr_t * ctx, voi
  * @retval BPF_SOCK_ADDR_VERDICT_PROCEED Block the socket operation.
  * @retval BPF_SOCK_ADDR_VERDICT_REJECT Allow the socket operation.
  *
- * Any other return value other than the two mentioned above is treated as BPF_SOCK_ADDR_VERDICT_REJECT.
+ * The verdict may be combined with BPF_SOCK_ADDR_VERDICT_CACHE or BPF_SOCK_ADDR_VERDICT_CACHE_PER_PROCESS. Any other
+ * return value other than the two mentioned above is treated as BPF_SOCK_ADDR_VERDICT_REJECT.
  */
 typedef int
 sock_addr_hook_t(bpf_sock_addr_t* context);
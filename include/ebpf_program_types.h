@@ -73,6 +73,20 @@ typedef void (*ebpf_program_context_destroy_t)(
     _Out_writes_bytes_to_opt_(*context_size_out, *context_size_out) uint8_t* context_out,
     _Inout_ size_t* context_size_out);
 
+typedef struct _ebpf_program_capabilities
+{
+    bool supports_context_header : 1; ///< Program contexts are preceded by an ebpf_context_header_t.
+} ebpf_program_capabilities_t;
+
+// Program types that set supports_context_header place this header immediately before every context they pass to
+// the execution context. The extension zero-initializes the header and, once the context will no longer be used to
+// invoke a program, calls free_storage if it has been set. All other fields are owned by the execution context.
+typedef struct _ebpf_context_header
+{
+    void* storage;                                                   ///< Per-context local storage.
+    void (*free_storage)(_Inout_ struct _ebpf_context_header* header); ///< Releases the per-context local storage.
+} ebpf_context_header_t;
+
 // This is the type definition for the eBPF program data
 // when version is EBPF_PROGRAM_DATA_CURRENT_VERSION.
 typedef struct _ebpf_program_data
@@ -87,6 +101,7 @@ typedef struct _ebpf_program_data
     ebpf_program_context_create_t context_create;   ///< Pointer to context create function.
     ebpf_program_context_destroy_t context_destroy; ///< Pointer to context destroy function.
     uint8_t required_irql;                          ///< IRQL at which the program is invoked.
+    ebpf_program_capabilities_t capabilities;       ///< Optional features supported by the program type.
 } ebpf_program_data_t;
 
 // This is the type definition for the eBPF program section information
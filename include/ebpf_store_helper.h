@@ -16,6 +16,87 @@ extern "C"
 
     typedef HKEY ebpf_store_key_t;
 
+#define EBPF_STORE_SNAPSHOT_MAGIC 0x50534245 // "EBSP"
+#define EBPF_STORE_SNAPSHOT_CURRENT_VERSION 1
+
+    /**
+     * @brief Type of a record in the program information snapshot.
+     */
+    typedef enum _ebpf_store_snapshot_record_type
+    {
+        EBPF_STORE_SNAPSHOT_RECORD_PROGRAM_INFORMATION, ///< Program information serialized by
+                                                        ///< ebpf_serialize_program_info.
+        EBPF_STORE_SNAPSHOT_RECORD_SECTION_INFORMATION, ///< ebpf_store_snapshot_section_record_t.
+        EBPF_STORE_SNAPSHOT_RECORD_GLOBAL_HELPER,       ///< ebpf_store_snapshot_helper_record_t.
+    } ebpf_store_snapshot_record_type_t;
+
+    /**
+     * @brief Header of the program information snapshot. The snapshot is stored as a single binary value and
+     * contains the same information as the per-key layout under the providers key.
+     */
+    typedef struct _ebpf_store_snapshot_header
+    {
+        uint32_t magic;        ///< EBPF_STORE_SNAPSHOT_MAGIC.
+        uint32_t version;      ///< EBPF_STORE_SNAPSHOT_CURRENT_VERSION.
+        uint64_t length;       ///< Length of the snapshot in bytes, including this header.
+        uint64_t hash;         ///< Hash of the records that follow this header.
+        uint32_t record_count; ///< Number of records that follow this header.
+        uint32_t reserved;     ///< Must be zero.
+    } ebpf_store_snapshot_header_t;
+
+    /**
+     * @brief Record in the program information snapshot. Records start on 8-byte boundaries.
+     */
+    typedef struct _ebpf_store_snapshot_record
+    {
+        uint32_t type;   ///< ebpf_store_snapshot_record_type_t.
+        uint32_t length; ///< Length of data in bytes.
+        uint8_t data[1]; ///< Record data.
+    } ebpf_store_snapshot_record_t;
+
+    typedef struct _ebpf_store_snapshot_section_record
+    {
+        uint32_t header_version;      ///< Version of the section information.
+        uint32_t header_size;         ///< Size of the section information.
+        GUID program_type;            ///< Program type.
+        GUID attach_type;             ///< Attach type.
+        uint32_t bpf_program_type;    ///< BPF program type.
+        uint32_t bpf_attach_type;     ///< BPF attach type.
+        uint32_t section_name_length; ///< Length of the section name in characters, not including a terminator.
+        wchar_t section_name[1];      ///< Section name.
+    } ebpf_store_snapshot_section_record_t;
+
+    typedef struct _ebpf_store_snapshot_helper_record
+    {
+        uint32_t header_version;           ///< Version of the helper function prototype.
+        uint32_t header_size;              ///< Size of the helper function prototype.
+        uint32_t helper_id;                ///< Helper ID.
+        ebpf_return_type_t return_type;    ///< Return type.
+        ebpf_argument_type_t arguments[5]; ///< Argument types.
+        uint32_t reallocate_packet;        ///< Non-zero if the helper can reallocate the packet.
+        uint32_t name_length;              ///< Length of the helper name in bytes, not including a terminator.
+        char name[1];                      ///< Helper name.
+    } ebpf_store_snapshot_helper_record_t;
+
+    /**
+     * @brief Compute the FNV-1a hash used to validate the records in a program information snapshot.
+     *
+     * @param[in] data Data to hash.
+     * @param[in] length Length of the data in bytes.
+     *
+     * @returns The 64-bit hash.
+     */
+    static inline uint64_t
+    ebpf_store_snapshot_hash(_In_reads_bytes_(length) const uint8_t* data, size_t length)
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (size_t index = 0; index < length; index++) {
+            hash ^= data[index];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
     extern ebpf_store_key_t ebpf_store_root_key;
     extern const wchar_t* ebpf_store_root_sub_key;
 
@@ -75,6 +156,37 @@ extern "C"
     ebpf_result_t
     ebpf_store_delete_section_information(_In_ const ebpf_program_section_info_t* section_info);
 
+    /**
+     * @brief Publish a snapshot of all program, section and global helper information in the eBPF store as a single
+     * binary value. Readers use the snapshot instead of walking the per-key layout. Any later update to the
+     * per-key layout deletes the snapshot, so the caller must supply the complete set of information.
+     *
+     * @param[in] program_info Pointer to an array of program information.
+     * @param[in] program_info_count Count of program information entries.
+     * @param[in] section_info Pointer to an array of section information.
+     * @param[in] section_info_count Count of section information entries.
+     * @param[in] helper_info Pointer to an array of global helper function prototypes.
+     * @param[in] helper_info_count Count of global helper function prototypes.
+     *
+     * @returns Status of the operation.
+     */
+    ebpf_result_t
+    ebpf_store_update_snapshot(
+        _In_reads_(program_info_count) const ebpf_program_info_t* program_info,
+        uint32_t program_info_count,
+        _In_reads_(section_info_count) const ebpf_program_section_info_t* section_info,
+        uint32_t section_info_count,
+        _In_reads_(helper_info_count) const ebpf_helper_function_prototype_t* helper_info,
+        uint32_t helper_info_count);
+
+    /**
+     * @brief Delete the program information snapshot from the eBPF store, if present.
+     *
+     * @returns Status of the operation.
+     */
+    ebpf_result_t
+    ebpf_store_delete_snapshot();
+
 #ifdef __cplusplus
 }
 #endif
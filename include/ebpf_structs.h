@@ -30,7 +30,8 @@ typedef enum bpf_map_type
     BPF_MAP_TYPE_QUEUE = 10,           ///< Queue.
     BPF_MAP_TYPE_LRU_PERCPU_HASH = 11, ///< Per-CPU least-recently-used hash table.
     BPF_MAP_TYPE_STACK = 12,           ///< Stack.
-    BPF_MAP_TYPE_RINGBUF = 13          ///< Ring buffer.
+    BPF_MAP_TYPE_RINGBUF = 13,         ///< Ring buffer.
+    BPF_MAP_TYPE_SK_STORAGE = 14       ///< Per-flow local storage, accessed with bpf_sk_storage_get.
 } ebpf_map_type_t;
 
 #define BPF_MAP_TYPE_PER_CPU(X) \
@@ -51,6 +52,7 @@ static const char* const _ebpf_map_type_names[] = {
     BPF_ENUM_TO_STRING(BPF_MAP_TYPE_LRU_PERCPU_HASH),
     BPF_ENUM_TO_STRING(BPF_MAP_TYPE_STACK),
     BPF_ENUM_TO_STRING(BPF_MAP_TYPE_RINGBUF),
+    BPF_ENUM_TO_STRING(BPF_MAP_TYPE_SK_STORAGE),
 };
 
 static const char* const _ebpf_map_display_names[] = {
@@ -68,6 +70,7 @@ static const char* const _ebpf_map_display_names[] = {
     "lru_percpu_hash",
     "stack",
     "ringbuf",
+    "sk_storage",
 };
 
 typedef enum ebpf_map_option
@@ -161,6 +164,11 @@ typedef enum
     BPF_FUNC_memset = 24,                    ///< \ref bpf_memset
     BPF_FUNC_memmove = 25,                   ///< \ref bpf_memmove
     BPF_FUNC_get_socket_cookie = 26,         ///< \ref bpf_get_socket_cookie
+    BPF_FUNC_get_current_app_id = 27,        ///< \ref bpf_get_current_app_id
+    BPF_FUNC_sk_storage_get = 28,            ///< \ref bpf_sk_storage_get
+    BPF_FUNC_sk_storage_delete = 29,         ///< \ref bpf_sk_storage_delete
+    BPF_FUNC_ktime_get_coarse_ns = 30,       ///< \ref bpf_ktime_get_coarse_ns
+    BPF_FUNC_ktime_get_fast_ns = 31,         ///< \ref bpf_ktime_get_fast_ns
 } ebpf_helper_id_t;
 
 // Cross-platform BPF program types.
@@ -378,12 +386,36 @@ struct bpf_map_info
     // Windows-specific fields.
     ebpf_id_t inner_map_id;     ///< ID of inner map template.
     uint32_t pinned_path_count; ///< Number of pinned paths.
+
+    // Access statistics, only reported when map_flags contains BPF_F_STATISTICS.
+    uint32_t entry_count;              ///< Number of entries in a hash based map.
+    uint32_t longest_bucket_length;    ///< Number of entries in the fullest bucket of a hash based map.
+    uint64_t lookup_count;             ///< Number of lookups.
+    uint64_t lookup_miss_count;        ///< Number of lookups that did not find the key.
+    uint64_t update_count;             ///< Number of successful updates.
+    uint64_t delete_count;             ///< Number of successful deletes.
+    uint64_t eviction_count;           ///< Number of entries evicted from an LRU map to make room for updates.
+    uint64_t allocation_failure_count; ///< Number of updates that failed to allocate memory.
 };
 
 #define BPF_ANY 0x0
 #define BPF_NOEXIST 0x1
 #define BPF_EXIST 0x2
 
+/// Windows-specific map flag to collect per-map access statistics, reported in bpf_map_info.
+#define BPF_F_STATISTICS 0x80000000
+
+/// Map flag to allocate the map storage on the NUMA node given by numa_node in bpf_map_create_opts.
+#define BPF_F_NUMA_NODE (1U << 2)
+
+/// Windows-specific map flag to keep a copy of the map contents on each NUMA node. Lookups are served from the copy
+/// of the node the caller runs on, and updates are applied to every copy. Only supported on array and hash maps.
+/// Such maps are meant to be read by programs and written from user mode: a program that writes through the pointer
+/// returned by bpf_map_lookup_elem only changes the copy of its own node, until the key is next updated.
+#define BPF_F_NUMA_REPLICATED 0x40000000
+
+#define BPF_SK_STORAGE_GET_F_CREATE 0x1 ///< Create the storage element if it does not exist.
+
 /**
  * @brief eBPF program information.  This structure can be retrieved by calling
  * \ref bpf_obj_get_info_by_fd on a program fd.
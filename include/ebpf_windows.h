@@ -39,6 +39,7 @@ typedef unsigned long long size_t;
 #define EBPF_PROGRAM_TYPE_DESCRIPTOR_REGISTRY_KEY L"TypeDescriptor"
 #define EBPF_PROGRAM_DATA_HELPERS_REGISTRY_KEY L"Helpers"
 #define EBPF_GLOBAL_HELPERS_REGISTRY_KEY L"GlobalHelpers"
+#define EBPF_STORE_SNAPSHOT L"Snapshot"
 
 #define EBPF_EXTENSION_HEADER_VERSION L"Version"
 #define EBPF_EXTENSION_HEADER_SIZE L"Size"
@@ -124,7 +125,7 @@ typedef enum _ebpf_helper_function
     }
 
 #define EBPF_PROGRAM_DATA_CURRENT_VERSION 1
-#define EBPF_PROGRAM_DATA_CURRENT_VERSION_SIZE EBPF_SIZE_INCLUDING_FIELD(ebpf_program_data_t, required_irql)
+#define EBPF_PROGRAM_DATA_CURRENT_VERSION_SIZE EBPF_SIZE_INCLUDING_FIELD(ebpf_program_data_t, capabilities)
 #define EBPF_PROGRAM_DATA_CURRENT_VERSION_TOTAL_SIZE sizeof(ebpf_program_data_t)
 #define EBPF_PROGRAM_DATA_HEADER                                                   \
     {                                                                              \
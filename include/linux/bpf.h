@@ -70,8 +70,12 @@ enum bpf_cmd_id
     BPF_PROG_BIND_MAP,
     BPF_PROG_TEST_RUN,
     BPF_PROG_RUN = BPF_PROG_TEST_RUN,
+    BPF_LINK_UPDATE,
 };
 
+/// Flag for BPF_LINK_UPDATE requiring that the link currently use old_prog_fd.
+#define BPF_F_REPLACE (1U << 2)
+
 /// Attributes used by BPF_OBJ_GET_INFO_BY_FD.
 typedef struct
 {
@@ -91,6 +95,15 @@ typedef struct
     uint32_t link_fd; ///< File descriptor of link to detach.
 } bpf_link_detach_attr_t;
 
+/// Attributes used by BPF_LINK_UPDATE.
+typedef struct
+{
+    uint32_t link_fd;     ///< File descriptor of link to update.
+    uint32_t new_prog_fd; ///< File descriptor of program to attach to the link.
+    uint32_t flags;       ///< Flags affecting the update operation.
+    uint32_t old_prog_fd; ///< File descriptor of the expected current program, used with BPF_F_REPLACE.
+} bpf_link_update_attr_t;
+
 /// Attributes used by BPF_PROG_BIND_MAP.
 typedef struct
 {
@@ -187,6 +200,9 @@ union bpf_attr
     // BPF_LINK_DETACH
     bpf_link_detach_attr_t link_detach; ///< Attributes used by BPF_LINK_DETACH.
 
+    // BPF_LINK_UPDATE
+    bpf_link_update_attr_t link_update; ///< Attributes used by BPF_LINK_UPDATE.
+
     // BPF_PROG_BIND_MAP
     bpf_prog_bind_map_attr_t prog_bind_map; ///< Attributes used by BPF_PROG_BIND_MAP.
 
@@ -0,0 +1,35 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @brief Header file for the eBPF network extension driver's device IOCTLs. The device is only accessible to
+ * SYSTEM and administrators.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define NET_EBPF_EXT_DEVICE_BASE_NAME L"NetEbpfExt"
+#define NET_EBPF_EXT_DEVICE_WIN32_NAME L"\\\\.\\" NET_EBPF_EXT_DEVICE_BASE_NAME
+
+//
+// IOCTL Codes
+//
+
+typedef enum _net_ebpf_ext_control_code
+{
+    NET_EBPF_EXT_CONTROL_GET_APP_ID,
+} net_ebpf_ext_control_code_t;
+
+/**
+ * @brief Reply to IOCTL_NET_EBPF_EXT_CTL_GET_APP_ID. The request is the WFP ALE application ID blob, as returned by
+ * FwpmGetAppIdFromFileName.
+ */
+typedef struct _net_ebpf_ext_get_app_id_reply
+{
+    uint64_t app_id; ///< Value that bpf_get_current_app_id returns for the application.
+} net_ebpf_ext_get_app_id_reply_t;
+
+#define IOCTL_NET_EBPF_EXT_CTL_GET_APP_ID \
+    CTL_CODE(FILE_DEVICE_NETWORK, NET_EBPF_EXT_CONTROL_GET_APP_ID, METHOD_BUFFERED, FILE_ANY_ACCESS)
@@ -20,7 +20,9 @@
 
 #include <ElfWrapper.h>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <sys/stat.h>
 #include <vector>
@@ -73,41 +75,6 @@ _get_pin_type_for_btf_map(const libbtf::btf_type_data& btf_data, libbtf::btf_typ
     return LIBBPF_PIN_NONE;
 }
 
-/**
- * @brief Invoke the visitor for each symbol in the specified section.
- *
- * @param[in] symbols Symbol table.
- * @param[in] required_section_index Section index to match.
- * @param[in] visitor Visitor to invoke for each symbol. Return false to stop iteration.
- */
-static void
-_for_each_symbol(
-    const ELFIO::const_symbol_section_accessor& symbols,
-    ELFIO::Elf_Half required_section_index,
-    std::function<bool(const std::string&, ELFIO::Elf64_Addr)> visitor)
-{
-    for (ELFIO::Elf_Xword i = 0; i < symbols.get_symbols_num(); i++) {
-        string symbol_name;
-        ELFIO::Elf64_Addr symbol_value{};
-        unsigned char symbol_bind{};
-        unsigned char symbol_type{};
-        ELFIO::Elf_Half symbol_section_index{};
-        unsigned char symbol_other{};
-        ELFIO::Elf_Xword symbol_size{};
-
-        symbols.get_symbol(
-            i, symbol_name, symbol_value, symbol_size, symbol_bind, symbol_type, symbol_section_index, symbol_other);
-
-        if (symbol_section_index != required_section_index) {
-            continue;
-        }
-
-        if (!visitor(symbol_name, symbol_value)) {
-            break;
-        }
-    }
-}
-
 template <typename T>
 static vector<T>
 vector_of(const ELFIO::section& sec)
@@ -209,24 +176,53 @@ _parse_btf_map_info_and_populate_cache(const ELFIO::elfio& reader, const vector<
 
 // Parse symbols to get map names for all maps sections.
 static void
-_get_map_names(
-    _In_ const ELFIO::elfio& reader,
-    _In_ const ELFIO::const_symbol_section_accessor& symbols,
-    _Inout_ vector<section_offset_to_map_t>& map_names) noexcept(false)
+_get_map_names(_In_ const ELFIO::elfio& reader, _Inout_ vector<section_offset_to_map_t>& map_names) noexcept(false)
 {
+    // Map names found in each maps section, keyed (and so ordered) by section index.
+    std::map<ELFIO::Elf_Half, vector<section_offset_to_map_t>> maps_sections;
     std::string maps_prefix = "maps/";
     for (const auto& section : reader.sections) {
         std::string name = section->get_name();
         if (name == ".maps" || name == "maps" ||
             (name.length() > 5 && name.compare(0, maps_prefix.length(), maps_prefix) == 0)) {
-            _for_each_symbol(
-                symbols, section->get_index(), [&](const std::string& symbol_name, ELFIO::Elf64_Addr symbol_value) {
-                    map_names.emplace_back(symbol_value, symbol_name);
-                    return true;
-                });
+            maps_sections[section->get_index()];
+        }
+    }
+
+    // Walk the symbol table once, rather than once per maps section.
+    ELFIO::section* symbol_section = reader.sections[".symtab"];
+    if (!maps_sections.empty() && symbol_section) {
+        ELFIO::const_symbol_section_accessor symbols{reader, symbol_section};
+        for (ELFIO::Elf_Xword i = 0; i < symbols.get_symbols_num(); i++) {
+            string symbol_name;
+            ELFIO::Elf64_Addr symbol_value{};
+            unsigned char symbol_bind{};
+            unsigned char symbol_type{};
+            ELFIO::Elf_Half symbol_section_index{};
+            unsigned char symbol_other{};
+            ELFIO::Elf_Xword symbol_size{};
+
+            symbols.get_symbol(
+                i,
+                symbol_name,
+                symbol_value,
+                symbol_size,
+                symbol_bind,
+                symbol_type,
+                symbol_section_index,
+                symbol_other);
+
+            auto maps_section = maps_sections.find(symbol_section_index);
+            if (maps_section != maps_sections.end()) {
+                maps_section->second.emplace_back(symbol_value, symbol_name);
+            }
         }
     }
 
+    for (auto& [section_index, section_map_names] : maps_sections) {
+        map_names.insert(map_names.end(), section_map_names.begin(), section_map_names.end());
+    }
+
     ELFIO::section* btf_maps_section = reader.sections[".maps"];
     if (btf_maps_section) {
         _parse_btf_map_info_and_populate_cache(reader, map_names);
@@ -253,28 +249,64 @@ _get_map_names(
     }
 }
 
-static void
-_get_map_names(
-    std::variant<std::string, std::vector<uint8_t>>& file_or_buffer,
-    _Inout_ vector<section_offset_to_map_t>& map_names) noexcept(false)
+/**
+ * @brief Parsed form of an ELF object. The image is read once and loaded into a single ELFIO reader, from which the
+ * map names are resolved. It only lives while the object is being opened or enumerated.
+ */
+typedef struct _ebpf_elf_object_model
 {
-    ELFIO::elfio reader;
+    std::string image;                              ///< Raw ELF image.
+    ELFIO::elfio reader;                            ///< Sections, symbols and relocations of the image.
+    std::vector<raw_program> raw_programs;          ///< Programs found in the requested section(s).
+    std::vector<section_offset_to_map_t> map_names; ///< Map symbols, by offset in their maps section.
+} ebpf_elf_object_model_t;
+
+/**
+ * @brief Read and parse an ELF object.
+ *
+ * @param[in] file_or_buffer File name or in-memory ELF image.
+ * @param[in] section_name Section to extract programs from, or empty for all sections.
+ * @param[in] verifier_options Verifier options used to extract the programs.
+ * @param[in] parse_maps Whether to resolve map names and BTF map definitions into the map descriptor cache.
+ * @return The parsed object.
+ */
+static std::unique_ptr<const ebpf_elf_object_model_t>
+_create_elf_object_model(
+    const std::variant<std::string, std::vector<uint8_t>>& file_or_buffer,
+    const std::string& section_name,
+    _In_ const ebpf_verifier_options_t* verifier_options,
+    bool parse_maps) noexcept(false)
+{
+    auto model = std::make_unique<ebpf_elf_object_model_t>();
+    std::string stream_name;
 
     if (std::holds_alternative<std::string>(file_or_buffer)) {
-        if (!reader.load(std::get<std::string>(file_or_buffer))) {
-            throw std::runtime_error("Can't process ELF file " + std::get<std::string>(file_or_buffer));
+        stream_name = std::get<std::string>(file_or_buffer);
+        std::ifstream file_stream(stream_name, std::ios::in | std::ios::binary);
+        if (!file_stream) {
+            throw std::runtime_error(std::string("No such file or directory opening ") + stream_name);
         }
+        model->image.assign(std::istreambuf_iterator<char>(file_stream), std::istreambuf_iterator<char>());
     } else {
-        std::stringstream buffer_stream(std::string(
-            std::get<std::vector<uint8_t>>(file_or_buffer).begin(),
-            std::get<std::vector<uint8_t>>(file_or_buffer).end()));
-        if (!reader.load(buffer_stream)) {
-            throw std::runtime_error("Can't process ELF file from memory");
+        stream_name = "memory";
+        auto& buffer = std::get<std::vector<uint8_t>>(file_or_buffer);
+        model->image.assign(buffer.begin(), buffer.end());
+    }
+
+    // The verifier parses the image from a stream; everything else uses the reader below.
+    std::istringstream image_stream(model->image);
+    model->raw_programs = read_elf(image_stream, stream_name, section_name, verifier_options, &g_ebpf_platform_windows);
+
+    if (parse_maps) {
+        image_stream.clear();
+        image_stream.seekg(0);
+        if (!model->reader.load(image_stream)) {
+            throw std::runtime_error("Can't process ELF file " + stream_name);
         }
+        _get_map_names(model->reader, model->map_names);
     }
 
-    ELFIO::const_symbol_section_accessor symbols{reader, reader.sections[".symtab"]};
-    _get_map_names(reader, symbols, map_names);
+    return model;
 }
 
 _Must_inspect_result_ ebpf_result_t
@@ -296,32 +328,21 @@ load_byte_code(
     ebpf_program_type_t empty_program_type{};
 
     try {
-        const ebpf_platform_t* platform = &g_ebpf_platform_windows;
         std::string section_name_string;
         if (section_name != nullptr) {
             section_name_string = std::string(section_name);
         }
 
-        std::vector<raw_program> raw_programs;
-
-        // If file_or_buffer is a string, it is a file name.
-        if (std::holds_alternative<std::string>(file_or_buffer)) {
-            raw_programs =
-                read_elf(std::get<std::string>(file_or_buffer), section_name_string, verifier_options, platform);
-        } else {
-            std::stringstream buffer_stream;
-            // If file_or_buffer is a vector, it is a buffer.
-            auto& buffer = std::get<std::vector<uint8_t>>(file_or_buffer);
-            buffer_stream = std::stringstream(std::string(buffer.begin(), buffer.end()));
-            raw_programs = read_elf(buffer_stream, "memory", section_name_string, verifier_options, platform);
-        }
+        auto model = _create_elf_object_model(file_or_buffer, section_name_string, verifier_options, true);
+        const std::vector<raw_program>& raw_programs = model->raw_programs;
+        map_names = model->map_names;
 
         if (raw_programs.size() == 0) {
             result = EBPF_ELF_PARSING_FAILED;
             goto Exit;
         }
 
-        for (auto& raw_program : raw_programs) {
+        for (const auto& raw_program : raw_programs) {
             program = (ebpf_program_t*)ebpf_allocate(sizeof(ebpf_program_t));
             if (program == nullptr) {
                 result = EBPF_NO_MEMORY;
@@ -369,8 +390,6 @@ load_byte_code(
             program = nullptr;
         }
 
-        _get_map_names(file_or_buffer, map_names);
-
         auto map_descriptors = get_all_map_descriptors();
         size_t anonymous_map_count = 0;
         for (const auto& descriptor : map_descriptors) {
@@ -487,7 +506,6 @@ ebpf_api_elf_enumerate_programs(
     _Outptr_result_maybenull_z_ const char** error_message) noexcept
 {
     ebpf_verifier_options_t verifier_options{false, false, false, false, true};
-    const ebpf_platform_t* platform = &g_ebpf_platform_windows;
     std::ostringstream str;
 
     *infos = nullptr;
@@ -497,8 +515,9 @@ ebpf_api_elf_enumerate_programs(
     ebpf_clear_thread_local_storage();
 
     try {
-        auto raw_programs = read_elf(file, section ? std::string(section) : std::string(), &verifier_options, platform);
-        for (const auto& raw_program : raw_programs) {
+        auto model = _create_elf_object_model(
+            std::string(file), section ? std::string(section) : std::string(), &verifier_options, false);
+        for (const auto& raw_program : model->raw_programs) {
             info = (ebpf_api_program_info_t*)ebpf_allocate(sizeof(*info));
             if (info == nullptr) {
                 throw std::runtime_error("Out of memory");
@@ -428,6 +428,22 @@ ebpf_map_get_next_key(fd_t map_fd, _In_opt_ const void* previous_key, _Out_ void
 _Must_inspect_result_ ebpf_result_t
 ebpf_detach_link_by_fd(fd_t fd) noexcept;
 
+/**
+ * @brief Replace the program attached to a link without detaching the link.
+ *
+ * @param[in] link_fd File descriptor for the link.
+ * @param[in] program_fd File descriptor for the program to attach.
+ * @param[in] old_program_fd Optional file descriptor for the program that
+ *  must currently be attached, or ebpf_fd_invalid.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_INVALID_FD A file descriptor was not valid.
+ * @retval EBPF_INVALID_ARGUMENT The link is not attached to old_program_fd,
+ *  or the program type does not match the link.
+ */
+_Must_inspect_result_ ebpf_result_t
+ebpf_update_link_program_by_fd(fd_t link_fd, fd_t program_fd, fd_t old_program_fd) noexcept;
+
 /**
  * @brief Open a file descriptor for the map with a given ID.
  *
@@ -18,6 +18,12 @@ bpf(int cmd, union bpf_attr* attr, unsigned int size)
     case BPF_LINK_DETACH:
         CHECK_SIZE(link_detach.link_fd);
         return bpf_link_detach(attr->link_detach.link_fd);
+    case BPF_LINK_UPDATE: {
+        CHECK_SIZE(link_update.old_prog_fd);
+        struct bpf_link_update_opts opts = {
+            .sz = sizeof(opts), .flags = attr->link_update.flags, .old_prog_fd = attr->link_update.old_prog_fd};
+        return bpf_link_update(attr->link_update.link_fd, attr->link_update.new_prog_fd, &opts);
+    }
     case BPF_LINK_GET_FD_BY_ID:
         CHECK_SIZE(link_id);
         return bpf_link_get_fd_by_id(attr->link_id);
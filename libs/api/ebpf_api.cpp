@@ -20,6 +20,7 @@
 #include "libbpf.h"
 #pragma warning(pop)
 #include "map_descriptors.hpp"
+#include "net_ebpf_ext_ioctls.h"
 #define _PEPARSE_WINDOWS_CONFLICTS
 #include "pe-parse/parse.h"
 #if !defined(CONFIG_BPF_JIT_DISABLED) || !defined(CONFIG_BPF_INTERPRETER_DISABLED)
@@ -36,8 +37,10 @@ typedef unsigned char boolean;
 #include "windows_platform_common.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <codecvt>
 #include <fcntl.h>
+#include <fwpmu.h>
 #include <io.h>
 #include <mutex>
 #include <rpc.h>
@@ -51,6 +54,8 @@ const GUID GUID_NULL = {0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0}};
 
 #define MAX_CODE_SIZE (32 * 1024) // 32 KB
 
+#pragma comment(lib, "fwpuclnt")
+
 static std::mutex _ebpf_state_mutex;
 _Guarded_by_(_ebpf_state_mutex) static std::map<ebpf_handle_t, ebpf_program_t*> _ebpf_programs;
 _Guarded_by_(_ebpf_state_mutex) static std::map<ebpf_handle_t, ebpf_map_t*> _ebpf_maps;
@@ -250,6 +255,8 @@ _create_map(
     _In_opt_z_ const char* name,
     _In_ const ebpf_map_definition_in_memory_t* map_definition,
     ebpf_handle_t inner_map_handle,
+    uint32_t map_flags,
+    uint32_t numa_node,
     _Out_ ebpf_handle_t* map_handle) NO_EXCEPT_TRY
 {
     EBPF_LOG_ENTRY();
@@ -279,6 +286,8 @@ _create_map(
     request->header.length = static_cast<uint16_t>(request_buffer.size());
     request->ebpf_map_definition = *map_definition;
     request->inner_map_handle = (uint64_t)inner_map_handle;
+    request->map_flags = map_flags;
+    request->numa_node = numa_node;
     std::copy(
         map_name.begin(), map_name.end(), request_buffer.begin() + offsetof(ebpf_operation_create_map_request_t, data));
 
@@ -295,6 +304,18 @@ Exit:
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
+static ebpf_result_t
+_map_set_statistics(ebpf_handle_t map_handle, bool enabled) NO_EXCEPT_TRY
+{
+    ebpf_operation_map_set_statistics_request_t request = {0};
+    request.header.length = sizeof(request);
+    request.header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_SET_STATISTICS;
+    request.handle = map_handle;
+    request.enabled = enabled;
+    return win32_error_code_to_ebpf_result(invoke_ioctl(request));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_map_create(
     enum bpf_map_type map_type,
@@ -313,7 +334,7 @@ ebpf_map_create(
 
     ebpf_assert(map_fd);
 
-    if (opts && opts->map_flags != 0) {
+    if (opts && (opts->map_flags & ~(BPF_F_STATISTICS | BPF_F_NUMA_NODE | BPF_F_NUMA_REPLICATED)) != 0) {
         result = EBPF_INVALID_ARGUMENT;
         goto Exit;
     }
@@ -330,10 +351,23 @@ ebpf_map_create(
         inner_map_handle = (opts && opts->inner_map_fd != 0) ? _get_handle_from_file_descriptor(opts->inner_map_fd)
                                                              : ebpf_handle_invalid;
 
-        result = _create_map(map_name, &map_definition, inner_map_handle, &map_handle);
+        result = _create_map(
+            map_name,
+            &map_definition,
+            inner_map_handle,
+            opts ? (opts->map_flags & (BPF_F_NUMA_NODE | BPF_F_NUMA_REPLICATED)) : 0,
+            opts ? opts->numa_node : 0,
+            &map_handle);
         if (result != EBPF_SUCCESS) {
             goto Exit;
         }
+        if (opts && (opts->map_flags & BPF_F_STATISTICS)) {
+            // The map is not yet visible to anyone else, so statistics cover every access.
+            result = _map_set_statistics(map_handle, true);
+            if (result != EBPF_SUCCESS) {
+                goto Exit;
+            }
+        }
         *map_fd = _create_file_descriptor_for_handle(map_handle);
         if (*map_fd == ebpf_fd_invalid) {
             result = EBPF_NO_MEMORY;
@@ -357,6 +391,11 @@ Exit:
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
+// Per-thread protocol buffers reused by the single element map operations. Resizing within the existing
+// capacity does not allocate, so after warm-up each element operation is a single IOCTL with no heap traffic.
+thread_local static ebpf_protocol_buffer_t _ebpf_element_request_buffer;
+thread_local static ebpf_protocol_buffer_t _ebpf_element_reply_buffer;
+
 static ebpf_result_t
 _map_lookup_element(
     ebpf_handle_t handle,
@@ -370,10 +409,10 @@ _map_lookup_element(
     ebpf_result_t result = EBPF_SUCCESS;
     ebpf_assert(value);
     try {
-        ebpf_protocol_buffer_t request_buffer(
-            EBPF_OFFSET_OF(ebpf_operation_map_find_element_request_t, key) + key_size);
-        ebpf_protocol_buffer_t reply_buffer(
-            EBPF_OFFSET_OF(ebpf_operation_map_find_element_reply_t, value) + value_size);
+        ebpf_protocol_buffer_t& request_buffer = _ebpf_element_request_buffer;
+        ebpf_protocol_buffer_t& reply_buffer = _ebpf_element_reply_buffer;
+        request_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_find_element_request_t, key) + key_size);
+        reply_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_find_element_reply_t, value) + value_size);
         auto request = reinterpret_cast<ebpf_operation_map_find_element_request_t*>(request_buffer.data());
         auto reply = reinterpret_cast<ebpf_operation_map_find_element_reply_t*>(reply_buffer.data());
 
@@ -448,17 +487,163 @@ Exit:
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
+// Cache of map properties indexed by file descriptor. Maps that were not created by a bpf_object in this process
+// (pinned maps, maps opened by ID or fd) would otherwise need a query_map_definition IOCTL on every element
+// operation, and maps that were would need _ebpf_state_mutex. Each entry is protected by a sequence counter so that
+// readers never block: a reader retries the slow path if it observes a writer in progress or a changed sequence.
+#define EBPF_MAP_FD_CACHE_SIZE 1024
+
+typedef struct _ebpf_map_fd_properties
+{
+    ebpf_handle_t handle;
+    uint32_t type;
+    uint32_t key_size;
+    uint32_t value_size;
+    uint32_t max_entries;
+} ebpf_map_fd_properties_t;
+
+typedef struct _ebpf_map_fd_cache_entry
+{
+    std::atomic<uint32_t> sequence; // Odd while an update is in progress.
+    std::atomic<ebpf_handle_t> handle;
+    std::atomic<uint32_t> type;
+    std::atomic<uint32_t> key_size;
+    std::atomic<uint32_t> value_size;
+    std::atomic<uint32_t> max_entries;
+} ebpf_map_fd_cache_entry_t;
+
+static ebpf_map_fd_cache_entry_t _ebpf_map_fd_cache[EBPF_MAP_FD_CACHE_SIZE];
+
+static bool
+_ebpf_map_fd_cache_read(fd_t map_fd, ebpf_handle_t map_handle, _Out_ ebpf_map_fd_properties_t* properties) noexcept
+{
+    if (map_fd < 0 || map_fd >= EBPF_MAP_FD_CACHE_SIZE) {
+        return false;
+    }
+    ebpf_map_fd_cache_entry_t& entry = _ebpf_map_fd_cache[map_fd];
+
+    uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+    properties->handle = entry.handle.load(std::memory_order_relaxed);
+    properties->type = entry.type.load(std::memory_order_relaxed);
+    properties->key_size = entry.key_size.load(std::memory_order_relaxed);
+    properties->value_size = entry.value_size.load(std::memory_order_relaxed);
+    properties->max_entries = entry.max_entries.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry.sequence.load(std::memory_order_relaxed) != sequence) {
+        return false;
+    }
+
+    // The fd may have been closed and reused for a different handle since the entry was written.
+    return (properties->handle == map_handle) && (properties->type != BPF_MAP_TYPE_UNSPEC);
+}
+
+static void
+_ebpf_map_fd_cache_write(fd_t map_fd, _In_ const ebpf_map_fd_properties_t* properties) noexcept
+{
+    if (map_fd < 0 || map_fd >= EBPF_MAP_FD_CACHE_SIZE) {
+        return;
+    }
+    ebpf_map_fd_cache_entry_t& entry = _ebpf_map_fd_cache[map_fd];
+
+    // If another thread is already updating this entry, skip the update; the cache is best effort.
+    uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) || !entry.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acq_rel)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.handle.store(properties->handle, std::memory_order_relaxed);
+    entry.type.store(properties->type, std::memory_order_relaxed);
+    entry.key_size.store(properties->key_size, std::memory_order_relaxed);
+    entry.value_size.store(properties->value_size, std::memory_order_relaxed);
+    entry.max_entries.store(properties->max_entries, std::memory_order_relaxed);
+    entry.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+static void
+_ebpf_map_fd_cache_invalidate(fd_t map_fd) noexcept
+{
+    ebpf_map_fd_properties_t properties = {ebpf_handle_invalid, BPF_MAP_TYPE_UNSPEC};
+    _ebpf_map_fd_cache_write(map_fd, &properties);
+}
+
+/**
+ * @brief Resolve a map fd to its handle and map properties.
+ *
+ * @param[in] map_fd File descriptor of the map.
+ * @param[in] refresh If true, ignore any cached entry and query the properties again.
+ * @param[out] properties Handle and properties of the map.
+ *
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_INVALID_FD The fd is not valid.
+ * @retval EBPF_INVALID_ARGUMENT The fd does not refer to a map.
+ */
+static ebpf_result_t
+_get_map_fd_properties(fd_t map_fd, bool refresh, _Out_ ebpf_map_fd_properties_t* properties) NO_EXCEPT_TRY
+{
+    ebpf_result_t result;
+
+    properties->handle = _get_handle_from_file_descriptor(map_fd);
+    if (properties->handle == ebpf_handle_invalid) {
+        return EBPF_INVALID_FD;
+    }
+
+    if (!refresh && _ebpf_map_fd_cache_read(map_fd, properties->handle, properties)) {
+        return EBPF_SUCCESS;
+    }
+
+    // Get map properties, either from local cache or from execution context.
+    result = _get_map_descriptor_properties(
+        properties->handle,
+        &properties->type,
+        &properties->key_size,
+        &properties->value_size,
+        &properties->max_entries);
+    if (result != EBPF_SUCCESS) {
+        return result;
+    }
+    _ebpf_map_fd_cache_write(map_fd, properties);
+    return EBPF_SUCCESS;
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+/**
+ * @brief Check whether an element operation failed because the cached properties for the fd were stale, e.g.,
+ * because the application closed the fd and it was reused for a different map. If so, the cache entry is refreshed
+ * and the caller should retry the operation once.
+ *
+ * @param[in] map_fd File descriptor of the map.
+ * @param[in] result Result of the element operation.
+ * @param[in] properties Properties that were used for the operation.
+ *
+ * @retval true The properties were stale and have been refreshed.
+ * @retval false The failure was not caused by stale properties.
+ */
+static bool
+_map_fd_properties_are_stale(
+    fd_t map_fd, ebpf_result_t result, _In_ const ebpf_map_fd_properties_t* properties) noexcept
+{
+    if (result != EBPF_INVALID_ARGUMENT && result != EBPF_INVALID_OBJECT) {
+        return false;
+    }
+    ebpf_map_fd_properties_t current;
+    if (_get_map_fd_properties(map_fd, true, &current) != EBPF_SUCCESS) {
+        return false;
+    }
+    return (current.handle != properties->handle) || (current.type != properties->type) ||
+           (current.key_size != properties->key_size) || (current.value_size != properties->value_size);
+}
+
 static ebpf_result_t
 _ebpf_map_lookup_element_helper(fd_t map_fd, bool find_and_delete, _In_opt_ const void* key, _Out_ void* value)
     NO_EXCEPT_TRY
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result = EBPF_SUCCESS;
-    ebpf_handle_t map_handle;
-    uint32_t key_size = 0;
-    uint32_t value_size = 0;
-    uint32_t max_entries = 0;
-    uint32_t type;
+    ebpf_map_fd_properties_t properties;
+    uint32_t value_size;
 
     ebpf_assert(value);
     if (map_fd <= 0) {
@@ -467,29 +652,27 @@ _ebpf_map_lookup_element_helper(fd_t map_fd, bool find_and_delete, _In_opt_ cons
     }
     *((uint8_t*)value) = 0;
 
-    map_handle = _get_handle_from_file_descriptor(map_fd);
-    if (map_handle == ebpf_handle_invalid) {
-        result = EBPF_INVALID_FD;
-        goto Exit;
-    }
-
-    // Get map properties, either from local cache or from execution context.
-    result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
-    if (result != EBPF_SUCCESS) {
-        goto Exit;
-    }
-    if ((key == nullptr) != (key_size == 0)) {
-        result = EBPF_INVALID_ARGUMENT;
-        goto Exit;
-    }
-    assert(value_size != 0);
-    if (BPF_MAP_TYPE_PER_CPU(type)) {
-        value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
-    }
+    for (bool refresh = false;; refresh = true) {
+        // Get map properties, either from the per-fd cache or from execution context.
+        result = _get_map_fd_properties(map_fd, refresh, &properties);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        if ((key == nullptr) != (properties.key_size == 0)) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Exit;
+        }
+        assert(properties.value_size != 0);
+        value_size = properties.value_size;
+        if (BPF_MAP_TYPE_PER_CPU(properties.type)) {
+            value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
+        }
 
-    result = _map_lookup_element(map_handle, find_and_delete, key_size, (uint8_t*)key, value_size, (uint8_t*)value);
-    if (result != EBPF_SUCCESS) {
-        goto Exit;
+        result = _map_lookup_element(
+            properties.handle, find_and_delete, properties.key_size, (uint8_t*)key, value_size, (uint8_t*)value);
+        if (refresh || !_map_fd_properties_are_stale(map_fd, result, &properties)) {
+            break;
+        }
     }
 
 Exit:
@@ -683,6 +866,284 @@ ebpf_map_lookup_and_delete_element_batch(
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
+static ebpf_result_t
+_map_find_element_batch(
+    ebpf_handle_t handle,
+    bool find_and_delete,
+    size_t key_size,
+    size_t value_size,
+    size_t count,
+    _In_reads_bytes_(count* key_size) const uint8_t* keys,
+    _Out_writes_bytes_(count* value_size) uint8_t* values,
+    _Out_writes_(count) ebpf_result_t* results) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_element_request_buffer;
+    ebpf_protocol_buffer_t& reply_buffer = _ebpf_element_reply_buffer;
+
+    // Compute the maximum number of keys that fit in both a single request and a single reply.
+    size_t max_entries_per_batch =
+        min((UINT16_MAX - EBPF_OFFSET_OF(ebpf_operation_map_find_element_batch_request_t, keys)) / key_size,
+            (UINT16_MAX - EBPF_OFFSET_OF(ebpf_operation_map_find_element_batch_reply_t, data)) /
+                (sizeof(ebpf_result_t) + value_size));
+    if (max_entries_per_batch == 0) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    for (size_t key_index = 0; key_index < count;) {
+        size_t entries_to_find = min(count - key_index, max_entries_per_batch);
+
+        request_buffer.resize(
+            EBPF_OFFSET_OF(ebpf_operation_map_find_element_batch_request_t, keys) + key_size * entries_to_find);
+        reply_buffer.resize(
+            EBPF_OFFSET_OF(ebpf_operation_map_find_element_batch_reply_t, data) +
+            entries_to_find * (sizeof(ebpf_result_t) + value_size));
+        auto request = reinterpret_cast<ebpf_operation_map_find_element_batch_request_t*>(request_buffer.data());
+        auto reply = reinterpret_cast<ebpf_operation_map_find_element_batch_reply_t*>(reply_buffer.data());
+
+        request->header.length = static_cast<uint16_t>(request_buffer.size());
+        request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_FIND_ELEMENT_BATCH;
+        request->handle = handle;
+        request->find_and_delete = find_and_delete;
+        std::copy(keys + key_index * key_size, keys + (key_index + entries_to_find) * key_size, request->keys);
+
+        result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer, reply_buffer));
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+
+        // The reply holds one result per key followed by the values.
+        const uint8_t* reply_results = reply->data;
+        const uint8_t* reply_values = reply->data + entries_to_find * sizeof(ebpf_result_t);
+        memcpy(results + key_index, reply_results, entries_to_find * sizeof(ebpf_result_t));
+        std::copy(reply_values, reply_values + entries_to_find * value_size, values + key_index * value_size);
+
+        key_index += entries_to_find;
+    }
+
+Exit:
+    EBPF_RETURN_RESULT(result);
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+static ebpf_result_t
+_ebpf_map_lookup_elements_by_keys_helper(
+    fd_t map_fd,
+    _In_ const void* keys,
+    _Out_ void* values,
+    _Out_writes_(count) ebpf_result_t* results,
+    uint32_t count,
+    bool find_and_delete) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_map_fd_properties_t properties;
+    size_t value_size;
+
+    ebpf_assert(keys);
+    ebpf_assert(values);
+    ebpf_assert(results);
+    if (map_fd <= 0 || count == 0) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    for (bool refresh = false;; refresh = true) {
+        // Get map properties, either from the per-fd cache or from execution context.
+        result = _get_map_fd_properties(map_fd, refresh, &properties);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        if (properties.key_size == 0 || properties.value_size == 0) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Exit;
+        }
+        value_size = properties.value_size;
+        if (BPF_MAP_TYPE_PER_CPU(properties.type)) {
+            value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
+        }
+
+        result = _map_find_element_batch(
+            properties.handle,
+            find_and_delete,
+            properties.key_size,
+            value_size,
+            count,
+            reinterpret_cast<const uint8_t*>(keys),
+            reinterpret_cast<uint8_t*>(values),
+            results);
+        if (refresh || !_map_fd_properties_are_stale(map_fd, result, &properties)) {
+            break;
+        }
+    }
+
+Exit:
+    EBPF_RETURN_RESULT(result);
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_lookup_elements_by_keys(
+    fd_t map_fd,
+    _In_ const void* keys,
+    _Out_ void* values,
+    _Out_writes_(count) ebpf_result_t* results,
+    uint32_t count,
+    uint64_t flags) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    if (flags != 0) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+    EBPF_RETURN_RESULT(_ebpf_map_lookup_elements_by_keys_helper(map_fd, keys, values, results, count, false));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_lookup_and_delete_elements_by_keys(
+    fd_t map_fd,
+    _In_ const void* keys,
+    _Out_ void* values,
+    _Out_writes_(count) ebpf_result_t* results,
+    uint32_t count,
+    uint64_t flags) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    if (flags != 0) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+    EBPF_RETURN_RESULT(_ebpf_map_lookup_elements_by_keys_helper(map_fd, keys, values, results, count, true));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+static ebpf_result_t
+_map_replace_contents(
+    ebpf_handle_t handle,
+    size_t key_size,
+    size_t value_size,
+    size_t count,
+    _In_reads_bytes_(count* key_size) const uint8_t* keys,
+    _In_reads_bytes_(count* value_size) const uint8_t* values) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_element_request_buffer;
+    size_t record_size = key_size + value_size;
+
+    // Compute the maximum number of records that fit in a single request.
+    size_t max_entries_per_batch =
+        (UINT16_MAX - EBPF_OFFSET_OF(ebpf_operation_map_stage_contents_request_t, data)) / record_size;
+    if (max_entries_per_batch == 0) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    // Stage the records in chunks. The first request discards anything previously staged, and is sent even when
+    // there are no records so that the map is emptied.
+    size_t record_index = 0;
+    do {
+        size_t entries_to_stage = min(count - record_index, max_entries_per_batch);
+
+        request_buffer.resize(
+            EBPF_OFFSET_OF(ebpf_operation_map_stage_contents_request_t, data) + record_size * entries_to_stage);
+        auto request = reinterpret_cast<ebpf_operation_map_stage_contents_request_t*>(request_buffer.data());
+
+        request->header.length = static_cast<uint16_t>(request_buffer.size());
+        request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_STAGE_CONTENTS;
+        request->handle = handle;
+        request->reset = (record_index == 0);
+        for (size_t index = 0; index < entries_to_stage; index++) {
+            uint8_t* record = request->data + index * record_size;
+            std::copy(
+                keys + (record_index + index) * key_size, keys + (record_index + index + 1) * key_size, record);
+            std::copy(
+                values + (record_index + index) * value_size,
+                values + (record_index + index + 1) * value_size,
+                record + key_size);
+        }
+
+        result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer));
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+
+        record_index += entries_to_stage;
+    } while (record_index < count);
+
+    {
+        ebpf_operation_map_replace_contents_request_t request = {0};
+        request.header.length = sizeof(request);
+        request.header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_REPLACE_CONTENTS;
+        request.handle = handle;
+        request.record_count = static_cast<uint32_t>(count);
+        result = win32_error_code_to_ebpf_result(invoke_ioctl(request));
+    }
+
+Exit:
+    EBPF_RETURN_RESULT(result);
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_replace_contents(
+    fd_t map_fd, _In_opt_ const void* keys, _In_opt_ const void* values, uint32_t count, uint64_t flags) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_map_fd_properties_t properties;
+    size_t value_size;
+
+    if (map_fd <= 0 || flags != 0 || (count > 0 && (keys == nullptr || values == nullptr))) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    for (bool refresh = false;; refresh = true) {
+        // Get map properties, either from the per-fd cache or from execution context.
+        result = _get_map_fd_properties(map_fd, refresh, &properties);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        if (properties.key_size == 0 || properties.value_size == 0) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Exit;
+        }
+        value_size = properties.value_size;
+        if (BPF_MAP_TYPE_PER_CPU(properties.type)) {
+            value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
+        }
+
+        result = _map_replace_contents(
+            properties.handle,
+            properties.key_size,
+            value_size,
+            count,
+            reinterpret_cast<const uint8_t*>(keys),
+            reinterpret_cast<const uint8_t*>(values));
+        if (refresh || !_map_fd_properties_are_stale(map_fd, result, &properties)) {
+            break;
+        }
+    }
+
+Exit:
+    EBPF_RETURN_RESULT(result);
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_set_statistics(fd_t map_fd, bool enabled) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    ebpf_handle_t map_handle = _get_handle_from_file_descriptor(map_fd);
+    if (map_handle == ebpf_handle_invalid) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+    }
+    EBPF_RETURN_RESULT(_map_set_statistics(map_handle, enabled));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
 static ebpf_result_t
 _update_map_element(
     ebpf_handle_t map_handle,
@@ -694,7 +1155,7 @@ _update_map_element(
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result;
-    ebpf_protocol_buffer_t request_buffer;
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_element_request_buffer;
     ebpf_operation_map_update_element_request_t* request;
     ebpf_assert(value);
     ebpf_assert(key || !key_size);
@@ -817,8 +1278,8 @@ _update_map_element_with_handle(
 {
     EBPF_LOG_ENTRY();
     ebpf_assert(key);
-    ebpf_protocol_buffer_t request_buffer(
-        EBPF_OFFSET_OF(ebpf_operation_map_update_element_with_handle_request_t, key) + key_size);
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_element_request_buffer;
+    request_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_update_element_with_handle_request_t, key) + key_size);
     auto request = reinterpret_cast<ebpf_operation_map_update_element_with_handle_request_t*>(request_buffer.data());
 
     request->header.length = static_cast<uint16_t>(request_buffer.size());
@@ -837,11 +1298,8 @@ ebpf_map_update_element(fd_t map_fd, _In_opt_ const void* key, _In_ const void*
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result = EBPF_SUCCESS;
-    ebpf_handle_t map_handle;
-    uint32_t key_size = 0;
-    uint32_t value_size = 0;
-    uint32_t max_entries = 0;
-    uint32_t type;
+    ebpf_map_fd_properties_t properties;
+    uint32_t value_size;
 
     ebpf_assert(value);
     if (map_fd <= 0) {
@@ -857,44 +1315,47 @@ ebpf_map_update_element(fd_t map_fd, _In_opt_ const void* key, _In_ const void*
         EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
     }
 
-    map_handle = _get_handle_from_file_descriptor(map_fd);
-    if (map_handle == ebpf_handle_invalid) {
-        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
-    }
-
-    // Get map properties, either from local cache or from execution context.
-    result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
-    if (result != EBPF_SUCCESS) {
-        EBPF_RETURN_RESULT(result);
-    }
-    if ((key == nullptr) != (key_size == 0)) {
-        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
-    }
-    assert(value_size != 0);
-    assert(type != 0);
+    for (bool refresh = false;; refresh = true) {
+        // Get map properties, either from the per-fd cache or from execution context.
+        result = _get_map_fd_properties(map_fd, refresh, &properties);
+        if (result != EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(result);
+        }
+        if ((key == nullptr) != (properties.key_size == 0)) {
+            EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+        }
+        assert(properties.value_size != 0);
+        assert(properties.type != 0);
 
-    if (BPF_MAP_TYPE_PER_CPU(type)) {
-        value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
-    }
+        value_size = properties.value_size;
+        if (BPF_MAP_TYPE_PER_CPU(properties.type)) {
+            value_size = EBPF_PAD_8(value_size) * libbpf_num_possible_cpus();
+        }
 
-    if ((type == BPF_MAP_TYPE_PROG_ARRAY) || (type == BPF_MAP_TYPE_HASH_OF_MAPS) ||
-        (type == BPF_MAP_TYPE_ARRAY_OF_MAPS)) {
-        fd_t fd = *(fd_t*)value;
-        ebpf_handle_t handle = ebpf_handle_invalid;
-        // If the fd is valid, resolve it to a handle, else pass ebpf_handle_invalid to the IOCTL.
-        if (fd != ebpf_fd_invalid) {
-            handle = _get_handle_from_file_descriptor(fd);
-            if (handle == ebpf_handle_invalid) {
-                EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+        if ((properties.type == BPF_MAP_TYPE_PROG_ARRAY) || (properties.type == BPF_MAP_TYPE_HASH_OF_MAPS) ||
+            (properties.type == BPF_MAP_TYPE_ARRAY_OF_MAPS)) {
+            fd_t fd = *(fd_t*)value;
+            ebpf_handle_t handle = ebpf_handle_invalid;
+            // If the fd is valid, resolve it to a handle, else pass ebpf_handle_invalid to the IOCTL.
+            if (fd != ebpf_fd_invalid) {
+                handle = _get_handle_from_file_descriptor(fd);
+                if (handle == ebpf_handle_invalid) {
+                    EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+                }
             }
-        }
 
-        assert(key_size != 0);
-        __analysis_assume(key_size != 0);
-        EBPF_RETURN_RESULT(_update_map_element_with_handle(map_handle, key_size, (const uint8_t*)key, handle, flags));
-    } else {
-        EBPF_RETURN_RESULT(_update_map_element(map_handle, key, key_size, value, value_size, flags));
+            assert(properties.key_size != 0);
+            __analysis_assume(properties.key_size != 0);
+            result = _update_map_element_with_handle(
+                properties.handle, properties.key_size, (const uint8_t*)key, handle, flags);
+        } else {
+            result = _update_map_element(properties.handle, key, properties.key_size, value, value_size, flags);
+        }
+        if (refresh || !_map_fd_properties_are_stale(map_fd, result, &properties)) {
+            break;
+        }
     }
+    EBPF_RETURN_RESULT(result);
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
@@ -986,12 +1447,8 @@ ebpf_map_delete_element(fd_t map_fd, _In_ const void* key) NO_EXCEPT_TRY
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result = EBPF_SUCCESS;
-    ebpf_handle_t map_handle;
-    uint32_t key_size = 0;
-    uint32_t value_size = 0;
-    uint32_t max_entries = 0;
-    uint32_t type;
-    ebpf_protocol_buffer_t request_buffer;
+    ebpf_map_fd_properties_t properties;
+    ebpf_protocol_buffer_t& request_buffer = _ebpf_element_request_buffer;
     ebpf_operation_map_delete_element_request_t* request;
 
     ebpf_assert(key);
@@ -1000,42 +1457,42 @@ ebpf_map_delete_element(fd_t map_fd, _In_ const void* key) NO_EXCEPT_TRY
         goto Exit;
     }
 
-    map_handle = _get_handle_from_file_descriptor(map_fd);
-    if (map_handle == ebpf_handle_invalid) {
-        result = EBPF_INVALID_FD;
-        goto Exit;
-    }
-
-    // Get map properties, either from local cache or from execution context.
-    result = _get_map_descriptor_properties(map_handle, &type, &key_size, &value_size, &max_entries);
-    if (result != EBPF_SUCCESS) {
-        goto Exit;
-    }
-    if (key_size == 0) {
-        result = EBPF_INVALID_ARGUMENT;
-        goto Exit;
-    }
-    assert(value_size != 0);
+    for (bool refresh = false;; refresh = true) {
+        // Get map properties, either from the per-fd cache or from execution context.
+        result = _get_map_fd_properties(map_fd, refresh, &properties);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        if (properties.key_size == 0) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Exit;
+        }
+        assert(properties.value_size != 0);
 
-    try {
-        request_buffer.resize(EBPF_OFFSET_OF(ebpf_operation_map_delete_element_request_t, key) + key_size);
-        request = reinterpret_cast<ebpf_operation_map_delete_element_request_t*>(request_buffer.data());
+        try {
+            request_buffer.resize(
+                EBPF_OFFSET_OF(ebpf_operation_map_delete_element_request_t, key) + properties.key_size);
+            request = reinterpret_cast<ebpf_operation_map_delete_element_request_t*>(request_buffer.data());
 
-        request->header.length = static_cast<uint16_t>(request_buffer.size());
-        request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_DELETE_ELEMENT;
-        request->handle = (uint64_t)map_handle;
-        std::copy((uint8_t*)key, (uint8_t*)key + key_size, request->key);
+            request->header.length = static_cast<uint16_t>(request_buffer.size());
+            request->header.id = ebpf_operation_id_t::EBPF_OPERATION_MAP_DELETE_ELEMENT;
+            request->handle = (uint64_t)properties.handle;
+            std::copy((uint8_t*)key, (uint8_t*)key + properties.key_size, request->key);
 
-        result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer));
-        if (result == EBPF_INVALID_OBJECT) {
-            result = EBPF_INVALID_FD;
+            result = win32_error_code_to_ebpf_result(invoke_ioctl(request_buffer));
+        } catch (const std::bad_alloc&) {
+            result = EBPF_NO_MEMORY;
+            goto Exit;
+        } catch (...) {
+            result = EBPF_FAILED;
+            goto Exit;
         }
-    } catch (const std::bad_alloc&) {
-        result = EBPF_NO_MEMORY;
-        goto Exit;
-    } catch (...) {
-        result = EBPF_FAILED;
-        goto Exit;
+        if (refresh || !_map_fd_properties_are_stale(map_fd, result, &properties)) {
+            break;
+        }
+    }
+    if (result == EBPF_INVALID_OBJECT) {
+        result = EBPF_INVALID_FD;
     }
 
 Exit:
@@ -1617,6 +2074,30 @@ ebpf_detach_link_by_fd(fd_t fd) NO_EXCEPT_TRY
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_update_link_program_by_fd(fd_t link_fd, fd_t program_fd, fd_t old_program_fd) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    ebpf_operation_update_link_program_request_t request = {0};
+    request.header.length = sizeof(request);
+    request.header.id = ebpf_operation_id_t::EBPF_OPERATION_UPDATE_LINK_PROGRAM;
+    request.link_handle = _get_handle_from_file_descriptor(link_fd);
+    request.program_handle = _get_handle_from_file_descriptor(program_fd);
+    request.old_program_handle = ebpf_handle_invalid;
+    if (request.link_handle == ebpf_handle_invalid || request.program_handle == ebpf_handle_invalid) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+    }
+    if (old_program_fd != ebpf_fd_invalid) {
+        request.old_program_handle = _get_handle_from_file_descriptor(old_program_fd);
+        if (request.old_program_handle == ebpf_handle_invalid) {
+            EBPF_RETURN_RESULT(EBPF_INVALID_FD);
+        }
+    }
+
+    EBPF_RETURN_RESULT(win32_error_code_to_ebpf_result(invoke_ioctl(request)));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_program_attach(
     _In_ const struct bpf_program* program,
@@ -1914,6 +2395,7 @@ _Requires_lock_not_held_(_ebpf_state_mutex) void clean_up_ebpf_map(_In_ _Post_in
     EBPF_LOG_ENTRY();
     ebpf_assert(map);
     if (map->map_fd > 0) {
+        _ebpf_map_fd_cache_invalidate(map->map_fd);
         Platform::_close(map->map_fd);
     }
     if (map->map_handle != ebpf_handle_invalid) {
@@ -3094,7 +3576,7 @@ _Requires_lock_not_held_(_ebpf_state_mutex) static ebpf_result_t
         }
 
         ebpf_handle_t inner_map_handle = (map->inner_map) ? map->inner_map->map_handle : ebpf_handle_invalid;
-        result = _create_map(map->name, &map->map_definition, inner_map_handle, &map->map_handle);
+        result = _create_map(map->name, &map->map_definition, inner_map_handle, 0, 0, &map->map_handle);
         if (result != EBPF_SUCCESS) {
             break;
         }
@@ -3371,6 +3853,7 @@ _Requires_lock_not_held_(_ebpf_state_mutex) _Must_inspect_result_ ebpf_result_t
 
     for (auto& map : object->maps) {
         if (map->map_fd > 0) {
+            _ebpf_map_fd_cache_invalidate(map->map_fd);
             Platform::_close(map->map_fd);
             map->map_fd = ebpf_fd_invalid;
         }
@@ -4052,6 +4535,85 @@ ebpf_get_next_program_id(ebpf_id_t start_id, _Out_ ebpf_id_t* next_id) NO_EXCEPT
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
+static ebpf_result_t
+_get_object_info_batch(
+    ebpf_operation_id_t operation,
+    ebpf_id_t start_id,
+    size_t record_size,
+    _Out_writes_bytes_(*count * record_size) void* infos,
+    _Inout_ uint32_t* count,
+    _Out_ ebpf_id_t* next_id) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    ebpf_assert(infos);
+    ebpf_assert(count);
+    ebpf_assert(next_id);
+
+    // Limit the request to what fits in a single reply.
+    size_t header_size = EBPF_OFFSET_OF(ebpf_operation_get_object_info_batch_reply_t, info);
+    size_t capacity = min(static_cast<size_t>(*count), (UINT16_MAX - header_size) / record_size);
+    if (capacity == 0) {
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    ebpf_protocol_buffer_t reply_buffer(header_size + capacity * record_size);
+    auto reply = reinterpret_cast<ebpf_operation_get_object_info_batch_reply_t*>(reply_buffer.data());
+    ebpf_operation_get_object_info_batch_request_t request{sizeof(request), operation, start_id};
+
+    uint32_t error = invoke_ioctl(request, reply_buffer);
+    ebpf_result_t result = win32_error_code_to_ebpf_result(error);
+    if (result != EBPF_SUCCESS) {
+        EBPF_RETURN_RESULT(result);
+    }
+    ebpf_assert(reply->header.id == operation);
+    ebpf_assert(reply->count_of_records <= capacity);
+
+    memcpy(infos, reply->info, reply->count_of_records * record_size);
+    *count = reply->count_of_records;
+    *next_id = reply->next_id;
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_link_info_batch(
+    ebpf_id_t start_id,
+    _Out_writes_to_(*count, *count) struct bpf_link_info* infos,
+    _Inout_ uint32_t* count,
+    _Out_ ebpf_id_t* next_id) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_object_info_batch(
+        ebpf_operation_id_t::EBPF_OPERATION_GET_LINK_INFO_BATCH, start_id, sizeof(*infos), infos, count, next_id));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_map_info_batch(
+    ebpf_id_t start_id,
+    _Out_writes_to_(*count, *count) struct bpf_map_info* infos,
+    _Inout_ uint32_t* count,
+    _Out_ ebpf_id_t* next_id) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_object_info_batch(
+        ebpf_operation_id_t::EBPF_OPERATION_GET_MAP_INFO_BATCH, start_id, sizeof(*infos), infos, count, next_id));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_program_info_batch(
+    ebpf_id_t start_id,
+    _Out_writes_to_(*count, *count) struct bpf_prog_info* infos,
+    _Inout_ uint32_t* count,
+    _Out_ ebpf_id_t* next_id) NO_EXCEPT_TRY
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_object_info_batch(
+        ebpf_operation_id_t::EBPF_OPERATION_GET_PROGRAM_INFO_BATCH, start_id, sizeof(*infos), infos, count, next_id));
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_object_get_info_by_fd(
     fd_t bpf_fd, _Inout_updates_bytes_to_(*info_size, *info_size) void* info, _Inout_ uint32_t* info_size) NO_EXCEPT_TRY
@@ -4564,10 +5126,136 @@ ebpf_program_test_run(fd_t program_fd, _Inout_ ebpf_test_run_options_t* options)
 }
 CATCH_NO_MEMORY_EBPF_RESULT
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_format_deferred_printk(
+    _In_z_ const char* format,
+    uint32_t argument_count,
+    _In_reads_(argument_count) const uint64_t* arguments,
+    _Out_writes_z_(output_size) char* output,
+    size_t output_size) NO_EXCEPT_TRY
+{
+    int specifier_count;
+    if (output_size == 0 || !ebpf_validate_printk_format(format, &specifier_count) ||
+        (uint32_t)specifier_count != argument_count) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    // The format has already been validated, so every '%' is either a "%%" escape
+    // or a d/i/u/x conversion with zero, one, or two 'l' modifiers.
+    std::string text;
+    uint32_t argument_index = 0;
+    for (const char* p = format; *p; p++) {
+        if (*p != '%') {
+            text.push_back(*p);
+            continue;
+        }
+        if (p[1] == '%') {
+            text.push_back('%');
+            p++;
+            continue;
+        }
+
+        size_t modifier_count = 0;
+        while (p[1 + modifier_count] == 'l') {
+            modifier_count++;
+        }
+        char conversion = p[1 + modifier_count];
+        p += 1 + modifier_count;
+
+        // Match the kernel, where int and long are both 32 bits and only %ll consumes all 64 bits.
+        uint64_t argument = arguments[argument_index++];
+        char value[32];
+        if (modifier_count == 2) {
+            if (conversion == 'x') {
+                sprintf_s(value, sizeof(value), "%llx", argument);
+            } else if (conversion == 'u') {
+                sprintf_s(value, sizeof(value), "%llu", argument);
+            } else {
+                sprintf_s(value, sizeof(value), "%lld", (int64_t)argument);
+            }
+        } else if (conversion == 'x') {
+            sprintf_s(value, sizeof(value), "%x", (uint32_t)argument);
+        } else if (conversion == 'u') {
+            sprintf_s(value, sizeof(value), "%u", (uint32_t)argument);
+        } else {
+            sprintf_s(value, sizeof(value), "%d", (int32_t)argument);
+        }
+        text.append(value);
+    }
+
+    if (text.size() + 1 > output_size) {
+        return EBPF_INSUFFICIENT_BUFFER;
+    }
+    memcpy(output, text.c_str(), text.size() + 1);
+    return EBPF_SUCCESS;
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_get_app_id(_In_z_ const wchar_t* file_name, _Out_ uint64_t* app_id) NO_EXCEPT_TRY
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    FWP_BYTE_BLOB* app_id_blob = nullptr;
+    HANDLE device_handle = INVALID_HANDLE_VALUE;
+    net_ebpf_ext_get_app_id_reply_t reply = {};
+    unsigned long bytes_returned = 0;
+    uint32_t error;
+    EBPF_LOG_ENTRY();
+    ebpf_assert(file_name);
+    ebpf_assert(app_id);
+    *app_id = 0;
+
+    // WFP reports the application as the NT path of its image, so convert the file name the same way WFP does.
+    error = FwpmGetAppIdFromFileName0(file_name, &app_id_blob);
+    if (error != ERROR_SUCCESS) {
+        result = win32_error_code_to_ebpf_result(error);
+        goto Exit;
+    }
+
+    // The application ID is keyed with a secret that only the network extension knows.
+    device_handle =
+        ::CreateFileW(NET_EBPF_EXT_DEVICE_WIN32_NAME, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, 0);
+    if (device_handle == INVALID_HANDLE_VALUE) {
+        result = win32_error_code_to_ebpf_result(GetLastError());
+        goto Exit;
+    }
+
+    if (!::DeviceIoControl(
+            device_handle,
+            IOCTL_NET_EBPF_EXT_CTL_GET_APP_ID,
+            app_id_blob->data,
+            app_id_blob->size,
+            &reply,
+            sizeof(reply),
+            &bytes_returned,
+            nullptr)) {
+        result = win32_error_code_to_ebpf_result(GetLastError());
+        goto Exit;
+    }
+    if (bytes_returned != sizeof(reply)) {
+        result = EBPF_FAILED;
+        goto Exit;
+    }
+
+    *app_id = reply.app_id;
+
+Exit:
+    if (device_handle != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(device_handle);
+    }
+    if (app_id_blob != nullptr) {
+        FwpmFreeMemory0((void**)&app_id_blob);
+    }
+    EBPF_RETURN_RESULT(result);
+}
+CATCH_NO_MEMORY_EBPF_RESULT
+
 void
 ebpf_api_thread_local_cleanup() noexcept
 {
     clean_up_sync_device_handle();
+    _ebpf_element_request_buffer = ebpf_protocol_buffer_t();
+    _ebpf_element_reply_buffer = ebpf_protocol_buffer_t();
 }
 
 void
@@ -83,6 +83,24 @@ bpf_link_detach(int link_fd)
     return libbpf_result_err(ebpf_detach_link_by_fd(link_fd));
 }
 
+int
+bpf_link_update(int link_fd, int new_prog_fd, const struct bpf_link_update_opts* opts)
+{
+    uint32_t flags = (opts) ? opts->flags : 0;
+    if ((flags & ~BPF_F_REPLACE) != 0) {
+        return libbpf_err(-EINVAL);
+    }
+
+    fd_t old_prog_fd = (flags & BPF_F_REPLACE) ? (fd_t)opts->old_prog_fd : ebpf_fd_invalid;
+    return libbpf_result_err(ebpf_update_link_program_by_fd(link_fd, new_prog_fd, old_prog_fd));
+}
+
+int
+bpf_link__update_program(struct bpf_link* link, struct bpf_program* prog)
+{
+    return bpf_link_update(bpf_link__fd(link), bpf_program__fd(prog), nullptr);
+}
+
 int
 bpf_link_get_fd_by_id(uint32_t id)
 {
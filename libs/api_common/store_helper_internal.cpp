@@ -28,6 +28,318 @@ _open_ebpf_store_key(_Out_ ebpf_store_key_t* store_key)
     EBPF_RETURN_RESULT(result);
 }
 
+/**
+ * @brief Program information snapshot read from the eBPF store.
+ */
+typedef struct _ebpf_store_snapshot
+{
+    uint8_t* buffer = nullptr;
+    size_t length = 0;
+    std::vector<const ebpf_store_snapshot_record_t*> records;
+
+    ~_ebpf_store_snapshot() { ebpf_free(buffer); }
+} ebpf_store_snapshot_t;
+
+/**
+ * @brief Read the program information snapshot from the eBPF store with a single registry query and validate its
+ * header, hash and record bounds.
+ *
+ * @param[out] snapshot Snapshot to populate.
+ *
+ * @retval EBPF_SUCCESS The snapshot is present and valid.
+ * @retval EBPF_FILE_NOT_FOUND No snapshot is present.
+ * @retval EBPF_INVALID_OBJECT The snapshot is corrupt or has an unsupported version.
+ */
+static ebpf_result_t
+_ebpf_store_read_snapshot(_Inout_ ebpf_store_snapshot_t& snapshot) noexcept
+{
+    ebpf_store_key_t store_key = nullptr;
+    const ebpf_store_snapshot_header_t* header;
+    size_t offset;
+
+    EBPF_LOG_ENTRY();
+
+    ebpf_result_t result = _open_ebpf_store_key(&store_key);
+    if (result != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    result = ebpf_read_registry_value_binary_allocated(
+        store_key, EBPF_STORE_SNAPSHOT, &snapshot.buffer, &snapshot.length);
+    if (result != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    result = EBPF_INVALID_OBJECT;
+    if (snapshot.length < sizeof(ebpf_store_snapshot_header_t)) {
+        goto Exit;
+    }
+
+    header = reinterpret_cast<const ebpf_store_snapshot_header_t*>(snapshot.buffer);
+    if (header->magic != EBPF_STORE_SNAPSHOT_MAGIC || header->version != EBPF_STORE_SNAPSHOT_CURRENT_VERSION ||
+        header->length != snapshot.length || header->reserved != 0) {
+        goto Exit;
+    }
+
+    if (header->hash != ebpf_store_snapshot_hash(
+                            snapshot.buffer + sizeof(ebpf_store_snapshot_header_t),
+                            snapshot.length - sizeof(ebpf_store_snapshot_header_t))) {
+        goto Exit;
+    }
+
+    try {
+        offset = sizeof(ebpf_store_snapshot_header_t);
+        for (uint32_t index = 0; index < header->record_count; index++) {
+            if (snapshot.length - offset < EBPF_OFFSET_OF(ebpf_store_snapshot_record_t, data)) {
+                goto Exit;
+            }
+            auto record = reinterpret_cast<const ebpf_store_snapshot_record_t*>(snapshot.buffer + offset);
+            offset += EBPF_OFFSET_OF(ebpf_store_snapshot_record_t, data);
+            if (snapshot.length - offset < record->length) {
+                goto Exit;
+            }
+            // Records start on 8-byte boundaries. The padding after the last record may be omitted.
+            offset = EBPF_PAD_8(offset + record->length);
+            if (offset > snapshot.length) {
+                offset = snapshot.length;
+            }
+            snapshot.records.push_back(record);
+        }
+    } catch (const std::bad_alloc&) {
+        result = EBPF_NO_MEMORY;
+        goto Exit;
+    }
+
+    result = EBPF_SUCCESS;
+
+Exit:
+    if (store_key) {
+        ebpf_close_registry_key(store_key);
+    }
+    if (result == EBPF_INVALID_OBJECT) {
+        EBPF_LOG_MESSAGE(
+            EBPF_TRACELOG_LEVEL_WARNING,
+            EBPF_TRACELOG_KEYWORD_BASE,
+            "Program information snapshot failed validation. Falling back to the per-key layout.");
+    }
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_ebpf_store_load_program_data_from_snapshot(
+    _In_ const ebpf_store_snapshot_t& snapshot,
+    _Outptr_result_buffer_maybenull_(*program_info_count) ebpf_program_info_t*** program_info,
+    _Out_ uint32_t* program_info_count) noexcept
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    std::vector<ebpf_program_info_t*> program_info_array;
+
+    *program_info = nullptr;
+    *program_info_count = 0;
+
+    try {
+        for (auto record : snapshot.records) {
+            if (record->type != EBPF_STORE_SNAPSHOT_RECORD_PROGRAM_INFORMATION) {
+                continue;
+            }
+
+            ebpf_program_info_t* local_program_info = nullptr;
+            result = ebpf_deserialize_program_info(record->length, record->data, &local_program_info);
+            if (result != EBPF_SUCCESS) {
+                goto Exit;
+            }
+            program_info_array.push_back(local_program_info);
+
+            if (!ebpf_validate_program_info(local_program_info)) {
+                result = EBPF_INVALID_OBJECT;
+                goto Exit;
+            }
+        }
+
+        if (program_info_array.size() > 0) {
+            auto size = program_info_array.size() * sizeof(ebpf_program_info_t*);
+            *program_info = (ebpf_program_info_t**)ebpf_allocate(size);
+            if (*program_info == nullptr) {
+                result = EBPF_NO_MEMORY;
+                goto Exit;
+            }
+
+            memcpy(*program_info, program_info_array.data(), size);
+            *program_info_count = (uint32_t)program_info_array.size();
+        }
+    } catch (const std::bad_alloc&) {
+        result = EBPF_NO_MEMORY;
+        goto Exit;
+    }
+
+Exit:
+    if (result != EBPF_SUCCESS) {
+        for (auto local_program_info : program_info_array) {
+            ebpf_program_info_free(local_program_info);
+        }
+    }
+    return result;
+}
+
+static ebpf_result_t
+_ebpf_store_load_section_information_from_snapshot(
+    _In_ const ebpf_store_snapshot_t& snapshot,
+    _Outptr_result_buffer_maybenull_(*section_info_count) ebpf_section_definition_t*** section_info,
+    _Out_ uint32_t* section_info_count) noexcept
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    std::vector<ebpf_section_definition_t*> section_info_array;
+
+    *section_info = nullptr;
+    *section_info_count = 0;
+
+    try {
+        for (auto record : snapshot.records) {
+            if (record->type != EBPF_STORE_SNAPSHOT_RECORD_SECTION_INFORMATION) {
+                continue;
+            }
+
+            auto section_record = reinterpret_cast<const ebpf_store_snapshot_section_record_t*>(record->data);
+            if (record->length < EBPF_OFFSET_OF(ebpf_store_snapshot_section_record_t, section_name) ||
+                (record->length - EBPF_OFFSET_OF(ebpf_store_snapshot_section_record_t, section_name)) /
+                        sizeof(wchar_t) <
+                    section_record->section_name_length) {
+                result = EBPF_INVALID_OBJECT;
+                goto Exit;
+            }
+
+            auto section_information = (ebpf_section_definition_t*)ebpf_allocate(sizeof(ebpf_section_definition_t));
+            if (section_information == nullptr) {
+                result = EBPF_NO_MEMORY;
+                goto Exit;
+            }
+            section_info_array.push_back(section_information);
+
+            auto program_type = (ebpf_program_type_t*)ebpf_allocate(sizeof(ebpf_program_type_t));
+            auto attach_type = (ebpf_attach_type_t*)ebpf_allocate(sizeof(ebpf_attach_type_t));
+            section_information->program_type = program_type;
+            section_information->attach_type = attach_type;
+            if (program_type == nullptr || attach_type == nullptr) {
+                result = EBPF_NO_MEMORY;
+                goto Exit;
+            }
+            *program_type = section_record->program_type;
+            *attach_type = section_record->attach_type;
+            section_information->bpf_prog_type = (bpf_prog_type_t)section_record->bpf_program_type;
+            section_information->bpf_attach_type = (bpf_attach_type_t)section_record->bpf_attach_type;
+            section_information->section_prefix = cxplat_duplicate_string(
+                ebpf_down_cast_from_wstring(
+                    std::wstring(section_record->section_name, section_record->section_name_length))
+                    .c_str());
+            if (section_information->section_prefix == nullptr) {
+                result = EBPF_NO_MEMORY;
+                goto Exit;
+            }
+        }
+
+        if (section_info_array.size() > 0) {
+            auto size = section_info_array.size() * sizeof(ebpf_section_definition_t*);
+            *section_info = (ebpf_section_definition_t**)ebpf_allocate(size);
+            if (*section_info == nullptr) {
+                result = EBPF_NO_MEMORY;
+                goto Exit;
+            }
+
+            memcpy(*section_info, section_info_array.data(), size);
+            *section_info_count = (uint32_t)section_info_array.size();
+        }
+    } catch (...) {
+        result = EBPF_NO_MEMORY;
+        goto Exit;
+    }
+
+Exit:
+    if (result != EBPF_SUCCESS) {
+        for (auto section_data : section_info_array) {
+            ebpf_free(section_data->program_type);
+            ebpf_free(section_data->attach_type);
+            ebpf_free(const_cast<char*>(section_data->section_prefix));
+            ebpf_free(section_data);
+        }
+    }
+    return result;
+}
+
+static ebpf_result_t
+_ebpf_store_load_global_helper_information_from_snapshot(
+    _In_ const ebpf_store_snapshot_t& snapshot,
+    _Outptr_result_buffer_maybenull_(*global_helper_info_count) ebpf_helper_function_prototype_t** global_helper_info,
+    _Out_ uint32_t* global_helper_info_count) noexcept
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    uint32_t helper_count = 0;
+    uint32_t index = 0;
+    ebpf_helper_function_prototype_t* helper_prototype = nullptr;
+
+    *global_helper_info = nullptr;
+    *global_helper_info_count = 0;
+
+    for (auto record : snapshot.records) {
+        if (record->type == EBPF_STORE_SNAPSHOT_RECORD_GLOBAL_HELPER) {
+            helper_count++;
+        }
+    }
+
+    if (helper_count == 0) {
+        goto Exit;
+    }
+
+    helper_prototype =
+        (ebpf_helper_function_prototype_t*)ebpf_allocate(helper_count * sizeof(ebpf_helper_function_prototype_t));
+    if (helper_prototype == nullptr) {
+        result = EBPF_NO_MEMORY;
+        goto Exit;
+    }
+
+    for (auto record : snapshot.records) {
+        if (record->type != EBPF_STORE_SNAPSHOT_RECORD_GLOBAL_HELPER) {
+            continue;
+        }
+
+        auto helper_record = reinterpret_cast<const ebpf_store_snapshot_helper_record_t*>(record->data);
+        if (record->length < EBPF_OFFSET_OF(ebpf_store_snapshot_helper_record_t, name) ||
+            record->length - EBPF_OFFSET_OF(ebpf_store_snapshot_helper_record_t, name) < helper_record->name_length) {
+            result = EBPF_INVALID_OBJECT;
+            goto Exit;
+        }
+
+        ebpf_helper_function_prototype_t* prototype = &helper_prototype[index];
+        prototype->header.version = static_cast<uint16_t>(helper_record->header_version);
+        prototype->header.size = helper_record->header_size;
+        prototype->helper_id = helper_record->helper_id;
+        prototype->return_type = helper_record->return_type;
+        memcpy(prototype->arguments, helper_record->arguments, sizeof(prototype->arguments));
+        prototype->flags.reallocate_packet = !!helper_record->reallocate_packet;
+
+        // ebpf_allocate zero-fills, so the copy is null terminated.
+        char* name = (char*)ebpf_allocate(static_cast<size_t>(helper_record->name_length) + 1);
+        if (name == nullptr) {
+            result = EBPF_NO_MEMORY;
+            goto Exit;
+        }
+        memcpy(name, helper_record->name, helper_record->name_length);
+        prototype->name = name;
+        index++;
+    }
+
+    *global_helper_info = helper_prototype;
+    *global_helper_info_count = helper_count;
+
+Exit:
+    if (result != EBPF_SUCCESS && helper_prototype) {
+        for (uint32_t i = 0; i < index; i++) {
+            ebpf_free((void*)helper_prototype[i].name);
+        }
+        ebpf_free(helper_prototype);
+    }
+    return result;
+}
+
 static ebpf_result_t
 _load_extension_header(HKEY data_key, _Out_ ebpf_extension_header_t* extension_header)
 {
@@ -422,6 +734,15 @@ ebpf_store_load_program_data(
     *program_info = nullptr;
     *program_info_count = 0;
 
+    {
+        // Prefer the snapshot, which is read with a single registry query.
+        ebpf_store_snapshot_t snapshot;
+        if (_ebpf_store_read_snapshot(snapshot) == EBPF_SUCCESS &&
+            _ebpf_store_load_program_data_from_snapshot(snapshot, program_info, program_info_count) == EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(EBPF_SUCCESS);
+        }
+    }
+
     result = _open_ebpf_store_key(&store_key);
     if (result != EBPF_SUCCESS) {
         if (result == EBPF_FILE_NOT_FOUND) {
@@ -635,6 +956,16 @@ ebpf_store_load_section_information(
     *section_info = nullptr;
     *section_info_count = 0;
 
+    {
+        // Prefer the snapshot, which is read with a single registry query.
+        ebpf_store_snapshot_t snapshot;
+        if (_ebpf_store_read_snapshot(snapshot) == EBPF_SUCCESS &&
+            _ebpf_store_load_section_information_from_snapshot(snapshot, section_info, section_info_count) ==
+                EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(EBPF_SUCCESS);
+        }
+    }
+
     result = _open_ebpf_store_key(&store_key);
     if (result != EBPF_SUCCESS) {
         if (result == EBPF_FILE_NOT_FOUND) {
@@ -735,6 +1066,16 @@ ebpf_store_load_global_helper_information(
     *global_helper_info = nullptr;
     *global_helper_info_count = 0;
 
+    {
+        // Prefer the snapshot, which is read with a single registry query.
+        ebpf_store_snapshot_t snapshot;
+        if (_ebpf_store_read_snapshot(snapshot) == EBPF_SUCCESS &&
+            _ebpf_store_load_global_helper_information_from_snapshot(
+                snapshot, global_helper_info, global_helper_info_count) == EBPF_SUCCESS) {
+            EBPF_RETURN_RESULT(EBPF_SUCCESS);
+        }
+    }
+
     result = _open_ebpf_store_key(&store_key);
     if (result != EBPF_SUCCESS) {
         if (result == EBPF_FILE_NOT_FOUND) {
@@ -902,6 +1243,12 @@ ebpf_store_delete_global_helper_information(_In_ ebpf_helper_function_prototype_
         goto Exit;
     }
 
+    // The snapshot no longer matches the per-key layout.
+    result = ebpf_store_delete_snapshot();
+    if (result != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
     // Open root registry key.
     result = ebpf_open_registry_key(ebpf_store_root_key, EBPF_ROOT_RELATIVE_PATH, REG_CREATE_FLAGS, &root_key);
     if (result != EBPF_SUCCESS) {
@@ -9,6 +9,7 @@
 #include "links.h"
 #include "platform.h"
 #include "tokens.h"
+#include "utilities.h"
 
 #include <windows.h>
 #include <iomanip>
@@ -42,26 +43,20 @@ handle_ebpf_show_links(
     std::cout << "     ID       ID  Type\n";
     std::cout << "=======  =======  =============\n";
 
-    uint32_t link_id = 0;
+    std::vector<struct bpf_link_info> infos(NETSH_OBJECT_INFO_BATCH_SIZE);
+    ebpf_id_t start_id = 0;
     for (;;) {
-        if (bpf_link_get_next_id(link_id, &link_id) < 0) {
+        uint32_t count = (uint32_t)infos.size();
+        if (ebpf_get_link_info_batch(start_id, infos.data(), &count, &start_id) != EBPF_SUCCESS) {
             break;
         }
 
-        fd_t link_fd = bpf_link_get_fd_by_id(link_id);
-        if (link_fd < 0) {
-            break;
-        }
-
-        struct bpf_link_info info;
-        uint32_t info_size = (uint32_t)sizeof(info);
-        if (bpf_obj_get_info_by_fd(link_fd, &info, &info_size) == 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            const struct bpf_link_info& info = infos[i];
             const char* attach_type_name = ebpf_get_attach_type_name(&info.attach_type_uuid);
 
             printf("%7u%9u  %s\n", info.id, info.prog_id, attach_type_name);
         }
-
-        Platform::_close(link_fd);
     }
     return EBPF_SUCCESS;
 }
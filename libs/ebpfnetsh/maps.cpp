@@ -8,6 +8,7 @@
 #include "maps.h"
 #include "platform.h"
 #include "tokens.h"
+#include "utilities.h"
 
 #include <iomanip>
 #include <iostream>
@@ -26,46 +27,94 @@ handle_ebpf_show_maps(
     IN LPCVOID data,
     OUT BOOL* done)
 {
-    UNREFERENCED_PARAMETER(argv);
-    UNREFERENCED_PARAMETER(current_index);
-    UNREFERENCED_PARAMETER(argc);
     UNREFERENCED_PARAMETER(machine);
     UNREFERENCED_PARAMETER(flags);
     UNREFERENCED_PARAMETER(data);
     UNREFERENCED_PARAMETER(done);
 
-    std::cout << "\n";
-    std::cout << "                              Key  Value      Max  Inner\n";
-    std::cout << "     ID            Map Type  Size   Size  Entries     ID  Pins  Name\n";
-    std::cout << "=======  ==================  ====  =====  =======  =====  ====  ========\n";
+    TAG_TYPE tags[] = {
+        {TOKEN_LEVEL, NS_REQ_ZERO, FALSE},
+    };
+    const int LEVEL_INDEX = 0;
 
-    uint32_t map_id = 0;
-    for (;;) {
-        if (bpf_map_get_next_id(map_id, &map_id) < 0) {
+    unsigned long tag_type[_countof(tags)] = {0};
+
+    unsigned long status =
+        PreprocessCommand(nullptr, argv, current_index, argc, tags, _countof(tags), 0, _countof(tags), tag_type);
+
+    VERBOSITY_LEVEL level = VL_NORMAL;
+    for (int i = 0; (status == NO_ERROR) && ((i + current_index) < argc); i++) {
+        switch (tag_type[i]) {
+        case LEVEL_INDEX:
+            status =
+                MatchEnumTag(NULL, argv[current_index + i], _countof(g_LevelEnum), g_LevelEnum, (unsigned long*)&level);
+            if (status != NO_ERROR) {
+                status = ERROR_INVALID_PARAMETER;
+            }
+            break;
+        default:
+            status = ERROR_INVALID_SYNTAX;
             break;
         }
+    }
+    if (status != NO_ERROR) {
+        return status;
+    }
 
-        fd_t map_fd = bpf_map_get_fd_by_id(map_id);
-        if (map_fd < 0) {
+    if (level == VL_NORMAL) {
+        std::cout << "\n";
+        std::cout << "                              Key  Value      Max  Inner\n";
+        std::cout << "     ID            Map Type  Size   Size  Entries     ID  Pins  Name\n";
+        std::cout << "=======  ==================  ====  =====  =======  =====  ====  ========\n";
+    }
+
+    std::vector<struct bpf_map_info> infos(NETSH_OBJECT_INFO_BATCH_SIZE);
+    ebpf_id_t start_id = 0;
+    for (;;) {
+        uint32_t count = (uint32_t)infos.size();
+        if (ebpf_get_map_info_batch(start_id, infos.data(), &count, &start_id) != EBPF_SUCCESS) {
             break;
         }
 
-        struct bpf_map_info info;
-        uint32_t info_size = (uint32_t)sizeof(info);
-        if (bpf_obj_get_info_by_fd(map_fd, &info, &info_size) == 0) {
-            printf(
-                "%7u  %18s%6u%7u%9u%7d%6u  %s\n",
-                info.id,
-                libbpf_bpf_map_type_str(info.type),
-                info.key_size,
-                info.value_size,
-                info.max_entries,
-                info.inner_map_id,
-                info.pinned_path_count,
-                info.name);
-        }
+        for (uint32_t i = 0; i < count; i++) {
+            const struct bpf_map_info& info = infos[i];
+            if (level == VL_NORMAL) {
+                printf(
+                    "%7u  %18s%6u%7u%9u%7d%6u  %s\n",
+                    info.id,
+                    libbpf_bpf_map_type_str(info.type),
+                    info.key_size,
+                    info.value_size,
+                    info.max_entries,
+                    info.inner_map_id,
+                    info.pinned_path_count,
+                    info.name);
+                continue;
+            }
 
-        Platform::_close(map_fd);
+            std::cout << "\n";
+            std::cout << "ID                  : " << info.id << "\n";
+            std::cout << "Name                : " << info.name << "\n";
+            std::cout << "Map type            : " << libbpf_bpf_map_type_str(info.type) << "\n";
+            std::cout << "Key size            : " << info.key_size << "\n";
+            std::cout << "Value size          : " << info.value_size << "\n";
+            std::cout << "Max entries         : " << info.max_entries << "\n";
+            std::cout << "Inner map ID        : " << (int32_t)info.inner_map_id << "\n";
+            std::cout << "# pinned paths      : " << info.pinned_path_count << "\n";
+            if (!(info.map_flags & BPF_F_STATISTICS)) {
+                std::cout << "Statistics          : disabled\n";
+                continue;
+            }
+            std::cout << "Entries             : " << info.entry_count << "\n";
+            std::cout << "Longest bucket      : " << info.longest_bucket_length << "\n";
+            std::cout << "Lookups             : " << info.lookup_count << "\n";
+            std::cout << "Lookup hits         : " << info.lookup_count - info.lookup_miss_count << "\n";
+            std::cout << "Lookup misses       : " << info.lookup_miss_count << "\n";
+            std::cout << "Updates             : " << info.update_count << "\n";
+            std::cout << "Deletes             : " << info.delete_count << "\n";
+            std::cout << "Evictions           : " << info.eviction_count << "\n";
+            std::cout << "Allocation failures : " << info.allocation_failure_count << "\n";
+        }
     }
     return NO_ERROR;
 }
@@ -6,6 +6,9 @@
 
 #include <iostream>
 
+// Number of object info records requested at a time when enumerating maps, programs or links.
+#define NETSH_OBJECT_INFO_BATCH_SIZE 64
+
 std::string
 down_cast_from_wstring(const std::wstring& wide_string);
 
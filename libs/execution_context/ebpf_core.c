@@ -4,10 +4,12 @@
 #define EBPF_FILE_ID EBPF_FILE_ID_CORE
 
 #include "ebpf_async.h"
+#include "ebpf_clock.h"
 #include "ebpf_core.h"
 #include "ebpf_epoch.h"
 #include "ebpf_extension_uuids.h"
 #include "ebpf_handle.h"
+#include "ebpf_hash_table.h"
 #include "ebpf_link.h"
 #include "ebpf_maps.h"
 #include "ebpf_native.h"
@@ -37,6 +39,11 @@ static ebpf_pinning_table_t* _ebpf_core_map_pinning_table = NULL;
 // Assume enabled until we can query it.
 static ebpf_code_integrity_state_t _ebpf_core_code_integrity_state = EBPF_CODE_INTEGRITY_HYPERVISOR_KERNEL_MODE;
 
+static _Must_inspect_result_ ebpf_result_t
+_ebpf_core_printk_formats_initiate();
+static void
+_ebpf_core_printk_formats_terminate();
+
 static void*
 _ebpf_core_map_find_element(ebpf_map_t* map, const uint8_t* key);
 static int64_t
@@ -57,9 +64,6 @@ static long
 _ebpf_core_trace_printk3(_In_reads_(fmt_size) const char* fmt, size_t fmt_size, uint64_t arg3);
 static long
 _ebpf_core_trace_printk4(_In_reads_(fmt_size) const char* fmt, size_t fmt_size, uint64_t arg3, uint64_t arg4);
-static long
-_ebpf_core_trace_printk5(
-    _In_reads_(fmt_size) const char* fmt, size_t fmt_size, uint64_t arg3, uint64_t arg4, uint64_t arg5);
 static int
 _ebpf_core_ring_buffer_output(
     _Inout_ ebpf_map_t* map, _In_reads_bytes_(length) uint8_t* data, size_t length, uint64_t flags);
@@ -99,6 +103,12 @@ _ebpf_core_memmove(
     _In_reads_(source_length) const void* source,
     size_t source_length);
 
+static void*
+_ebpf_core_sk_storage_get(_In_ const ebpf_map_t* map, _In_ void* ctx, _In_opt_ const uint8_t* value, uint64_t flags);
+
+static int64_t
+_ebpf_core_sk_storage_delete(_In_ const ebpf_map_t* map, _In_ void* ctx);
+
 #define EBPF_CORE_GLOBAL_HELPER_EXTENSION_VERSION 0
 
 static ebpf_program_type_descriptor_t _ebpf_global_helper_program_descriptor = {
@@ -126,7 +136,7 @@ static const void* _ebpf_general_helpers[] = {
     (void*)&_ebpf_core_trace_printk2,
     (void*)&_ebpf_core_trace_printk3,
     (void*)&_ebpf_core_trace_printk4,
-    (void*)&_ebpf_core_trace_printk5,
+    (void*)&ebpf_core_trace_printk5,
     (void*)&_ebpf_core_map_push_elem,
     (void*)&_ebpf_core_map_pop_elem,
     (void*)&_ebpf_core_map_peek_elem,
@@ -139,6 +149,14 @@ static const void* _ebpf_general_helpers[] = {
     (void*)&_ebpf_core_memmove,
     // No default implementation of bpf_get_socket_cookie
     (void*)NULL, // bpf_get_socket_cookie
+    // No default implementation of bpf_get_current_app_id
+    (void*)NULL, // bpf_get_current_app_id
+    // Only available to program types that support a context header.
+    (void*)&_ebpf_core_sk_storage_get,
+    (void*)&_ebpf_core_sk_storage_delete,
+    // Clock helpers.
+    (void*)&ebpf_clock_get_coarse_ns,
+    (void*)&ebpf_clock_get_fast_ns,
 };
 
 static const ebpf_helper_function_addresses_t _ebpf_global_helper_function_dispatch_table = {
@@ -214,6 +232,11 @@ ebpf_core_initiate()
         goto Done;
     }
 
+    return_value = ebpf_clock_initiate();
+    if (return_value != EBPF_SUCCESS) {
+        goto Done;
+    }
+
     return_value = ebpf_trace_initiate();
     if (return_value != EBPF_SUCCESS) {
         goto Done;
@@ -256,6 +279,11 @@ ebpf_core_initiate()
         goto Done;
     }
 
+    return_value = _ebpf_core_printk_formats_initiate();
+    if (return_value != EBPF_SUCCESS) {
+        goto Done;
+    }
+
     _ebpf_global_helper_program_info.count_of_program_type_specific_helpers = ebpf_core_helper_functions_count;
     _ebpf_global_helper_program_info.program_type_specific_helper_prototype = ebpf_core_helper_function_prototype;
 
@@ -298,6 +326,8 @@ ebpf_core_terminate()
 
     ebpf_state_terminate();
 
+    _ebpf_core_printk_formats_terminate();
+
     // Verify that all ebpf_core_object_t objects have been freed.
     ebpf_object_tracking_terminate();
 
@@ -314,6 +344,8 @@ ebpf_core_terminate()
 
     ebpf_trace_terminate();
 
+    ebpf_clock_terminate();
+
     ebpf_random_terminate();
 
     ebpf_platform_terminate();
@@ -556,18 +588,153 @@ Done:
 }
 #endif
 
+#if !defined(CONFIG_BPF_JIT_DISABLED)
+static ebpf_result_t
+_ebpf_core_protocol_resolve_program(
+    _In_ const ebpf_operation_resolve_program_request_t* request,
+    _Inout_ ebpf_operation_resolve_program_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_handle_t program_handle = request->program_handle;
+    uint32_t map_count = request->map_count;
+    uint32_t map_reference_count = request->map_reference_count;
+    uint8_t* request_data = NULL;
+    const ebpf_handle_t* map_handles = NULL;
+    const uint32_t* map_reference_indices = NULL;
+    const uint32_t* helper_ids = NULL;
+    ebpf_handle_t* referenced_map_handles = NULL;
+    bool helpers_resolved = false;
+    size_t data_length;
+    size_t map_data_length = (size_t)map_count * sizeof(ebpf_handle_t) + (size_t)map_reference_count * sizeof(uint32_t);
+    size_t count_of_helpers;
+    size_t required_reply_length;
+
+    ebpf_result_t return_value = ebpf_safe_size_t_subtract(
+        request->header.length, EBPF_OFFSET_OF(ebpf_operation_resolve_program_request_t, data), &data_length);
+    if (return_value != EBPF_SUCCESS) {
+        goto Done;
+    }
+    if (data_length < map_data_length || (data_length - map_data_length) % sizeof(uint32_t) != 0) {
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+    count_of_helpers = (data_length - map_data_length) / sizeof(uint32_t);
+
+    required_reply_length = EBPF_OFFSET_OF(ebpf_operation_resolve_program_reply_t, data) +
+                            (map_reference_count + count_of_helpers) * sizeof(uintptr_t) +
+                            (size_t)map_count * sizeof(ebpf_operation_resolve_program_map_definition_t);
+    if (reply_length < required_reply_length) {
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    // The request and reply share the same buffer, so copy the request before any part of the reply is written.
+    if (data_length != 0) {
+        request_data = (uint8_t*)ebpf_allocate_with_tag(data_length, EBPF_POOL_TAG_CORE);
+        if (request_data == NULL) {
+            return_value = EBPF_NO_MEMORY;
+            goto Done;
+        }
+        memcpy(request_data, request->data, data_length);
+        map_handles = (const ebpf_handle_t*)request_data;
+        map_reference_indices = (const uint32_t*)(request_data + (size_t)map_count * sizeof(ebpf_handle_t));
+        helper_ids = (const uint32_t*)(request_data + map_data_length);
+    }
+
+    if (map_reference_count != 0) {
+        referenced_map_handles = (ebpf_handle_t*)ebpf_allocate_with_tag(
+            (size_t)map_reference_count * sizeof(ebpf_handle_t), EBPF_POOL_TAG_CORE);
+        if (referenced_map_handles == NULL) {
+            return_value = EBPF_NO_MEMORY;
+            goto Done;
+        }
+        for (uint32_t reference_index = 0; reference_index < map_reference_count; reference_index++) {
+            if (map_reference_indices[reference_index] >= map_count) {
+                return_value = EBPF_INVALID_ARGUMENT;
+                goto Done;
+            }
+            referenced_map_handles[reference_index] = map_handles[map_reference_indices[reference_index]];
+        }
+    }
+
+    uintptr_t* map_addresses = (uintptr_t*)reply->data;
+    uintptr_t* helper_addresses = map_addresses + map_reference_count;
+    ebpf_operation_resolve_program_map_definition_t* map_definitions =
+        (ebpf_operation_resolve_program_map_definition_t*)(helper_addresses + count_of_helpers);
+
+    // Query the map definitions first, as that does not modify the program.
+    for (uint32_t map_index = 0; map_index < map_count; map_index++) {
+        ebpf_map_t* map;
+        struct bpf_map_info info;
+        uint16_t info_size = sizeof(info);
+
+        return_value =
+            EBPF_OBJECT_REFERENCE_BY_HANDLE(map_handles[map_index], EBPF_OBJECT_MAP, (ebpf_core_object_t**)&map);
+        if (return_value != EBPF_SUCCESS) {
+            goto Done;
+        }
+        return_value = ebpf_map_get_info(map, (uint8_t*)&info, &info_size);
+        EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)map);
+        if (return_value != EBPF_SUCCESS) {
+            goto Done;
+        }
+
+        map_definitions[map_index].id = info.id;
+        map_definitions[map_index].type = info.type;
+        map_definitions[map_index].key_size = info.key_size;
+        map_definitions[map_index].value_size = info.value_size;
+        map_definitions[map_index].max_entries = info.max_entries;
+        map_definitions[map_index].inner_map_id = info.inner_map_id;
+    }
+
+    return_value = ebpf_core_resolve_helper(program_handle, count_of_helpers, helper_ids, helper_addresses);
+    if (return_value != EBPF_SUCCESS) {
+        goto Done;
+    }
+    helpers_resolved = true;
+
+    if (map_reference_count != 0) {
+        return_value =
+            ebpf_core_resolve_maps(program_handle, map_reference_count, referenced_map_handles, map_addresses);
+        if (return_value != EBPF_SUCCESS) {
+            goto Done;
+        }
+    }
+
+    reply->log_function_address = (uint64_t)ebpf_log_function;
+    reply->header.length = (uint16_t)required_reply_length;
+
+Done:
+    // Leave the program as it was if any part of the resolution failed.
+    if (return_value != EBPF_SUCCESS && helpers_resolved) {
+        ebpf_program_t* program = NULL;
+        if (EBPF_OBJECT_REFERENCE_BY_HANDLE(program_handle, EBPF_OBJECT_PROGRAM, (ebpf_core_object_t**)&program) ==
+            EBPF_SUCCESS) {
+            ebpf_program_clear_helper_function_ids(program);
+            EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)program);
+        }
+    }
+    ebpf_free(referenced_map_handles);
+    ebpf_free(request_data);
+    EBPF_RETURN_RESULT(return_value);
+}
+#endif
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_core_create_map(
     _In_ const cxplat_utf8_string_t* map_name,
     _In_ const ebpf_map_definition_in_memory_t* ebpf_map_definition,
     ebpf_handle_t inner_map_handle,
+    uint32_t map_flags,
+    uint32_t numa_node,
     _Out_ ebpf_handle_t* map_handle)
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t retval;
     ebpf_map_t* map = NULL;
 
-    retval = ebpf_map_create(map_name, ebpf_map_definition, inner_map_handle, &map);
+    retval = ebpf_map_create_with_flags(map_name, ebpf_map_definition, inner_map_handle, map_flags, numa_node, &map);
     if (retval != EBPF_SUCCESS) {
         return retval;
     }
@@ -600,7 +767,13 @@ _ebpf_core_protocol_create_map(
         map_name.length = ((uint8_t*)request) + request->header.length - ((uint8_t*)request->data);
     }
 
-    retval = ebpf_core_create_map(&map_name, &request->ebpf_map_definition, request->inner_map_handle, &reply->handle);
+    retval = ebpf_core_create_map(
+        &map_name,
+        &request->ebpf_map_definition,
+        request->inner_map_handle,
+        request->map_flags,
+        request->numa_node,
+        &reply->handle);
 
     EBPF_RETURN_RESULT(retval);
 }
@@ -1146,6 +1319,149 @@ Done:
     EBPF_RETURN_RESULT(retval);
 }
 
+static ebpf_result_t
+_ebpf_core_protocol_map_find_element_batch(
+    _In_ const ebpf_operation_map_find_element_batch_request_t* request,
+    _Inout_ ebpf_operation_map_find_element_batch_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t retval;
+    ebpf_map_t* map = NULL;
+    size_t key_length;
+    size_t reply_data_length;
+    size_t key_count;
+    uint8_t* keys = NULL;
+    bool find_and_delete = request->find_and_delete;
+
+    retval = EBPF_OBJECT_REFERENCE_BY_HANDLE(request->handle, EBPF_OBJECT_MAP, (ebpf_core_object_t**)&map);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    const ebpf_map_definition_in_memory_t* map_definition = ebpf_map_get_definition(map);
+
+    retval = ebpf_safe_size_t_subtract(
+        request->header.length, EBPF_OFFSET_OF(ebpf_operation_map_find_element_batch_request_t, keys), &key_length);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    if (map_definition->key_size == 0 || key_length == 0 || key_length % map_definition->key_size != 0) {
+        retval = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    key_count = key_length / map_definition->key_size;
+
+    retval = ebpf_safe_size_t_subtract(
+        reply_length, EBPF_OFFSET_OF(ebpf_operation_map_find_element_batch_reply_t, data), &reply_data_length);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    // The reply holds the per-key results followed by the values.
+    if (reply_data_length / (sizeof(ebpf_result_t) + map_definition->value_size) < key_count) {
+        retval = EBPF_INSUFFICIENT_BUFFER;
+        goto Done;
+    }
+
+    // The request and reply share the same buffer, so copy the keys before any part of the reply is written.
+    keys = (uint8_t*)ebpf_allocate_with_tag(key_length, EBPF_POOL_TAG_CORE);
+    if (keys == NULL) {
+        retval = EBPF_NO_MEMORY;
+        goto Done;
+    }
+    memcpy(keys, request->keys, key_length);
+
+    // All keys are looked up under the epoch entered by the protocol dispatcher for this request.
+    retval = ebpf_map_find_entry_batch(
+        map,
+        key_count,
+        map_definition->key_size,
+        keys,
+        map_definition->value_size,
+        reply->data + key_count * sizeof(ebpf_result_t),
+        (ebpf_result_t*)reply->data,
+        find_and_delete ? EBPF_MAP_FIND_FLAG_DELETE : 0);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    reply->header.length = (uint16_t)(EBPF_OFFSET_OF(ebpf_operation_map_find_element_batch_reply_t, data) +
+                                      key_count * (sizeof(ebpf_result_t) + map_definition->value_size));
+
+Done:
+    ebpf_free(keys);
+    EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)map);
+    EBPF_RETURN_RESULT(retval);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_map_stage_contents(_In_ const ebpf_operation_map_stage_contents_request_t* request)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t retval;
+    ebpf_map_t* map = NULL;
+    size_t records_length;
+
+    retval = EBPF_OBJECT_REFERENCE_BY_HANDLE(request->handle, EBPF_OBJECT_MAP, (ebpf_core_object_t**)&map);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    retval = ebpf_safe_size_t_subtract(
+        request->header.length, EBPF_OFFSET_OF(ebpf_operation_map_stage_contents_request_t, data), &records_length);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    retval = ebpf_map_stage_contents(map, request->reset, records_length, request->data);
+
+Done:
+    EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)map);
+    EBPF_RETURN_RESULT(retval);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_map_replace_contents(_In_ const ebpf_operation_map_replace_contents_request_t* request)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t retval;
+    ebpf_map_t* map = NULL;
+
+    retval = EBPF_OBJECT_REFERENCE_BY_HANDLE(request->handle, EBPF_OBJECT_MAP, (ebpf_core_object_t**)&map);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    // The old contents are reclaimed once the epoch entered by the protocol dispatcher for this request ends.
+    retval = ebpf_map_publish_staged_contents(map, request->record_count);
+
+Done:
+    EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)map);
+    EBPF_RETURN_RESULT(retval);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_map_set_statistics(_In_ const ebpf_operation_map_set_statistics_request_t* request)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t retval;
+    ebpf_map_t* map = NULL;
+
+    retval = EBPF_OBJECT_REFERENCE_BY_HANDLE(request->handle, EBPF_OBJECT_MAP, (ebpf_core_object_t**)&map);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    retval = ebpf_map_set_statistics_enabled(map, request->enabled);
+
+Done:
+    EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)map);
+    EBPF_RETURN_RESULT(retval);
+}
+
 /**
  * @brief Complete the test run of an eBPF program. This is called when a program test run has completed. This
  * function will build the reply message and send it to the client.
@@ -1364,6 +1680,51 @@ Done:
     EBPF_RETURN_RESULT(retval);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_core_pin_objects(
+    size_t count, _In_reads_(count) const ebpf_handle_t* handles, _In_reads_(count) const cxplat_utf8_string_t* paths)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t retval = EBPF_SUCCESS;
+    ebpf_pinning_entry_t* entries = NULL;
+    size_t entries_size;
+
+    if (count == 0) {
+        EBPF_RETURN_RESULT(EBPF_SUCCESS);
+    }
+
+    retval = ebpf_safe_size_t_multiply(count, sizeof(ebpf_pinning_entry_t), &entries_size);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    entries = (ebpf_pinning_entry_t*)ebpf_allocate_with_tag(entries_size, EBPF_POOL_TAG_CORE);
+    if (entries == NULL) {
+        retval = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    for (size_t index = 0; index < count; index++) {
+        retval = EBPF_OBJECT_REFERENCE_BY_HANDLE(handles[index], EBPF_OBJECT_UNKNOWN, &entries[index].object);
+        if (retval != EBPF_SUCCESS) {
+            goto Done;
+        }
+        entries[index].path = paths[index];
+    }
+
+    retval = ebpf_pinning_table_insert_batch(_ebpf_core_map_pinning_table, count, entries);
+
+Done:
+    if (entries != NULL) {
+        for (size_t index = 0; index < count; index++) {
+            EBPF_OBJECT_RELEASE_REFERENCE(entries[index].object);
+        }
+        ebpf_free(entries);
+    }
+
+    EBPF_RETURN_RESULT(retval);
+}
+
 static ebpf_result_t
 _ebpf_core_protocol_update_pinning(_In_ const struct _ebpf_operation_update_map_pinning_request* request)
 {
@@ -1616,6 +1977,48 @@ Done:
     EBPF_RETURN_RESULT(retval);
 }
 
+static ebpf_result_t
+_ebpf_core_protocol_update_link_program(_In_ const ebpf_operation_update_link_program_request_t* request)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t retval;
+    ebpf_link_t* link = NULL;
+    ebpf_program_t* program = NULL;
+    ebpf_program_t* old_program = NULL;
+
+    retval = EBPF_OBJECT_REFERENCE_BY_HANDLE(request->link_handle, EBPF_OBJECT_LINK, (ebpf_core_object_t**)&link);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    retval =
+        EBPF_OBJECT_REFERENCE_BY_HANDLE(request->program_handle, EBPF_OBJECT_PROGRAM, (ebpf_core_object_t**)&program);
+    if (retval != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    if (ebpf_program_get_code_type(program) == EBPF_CODE_NONE) {
+        retval = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    if (request->old_program_handle != ebpf_handle_invalid) {
+        retval = EBPF_OBJECT_REFERENCE_BY_HANDLE(
+            request->old_program_handle, EBPF_OBJECT_PROGRAM, (ebpf_core_object_t**)&old_program);
+        if (retval != EBPF_SUCCESS) {
+            goto Done;
+        }
+    }
+
+    retval = ebpf_link_update_program(link, program, old_program);
+
+Done:
+    EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)old_program);
+    EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)program);
+    EBPF_OBJECT_RELEASE_REFERENCE((ebpf_core_object_t*)link);
+    EBPF_RETURN_RESULT(retval);
+}
+
 static ebpf_result_t
 _ebpf_core_protocol_close_handle(_In_ const ebpf_operation_close_handle_request_t* request)
 {
@@ -2005,6 +2408,120 @@ _ebpf_core_protocol_get_object_info(
     EBPF_RETURN_RESULT(result);
 }
 
+static ebpf_result_t
+_get_object_info_batch(
+    ebpf_object_type_t type,
+    _In_ const ebpf_operation_get_object_info_batch_request_t* request,
+    _Out_ ebpf_operation_get_object_info_batch_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    ebpf_id_t* ids = NULL;
+    uint16_t record_size;
+    uint32_t count_of_records = 0;
+    // Only used as input for programs: no map IDs are requested in batch mode.
+    const struct bpf_prog_info input_info = {0};
+
+    switch (type) {
+    case EBPF_OBJECT_LINK:
+        record_size = sizeof(struct bpf_link_info);
+        break;
+    case EBPF_OBJECT_MAP:
+        record_size = sizeof(struct bpf_map_info);
+        break;
+    case EBPF_OBJECT_PROGRAM:
+        record_size = sizeof(struct bpf_prog_info);
+        break;
+    default:
+        EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+    }
+
+    uint32_t capacity = (reply_length - FIELD_OFFSET(ebpf_operation_get_object_info_batch_reply_t, info)) / record_size;
+    if (capacity == 0) {
+        EBPF_RETURN_RESULT(EBPF_INSUFFICIENT_BUFFER);
+    }
+
+    ids = (ebpf_id_t*)ebpf_allocate_with_tag(capacity * sizeof(ebpf_id_t), EBPF_POOL_TAG_CORE);
+    if (ids == NULL) {
+        EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+    }
+
+    uint32_t count_of_ids = capacity;
+    result = ebpf_object_get_next_ids(request->start_id, type, &count_of_ids, ids);
+    if (result != EBPF_SUCCESS) {
+        goto Exit;
+    }
+
+    reply->next_id = request->start_id;
+    for (uint32_t i = 0; i < count_of_ids; i++) {
+        ebpf_core_object_t* object;
+        reply->next_id = ids[i];
+
+        // The object may have been deleted since the ID table was walked.
+        if (EBPF_OBJECT_REFERENCE_BY_ID(ids[i], type, &object) != EBPF_SUCCESS) {
+            continue;
+        }
+
+        uint8_t* record = reply->info + ((size_t)count_of_records * record_size);
+        uint16_t info_size = record_size;
+        switch (type) {
+        case EBPF_OBJECT_LINK:
+            result = ebpf_link_get_info((ebpf_link_t*)object, record, &info_size);
+            break;
+        case EBPF_OBJECT_MAP:
+            result = ebpf_map_get_info((ebpf_map_t*)object, record, &info_size);
+            break;
+        default:
+            result = ebpf_program_get_info((ebpf_program_t*)object, (const uint8_t*)&input_info, record, &info_size);
+            break;
+        }
+        EBPF_OBJECT_RELEASE_REFERENCE(object);
+        if (result != EBPF_SUCCESS) {
+            goto Exit;
+        }
+        count_of_records++;
+    }
+
+    reply->count_of_records = count_of_records;
+    reply->header.length =
+        (uint16_t)(FIELD_OFFSET(ebpf_operation_get_object_info_batch_reply_t, info) + count_of_records * record_size);
+
+Exit:
+    ebpf_free(ids);
+    EBPF_RETURN_RESULT(result);
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_link_info_batch(
+    _In_ const ebpf_operation_get_object_info_batch_request_t* request,
+    _Out_ ebpf_operation_get_object_info_batch_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_object_info_batch(EBPF_OBJECT_LINK, request, reply, reply_length));
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_map_info_batch(
+    _In_ const ebpf_operation_get_object_info_batch_request_t* request,
+    _Out_ ebpf_operation_get_object_info_batch_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_object_info_batch(EBPF_OBJECT_MAP, request, reply, reply_length));
+}
+
+static ebpf_result_t
+_ebpf_core_protocol_get_program_info_batch(
+    _In_ const ebpf_operation_get_object_info_batch_request_t* request,
+    _Out_ ebpf_operation_get_object_info_batch_reply_t* reply,
+    uint16_t reply_length)
+{
+    EBPF_LOG_ENTRY();
+    EBPF_RETURN_RESULT(_get_object_info_batch(EBPF_OBJECT_PROGRAM, request, reply, reply_length));
+}
+
 static ebpf_result_t
 _ebpf_core_protocol_ring_buffer_map_query_buffer(
     _In_ const ebpf_operation_ring_buffer_map_query_buffer_request_t* request,
@@ -2187,26 +2704,108 @@ _ebpf_core_is_current_admin(_In_ const void* ctx)
 // Pick a limit on string size based on the size of the eBPF stack.
 #define MAX_PRINTK_STRING_SIZE 512
 
-// Only integers are currently supported.
-#define PRINTK_SPECIFIER_CHARS "diux"
+// Maximum number of distinct format strings that can use the deferred printk path.
+// Formats beyond this limit fall back to formatting in the kernel.
+#define MAX_PRINTK_DEFERRED_FORMATS 1024
 
-static long
-_ebpf_core_trace_printk(_In_reads_(fmt_size) const char* fmt, size_t fmt_size, int arg_count, ...)
+typedef struct _ebpf_core_printk_format
 {
-    if (fmt_size > MAX_PRINTK_STRING_SIZE - 1) {
-        // Disallow large fmt_size values.
-        return -1;
+    cxplat_utf8_string_t key; ///< Raw format bytes as passed by the program; the registry key.
+    uint32_t id;              ///< Identifier carried by EbpfPrintk events.
+    int specifier_count;      ///< Number of conversion specifiers, or -1 if the format is invalid.
+    char data[1];             ///< Raw format bytes followed by the null-terminated normalized format.
+} ebpf_core_printk_format_t;
+
+static ebpf_hash_table_t* _ebpf_core_printk_format_table = NULL;
+static ebpf_core_printk_format_t* _ebpf_core_printk_formats[MAX_PRINTK_DEFERRED_FORMATS] = {0};
+static volatile int32_t _ebpf_core_printk_format_count = 0;
+
+// Serializes the format rundown against terminate, which frees the formats.
+static ebpf_lock_t _ebpf_core_printk_format_lock;
+
+static void
+_ebpf_core_printk_format_extract(_In_ const uint8_t* value, _Outptr_ const uint8_t** data, _Out_ size_t* length)
+{
+    const cxplat_utf8_string_t* key = *(cxplat_utf8_string_t**)value;
+    *data = key->value;
+    *length = key->length * 8;
+}
+
+/**
+ * @brief Log every registered format again. EbpfPrintkFormat is otherwise only logged when a
+ * format is first registered, which a session started later would not see.
+ */
+static void
+_ebpf_core_printk_formats_rundown()
+{
+    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_core_printk_format_lock);
+    if (_ebpf_core_printk_format_table != NULL) {
+        // The count can run past the limit when registrations fail, so bound it by the table size.
+        int32_t count = _ebpf_core_printk_format_count;
+        if (count > MAX_PRINTK_DEFERRED_FORMATS) {
+            count = MAX_PRINTK_DEFERRED_FORMATS;
+        }
+        for (int32_t index = 0; index < count; index++) {
+            void* volatile* slot = (void* volatile*)&_ebpf_core_printk_formats[index];
+            const ebpf_core_printk_format_t* format = (const ebpf_core_printk_format_t*)ReadPointerAcquire(slot);
+            // The slot is still empty if the format is being registered, in which case the
+            // registration logs it.
+            if (format != NULL && format->specifier_count >= 0) {
+                ebpf_log_printk_format(format->id, format->data + format->key.length);
+            }
+        }
     }
+    ebpf_lock_unlock(&_ebpf_core_printk_format_lock, state);
+}
 
-    // Make a copy of the original format string.
-    char* output = (char*)ebpf_allocate_with_tag(fmt_size + 1, EBPF_POOL_TAG_CORE);
-    if (output == NULL) {
-        return -1;
+static _Must_inspect_result_ ebpf_result_t
+_ebpf_core_printk_formats_initiate()
+{
+    const ebpf_hash_table_creation_options_t options = {
+        .key_size = sizeof(cxplat_utf8_string_t*),
+        .value_size = sizeof(ebpf_core_printk_format_t*),
+        .extract_function = _ebpf_core_printk_format_extract,
+        .max_entries = MAX_PRINTK_DEFERRED_FORMATS,
+    };
+
+    ebpf_lock_create(&_ebpf_core_printk_format_lock);
+    _ebpf_core_printk_format_count = 0;
+    ebpf_result_t result = ebpf_hash_table_create(&_ebpf_core_printk_format_table, &options);
+    if (result != EBPF_SUCCESS) {
+        return result;
     }
+
+    ebpf_trace_set_printk_format_rundown(_ebpf_core_printk_formats_rundown);
+    return EBPF_SUCCESS;
+}
+
+static void
+_ebpf_core_printk_formats_terminate()
+{
+    ebpf_trace_set_printk_format_rundown(NULL);
+
+    ebpf_lock_state_t state = ebpf_lock_lock(&_ebpf_core_printk_format_lock);
+    ebpf_hash_table_destroy(_ebpf_core_printk_format_table);
+    _ebpf_core_printk_format_table = NULL;
+
+    for (int32_t index = 0; index < MAX_PRINTK_DEFERRED_FORMATS; index++) {
+        ebpf_free(_ebpf_core_printk_formats[index]);
+        _ebpf_core_printk_formats[index] = NULL;
+    }
+    _ebpf_core_printk_format_count = 0;
+    ebpf_lock_unlock(&_ebpf_core_printk_format_lock, state);
+}
+
+/**
+ * @brief Copy a format string supplied by a program, making sure the copy is
+ * null-terminated and removing the trailing newline if present.
+ */
+static void
+_ebpf_core_printk_normalize_format(
+    _In_reads_(fmt_size) const char* fmt, size_t fmt_size, _Out_writes_(fmt_size + 1) char* output)
+{
     memcpy(output, fmt, fmt_size);
 
-    // Make sure the output is null-terminated, and
-    // remove the newline if present.
     // A well-formed input should be null terminated,
     // so look at the next-to-last byte.
     char* end = output + fmt_size - 2;
@@ -2214,59 +2813,130 @@ _ebpf_core_trace_printk(_In_reads_(fmt_size) const char* fmt, size_t fmt_size, i
         end++;
     }
     *end = '\0';
+}
 
-    /* Validate format string.
-     * The conversion specifiers are limited to:
-     * %d, %i, %u, %x, %ld, %li, %lu, %lx, %lld, %lli, %llu, %llx.
-     * No modifier (size of field, padding with zeroes, etc.) is available.
-     */
-    long bytes_written = -1;
-    const char* p;
-    int specifier_count = 0;
-    for (p = output; *p; p++) {
-        if (*p != '%') {
-            continue;
-        }
-        if (p[1] == 0) {
-            break;
-        }
-        if (p[1] == '%') {
-            // Allow a %% escape.
-            p++;
-            continue;
-        }
+/**
+ * @brief Find the registry entry for a format string, registering it on first use.
+ * Registration validates the format once and logs it so that a user mode consumer
+ * can map the identifier in subsequent EbpfPrintk events back to the format.
+ *
+ * @returns The registry entry, or NULL if the format could not be registered.
+ */
+static _Ret_maybenull_ const ebpf_core_printk_format_t*
+_ebpf_core_printk_find_or_register_format(_In_reads_(fmt_size) const char* fmt, size_t fmt_size)
+{
+    cxplat_utf8_string_t key = {(uint8_t*)fmt, fmt_size};
+    const cxplat_utf8_string_t* key_pointer = &key;
+    ebpf_core_printk_format_t** value;
 
-        // We found a specifier.  Verify that it is in the legal set.
-        if (strchr(PRINTK_SPECIFIER_CHARS, p[1])) {
-            // We found a legal one character specifier.
-            p++;
-            specifier_count++;
-            continue;
-        }
+    if (_ebpf_core_printk_format_table == NULL) {
+        return NULL;
+    }
 
-        if (p[1] != 'l' || p[2] == 0) {
-            break;
+    if (ebpf_hash_table_find(_ebpf_core_printk_format_table, (const uint8_t*)&key_pointer, (uint8_t**)&value) ==
+        EBPF_SUCCESS) {
+        return *value;
+    }
+
+    if (_ebpf_core_printk_format_count >= MAX_PRINTK_DEFERRED_FORMATS) {
+        return NULL;
+    }
+    int32_t id = ebpf_interlocked_increment_int32(&_ebpf_core_printk_format_count) - 1;
+    if (id >= MAX_PRINTK_DEFERRED_FORMATS) {
+        return NULL;
+    }
+
+    ebpf_core_printk_format_t* format = (ebpf_core_printk_format_t*)ebpf_allocate_with_tag(
+        EBPF_OFFSET_OF(ebpf_core_printk_format_t, data) + (fmt_size * 2) + 1, EBPF_POOL_TAG_CORE);
+    if (format == NULL) {
+        return NULL;
+    }
+    memcpy(format->data, fmt, fmt_size);
+    format->key.value = (uint8_t*)format->data;
+    format->key.length = fmt_size;
+    format->id = (uint32_t)id;
+
+    char* normalized_format = format->data + fmt_size;
+    _ebpf_core_printk_normalize_format(fmt, fmt_size, normalized_format);
+    if (!ebpf_validate_printk_format(normalized_format, &format->specifier_count)) {
+        format->specifier_count = -1;
+    }
+
+    key_pointer = &format->key;
+    ebpf_result_t result = ebpf_hash_table_update(
+        _ebpf_core_printk_format_table,
+        (const uint8_t*)&key_pointer,
+        (const uint8_t*)&format,
+        EBPF_HASH_TABLE_OPERATION_INSERT);
+    if (result != EBPF_SUCCESS) {
+        // Either another thread registered the same format first, or the table is full.
+        ebpf_free(format);
+        if (result != EBPF_KEY_ALREADY_EXISTS) {
+            return NULL;
         }
-        if (strchr(PRINTK_SPECIFIER_CHARS, p[2])) {
-            // We found a legal two character specifier.
-            p += 2;
-            specifier_count++;
-            continue;
+        key_pointer = &key;
+        if (ebpf_hash_table_find(_ebpf_core_printk_format_table, (const uint8_t*)&key_pointer, (uint8_t**)&value) !=
+            EBPF_SUCCESS) {
+            return NULL;
         }
+        return *value;
+    }
 
-        if (p[2] != 'l' || p[3] == 0) {
-            break;
-        }
-        if (strchr(PRINTK_SPECIFIER_CHARS, p[3])) {
-            // We found a legal three character specifier.
-            p += 3;
-            specifier_count++;
-            continue;
+    // The slot is owned by this identifier, so no other thread writes to it. Publish the
+    // format only once it is in the table, so that the rundown never sees a freed format.
+    WritePointerRelease((void* volatile*)&_ebpf_core_printk_formats[id], format);
+
+    if (format->specifier_count >= 0) {
+        ebpf_log_printk_format(format->id, normalized_format);
+    }
+    return format;
+}
+
+static long
+_ebpf_core_trace_printk(_In_reads_(fmt_size) const char* fmt, size_t fmt_size, int arg_count, ...)
+{
+    if (fmt_size > MAX_PRINTK_STRING_SIZE - 1) {
+        // Disallow large fmt_size values.
+        return -1;
+    }
+
+    // When only the binary printk keyword is enabled, log the format identifier and the raw
+    // arguments, and leave the formatting to the user mode consumer.
+    if (TraceLoggingProviderEnabled(
+            ebpf_tracelog_provider, EBPF_TRACELOG_LEVEL_INFO, EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED) &&
+        !TraceLoggingProviderEnabled(ebpf_tracelog_provider, EBPF_TRACELOG_LEVEL_INFO, EBPF_TRACELOG_KEYWORD_PRINTK)) {
+        const ebpf_core_printk_format_t* format = _ebpf_core_printk_find_or_register_format(fmt, fmt_size);
+        if (format != NULL) {
+            if (format->specifier_count != arg_count) {
+                return -1;
+            }
+
+            uint64_t args[3] = {0};
+            va_list arg_list;
+            __va_start(&arg_list, arg_count);
+            for (int i = 0; i < arg_count && (size_t)i < EBPF_COUNT_OF(args); i++) {
+                args[i] = va_arg(arg_list, uint64_t);
+            }
+            __va_end(&arg_list);
+
+            ebpf_log_printk_deferred(format->id, (uint32_t)arg_count, args[0], args[1], args[2]);
+
+            // Nothing is formatted in the kernel, so no bytes are written.
+            return 0;
         }
-        break;
+        // The format could not be registered, so fall back to formatting it here.
+    }
+
+    // Make a copy of the original format string.
+    char* output = (char*)ebpf_allocate_with_tag(fmt_size + 1, EBPF_POOL_TAG_CORE);
+    if (output == NULL) {
+        return -1;
     }
+    _ebpf_core_printk_normalize_format(fmt, fmt_size, output);
 
-    if ((*p == 0) && (arg_count == specifier_count)) {
+    long bytes_written = -1;
+    int specifier_count;
+    if (ebpf_validate_printk_format(output, &specifier_count) && (arg_count == specifier_count)) {
         va_list arg_list;
         __va_start(&arg_list, arg_count);
         bytes_written = ebpf_platform_printk(output, arg_list);
@@ -2296,7 +2966,7 @@ _ebpf_core_trace_printk4(_In_reads_(fmt_size) const char* fmt, size_t fmt_size,
 }
 
 long
-_ebpf_core_trace_printk5(
+ebpf_core_trace_printk5(
     _In_reads_(fmt_size) const char* fmt, size_t fmt_size, uint64_t arg3, uint64_t arg4, uint64_t arg5)
 {
     return _ebpf_core_trace_printk(fmt, fmt_size, 3, arg3, arg4, arg5);
@@ -2366,6 +3036,21 @@ _ebpf_core_map_peek_elem(_Inout_ ebpf_map_t* map, _Out_ uint8_t* value)
     return -ebpf_map_peek_entry(map, 0, value, EBPF_MAP_FLAG_HELPER);
 }
 
+static void*
+_ebpf_core_sk_storage_get(_In_ const ebpf_map_t* map, _In_ void* ctx, _In_opt_ const uint8_t* value, uint64_t flags)
+{
+    // The helper is only resolved for program types whose contexts are preceded by a context header.
+    ebpf_context_header_t* header = (ebpf_context_header_t*)ctx - 1;
+    return ebpf_map_get_sk_storage(map, header, value, flags);
+}
+
+static int64_t
+_ebpf_core_sk_storage_delete(_In_ const ebpf_map_t* map, _In_ void* ctx)
+{
+    ebpf_context_header_t* header = (ebpf_context_header_t*)ctx - 1;
+    return -ebpf_map_delete_sk_storage(map, header);
+}
+
 static int32_t
 _ebpf_core_memcpy(
     _Out_writes_(destination_size) void* destination,
@@ -2554,6 +3239,9 @@ typedef struct _ebpf_protocol_handler
 ALIAS_TYPES(get_next_id, get_next_link_id)
 ALIAS_TYPES(get_next_id, get_next_map_id)
 ALIAS_TYPES(get_next_id, get_next_program_id)
+ALIAS_TYPES(get_object_info_batch, get_link_info_batch)
+ALIAS_TYPES(get_object_info_batch, get_map_info_batch)
+ALIAS_TYPES(get_object_info_batch, get_program_info_batch)
 ALIAS_TYPES(get_handle_by_id, get_link_handle_by_id)
 ALIAS_TYPES(get_handle_by_id, get_map_handle_by_id)
 ALIAS_TYPES(get_handle_by_id, get_program_handle_by_id)
@@ -2615,6 +3303,19 @@ static ebpf_protocol_handler_t _ebpf_protocol_handlers[] = {
     DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_FIXED_REPLY(map_delete_element_batch, keys, PROTOCOL_ALL_MODES),
     DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_VARIABLE_REPLY(
         map_get_next_key_value_batch, previous_key, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_NO_REPLY(update_link_program, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_link_info_batch, info, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_map_info_batch, info, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_VARIABLE_REPLY(get_program_info_batch, info, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_VARIABLE_REPLY(map_find_element_batch, keys, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_NO_REPLY(map_stage_contents, data, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_NO_REPLY(map_replace_contents, PROTOCOL_ALL_MODES),
+    DECLARE_PROTOCOL_HANDLER_FIXED_REQUEST_NO_REPLY(map_set_statistics, PROTOCOL_ALL_MODES),
+#if !defined(CONFIG_BPF_JIT_DISABLED)
+    DECLARE_PROTOCOL_HANDLER_VARIABLE_REQUEST_VARIABLE_REPLY(resolve_program, data, data, PROTOCOL_JIT_MODE),
+#else
+    DECLARE_PROTOCOL_HANDLER_INVALID(EBPF_PROTOCOL_VARIABLE_REQUEST_VARIABLE_REPLY),
+#endif
 };
 
 _Must_inspect_result_ ebpf_result_t
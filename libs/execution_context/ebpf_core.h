@@ -113,6 +113,22 @@ extern "C"
         int to_size,
         int seed);
 
+    /**
+     * @brief Implementation of the bpf_trace_printk5 helper function.
+     *
+     * @param[in] fmt Printf-style format string.
+     * @param[in] fmt_size Size in bytes of *fmt*.
+     * @param[in] arg3 First numeric argument to be used by the format string.
+     * @param[in] arg4 Second numeric argument to be used by the format string.
+     * @param[in] arg5 Third numeric argument to be used by the format string.
+     *
+     * @returns The number of bytes written, 0 if the record was logged for formatting
+     * in user mode, or a negative error in case of failure.
+     */
+    long
+    ebpf_core_trace_printk5(
+        _In_reads_(fmt_size) const char* fmt, size_t fmt_size, uint64_t arg3, uint64_t arg4, uint64_t arg5);
+
     /**
      * @brief Return a handle to the object which is pinned at the
      *  supplied pin path.
@@ -141,12 +157,34 @@ extern "C"
     _Must_inspect_result_ ebpf_result_t
     ebpf_core_update_pinning(const ebpf_handle_t handle, _In_ const cxplat_utf8_string_t* path);
 
+    /**
+     * @brief Pin a set of objects to the provided paths under a single
+     *  acquisition of the pinning table lock. Either all objects are pinned or
+     *  none are.
+     *
+     * @param[in] count Number of objects to pin.
+     * @param[in] handles Handles of the objects to be pinned.
+     * @param[in] paths Pin paths, one per handle.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_OBJECT One of the handles is invalid.
+     * @retval EBPF_OBJECT_ALREADY_EXISTS One of the paths is already in use.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this operation.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_core_pin_objects(
+        size_t count,
+        _In_reads_(count) const ebpf_handle_t* handles,
+        _In_reads_(count) const cxplat_utf8_string_t* paths);
+
     /**
      * @brief Create a new map object.
      *
      * @param[in] map_name Name of the map to be created.
      * @param[in] ebpf_map_definition Map definition structure.
      * @param[in] inner_map_handle Handle to the inner map object, if any.
+     * @param[in] map_flags Combination of BPF_F_NUMA_NODE and BPF_F_NUMA_REPLICATED.
+     * @param[in] numa_node NUMA node to allocate the map on if map_flags contains BPF_F_NUMA_NODE.
      * @param[out] map_handle Handle to the created map object.
      *
      * @retval EBPF_SUCCESS The operation was successful.
@@ -157,6 +195,8 @@ extern "C"
         _In_ const cxplat_utf8_string_t* map_name,
         _In_ const ebpf_map_definition_in_memory_t* ebpf_map_definition,
         ebpf_handle_t inner_map_handle,
+        uint32_t map_flags,
+        uint32_t numa_node,
         _Out_ ebpf_handle_t* map_handle);
 
     /**
@@ -169,6 +169,34 @@ ebpf_helper_function_prototype_t ebpf_core_helper_function_prototype_array[] = {
      "bpf_get_socket_cookie",
      EBPF_RETURN_TYPE_INTEGER,
      {EBPF_ARGUMENT_TYPE_PTR_TO_CTX}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_get_current_app_id,
+     "bpf_get_current_app_id",
+     EBPF_RETURN_TYPE_INTEGER,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_CTX}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_sk_storage_get,
+     "bpf_sk_storage_get",
+     EBPF_RETURN_TYPE_PTR_TO_MAP_VALUE_OR_NULL,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_MAP,
+      EBPF_ARGUMENT_TYPE_PTR_TO_CTX,
+      EBPF_ARGUMENT_TYPE_PTR_TO_MAP_VALUE,
+      EBPF_ARGUMENT_TYPE_ANYTHING}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_sk_storage_delete,
+     "bpf_sk_storage_delete",
+     EBPF_RETURN_TYPE_INTEGER,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_MAP, EBPF_ARGUMENT_TYPE_PTR_TO_CTX}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_ktime_get_coarse_ns,
+     "bpf_ktime_get_coarse_ns",
+     EBPF_RETURN_TYPE_INTEGER,
+     {0}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_ktime_get_fast_ns,
+     "bpf_ktime_get_fast_ns",
+     EBPF_RETURN_TYPE_INTEGER,
+     {0}},
 };
 
 #ifdef __cplusplus
@@ -88,6 +88,9 @@ _ebpf_link_instance_invoke_batch(
 static ebpf_result_t
 _ebpf_link_instance_invoke_batch_end(_Inout_ void* state);
 
+static uint64_t
+_ebpf_link_instance_get_state_generation(_In_ const void* extension_client_binding_context);
+
 static const ebpf_extension_program_dispatch_table_t _ebpf_link_dispatch_table = {
     EBPF_LINK_DISPATCH_TABLE_VERSION_CURRENT,
     EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_CURRENT, // Count of functions. This should be updated when new functions
@@ -96,6 +99,7 @@ static const ebpf_extension_program_dispatch_table_t _ebpf_link_dispatch_table =
     _ebpf_link_instance_invoke_batch_begin,
     _ebpf_link_instance_invoke_batch,
     _ebpf_link_instance_invoke_batch_end,
+    _ebpf_link_instance_get_state_generation,
 };
 
 // Assert that the invoke function is aligned with ebpf_extension_dispatch_table_t->function.
@@ -454,6 +458,78 @@ Done:
     EBPF_RETURN_VOID();
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_link_update_program(
+    _Inout_ ebpf_link_t* link, _Inout_ ebpf_program_t* program, _In_opt_ const ebpf_program_t* expected_program)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t return_value = EBPF_SUCCESS;
+    ebpf_program_type_t program_type = ebpf_program_type_uuid(program);
+    ebpf_attach_type_t expected_attach_type = ebpf_expected_attach_type(program);
+    static const ebpf_attach_type_t unspecified_attach_type = {0};
+    ebpf_program_t* old_program;
+
+    ebpf_lock_state_t state = ebpf_lock_lock(&link->lock);
+
+    if (link->state != EBPF_LINK_STATE_ATTACHED) {
+        EBPF_LOG_MESSAGE(EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_LINK, "Link is not attached to a program.");
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    if (expected_program != NULL && link->program != expected_program) {
+        EBPF_LOG_MESSAGE(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_LINK, "Link is not attached to the expected program.");
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    // The provider bound to this link only accepts the program type it was bound with.
+    if (memcmp(&program_type, &link->program_type, sizeof(program_type)) != 0) {
+        EBPF_LOG_MESSAGE_GUID_GUID(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_LINK,
+            "Program type does not match link.",
+            &program_type,
+            &link->program_type);
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    // A program loaded for a specific attach type can only be attached to a link of that type.
+    if (memcmp(&expected_attach_type, &unspecified_attach_type, sizeof(expected_attach_type)) != 0 &&
+        memcmp(&expected_attach_type, &link->attach_type, sizeof(expected_attach_type)) != 0) {
+        EBPF_LOG_MESSAGE_GUID_GUID(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_LINK,
+            "Program expected attach type does not match link.",
+            &expected_attach_type,
+            &link->attach_type);
+        return_value = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    old_program = link->program;
+    if (old_program == program) {
+        goto Done;
+    }
+
+    // Swap the program without re-binding to the provider. Invocations already in progress hold the epoch and keep
+    // running the old program, which is only freed once the current epoch ends.
+    // Both programs track the link through its single object_list_entry, so the link must leave the old program's
+    // list before joining the new one. Hold a reference so the link stays alive while it is on neither list.
+    EBPF_OBJECT_ACQUIRE_REFERENCE(&link->object);
+    ebpf_program_detach_link(old_program, link);
+    ebpf_interlocked_compare_exchange_pointer((void* volatile*)&link->program, program, old_program);
+    ebpf_program_attach_link(program, link);
+    EBPF_OBJECT_RELEASE_REFERENCE(&link->object);
+    ebpf_program_increment_state_generation();
+
+Done:
+    ebpf_lock_unlock(&link->lock, state);
+    EBPF_RETURN_RESULT(return_value);
+}
+
 static ebpf_result_t
 _ebpf_link_instance_invoke(
     _In_ const void* extension_client_binding_context, _Inout_ void* program_context, _Out_ uint32_t* result)
@@ -512,6 +588,15 @@ _ebpf_link_instance_invoke_batch_end(_Inout_ void* state)
     return EBPF_SUCCESS;
 }
 
+static uint64_t
+_ebpf_link_instance_get_state_generation(_In_ const void* extension_client_binding_context)
+{
+    // The generation is global rather than per link, so a change anywhere invalidates the verdicts cached for every
+    // link. That only costs cache misses, never stale verdicts.
+    UNREFERENCED_PARAMETER(extension_client_binding_context);
+    return ebpf_program_get_state_generation();
+}
+
 static ebpf_result_t
 _ebpf_link_instance_invoke_batch(
     _In_ const void* client_binding_context,
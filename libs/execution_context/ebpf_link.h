@@ -53,6 +53,22 @@ extern "C"
     void
     ebpf_link_detach_program(_Inout_ ebpf_link_t* link);
 
+    /**
+     * @brief Atomically replace the program a link invokes, without detaching
+     * the link from its hook provider.
+     *
+     * @param[in, out] link The attached link object to update.
+     * @param[in, out] program The program the link should invoke.
+     * @param[in] expected_program Optional program that must currently be
+     *  attached to the link for the update to succeed.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The link is not attached, is attached to a
+     *  program other than expected_program, or the program type does not match.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_link_update_program(
+        _Inout_ ebpf_link_t* link, _Inout_ ebpf_program_t* program, _In_opt_ const ebpf_program_t* expected_program);
+
     /**
      * @brief Get bpf_link_info about a link.
      *
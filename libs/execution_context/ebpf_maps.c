@@ -21,8 +21,75 @@ typedef struct _ebpf_core_map
     ebpf_map_definition_in_memory_t ebpf_map_definition;
     uint32_t original_value_size;
     uint8_t* data;
+    ebpf_lock_t staging_lock;         //< Lock protecting the staged replacement contents.
+    ebpf_list_entry_t staged_chunks;  //< List of ebpf_map_staged_chunk_t for the next replacement.
+    size_t staged_record_count;       //< Count of records in staged_chunks.
+    uint8_t* statistics;              //< Allocation holding cache aligned per-CPU ebpf_map_statistics_t, or NULL.
+    uint32_t map_flags;               //< BPF_F_NUMA_NODE and BPF_F_NUMA_REPLICATED flags the map was created with.
+    uint32_t replica_count;           //< Count of entries in replicas.
+    struct _ebpf_core_map** replicas; //< Per-NUMA-node copies of the map indexed by node, or NULL.
+    ebpf_lock_t replica_lock;         //< Lock serializing updates that are applied to every replica.
 } ebpf_core_map_t;
 
+/**
+ * @brief A chunk of key+value records staged for an atomic replacement of the map contents.
+ */
+typedef struct _ebpf_map_staged_chunk
+{
+    ebpf_list_entry_t list_entry;
+    size_t record_count;
+    uint8_t records[1];
+} ebpf_map_staged_chunk_t;
+
+/**
+ * @brief Per-CPU access counters of a map, allocated only while statistics are enabled on the map.
+ * Counters are updated without interlocked operations, so a count may occasionally be lost if a caller
+ * running below DISPATCH_LEVEL migrates to another CPU.
+ */
+typedef __declspec(align(EBPF_CACHE_LINE_SIZE)) struct _ebpf_map_statistics
+{
+    uint64_t lookup_count;
+    uint64_t lookup_miss_count;
+    uint64_t update_count;
+    uint64_t delete_count;
+    uint64_t eviction_count;
+    uint64_t allocation_failure_count;
+} ebpf_map_statistics_t;
+
+/**
+ * @brief Get the statistics of the current CPU for a map.
+ *
+ * @param[in] map Map to get the statistics of.
+ * @return Pointer to the counters of the current CPU, or NULL if statistics are not enabled.
+ */
+static inline _Ret_maybenull_ ebpf_map_statistics_t*
+_ebpf_map_current_cpu_statistics(_In_ const ebpf_core_map_t* map)
+{
+    uint8_t* statistics = (uint8_t*)ReadPointerNoFence((void* const volatile*)&map->statistics);
+    if (statistics == NULL) {
+        return NULL;
+    }
+    return &((ebpf_map_statistics_t*)EBPF_CACHE_ALIGN_POINTER(statistics))[ebpf_get_current_cpu()];
+}
+
+/**
+ * @brief Get the copy of a map to serve lookups from on the current NUMA node.
+ *
+ * @param[in] map Map to look up in.
+ * @return The replica of the current NUMA node if the map is replicated, otherwise the map itself.
+ */
+static inline _Ret_notnull_ ebpf_core_map_t*
+_ebpf_map_local_replica(_In_ ebpf_core_map_t* map)
+{
+    if (map->replicas != NULL) {
+        uint32_t node = ebpf_get_current_numa_node();
+        if (node < map->replica_count) {
+            return map->replicas[node];
+        }
+    }
+    return map;
+}
+
 typedef struct _ebpf_core_object_map
 {
     ebpf_core_map_t core_map;
@@ -369,10 +436,13 @@ typedef struct _ebpf_map_metadata_table
         _In_ const uint8_t* previous_key,
         _Out_ uint8_t* next_key,
         _Inout_opt_ uint8_t** next_value);
+    ebpf_result_t (*replace_contents)(
+        _Inout_ ebpf_core_map_t* map, size_t record_count, _In_opt_ const uint8_t* records);
     int zero_length_key : 1;
     int zero_length_value : 1;
     int per_cpu : 1;
     int key_history : 1;
+    int zero_max_entries : 1;
 } ebpf_map_metadata_table_t;
 
 const ebpf_map_metadata_table_t ebpf_map_metadata_tables[];
@@ -438,12 +508,121 @@ _create_array_map(
     return _create_array_map_with_map_struct_size(sizeof(ebpf_core_map_t), map_definition, map);
 }
 
+/**
+ * @brief Get the data that was allocated together with an array map, which is
+ * in use until the map contents are first replaced.
+ */
+static inline uint8_t*
+_array_map_inline_data(_In_ const ebpf_core_map_t* map)
+{
+    return ((uint8_t*)map) + EBPF_PAD_CACHE(sizeof(ebpf_core_map_t));
+}
+
 static void
 _delete_array_map(_In_ _Post_invalid_ ebpf_core_map_t* map)
 {
     ebpf_epoch_free(map);
 }
 
+static void
+_delete_replaceable_array_map(_In_ _Post_invalid_ ebpf_core_map_t* map)
+{
+    // Free the data published by a replacement of the map contents, if any.
+    if (map->data != _array_map_inline_data(map)) {
+        ebpf_epoch_free(map->data);
+    }
+    _delete_array_map(map);
+}
+
+/**
+ * @brief Atomically publish new data for a map. The old data is reclaimed by
+ * the reclaim function once the current epoch ends, since programs and other
+ * callers may still be reading or updating it.
+ *
+ * @param[in, out] map Map to update.
+ * @param[in] new_data Data to publish. On success, the map owns this memory.
+ * @param[in] unreclaimable_data Data that must not be reclaimed, if any.
+ * @param[in] reclaim Function to reclaim the old data.
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_NO_MEMORY Unable to allocate resources to reclaim the old data.
+ */
+static ebpf_result_t
+_publish_map_data(
+    _Inout_ ebpf_core_map_t* map,
+    _In_ uint8_t* new_data,
+    _In_opt_ const uint8_t* unreclaimable_data,
+    _In_ const void (*reclaim)(_Inout_ void* context))
+{
+    for (;;) {
+        uint8_t* old_data = map->data;
+        ebpf_epoch_work_item_t* work_item = NULL;
+        if (old_data != unreclaimable_data) {
+            work_item = ebpf_epoch_allocate_work_item(old_data, reclaim);
+            if (!work_item) {
+                return EBPF_NO_MEMORY;
+            }
+        }
+
+        if (ebpf_interlocked_compare_exchange_pointer((void* volatile*)&map->data, new_data, old_data) == old_data) {
+            if (work_item) {
+                ebpf_epoch_schedule_work_item(work_item);
+            }
+            return EBPF_SUCCESS;
+        }
+
+        // A concurrent replacement published first, retry against its data.
+        ebpf_epoch_cancel_work_item(work_item);
+    }
+}
+
+static void
+_reclaim_array_map_data(_Inout_ void* context)
+{
+    ebpf_epoch_free(context);
+}
+
+static ebpf_result_t
+_replace_array_map_contents(_Inout_ ebpf_core_map_t* map, size_t record_count, _In_opt_ const uint8_t* records)
+{
+    ebpf_result_t result;
+    size_t key_size = map->ebpf_map_definition.key_size;
+    size_t value_size = map->ebpf_map_definition.value_size;
+    size_t data_size;
+    uint8_t* new_data = NULL;
+
+    result = ebpf_safe_size_t_multiply(map->ebpf_map_definition.max_entries, value_size, &data_size);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    // Entries that are not in the records are zero, as if they were deleted.
+    new_data = ebpf_epoch_allocate_with_tag(data_size, EBPF_POOL_TAG_MAP);
+    if (new_data == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+    memset(new_data, 0, data_size);
+
+    for (size_t index = 0; index < record_count; index++) {
+        const uint8_t* record = records + index * (key_size + value_size);
+        uint32_t key_value = *(uint32_t*)record;
+        if (key_value >= map->ebpf_map_definition.max_entries) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Done;
+        }
+        memcpy(&new_data[key_value * value_size], record + key_size, value_size);
+    }
+
+    result = _publish_map_data(map, new_data, _array_map_inline_data(map), _reclaim_array_map_data);
+    if (result == EBPF_SUCCESS) {
+        new_data = NULL;
+    }
+
+Done:
+    ebpf_epoch_free(new_data);
+    return result;
+}
+
 static ebpf_result_t
 _find_array_map_entry(
     _Inout_ ebpf_core_map_t* map, _In_opt_ const uint8_t* key, bool delete_on_success, _Outptr_ uint8_t** data)
@@ -994,6 +1173,31 @@ _delete_hash_map(_In_ _Post_invalid_ ebpf_core_map_t* map)
     ebpf_epoch_free(map);
 }
 
+static void
+_reclaim_hash_map_data(_Inout_ void* context)
+{
+    ebpf_hash_table_destroy((ebpf_hash_table_t*)context);
+}
+
+static ebpf_result_t
+_replace_hash_map_contents(_Inout_ ebpf_core_map_t* map, size_t record_count, _In_opt_ const uint8_t* records)
+{
+    ebpf_hash_table_t* new_table = NULL;
+
+    // Build the replacement table off to the side, then swap it in.
+    ebpf_result_t result =
+        ebpf_hash_table_create_from_records((ebpf_hash_table_t*)map->data, record_count, records, &new_table);
+    if (result != EBPF_SUCCESS) {
+        return result;
+    }
+
+    result = _publish_map_data(map, (uint8_t*)new_table, NULL, _reclaim_hash_map_data);
+    if (result != EBPF_SUCCESS) {
+        ebpf_hash_table_destroy(new_table);
+    }
+    return result;
+}
+
 static void
 _delete_object_hash_map(_In_ _Post_invalid_ ebpf_core_map_t* map)
 {
@@ -1468,7 +1672,12 @@ _reap_oldest_map_entry(_Inout_ ebpf_core_map_t* map)
         // Attempt to delete the entry from the cold list.
         // This may fail if the entry has already been freed, but that's okay as the caller will
         // attempt to reap again if the next insert fails.
-        (void)_delete_hash_map_entry(map, EBPF_LRU_ENTRY_KEY_PTR(lru_map, entry));
+        if (_delete_hash_map_entry(map, EBPF_LRU_ENTRY_KEY_PTR(lru_map, entry)) == EBPF_SUCCESS) {
+            ebpf_map_statistics_t* statistics = _ebpf_map_current_cpu_statistics(map);
+            if (statistics) {
+                statistics->eviction_count++;
+            }
+        }
     }
 }
 
@@ -1886,6 +2095,30 @@ _update_lpm_map_entry(
     return result;
 }
 
+static ebpf_result_t
+_replace_lpm_map_contents(_Inout_ ebpf_core_map_t* map, size_t record_count, _In_opt_ const uint8_t* records)
+{
+    ebpf_core_lpm_map_t* trie_map = EBPF_FROM_FIELD(ebpf_core_lpm_map_t, core_map, map);
+    size_t record_size = (size_t)map->ebpf_map_definition.key_size + map->ebpf_map_definition.value_size;
+
+    for (size_t index = 0; index < record_count; index++) {
+        if (*(uint32_t*)(records + index * record_size) > trie_map->max_prefix) {
+            return EBPF_INVALID_ARGUMENT;
+        }
+    }
+
+    // Mark the new prefix lengths before publishing so lookups in the new contents search them. Bits of prefix lengths
+    // that are no longer used are left set, as is done on delete.
+    for (size_t index = 0; index < record_count; index++) {
+        uint32_t prefix_length = *(uint32_t*)(records + index * record_size);
+        if (!ebpf_bitmap_test_bit((ebpf_bitmap_t*)trie_map->data, prefix_length)) {
+            ebpf_bitmap_set_bit((ebpf_bitmap_t*)trie_map->data, prefix_length, true);
+        }
+    }
+
+    return _replace_hash_map_contents(map, record_count, records);
+}
+
 static ebpf_result_t
 _create_queue_map(
     _In_ const ebpf_map_definition_in_memory_t* map_definition,
@@ -2189,6 +2422,194 @@ Exit:
     EBPF_RETURN_RESULT(result);
 }
 
+/**
+ * @brief Local storage attached to a program context through its ebpf_context_header_t. Each
+ * BPF_MAP_TYPE_SK_STORAGE map holds at most one element in it.
+ */
+typedef struct _ebpf_sk_storage
+{
+    ebpf_lock_t lock;
+    _Guarded_by_(lock) ebpf_list_entry_t elements;
+} ebpf_sk_storage_t;
+
+typedef struct _ebpf_sk_storage_element
+{
+    ebpf_list_entry_t entry;
+    ebpf_core_map_t* map; ///< Map that owns this element. The element holds a reference on it.
+    uint8_t value[1];
+} ebpf_sk_storage_element_t;
+
+static ebpf_result_t
+_create_sk_storage_map(
+    _In_ const ebpf_map_definition_in_memory_t* map_definition,
+    ebpf_handle_t inner_map_handle,
+    _Outptr_ ebpf_core_map_t** map)
+{
+    ebpf_result_t result;
+    ebpf_core_map_t* sk_storage_map = NULL;
+
+    EBPF_LOG_ENTRY();
+
+    *map = NULL;
+
+    // As on Linux, the key is a socket descriptor. The map itself holds no entries, as the storage is owned by the
+    // program contexts it is attached to.
+    if (inner_map_handle != ebpf_handle_invalid || map_definition->key_size != sizeof(uint32_t) ||
+        map_definition->max_entries != 0) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    sk_storage_map = ebpf_epoch_allocate_with_tag(sizeof(ebpf_core_map_t), EBPF_POOL_TAG_MAP);
+    if (sk_storage_map == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Exit;
+    }
+    memset(sk_storage_map, 0, sizeof(ebpf_core_map_t));
+
+    sk_storage_map->ebpf_map_definition = *map_definition;
+    *map = sk_storage_map;
+    result = EBPF_SUCCESS;
+
+Exit:
+    EBPF_RETURN_RESULT(result);
+}
+
+static void
+_delete_sk_storage_map(_In_ _Post_invalid_ ebpf_core_map_t* map)
+{
+    // Every element holds a reference on its map, so none are left by the time the map is deleted.
+    ebpf_epoch_free(map);
+}
+
+static void
+_ebpf_sk_storage_free_element(_In_ _Post_invalid_ ebpf_sk_storage_element_t* element)
+{
+    EBPF_OBJECT_RELEASE_REFERENCE(&element->map->object);
+    ebpf_epoch_free(element);
+}
+
+static void
+_ebpf_sk_storage_free(_Inout_ ebpf_context_header_t* header)
+{
+    ebpf_sk_storage_t* storage = (ebpf_sk_storage_t*)header->storage;
+    if (storage == NULL) {
+        return;
+    }
+    header->storage = NULL;
+
+    // The extension frees the storage only once no program can be invoked with the context, so there is no need to
+    // take the lock. Programs that are still running in the current epoch keep their element pointers valid.
+    while (!ebpf_list_is_empty(&storage->elements)) {
+        ebpf_list_entry_t* entry = storage->elements.Flink;
+        ebpf_list_remove_entry(entry);
+        _ebpf_sk_storage_free_element(EBPF_FROM_FIELD(ebpf_sk_storage_element_t, entry, entry));
+    }
+    ebpf_lock_destroy(&storage->lock);
+    ebpf_epoch_free(storage);
+}
+
+static _Requires_lock_held_(storage->lock) ebpf_sk_storage_element_t* _ebpf_sk_storage_find_element(
+    _In_ const ebpf_sk_storage_t* storage, _In_ const ebpf_map_t* map)
+{
+    for (ebpf_list_entry_t* entry = storage->elements.Flink; entry != &storage->elements; entry = entry->Flink) {
+        ebpf_sk_storage_element_t* element = EBPF_FROM_FIELD(ebpf_sk_storage_element_t, entry, entry);
+        if (element->map == map) {
+            return element;
+        }
+    }
+    return NULL;
+}
+
+_Must_inspect_result_ _Ret_maybenull_ uint8_t*
+ebpf_map_get_sk_storage(
+    _In_ const ebpf_map_t* map, _Inout_ ebpf_context_header_t* header, _In_opt_ const uint8_t* value, uint64_t flags)
+{
+    ebpf_sk_storage_element_t* element = NULL;
+    ebpf_sk_storage_t* storage = NULL;
+    const bool create = (flags & BPF_SK_STORAGE_GET_F_CREATE) != 0;
+
+    if (map->ebpf_map_definition.type != BPF_MAP_TYPE_SK_STORAGE || (flags & ~BPF_SK_STORAGE_GET_F_CREATE) != 0) {
+        return NULL;
+    }
+
+    storage = (ebpf_sk_storage_t*)ReadPointerNoFence((void* const volatile*)&header->storage);
+    if (storage == NULL) {
+        if (!create) {
+            return NULL;
+        }
+
+        ebpf_sk_storage_t* new_storage = ebpf_epoch_allocate_with_tag(sizeof(ebpf_sk_storage_t), EBPF_POOL_TAG_MAP);
+        if (new_storage == NULL) {
+            return NULL;
+        }
+        ebpf_lock_create(&new_storage->lock);
+        ebpf_list_initialize(&new_storage->elements);
+
+        // Programs may run concurrently with the same context, so only one of them gets to install the storage.
+        header->free_storage = _ebpf_sk_storage_free;
+        storage = (ebpf_sk_storage_t*)ebpf_interlocked_compare_exchange_pointer(
+            (void* volatile*)&header->storage, new_storage, NULL);
+        if (storage == NULL) {
+            storage = new_storage;
+        } else {
+            ebpf_lock_destroy(&new_storage->lock);
+            ebpf_epoch_free(new_storage);
+        }
+    }
+
+    ebpf_lock_state_t state = ebpf_lock_lock(&storage->lock);
+    element = _ebpf_sk_storage_find_element(storage, map);
+    if (element == NULL && create) {
+        size_t value_size = map->ebpf_map_definition.value_size;
+        element = ebpf_epoch_allocate_with_tag(
+            EBPF_OFFSET_OF(ebpf_sk_storage_element_t, value) + value_size, EBPF_POOL_TAG_MAP);
+        if (element != NULL) {
+            // Keep the map alive while the element exists, so that deleting the map can't strand its elements.
+            element->map = (ebpf_core_map_t*)map;
+            EBPF_OBJECT_ACQUIRE_REFERENCE(&element->map->object);
+            if (value != NULL) {
+                memcpy(element->value, value, value_size);
+            } else {
+                memset(element->value, 0, value_size);
+            }
+            ebpf_list_insert_tail(&storage->elements, &element->entry);
+        }
+    }
+    ebpf_lock_unlock(&storage->lock, state);
+
+    return (element != NULL) ? element->value : NULL;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_delete_sk_storage(_In_ const ebpf_map_t* map, _Inout_ ebpf_context_header_t* header)
+{
+    ebpf_sk_storage_element_t* element = NULL;
+
+    if (map->ebpf_map_definition.type != BPF_MAP_TYPE_SK_STORAGE) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    ebpf_sk_storage_t* storage = (ebpf_sk_storage_t*)ReadPointerNoFence((void* const volatile*)&header->storage);
+    if (storage == NULL) {
+        return EBPF_KEY_NOT_FOUND;
+    }
+
+    ebpf_lock_state_t state = ebpf_lock_lock(&storage->lock);
+    element = _ebpf_sk_storage_find_element(storage, map);
+    if (element != NULL) {
+        ebpf_list_remove_entry(&element->entry);
+    }
+    ebpf_lock_unlock(&storage->lock, state);
+
+    if (element == NULL) {
+        return EBPF_KEY_NOT_FOUND;
+    }
+
+    _ebpf_sk_storage_free_element(element);
+    return EBPF_SUCCESS;
+}
+
 const ebpf_map_metadata_table_t ebpf_map_metadata_tables[] = {
     {
         BPF_MAP_TYPE_UNSPEC,
@@ -2202,15 +2623,17 @@ const ebpf_map_metadata_table_t ebpf_map_metadata_tables[] = {
         .update_entry = _update_hash_map_entry,
         .delete_entry = _delete_hash_map_entry,
         .next_key_and_value = _next_hash_map_key_and_value,
+        .replace_contents = _replace_hash_map_contents,
     },
     {
         .map_type = BPF_MAP_TYPE_ARRAY,
         .create_map = _create_array_map,
-        .delete_map = _delete_array_map,
+        .delete_map = _delete_replaceable_array_map,
         .find_entry = _find_array_map_entry,
         .update_entry = _update_array_map_entry,
         .delete_entry = _delete_array_map_entry,
         .next_key_and_value = _next_array_map_key_and_value,
+        .replace_contents = _replace_array_map_contents,
     },
     {
         .map_type = BPF_MAP_TYPE_PROG_ARRAY,
@@ -2232,17 +2655,19 @@ const ebpf_map_metadata_table_t ebpf_map_metadata_tables[] = {
         .update_entry_per_cpu = _update_entry_per_cpu,
         .delete_entry = _delete_hash_map_entry,
         .next_key_and_value = _next_hash_map_key_and_value,
+        .replace_contents = _replace_hash_map_contents,
         .per_cpu = true,
     },
     {
         .map_type = BPF_MAP_TYPE_PERCPU_ARRAY,
         .create_map = _create_array_map,
-        .delete_map = _delete_array_map,
+        .delete_map = _delete_replaceable_array_map,
         .find_entry = _find_array_map_entry,
         .update_entry = _update_array_map_entry,
         .update_entry_per_cpu = _update_entry_per_cpu,
         .delete_entry = _delete_array_map_entry,
         .next_key_and_value = _next_array_map_key_and_value,
+        .replace_contents = _replace_array_map_contents,
         .per_cpu = true,
     },
     {
@@ -2284,6 +2709,7 @@ const ebpf_map_metadata_table_t ebpf_map_metadata_tables[] = {
         .update_entry = _update_lpm_map_entry,
         .delete_entry = _delete_lpm_map_entry,
         .next_key_and_value = _next_hash_map_key_and_value,
+        .replace_contents = _replace_lpm_map_contents,
     },
     {
         .map_type = BPF_MAP_TYPE_QUEUE,
@@ -2320,25 +2746,208 @@ const ebpf_map_metadata_table_t ebpf_map_metadata_tables[] = {
         .zero_length_key = true,
         .zero_length_value = true,
     },
+    {
+        .map_type = BPF_MAP_TYPE_SK_STORAGE,
+        .create_map = _create_sk_storage_map,
+        .delete_map = _delete_sk_storage_map,
+        .zero_max_entries = true,
+    },
 };
 
+static void
+_ebpf_map_free_staged_chunks(_Inout_ ebpf_list_entry_t* staged_chunks)
+{
+    while (!ebpf_list_is_empty(staged_chunks)) {
+        ebpf_list_entry_t* entry = ebpf_list_remove_head_entry(staged_chunks);
+        ebpf_free(EBPF_FROM_FIELD(ebpf_map_staged_chunk_t, list_entry, entry));
+    }
+}
+
+/**
+ * @brief Move all staged chunks of a map to another list and reset the staged record count.
+ *
+ * @param[in, out] map Map whose staged chunks are taken. The caller must hold the staging lock.
+ * @param[out] staged_chunks List that receives the staged chunks.
+ * @return Count of records in the chunks.
+ */
+static size_t
+_ebpf_map_take_staged_chunks(_Inout_ ebpf_map_t* map, _Out_ ebpf_list_entry_t* staged_chunks)
+{
+    size_t record_count = map->staged_record_count;
+    ebpf_list_initialize(staged_chunks);
+    while (!ebpf_list_is_empty(&map->staged_chunks)) {
+        ebpf_list_insert_tail(staged_chunks, ebpf_list_remove_head_entry(&map->staged_chunks));
+    }
+    map->staged_record_count = 0;
+    return record_count;
+}
+
 static void
 _ebpf_map_delete(_In_ _Post_invalid_ ebpf_core_object_t* object)
 {
     EBPF_LOG_ENTRY();
     ebpf_map_t* map = (ebpf_map_t*)object;
 
+    _ebpf_map_free_staged_chunks(&map->staged_chunks);
+    ebpf_lock_destroy(&map->staging_lock);
+    ebpf_lock_destroy(&map->replica_lock);
+    ebpf_epoch_free(map->statistics);
     ebpf_free(map->name.value);
+    if (map->replicas != NULL) {
+        for (uint32_t node = 0; node < map->replica_count; node++) {
+            if (map->replicas[node] != NULL && map->replicas[node] != map) {
+                ebpf_map_metadata_tables[map->ebpf_map_definition.type].delete_map(map->replicas[node]);
+            }
+        }
+        ebpf_free(map->replicas);
+    }
     ebpf_map_metadata_tables[map->ebpf_map_definition.type].delete_map(map);
     EBPF_RETURN_VOID();
 }
 
+/**
+ * @brief Create the storage of a map while running on a CPU of the given NUMA node, so that the memory allocated by
+ * the map type is local to that node. Placement is best effort: if the thread cannot be moved to the node, the
+ * storage is created on the current node instead.
+ *
+ * @param[in] table Metadata table of the map type.
+ * @param[in] map_definition Definition of the map.
+ * @param[in] inner_map_handle Handle to inner map, or ebpf_handle_invalid if none.
+ * @param[in] numa_node NUMA node to allocate the map on.
+ * @param[out] map Pointer to memory that will contain the map on success.
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_NO_MEMORY Unable to allocate resources for this map.
+ */
+static ebpf_result_t
+_ebpf_map_create_on_numa_node(
+    _In_ const ebpf_map_metadata_table_t* table,
+    _In_ const ebpf_map_definition_in_memory_t* map_definition,
+    ebpf_handle_t inner_map_handle,
+    uint32_t numa_node,
+    _Outptr_ ebpf_core_map_t** map)
+{
+    ebpf_result_t result;
+    GROUP_AFFINITY old_thread_affinity;
+
+    if (ebpf_set_current_thread_numa_node(numa_node, &old_thread_affinity) != EBPF_SUCCESS) {
+        return table->create_map(map_definition, inner_map_handle, map);
+    }
+
+    result = table->create_map(map_definition, inner_map_handle, map);
+    ebpf_restore_current_thread_group_affinity(&old_thread_affinity);
+    return result;
+}
+
+/**
+ * @brief Apply an update to every replica of a replicated map. If a replica fails to update, the replicas that were
+ * already updated are rolled back to the previous value, or have the key removed if it didn't exist before.
+ *
+ * @param[in, out] map Replicated map to update.
+ * @param[in] key Key to update.
+ * @param[in] value Value to store.
+ * @param[in] option Update option.
+ * @return Result of the update.
+ */
+static ebpf_result_t
+_ebpf_map_update_replicas(
+    _Inout_ ebpf_core_map_t* map, _In_ const uint8_t* key, _In_ const uint8_t* value, ebpf_map_option_t option)
+{
+    const ebpf_map_metadata_table_t* table = &ebpf_map_metadata_tables[map->ebpf_map_definition.type];
+    size_t value_size = map->ebpf_map_definition.value_size;
+    ebpf_result_t result = EBPF_SUCCESS;
+    uint8_t* current_value = NULL;
+    bool previous_value_found = false;
+    uint32_t updated_count = 0;
+
+    // Allocate the copy of the previous value before acquiring the lock.
+    uint8_t* previous_value = (uint8_t*)ebpf_allocate_with_tag(value_size, EBPF_POOL_TAG_MAP);
+    if (previous_value == NULL) {
+        return EBPF_NO_MEMORY;
+    }
+
+    ebpf_lock_state_t state = ebpf_lock_lock(&map->replica_lock);
+
+    // All replicas hold the same contents, so the first one has the value to restore on failure.
+    if (table->find_entry(map->replicas[0], key, false, &current_value) == EBPF_SUCCESS && current_value != NULL) {
+        memcpy(previous_value, current_value, value_size);
+        previous_value_found = true;
+    }
+
+    for (uint32_t node = 0; node < map->replica_count; node++) {
+        result = table->update_entry(map->replicas[node], key, value, option);
+        if (result != EBPF_SUCCESS) {
+            break;
+        }
+        updated_count++;
+    }
+
+    if (result != EBPF_SUCCESS && updated_count > 0) {
+        bool rollback_failed = false;
+        for (uint32_t node = 0; node < updated_count; node++) {
+            ebpf_result_t rollback_result;
+            if (previous_value_found) {
+                rollback_result = table->update_entry(map->replicas[node], key, previous_value, EBPF_ANY);
+            } else {
+                rollback_result = table->delete_entry(map->replicas[node], key);
+            }
+            if (rollback_result != EBPF_SUCCESS) {
+                rollback_failed = true;
+            }
+        }
+
+        // Restoring a hash entry allocates and can fail too. Remove the key from every replica in that case, so that
+        // lookups never observe different values on different nodes.
+        if (rollback_failed) {
+            for (uint32_t node = 0; node < map->replica_count; node++) {
+                (void)table->delete_entry(map->replicas[node], key);
+            }
+        }
+    }
+
+    ebpf_lock_unlock(&map->replica_lock, state);
+    ebpf_free(previous_value);
+    return result;
+}
+
+/**
+ * @brief Delete a key from every replica of a replicated map.
+ *
+ * @param[in, out] map Replicated map to update.
+ * @param[in] key Key to delete.
+ * @return Result of the deletion from the first replica.
+ */
+static ebpf_result_t
+_ebpf_map_delete_replicas(_Inout_ ebpf_core_map_t* map, _In_ const uint8_t* key)
+{
+    const ebpf_map_metadata_table_t* table = &ebpf_map_metadata_tables[map->ebpf_map_definition.type];
+
+    ebpf_lock_state_t state = ebpf_lock_lock(&map->replica_lock);
+    ebpf_result_t result = table->delete_entry(map->replicas[0], key);
+    for (uint32_t node = 1; node < map->replica_count; node++) {
+        (void)table->delete_entry(map->replicas[node], key);
+    }
+    ebpf_lock_unlock(&map->replica_lock, state);
+    return result;
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_map_create(
     _In_ const cxplat_utf8_string_t* map_name,
     _In_ const ebpf_map_definition_in_memory_t* ebpf_map_definition,
     ebpf_handle_t inner_map_handle,
     _Outptr_ ebpf_map_t** ebpf_map)
+{
+    return ebpf_map_create_with_flags(map_name, ebpf_map_definition, inner_map_handle, 0, 0, ebpf_map);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_create_with_flags(
+    _In_ const cxplat_utf8_string_t* map_name,
+    _In_ const ebpf_map_definition_in_memory_t* ebpf_map_definition,
+    ebpf_handle_t inner_map_handle,
+    uint32_t map_flags,
+    uint32_t numa_node,
+    _Outptr_ ebpf_map_t** ebpf_map)
 {
     EBPF_LOG_ENTRY();
     ebpf_map_t* local_map = NULL;
@@ -2346,8 +2955,14 @@ ebpf_map_create(
     ebpf_result_t result = EBPF_SUCCESS;
     uint32_t cpu_count;
     cpu_count = ebpf_get_cpu_count();
+    uint32_t node_count = ebpf_get_numa_node_count();
     ebpf_map_definition_in_memory_t local_map_definition = *ebpf_map_definition;
 
+    // Without an explicit node, the map itself is placed on the first node.
+    if (!(map_flags & BPF_F_NUMA_NODE)) {
+        numa_node = 0;
+    }
+
     if (type >= EBPF_COUNT_OF(ebpf_map_metadata_tables)) {
         EBPF_LOG_MESSAGE_UINT64(EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_MAP, "Unsupported map type", type);
         result = EBPF_INVALID_ARGUMENT;
@@ -2365,7 +2980,7 @@ ebpf_map_create(
         result = EBPF_INVALID_ARGUMENT;
         goto Exit;
     }
-    if (ebpf_map_definition->max_entries == 0) {
+    if (ebpf_map_definition->max_entries == 0 && !(ebpf_map_metadata_tables[type].zero_max_entries)) {
         result = EBPF_INVALID_ARGUMENT;
         goto Exit;
     }
@@ -2387,12 +3002,69 @@ ebpf_map_create(
         goto Exit;
     }
 
-    result = ebpf_map_metadata_tables[type].create_map(&local_map_definition, inner_map_handle, &local_map);
+    if ((map_flags & ~(BPF_F_NUMA_NODE | BPF_F_NUMA_REPLICATED)) != 0) {
+        EBPF_LOG_MESSAGE_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_MAP, "Unsupported map flags", map_flags);
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    if ((map_flags & BPF_F_NUMA_NODE) && numa_node >= node_count) {
+        EBPF_LOG_MESSAGE_UINT64(EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_MAP, "Invalid NUMA node", numa_node);
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    // Only maps whose contents are fully described by key and value can be replicated.
+    if ((map_flags & BPF_F_NUMA_REPLICATED) && type != BPF_MAP_TYPE_ARRAY && type != BPF_MAP_TYPE_HASH) {
+        EBPF_LOG_MESSAGE_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR, EBPF_TRACELOG_KEYWORD_MAP, "Replication not supported on map", type);
+        result = EBPF_OPERATION_NOT_SUPPORTED;
+        goto Exit;
+    }
+
+    if (map_flags & (BPF_F_NUMA_NODE | BPF_F_NUMA_REPLICATED)) {
+        result = _ebpf_map_create_on_numa_node(
+            &ebpf_map_metadata_tables[type], &local_map_definition, inner_map_handle, numa_node, &local_map);
+    } else {
+        result = ebpf_map_metadata_tables[type].create_map(&local_map_definition, inner_map_handle, &local_map);
+    }
     if (result != EBPF_SUCCESS) {
         goto Exit;
     }
 
+    ebpf_lock_create(&local_map->staging_lock);
+    ebpf_list_initialize(&local_map->staged_chunks);
+    local_map->staged_record_count = 0;
     local_map->original_value_size = ebpf_map_definition->value_size;
+    local_map->map_flags = map_flags;
+    ebpf_lock_create(&local_map->replica_lock);
+
+    // The map itself serves as the replica of its own node. A single node system needs no other replica.
+    if ((map_flags & BPF_F_NUMA_REPLICATED) && node_count > 1) {
+        local_map->replicas =
+            (ebpf_core_map_t**)ebpf_allocate_with_tag(node_count * sizeof(ebpf_core_map_t*), EBPF_POOL_TAG_MAP);
+        if (local_map->replicas == NULL) {
+            result = EBPF_NO_MEMORY;
+            goto Exit;
+        }
+        local_map->replica_count = node_count;
+        for (uint32_t node = 0; node < node_count; node++) {
+            if (node == numa_node) {
+                local_map->replicas[node] = local_map;
+                continue;
+            }
+            result = _ebpf_map_create_on_numa_node(
+                &ebpf_map_metadata_tables[type],
+                &local_map_definition,
+                inner_map_handle,
+                node,
+                &local_map->replicas[node]);
+            if (result != EBPF_SUCCESS) {
+                goto Exit;
+            }
+        }
+    }
 
     result = ebpf_duplicate_utf8_string(&local_map->name, map_name);
     if (result != EBPF_SUCCESS) {
@@ -2457,6 +3129,11 @@ ebpf_map_find_entry(
         return EBPF_OPERATION_NOT_SUPPORTED;
     }
 
+    ebpf_map_statistics_t* statistics = _ebpf_map_current_cpu_statistics(map);
+    if (statistics) {
+        statistics->lookup_count++;
+    }
+
     ebpf_map_type_t type = map->ebpf_map_definition.type;
     if ((flags & EBPF_MAP_FLAG_HELPER) && (ebpf_map_metadata_tables[type].get_object_from_entry != NULL)) {
 
@@ -2472,15 +3149,26 @@ ebpf_map_find_entry(
             return_value = (uint8_t*)object;
         }
     } else {
+        // A replicated map is read from the replica of the current node and deletes from every replica below.
+        bool delete_on_success = (flags & EBPF_MAP_FIND_FLAG_DELETE) && map->replicas == NULL;
         ebpf_result_t result = ebpf_map_metadata_tables[map->ebpf_map_definition.type].find_entry(
-            map, key, flags & EBPF_MAP_FIND_FLAG_DELETE ? true : false, &return_value);
+            _ebpf_map_local_replica(map), key, delete_on_success, &return_value);
         if (result != EBPF_SUCCESS) {
+            if (statistics) {
+                statistics->lookup_miss_count++;
+            }
             return result;
         }
     }
     if (return_value == NULL) {
+        if (statistics) {
+            statistics->lookup_miss_count++;
+        }
         return EBPF_OBJECT_NOT_FOUND;
     }
+    if (statistics && (flags & EBPF_MAP_FIND_FLAG_DELETE)) {
+        statistics->delete_count++;
+    }
 
     if (flags & EBPF_MAP_FLAG_HELPER) {
         if (_ebpf_adjust_value_pointer(map, &return_value) != EBPF_SUCCESS) {
@@ -2491,9 +3179,198 @@ ebpf_map_find_entry(
     } else {
         memcpy(value, return_value, map->ebpf_map_definition.value_size);
     }
+
+    if ((flags & EBPF_MAP_FIND_FLAG_DELETE) && map->replicas != NULL) {
+        (void)_ebpf_map_delete_replicas(map, key);
+    }
+
+    // A lookup-and-delete from user mode changes the map contents just like a delete, so cached verdicts are stale.
+    if ((flags & EBPF_MAP_FIND_FLAG_DELETE) && !(flags & EBPF_MAP_FLAG_HELPER)) {
+        ebpf_program_increment_state_generation();
+    }
+    return EBPF_SUCCESS;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_find_entry_batch(
+    _Inout_ ebpf_map_t* map,
+    size_t key_count,
+    size_t key_size,
+    _In_reads_bytes_(key_count* key_size) const uint8_t* keys,
+    size_t value_size,
+    _Out_writes_bytes_(key_count* value_size) uint8_t* values,
+    _Out_writes_(key_count) ebpf_result_t* results,
+    int flags)
+{
+    // High volume call - Skip entry/exit logging.
+    if (key_size != map->ebpf_map_definition.key_size || value_size != map->ebpf_map_definition.value_size) {
+        EBPF_LOG_MESSAGE_UINT64_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_MAP,
+            "Incorrect map key or value size",
+            key_size,
+            value_size);
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    if (ebpf_map_metadata_tables[map->ebpf_map_definition.type].find_entry == NULL) {
+        EBPF_LOG_MESSAGE_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_MAP,
+            "ebpf_map_find_entry_batch not supported on map",
+            map->ebpf_map_definition.type);
+        return EBPF_OPERATION_NOT_SUPPORTED;
+    }
+
+    // The caller is expected to be in an epoch, so the whole batch is read under a single epoch.
+    for (size_t index = 0; index < key_count; index++) {
+        uint8_t* value = values + index * value_size;
+        results[index] = ebpf_map_find_entry(
+            map, key_size, keys + index * key_size, value_size, value, flags & EBPF_MAP_FIND_FLAG_DELETE);
+        if (results[index] != EBPF_SUCCESS) {
+            memset(value, 0, value_size);
+        }
+    }
+
     return EBPF_SUCCESS;
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_stage_contents(
+    _Inout_ ebpf_map_t* map,
+    bool reset,
+    size_t records_length,
+    _In_reads_bytes_opt_(records_length) const uint8_t* records)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    ebpf_map_staged_chunk_t* chunk = NULL;
+    size_t record_size = (size_t)map->ebpf_map_definition.key_size + map->ebpf_map_definition.value_size;
+    size_t record_count = records_length / record_size;
+    ebpf_list_entry_t discarded_chunks;
+    ebpf_lock_state_t state;
+    ebpf_list_initialize(&discarded_chunks);
+
+    // Replicated maps are not replaced as a whole, since the replicas could not be swapped atomically together.
+    if (ebpf_map_metadata_tables[map->ebpf_map_definition.type].replace_contents == NULL || map->replicas != NULL) {
+        EBPF_LOG_MESSAGE_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_MAP,
+            "ebpf_map_stage_contents not supported on map",
+            map->ebpf_map_definition.type);
+        result = EBPF_OPERATION_NOT_SUPPORTED;
+        goto Done;
+    }
+
+    if (records_length % record_size != 0) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    // Copy the records before acquiring the lock.
+    if (record_count > 0) {
+        size_t chunk_size;
+        result = ebpf_safe_size_t_add(EBPF_OFFSET_OF(ebpf_map_staged_chunk_t, records), records_length, &chunk_size);
+        if (result != EBPF_SUCCESS) {
+            goto Done;
+        }
+        chunk = (ebpf_map_staged_chunk_t*)ebpf_allocate_with_tag(chunk_size, EBPF_POOL_TAG_MAP);
+        if (chunk == NULL) {
+            result = EBPF_NO_MEMORY;
+            goto Done;
+        }
+        chunk->record_count = record_count;
+        memcpy(chunk->records, records, records_length);
+    }
+
+    state = ebpf_lock_lock(&map->staging_lock);
+    if (reset) {
+        (void)_ebpf_map_take_staged_chunks(map, &discarded_chunks);
+    }
+    if (map->staged_record_count + record_count > map->ebpf_map_definition.max_entries) {
+        result = EBPF_OUT_OF_SPACE;
+    } else {
+        if (chunk != NULL) {
+            ebpf_list_insert_tail(&map->staged_chunks, &chunk->list_entry);
+            map->staged_record_count += record_count;
+            chunk = NULL;
+        }
+        result = EBPF_SUCCESS;
+    }
+    ebpf_lock_unlock(&map->staging_lock, state);
+
+Done:
+    _ebpf_map_free_staged_chunks(&discarded_chunks);
+    ebpf_free(chunk);
+    EBPF_RETURN_RESULT(result);
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_publish_staged_contents(_Inout_ ebpf_map_t* map, size_t expected_record_count)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result;
+    ebpf_list_entry_t staged_chunks;
+    size_t record_count;
+    size_t record_size = (size_t)map->ebpf_map_definition.key_size + map->ebpf_map_definition.value_size;
+    uint8_t* records = NULL;
+    ebpf_lock_state_t state;
+
+    ebpf_list_initialize(&staged_chunks);
+
+    // Replicated maps are not replaced as a whole, since the replicas could not be swapped atomically together.
+    if (ebpf_map_metadata_tables[map->ebpf_map_definition.type].replace_contents == NULL || map->replicas != NULL) {
+        EBPF_LOG_MESSAGE_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_MAP,
+            "ebpf_map_publish_staged_contents not supported on map",
+            map->ebpf_map_definition.type);
+        result = EBPF_OPERATION_NOT_SUPPORTED;
+        goto Done;
+    }
+
+    state = ebpf_lock_lock(&map->staging_lock);
+    record_count = _ebpf_map_take_staged_chunks(map, &staged_chunks);
+    ebpf_lock_unlock(&map->staging_lock, state);
+
+    // A mismatch means another caller staged records for this map concurrently.
+    if (record_count != expected_record_count) {
+        EBPF_LOG_MESSAGE_UINT64_UINT64(
+            EBPF_TRACELOG_LEVEL_ERROR,
+            EBPF_TRACELOG_KEYWORD_MAP,
+            "Staged record count mismatch",
+            record_count,
+            expected_record_count);
+        result = EBPF_INVALID_ARGUMENT;
+        goto Done;
+    }
+
+    // Gather the staged chunks into a single buffer for the bulk build.
+    if (record_count > 0) {
+        records = (uint8_t*)ebpf_allocate_with_tag(record_count * record_size, EBPF_POOL_TAG_MAP);
+        if (records == NULL) {
+            result = EBPF_NO_MEMORY;
+            goto Done;
+        }
+        uint8_t* next_record = records;
+        for (ebpf_list_entry_t* entry = staged_chunks.Flink; entry != &staged_chunks; entry = entry->Flink) {
+            ebpf_map_staged_chunk_t* chunk = EBPF_FROM_FIELD(ebpf_map_staged_chunk_t, list_entry, entry);
+            memcpy(next_record, chunk->records, chunk->record_count * record_size);
+            next_record += chunk->record_count * record_size;
+        }
+    }
+
+    result = ebpf_map_metadata_tables[map->ebpf_map_definition.type].replace_contents(map, record_count, records);
+    if (result == EBPF_SUCCESS) {
+        ebpf_program_increment_state_generation();
+    }
+
+Done:
+    ebpf_free(records);
+    _ebpf_map_free_staged_chunks(&staged_chunks);
+    EBPF_RETURN_RESULT(result);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_map_associate_program(_Inout_ ebpf_map_t* map, _In_ const ebpf_program_t* program)
 {
@@ -2586,9 +3463,25 @@ ebpf_map_update_entry(
     if ((flags & EBPF_MAP_FLAG_HELPER) &&
         ebpf_map_metadata_tables[map->ebpf_map_definition.type].update_entry_per_cpu) {
         result = ebpf_map_metadata_tables[map->ebpf_map_definition.type].update_entry_per_cpu(map, key, value, option);
+    } else if (map->replicas != NULL) {
+        result = _ebpf_map_update_replicas(map, key, value, option);
     } else {
         result = ebpf_map_metadata_tables[map->ebpf_map_definition.type].update_entry(map, key, value, option);
     }
+
+    ebpf_map_statistics_t* statistics = _ebpf_map_current_cpu_statistics(map);
+    if (statistics) {
+        if (result == EBPF_SUCCESS) {
+            statistics->update_count++;
+        } else if (result == EBPF_NO_MEMORY || result == EBPF_OUT_OF_SPACE) {
+            statistics->allocation_failure_count++;
+        }
+    }
+
+    // Updates made by programs are part of their own behavior; only user mode updates invalidate cached verdicts.
+    if (result == EBPF_SUCCESS && !(flags & EBPF_MAP_FLAG_HELPER)) {
+        ebpf_program_increment_state_generation();
+    }
     return result;
 }
 
@@ -2619,8 +3512,12 @@ ebpf_map_update_entry_with_handle(
             map->ebpf_map_definition.type);
         return EBPF_OPERATION_NOT_SUPPORTED;
     }
-    return ebpf_map_metadata_tables[map->ebpf_map_definition.type].update_entry_with_handle(
+    ebpf_result_t result = ebpf_map_metadata_tables[map->ebpf_map_definition.type].update_entry_with_handle(
         map, key, value_handle, option);
+    if (result == EBPF_SUCCESS) {
+        ebpf_program_increment_state_generation();
+    }
+    return result;
 }
 
 _Must_inspect_result_ ebpf_result_t
@@ -2646,7 +3543,17 @@ ebpf_map_delete_entry(_In_ ebpf_map_t* map, size_t key_size, _In_reads_(key_size
         return EBPF_OPERATION_NOT_SUPPORTED;
     }
 
-    ebpf_result_t result = ebpf_map_metadata_tables[map->ebpf_map_definition.type].delete_entry(map, key);
+    ebpf_result_t result = (map->replicas != NULL)
+                               ? _ebpf_map_delete_replicas(map, key)
+                               : ebpf_map_metadata_tables[map->ebpf_map_definition.type].delete_entry(map, key);
+
+    ebpf_map_statistics_t* statistics = _ebpf_map_current_cpu_statistics(map);
+    if (statistics && result == EBPF_SUCCESS) {
+        statistics->delete_count++;
+    }
+    if (result == EBPF_SUCCESS && !(flags & EBPF_MAP_FLAG_HELPER)) {
+        ebpf_program_increment_state_generation();
+    }
     return result;
 }
 
@@ -2679,6 +3586,52 @@ ebpf_map_next_key(
         map, previous_key, next_key, NULL);
 }
 
+/**
+ * @brief Fill in the access statistics of a map info structure.
+ *
+ * @param[in] map Map to query.
+ * @param[in, out] info Map info to update.
+ */
+static void
+_ebpf_map_get_statistics(_In_ const ebpf_core_map_t* map, _Inout_ struct bpf_map_info* info)
+{
+    info->entry_count = 0;
+    info->longest_bucket_length = 0;
+    info->lookup_count = 0;
+    info->lookup_miss_count = 0;
+    info->update_count = 0;
+    info->delete_count = 0;
+    info->eviction_count = 0;
+    info->allocation_failure_count = 0;
+
+    uint8_t* statistics = (uint8_t*)ReadPointerNoFence((void* const volatile*)&map->statistics);
+    if (statistics == NULL) {
+        return;
+    }
+    info->map_flags |= BPF_F_STATISTICS;
+
+    const ebpf_map_statistics_t* per_cpu_statistics =
+        (const ebpf_map_statistics_t*)EBPF_CACHE_ALIGN_POINTER(statistics);
+    uint32_t cpu_count = ebpf_get_cpu_count();
+    for (uint32_t cpu_index = 0; cpu_index < cpu_count; cpu_index++) {
+        info->lookup_count += per_cpu_statistics[cpu_index].lookup_count;
+        info->lookup_miss_count += per_cpu_statistics[cpu_index].lookup_miss_count;
+        info->update_count += per_cpu_statistics[cpu_index].update_count;
+        info->delete_count += per_cpu_statistics[cpu_index].delete_count;
+        info->eviction_count += per_cpu_statistics[cpu_index].eviction_count;
+        info->allocation_failure_count += per_cpu_statistics[cpu_index].allocation_failure_count;
+    }
+
+    // Hash based maps also report how full they are and how well their keys are distributed.
+    ebpf_map_type_t type = map->ebpf_map_definition.type;
+    if (ebpf_map_metadata_tables[type].delete_map == _delete_hash_map ||
+        ebpf_map_metadata_tables[type].delete_map == _delete_object_hash_map) {
+        const ebpf_hash_table_t* hash_table = (const ebpf_hash_table_t*)map->data;
+        info->entry_count = (uint32_t)ebpf_hash_table_key_count(hash_table);
+        info->longest_bucket_length = (uint32_t)ebpf_hash_table_longest_bucket_length(hash_table);
+    }
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_map_get_info(
     _In_ const ebpf_map_t* map, _Out_writes_to_(*info_size, *info_size) uint8_t* buffer, _Inout_ uint16_t* info_size)
@@ -2701,7 +3654,7 @@ ebpf_map_get_info(
     info->key_size = map->ebpf_map_definition.key_size;
     info->value_size = map->original_value_size;
     info->max_entries = map->ebpf_map_definition.max_entries;
-    info->map_flags = 0;
+    info->map_flags = map->map_flags;
     if (info->type == BPF_MAP_TYPE_ARRAY_OF_MAPS || info->type == BPF_MAP_TYPE_HASH_OF_MAPS) {
         ebpf_core_object_map_t* object_map = EBPF_FROM_FIELD(ebpf_core_object_map_t, core_map, map);
         info->inner_map_id = object_map->core_map.ebpf_map_definition.inner_map_id
@@ -2712,11 +3665,48 @@ ebpf_map_get_info(
     }
     info->pinned_path_count = map->object.pinned_path_count;
     strncpy_s(info->name, sizeof(info->name), (char*)map->name.value, map->name.length);
+    _ebpf_map_get_statistics(map, info);
 
     *info_size = sizeof(*info);
     return EBPF_SUCCESS;
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_map_set_statistics_enabled(_Inout_ ebpf_map_t* map, bool enabled)
+{
+    EBPF_LOG_ENTRY();
+    uint8_t* statistics = NULL;
+
+    if (enabled) {
+        if (map->statistics != NULL) {
+            EBPF_RETURN_RESULT(EBPF_SUCCESS);
+        }
+
+        // Over-allocate so that the per-CPU counters can start on a cache line.
+        size_t statistics_size = ebpf_get_cpu_count() * sizeof(ebpf_map_statistics_t) + EBPF_CACHE_LINE_SIZE - 1;
+        statistics = (uint8_t*)ebpf_epoch_allocate_with_tag(statistics_size, EBPF_POOL_TAG_MAP);
+        if (statistics == NULL) {
+            EBPF_RETURN_RESULT(EBPF_NO_MEMORY);
+        }
+        memset(statistics, 0, statistics_size);
+
+        if (ebpf_interlocked_compare_exchange_pointer((void* volatile*)&map->statistics, statistics, NULL) != NULL) {
+            // Statistics were concurrently enabled by another caller.
+            ebpf_epoch_free(statistics);
+        }
+    } else {
+        // Callers that already read the pointer may still be counting, so free it once the epoch ends.
+        statistics = map->statistics;
+        if (statistics != NULL &&
+            ebpf_interlocked_compare_exchange_pointer((void* volatile*)&map->statistics, NULL, statistics) ==
+                statistics) {
+            ebpf_epoch_free(statistics);
+        }
+    }
+
+    EBPF_RETURN_RESULT(EBPF_SUCCESS);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_map_push_entry(_Inout_ ebpf_map_t* map, size_t value_size, _In_reads_(value_size) const uint8_t* value, int flags)
 {
@@ -2810,6 +3800,7 @@ ebpf_map_get_next_key_and_value_batch(
     size_t value_size = map->ebpf_map_definition.value_size;
     size_t output_length = 0;
     size_t maximum_output_length = *key_and_value_length;
+    bool entries_deleted = false;
 
     if (ebpf_map_metadata_tables[map->ebpf_map_definition.type].next_key_and_value == NULL) {
         EBPF_LOG_MESSAGE_UINT64(
@@ -2865,6 +3856,7 @@ ebpf_map_get_next_key_and_value_batch(
             if (result != EBPF_SUCCESS) {
                 break;
             }
+            entries_deleted = true;
         }
 
         previous_key = key_and_value + output_length;
@@ -2880,5 +3872,9 @@ ebpf_map_get_next_key_and_value_batch(
 
     *key_and_value_length = output_length;
 
+    if (entries_deleted) {
+        ebpf_program_increment_state_generation();
+    }
+
     return result;
 }
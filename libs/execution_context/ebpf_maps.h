@@ -7,6 +7,7 @@
 #include "cxplat.h"
 #include "ebpf_core_structs.h"
 #include "ebpf_platform.h"
+#include "ebpf_program_types.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -36,6 +37,30 @@ extern "C"
         ebpf_handle_t inner_map_handle,
         _Outptr_ ebpf_map_t** map);
 
+    /**
+     * @brief Allocate a new map with placement flags.
+     *
+     * @param[in] map_name Name of the map.
+     * @param[in] ebpf_map_definition Definition of the new map.
+     * @param[in] inner_map_handle Handle to inner map, or ebpf_handle_invalid if none.
+     * @param[in] map_flags Combination of BPF_F_NUMA_NODE and BPF_F_NUMA_REPLICATED.
+     * @param[in] numa_node NUMA node to allocate the map on if map_flags contains BPF_F_NUMA_NODE.
+     * @param[out] map Pointer to memory that will contain the map on success.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The flags or NUMA node are not valid.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map type cannot be replicated.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this
+     *  map.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_create_with_flags(
+        _In_ const cxplat_utf8_string_t* map_name,
+        _In_ const ebpf_map_definition_in_memory_t* ebpf_map_definition,
+        ebpf_handle_t inner_map_handle,
+        uint32_t map_flags,
+        uint32_t numa_node,
+        _Outptr_ ebpf_map_t** map);
+
     /**
      * @brief Get a pointer to the map definition.
      *
@@ -192,6 +217,19 @@ extern "C"
         _Out_writes_to_(*info_size, *info_size) uint8_t* buffer,
         _Inout_ uint16_t* info_size);
 
+    /**
+     * @brief Enable or disable collection of access statistics on a map.
+     * Enabling statistics that are already enabled keeps the current counts,
+     * while disabling them discards the counts.
+     *
+     * @param[in, out] map Map to update.
+     * @param[in] enabled True to collect statistics, false to stop.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for the statistics.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_set_statistics_enabled(_Inout_ ebpf_map_t* map, bool enabled);
+
     /**
      * @brief Get pointer to the ring buffer map's shared data.
      *
@@ -300,6 +338,34 @@ extern "C"
     ebpf_id_t
     ebpf_map_get_id(_In_ const ebpf_map_t* map);
 
+    /**
+     * @brief Get the element a BPF_MAP_TYPE_SK_STORAGE map holds in the local storage of a program context.
+     *
+     * @param[in] map Map of type BPF_MAP_TYPE_SK_STORAGE.
+     * @param[in, out] header Header that precedes the program context.
+     * @param[in] value Optional initial value of the element if it is created.
+     * @param[in] flags BPF_SK_STORAGE_GET_F_CREATE to create the element if it does not exist.
+     * @returns Pointer to the value of the element, or NULL if it does not exist and could not be created.
+     */
+    _Must_inspect_result_ _Ret_maybenull_ uint8_t*
+    ebpf_map_get_sk_storage(
+        _In_ const ebpf_map_t* map,
+        _Inout_ ebpf_context_header_t* header,
+        _In_opt_ const uint8_t* value,
+        uint64_t flags);
+
+    /**
+     * @brief Delete the element a BPF_MAP_TYPE_SK_STORAGE map holds in the local storage of a program context.
+     *
+     * @param[in] map Map of type BPF_MAP_TYPE_SK_STORAGE.
+     * @param[in, out] header Header that precedes the program context.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_KEY_NOT_FOUND The program context holds no element for this map.
+     * @retval EBPF_INVALID_ARGUMENT The map is not of type BPF_MAP_TYPE_SK_STORAGE.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_delete_sk_storage(_In_ const ebpf_map_t* map, _Inout_ ebpf_context_header_t* header);
+
     /**
      * @brief Copy keys and values from the map to the caller provided buffer.
      *
@@ -323,6 +389,73 @@ extern "C"
         _Out_writes_bytes_to_(*key_and_value_length, *key_and_value_length) uint8_t* key_and_value,
         int flags);
 
+    /**
+     * @brief Find the values of a list of keys in the map.
+     *
+     * @param[in, out] map Map to search and update metadata on.
+     * @param[in] key_count Number of keys to find.
+     * @param[in] key_size Size of each key, which must match the map's key size.
+     * @param[in] keys Concatenation of key_count keys.
+     * @param[in] value_size Size of each value, which must match the map's value size.
+     * @param[out] values Buffer that receives key_count values. The value of a
+     *  key that was not found is zero filled.
+     * @param[out] results Result of the find operation for each key.
+     * @param[in] flags Zero or EBPF_MAP_FIND_FLAG_DELETE.
+     * @retval EBPF_SUCCESS The operation was successful. The result of each
+     *  individual key is reported in results.
+     * @retval EBPF_INVALID_ARGUMENT The key or value size is wrong.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map type does not support find.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_find_entry_batch(
+        _Inout_ ebpf_map_t* map,
+        size_t key_count,
+        size_t key_size,
+        _In_reads_bytes_(key_count* key_size) const uint8_t* keys,
+        size_t value_size,
+        _Out_writes_bytes_(key_count* value_size) uint8_t* values,
+        _Out_writes_(key_count) ebpf_result_t* results,
+        int flags);
+
+    /**
+     * @brief Stage key+value records to become the contents of the map on the
+     * next call to ebpf_map_publish_staged_contents.
+     *
+     * @param[in, out] map Map to stage records for.
+     * @param[in] reset Discard any previously staged records first.
+     * @param[in] records_length Length of records in bytes.
+     * @param[in] records Concatenation of key followed by value records.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT records_length is not a multiple of the record size.
+     * @retval EBPF_OUT_OF_SPACE More records are staged than the map can hold.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for the records.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map type does not support replacing contents.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_stage_contents(
+        _Inout_ ebpf_map_t* map,
+        bool reset,
+        size_t records_length,
+        _In_reads_bytes_opt_(records_length) const uint8_t* records);
+
+    /**
+     * @brief Atomically replace the contents of the map with the staged
+     * records. The new contents are built without modifying the map and then
+     * published in one step, so readers see either the old or the new contents.
+     * The old contents are freed when the current epoch ends. Staged records
+     * are consumed whether or not the operation succeeds.
+     *
+     * @param[in, out] map Map to replace the contents of.
+     * @param[in] expected_record_count Number of records the caller staged.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The number of staged records doesn't match
+     *  expected_record_count, or a record is not valid for the map.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for the new contents.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The map type does not support replacing contents.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_map_publish_staged_contents(_Inout_ ebpf_map_t* map, size_t expected_record_count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,9 @@ static const GUID GUID_NULL = {0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0}};
 
 typedef uint64_t (*helper_function_address)(uint64_t r1, uint64_t r2, uint64_t r3, uint64_t r4, uint64_t r5);
 
+// Maps are assigned an original id of their index in the module's map table plus this offset.
+#define EBPF_NATIVE_MAP_ORIGINAL_ID_OFFSET 1
+
 typedef struct _ebpf_native_map
 {
     map_entry_t* entry;
@@ -621,42 +624,103 @@ Done:
     EBPF_RETURN_RESULT(return_value);
 }
 
-static ebpf_native_map_t*
-_ebpf_native_get_next_map_to_create(_In_reads_(map_count) ebpf_native_map_t* maps, size_t map_count)
+typedef enum _ebpf_native_map_order_state
 {
+    MAP_ORDER_STATE_UNVISITED = 0,
+    MAP_ORDER_STATE_VISITING,
+    MAP_ORDER_STATE_ORDERED,
+} ebpf_native_map_order_state_t;
+
+/**
+ * @brief Compute an order in which the maps can be created such that every
+ * inner map template is created before the map-in-map that uses it. Each map
+ * depends on at most one other map, so the dependencies form chains that are
+ * each walked once, giving a single linear pass over the maps.
+ *
+ * @param[in] module_id Module the maps belong to, used for logging.
+ * @param[in, out] maps Maps to order. The inner_map field of each map-in-map
+ *  is resolved on success.
+ * @param[in] map_count Number of maps.
+ * @param[out] order Indices of the maps in creation order.
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_INVALID_OBJECT A map-in-map has no inner map template or the
+ *  templates form a cycle.
+ * @retval EBPF_NO_MEMORY Unable to allocate resources for this operation.
+ */
+static ebpf_result_t
+_ebpf_native_order_maps_for_creation(
+    _In_ const GUID* module_id,
+    _Inout_updates_(map_count) ebpf_native_map_t* maps,
+    size_t map_count,
+    _Out_writes_(map_count) uint32_t* order)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_result_t result = EBPF_SUCCESS;
+    uint8_t* state = NULL;
+    uint32_t* chain = NULL;
+    size_t ordered_count = 0;
+
+    state = (uint8_t*)ebpf_allocate_with_tag(map_count * sizeof(uint8_t), EBPF_POOL_TAG_NATIVE);
+    chain = (uint32_t*)ebpf_allocate_with_tag(map_count * sizeof(uint32_t), EBPF_POOL_TAG_NATIVE);
+    if (state == NULL || chain == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
     for (uint32_t i = 0; i < map_count; i++) {
-        ebpf_native_map_t* map = &maps[i];
-        if (map->handle != ebpf_handle_invalid) {
-            // Already created.
-            continue;
-        }
-        if (!_ebpf_native_is_map_in_map(map)) {
-            return map;
-        }
-        if (map->inner_map == NULL) {
-            // This map requires an inner map template, look up which one.
-            for (uint32_t j = 0; j < map_count; j++) {
-                ebpf_native_map_t* inner_map = &maps[j];
-                if (inner_map->original_id == map->inner_map_original_id) {
-                    map->inner_map = inner_map;
-                    break;
-                }
+        // Walk the chain of inner map templates starting at this map, until reaching a map that is already ordered
+        // or one that does not depend on another map.
+        size_t depth = 0;
+        uint32_t index = i;
+        while (state[index] == MAP_ORDER_STATE_UNVISITED) {
+            ebpf_native_map_t* map = &maps[index];
+            state[index] = MAP_ORDER_STATE_VISITING;
+            chain[depth++] = index;
+
+            if (!_ebpf_native_is_map_in_map(map)) {
+                break;
             }
-            if (map->inner_map == NULL) {
+
+            int32_t inner_map_index = map->inner_map_original_id - EBPF_NATIVE_MAP_ORIGINAL_ID_OFFSET;
+            if (inner_map_index < 0 || (size_t)inner_map_index >= map_count) {
                 // We can't create this map because there is no inner template.
-                continue;
+                result = EBPF_INVALID_OBJECT;
+                EBPF_LOG_MESSAGE_GUID(
+                    EBPF_TRACELOG_LEVEL_ERROR,
+                    EBPF_TRACELOG_KEYWORD_NATIVE,
+                    "_ebpf_native_order_maps_for_creation: inner map template not found",
+                    module_id);
+                goto Done;
             }
-        }
-        if (map->inner_map->handle == ebpf_handle_invalid) {
-            // We need to create the inner map template first.
-            continue;
+            if (state[inner_map_index] == MAP_ORDER_STATE_VISITING) {
+                result = EBPF_INVALID_OBJECT;
+                EBPF_LOG_MESSAGE_GUID(
+                    EBPF_TRACELOG_LEVEL_ERROR,
+                    EBPF_TRACELOG_KEYWORD_NATIVE,
+                    "_ebpf_native_order_maps_for_creation: inner map templates form a cycle",
+                    module_id);
+                goto Done;
+            }
+
+            map->inner_map = &maps[inner_map_index];
+            index = (uint32_t)inner_map_index;
         }
 
-        return map;
+        // Every map in the chain depends only on the map after it, so add them to the order deepest first.
+        while (depth > 0) {
+            depth--;
+            state[chain[depth]] = MAP_ORDER_STATE_ORDERED;
+            order[ordered_count++] = chain[depth];
+        }
     }
 
-    // There are no maps left that we can create.
-    return NULL;
+    ebpf_assert(ordered_count == map_count);
+
+Done:
+    ebpf_free(state);
+    ebpf_free(chain);
+
+    EBPF_RETURN_RESULT(result);
 }
 
 static ebpf_result_t
@@ -668,7 +732,6 @@ _ebpf_native_initialize_maps(
 {
     EBPF_LOG_ENTRY();
     ebpf_result_t result = EBPF_SUCCESS;
-    const int ORIGINAL_ID_OFFSET = 1;
 
     // First set all handle value to invalid.
     // This is needed because initializing negative tests can cause initialization
@@ -688,7 +751,7 @@ _ebpf_native_initialize_maps(
             goto Done;
         }
         native_maps[i].entry = &maps[i];
-        native_maps[i].original_id = i + ORIGINAL_ID_OFFSET;
+        native_maps[i].original_id = i + EBPF_NATIVE_MAP_ORIGINAL_ID_OFFSET;
         maps[i].address = NULL;
 
         if (maps[i].definition.pinning == LIBBPF_PIN_BY_NAME) {
@@ -728,12 +791,12 @@ _ebpf_native_initialize_maps(
         int32_t inner_map_original_id = -1;
         if (_ebpf_native_is_map_in_map(&native_maps[i])) {
             if (definition->inner_map_idx != 0) {
-                inner_map_original_id = definition->inner_map_idx + ORIGINAL_ID_OFFSET;
+                inner_map_original_id = definition->inner_map_idx + EBPF_NATIVE_MAP_ORIGINAL_ID_OFFSET;
             } else if (definition->inner_id != 0) {
                 for (uint32_t j = 0; j < map_count; j++) {
                     ebpf_map_definition_in_file_t* inner_definition = &(native_maps[j].entry->definition);
                     if (inner_definition->id == definition->inner_id && i != j) {
-                        inner_map_original_id = j + ORIGINAL_ID_OFFSET;
+                        inner_map_original_id = j + EBPF_NATIVE_MAP_ORIGINAL_ID_OFFSET;
                         break;
                     }
                 }
@@ -949,7 +1012,10 @@ _ebpf_native_create_maps(_Inout_ ebpf_native_module_t* module)
     ebpf_native_map_t* native_maps = NULL;
     map_entry_t* maps = NULL;
     size_t map_count = 0;
-    cxplat_utf8_string_t map_name = {0};
+    uint32_t* order = NULL;
+    ebpf_handle_t* pin_handles = NULL;
+    cxplat_utf8_string_t* pin_paths = NULL;
+    size_t pin_count = 0;
     ebpf_map_definition_in_memory_t map_definition = {0};
 
     // Get the maps
@@ -972,18 +1038,19 @@ _ebpf_native_create_maps(_Inout_ ebpf_native_module_t* module)
         goto Done;
     }
 
+    order = (uint32_t*)ebpf_allocate_with_tag(map_count * sizeof(uint32_t), EBPF_POOL_TAG_NATIVE);
+    if (order == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    result = _ebpf_native_order_maps_for_creation(&module->client_module_id, native_maps, map_count, order);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+
     for (uint32_t count = 0; count < map_count; count++) {
-        ebpf_native_map_t* native_map = _ebpf_native_get_next_map_to_create(native_maps, map_count);
-        if (native_map == NULL) {
-            // Any remaining maps cannot be created.
-            result = EBPF_INVALID_OBJECT;
-            EBPF_LOG_MESSAGE_GUID(
-                EBPF_TRACELOG_LEVEL_ERROR,
-                EBPF_TRACELOG_KEYWORD_NATIVE,
-                "_ebpf_native_create_maps: module already detaching / unloading",
-                &module->client_module_id);
-            break;
-        }
+        ebpf_native_map_t* native_map = &native_maps[order[count]];
 
         if (native_map->entry->definition.pinning == LIBBPF_PIN_BY_NAME) {
             result = _ebpf_native_reuse_map(native_map);
@@ -996,33 +1063,55 @@ _ebpf_native_create_maps(_Inout_ ebpf_native_module_t* module)
         }
 
         ebpf_handle_t inner_map_handle = (native_map->inner_map) ? native_map->inner_map->handle : ebpf_handle_invalid;
-        map_name.length = strlen(native_map->entry->name);
-        map_name.value = (uint8_t*)ebpf_allocate_with_tag(map_name.length, EBPF_POOL_TAG_NATIVE);
-        if (map_name.value == NULL) {
-            result = EBPF_NO_MEMORY;
-            break;
-        }
-        memcpy(map_name.value, native_map->entry->name, map_name.length);
+        // The map name is copied by the map, so it can refer directly to the name in the module's map table.
+        cxplat_utf8_string_t map_name = {
+            (uint8_t*)native_map->entry->name, strnlen_s(native_map->entry->name, BPF_OBJ_NAME_LEN)};
         map_definition.type = native_map->entry->definition.type;
         map_definition.key_size = native_map->entry->definition.key_size;
         map_definition.value_size = native_map->entry->definition.value_size;
         map_definition.max_entries = native_map->entry->definition.max_entries;
 
-        result = ebpf_core_create_map(&map_name, &map_definition, inner_map_handle, &native_map->handle);
+        result = ebpf_core_create_map(&map_name, &map_definition, inner_map_handle, 0, 0, &native_map->handle);
         if (result != EBPF_SUCCESS) {
             break;
         }
 
-        ebpf_free(map_name.value);
-        map_name.value = NULL;
+        // If pin_path is set and the map is not yet pinned, pin it with the rest of the module's maps below.
+        if (native_map->pin_path.value != NULL && !native_map->pinned) {
+            pin_count++;
+        }
+    }
+    if (result != EBPF_SUCCESS || pin_count == 0) {
+        goto Done;
+    }
+
+    // Pin all newly created maps in one batch, so the pinning table lock is acquired once per module.
+    pin_handles = (ebpf_handle_t*)ebpf_allocate_with_tag(pin_count * sizeof(ebpf_handle_t), EBPF_POOL_TAG_NATIVE);
+    pin_paths = (cxplat_utf8_string_t*)ebpf_allocate_with_tag(
+        pin_count * sizeof(cxplat_utf8_string_t), EBPF_POOL_TAG_NATIVE);
+    if (pin_handles == NULL || pin_paths == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
 
-        // If pin_path is set and the map is not yet pinned, pin it now.
+    pin_count = 0;
+    for (uint32_t count = 0; count < map_count; count++) {
+        ebpf_native_map_t* native_map = &native_maps[count];
         if (native_map->pin_path.value != NULL && !native_map->pinned) {
-            result = ebpf_core_update_pinning(native_map->handle, &native_map->pin_path);
-            if (result != EBPF_SUCCESS) {
-                break;
-            }
-            native_map->pinned = true;
+            pin_handles[pin_count] = native_map->handle;
+            pin_paths[pin_count] = native_map->pin_path;
+            pin_count++;
+        }
+    }
+
+    result = ebpf_core_pin_objects(pin_count, pin_handles, pin_paths);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    for (uint32_t count = 0; count < map_count; count++) {
+        if (native_maps[count].pin_path.value != NULL) {
+            native_maps[count].pinned = true;
         }
     }
 
@@ -1032,9 +1121,9 @@ Done:
         module->maps = NULL;
         module->map_count = 0;
     }
-    if (map_name.value != NULL) {
-        ebpf_free(map_name.value);
-    }
+    ebpf_free(order);
+    ebpf_free(pin_handles);
+    ebpf_free(pin_paths);
 
     EBPF_RETURN_RESULT(result);
 }
@@ -23,6 +23,10 @@
 #include <stdlib.h>
 
 static size_t _ebpf_program_state_index = MAXUINT64;
+
+// Advanced on every user mode map update and program replacement. Extensions that cache verdicts treat a change as
+// invalidating all of them, since tracking which programs reference which maps is not worth the hot path cost.
+static volatile int64_t _ebpf_program_state_generation = 0;
 #define EBPF_MAX_HASH_SIZE 128
 
 // Global flag to disable invoking programs. This is used when fuzzing the IOCTL interface.
@@ -1606,6 +1610,17 @@ _Requires_lock_held_(program->lock) static ebpf_result_t _ebpf_program_get_helpe
                 }
             }
         }
+
+        // The local storage helpers locate their storage through the header that precedes the program context.
+        if (found && !program_data->capabilities.supports_context_header &&
+            (helper_function_id == BPF_FUNC_sk_storage_get || helper_function_id == BPF_FUNC_sk_storage_delete)) {
+            EBPF_LOG_MESSAGE_UINT64(
+                EBPF_TRACELOG_LEVEL_ERROR,
+                EBPF_TRACELOG_KEYWORD_PROGRAM,
+                "Program type does not support a context header for helper ID",
+                helper_function_id);
+            found = false;
+        }
     } else {
         // Check the program type specific helper function table of the program type.
         if (!found) {
@@ -2542,3 +2557,15 @@ ebpf_program_get_state_index()
 {
     return _ebpf_program_state_index;
 }
+
+void
+ebpf_program_increment_state_generation()
+{
+    ebpf_interlocked_increment_int64(&_ebpf_program_state_generation);
+}
+
+uint64_t
+ebpf_program_get_state_generation()
+{
+    return (uint64_t)ReadNoFence64(&_ebpf_program_state_generation);
+}
@@ -414,6 +414,21 @@ extern "C"
     size_t
     ebpf_program_get_state_index();
 
+    /**
+     * @brief Advance the global program state generation. Called whenever the input a program's verdict depends on,
+     * other than its context, may have changed: a map was modified from user mode or a link was given a new program.
+     */
+    void
+    ebpf_program_increment_state_generation();
+
+    /**
+     * @brief Get the global program state generation.
+     *
+     * @return The current state generation.
+     */
+    uint64_t
+    ebpf_program_get_state_generation();
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,15 @@ typedef enum _ebpf_operation_id
     EBPF_OPERATION_MAP_UPDATE_ELEMENT_BATCH,
     EBPF_OPERATION_MAP_DELETE_ELEMENT_BATCH,
     EBPF_OPERATION_MAP_GET_NEXT_KEY_VALUE_BATCH,
+    EBPF_OPERATION_UPDATE_LINK_PROGRAM,
+    EBPF_OPERATION_GET_LINK_INFO_BATCH,
+    EBPF_OPERATION_GET_MAP_INFO_BATCH,
+    EBPF_OPERATION_GET_PROGRAM_INFO_BATCH,
+    EBPF_OPERATION_MAP_FIND_ELEMENT_BATCH,
+    EBPF_OPERATION_MAP_STAGE_CONTENTS,
+    EBPF_OPERATION_MAP_REPLACE_CONTENTS,
+    EBPF_OPERATION_MAP_SET_STATISTICS,
+    EBPF_OPERATION_RESOLVE_PROGRAM,
 } ebpf_operation_id_t;
 
 typedef enum _ebpf_code_type
@@ -126,6 +135,8 @@ typedef struct _ebpf_operation_create_map_request
     struct _ebpf_operation_header header;
     ebpf_map_definition_in_memory_t ebpf_map_definition;
     ebpf_handle_t inner_map_handle;
+    uint32_t map_flags; // Only BPF_F_NUMA_NODE and BPF_F_NUMA_REPLICATED are supported.
+    uint32_t numa_node; // NUMA node to allocate the map on if map_flags contains BPF_F_NUMA_NODE.
     uint8_t data[1];
 } ebpf_operation_create_map_request_t;
 
@@ -269,6 +280,14 @@ typedef struct _ebpf_operation_unlink_program_request
     uint8_t data[1];
 } ebpf_operation_unlink_program_request_t;
 
+typedef struct _ebpf_operation_update_link_program_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t link_handle;
+    ebpf_handle_t program_handle;
+    ebpf_handle_t old_program_handle; // ebpf_handle_invalid if the current program is not checked.
+} ebpf_operation_update_link_program_request_t;
+
 typedef struct _ebpf_operation_close_handle_request
 {
     struct _ebpf_operation_header header;
@@ -354,6 +373,21 @@ typedef struct _ebpf_operation_get_object_info_reply
     uint8_t info[1];
 } ebpf_operation_get_object_info_reply_t;
 
+typedef struct _ebpf_operation_get_object_info_batch_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_id_t start_id;
+} ebpf_operation_get_object_info_batch_request_t;
+
+typedef struct _ebpf_operation_get_object_info_batch_reply
+{
+    struct _ebpf_operation_header header;
+    ebpf_id_t next_id; // Cursor to pass as start_id to continue the enumeration.
+    uint32_t count_of_records;
+    // Each record is a bpf_link_info, bpf_map_info or bpf_prog_info, depending on the operation.
+    uint8_t info[1];
+} ebpf_operation_get_object_info_batch_reply_t;
+
 typedef struct _ebpf_operation_bind_map_request
 {
     struct _ebpf_operation_header header;
@@ -510,3 +544,78 @@ typedef struct _ebpf_operation_map_get_next_key_value_batch_reply
     // Data is a concatenation of key+value.
     uint8_t data[1];
 } ebpf_operation_map_get_next_key_value_batch_reply_t;
+
+typedef struct _ebpf_operation_map_find_element_batch_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t handle;
+    bool find_and_delete;
+    // Count of elements is derived from the length of the request.
+    // Data is a concatenation of keys.
+    uint8_t keys[1];
+} ebpf_operation_map_find_element_batch_request_t;
+
+typedef struct _ebpf_operation_map_find_element_batch_reply
+{
+    struct _ebpf_operation_header header;
+    // Data is an array of one ebpf_result_t per key, followed by a concatenation of values.
+    // The value of a key whose result is not EBPF_SUCCESS is zero filled.
+    uint8_t data[1];
+} ebpf_operation_map_find_element_batch_reply_t;
+
+typedef struct _ebpf_operation_map_stage_contents_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t handle;
+    bool reset;
+    // Count of records is derived from the length of the request.
+    // Data is a concatenation of key+value records.
+    uint8_t data[1];
+} ebpf_operation_map_stage_contents_request_t;
+
+typedef struct _ebpf_operation_map_replace_contents_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t handle;
+    uint32_t record_count;
+} ebpf_operation_map_replace_contents_request_t;
+
+typedef struct _ebpf_operation_map_set_statistics_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t handle;
+    bool enabled;
+} ebpf_operation_map_set_statistics_request_t;
+
+#if !defined(CONFIG_BPF_JIT_DISABLED)
+typedef struct _ebpf_operation_resolve_program_request
+{
+    struct _ebpf_operation_header header;
+    ebpf_handle_t program_handle;
+    uint32_t map_count;           // Number of map handles at the start of data.
+    uint32_t map_reference_count; // Number of map reference indices that follow the map handles.
+    // Data is map_count map handles whose definitions are returned, followed by map_reference_count uint32_t indices
+    // into the map handles, one per map load in the byte code, followed by the IDs of the helper functions the byte
+    // code calls. Count of helper function IDs is derived from the length of the request.
+    uint8_t data[1];
+} ebpf_operation_resolve_program_request_t;
+
+typedef struct _ebpf_operation_resolve_program_map_definition
+{
+    ebpf_id_t id;
+    uint32_t type;
+    uint32_t key_size;
+    uint32_t value_size;
+    uint32_t max_entries;
+    ebpf_id_t inner_map_id;
+} ebpf_operation_resolve_program_map_definition_t;
+
+typedef struct _ebpf_operation_resolve_program_reply
+{
+    struct _ebpf_operation_header header;
+    uint64_t log_function_address;
+    // Data is one address per map reference, followed by one address per helper function ID, followed by one
+    // ebpf_operation_resolve_program_map_definition_t per map handle.
+    uint8_t data[1];
+} ebpf_operation_resolve_program_reply_t;
+#endif
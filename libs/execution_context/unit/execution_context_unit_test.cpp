@@ -1057,6 +1057,265 @@ TEST_CASE("ring_buffer_async_query", "[execution_context]")
     }
 }
 
+TEST_CASE("map_sk_storage", "[execution_context]")
+{
+    _ebpf_core_initializer core;
+    core.initialize();
+    ebpf_map_definition_in_memory_t map_definition{BPF_MAP_TYPE_SK_STORAGE, sizeof(uint32_t), sizeof(uint64_t), 0};
+    map_ptr map;
+    map_ptr other_map;
+    {
+        ebpf_map_t* local_map;
+        cxplat_utf8_string_t map_name = {0};
+        REQUIRE(
+            ebpf_map_create(&map_name, &map_definition, (uintptr_t)ebpf_handle_invalid, &local_map) == EBPF_SUCCESS);
+        map.reset(local_map);
+        REQUIRE(
+            ebpf_map_create(&map_name, &map_definition, (uintptr_t)ebpf_handle_invalid, &local_map) == EBPF_SUCCESS);
+        other_map.reset(local_map);
+
+        // The storage is not indexed by key, so the map must not declare any entries.
+        ebpf_map_definition_in_memory_t bad_definition = map_definition;
+        bad_definition.max_entries = 1;
+        REQUIRE(
+            ebpf_map_create(&map_name, &bad_definition, (uintptr_t)ebpf_handle_invalid, &local_map) ==
+            EBPF_INVALID_ARGUMENT);
+    }
+
+    // The map holds no entries of its own.
+    uint32_t key = 0;
+    uint64_t value = 0;
+    REQUIRE(
+        ebpf_map_find_entry(
+            map.get(),
+            sizeof(key),
+            reinterpret_cast<uint8_t*>(&key),
+            sizeof(value),
+            reinterpret_cast<uint8_t*>(&value),
+            0) == EBPF_OPERATION_NOT_SUPPORTED);
+
+    ebpf_context_header_t header = {};
+    uint64_t initial_value = 42;
+
+    // Lookup without create does not allocate storage.
+    REQUIRE(ebpf_map_get_sk_storage(map.get(), &header, nullptr, 0) == nullptr);
+    REQUIRE(header.storage == nullptr);
+    REQUIRE(ebpf_map_delete_sk_storage(map.get(), &header) == EBPF_KEY_NOT_FOUND);
+
+    uint64_t* storage = reinterpret_cast<uint64_t*>(ebpf_map_get_sk_storage(
+        map.get(), &header, reinterpret_cast<uint8_t*>(&initial_value), BPF_SK_STORAGE_GET_F_CREATE));
+    REQUIRE(storage != nullptr);
+    REQUIRE(*storage == initial_value);
+    REQUIRE(header.free_storage != nullptr);
+
+    // Subsequent lookups return the same element, and each map has its own element.
+    *storage = 7;
+    REQUIRE(ebpf_map_get_sk_storage(map.get(), &header, nullptr, 0) == reinterpret_cast<uint8_t*>(storage));
+    uint64_t* other_storage = reinterpret_cast<uint64_t*>(
+        ebpf_map_get_sk_storage(other_map.get(), &header, nullptr, BPF_SK_STORAGE_GET_F_CREATE));
+    REQUIRE(other_storage != nullptr);
+    REQUIRE(other_storage != storage);
+    REQUIRE(*other_storage == 0);
+    REQUIRE(*storage == 7);
+
+    // Unknown flags are rejected.
+    REQUIRE(ebpf_map_get_sk_storage(map.get(), &header, nullptr, 2) == nullptr);
+
+    REQUIRE(ebpf_map_delete_sk_storage(map.get(), &header) == EBPF_SUCCESS);
+    REQUIRE(ebpf_map_delete_sk_storage(map.get(), &header) == EBPF_KEY_NOT_FOUND);
+    REQUIRE(ebpf_map_get_sk_storage(map.get(), &header, nullptr, 0) == nullptr);
+    REQUIRE(ebpf_map_get_sk_storage(other_map.get(), &header, nullptr, 0) == reinterpret_cast<uint8_t*>(other_storage));
+
+    // The element keeps its map alive, so the map can go away before the storage is freed.
+    other_map.reset();
+
+    header.free_storage(&header);
+    REQUIRE(header.storage == nullptr);
+}
+
+extern uint32_t _ebpf_platform_numa_node_count;
+
+TEST_CASE("map_numa_replicated", "[execution_context]")
+{
+    _ebpf_core_initializer core;
+    core.initialize();
+
+    // Each simulated NUMA node needs at least one CPU.
+    if (ebpf_get_cpu_count() < 2) {
+        return;
+    }
+    _ebpf_platform_numa_node_count = 2;
+    REQUIRE(ebpf_get_numa_node_count() == 2);
+
+    auto run_on_node = [](uint32_t node, auto function) {
+        uint32_t cpu_id = 0;
+        while (ebpf_get_cpu_numa_node(cpu_id) != node) {
+            cpu_id++;
+        }
+        uintptr_t old_thread_affinity;
+        REQUIRE(ebpf_set_current_thread_affinity((uintptr_t)1 << cpu_id, &old_thread_affinity) == EBPF_SUCCESS);
+        REQUIRE(ebpf_get_current_numa_node() == node);
+        function();
+        ebpf_restore_current_thread_affinity(old_thread_affinity);
+    };
+
+    cxplat_utf8_string_t map_name = {0};
+    ebpf_map_t* local_map;
+
+    // Unknown flags, nodes that don't exist and map types that can't be replicated are rejected.
+    ebpf_map_definition_in_memory_t map_definition{BPF_MAP_TYPE_HASH, sizeof(uint32_t), sizeof(uint64_t), 16};
+    REQUIRE(
+        ebpf_map_create_with_flags(&map_name, &map_definition, ebpf_handle_invalid, 0x1000, 0, &local_map) ==
+        EBPF_INVALID_ARGUMENT);
+    REQUIRE(
+        ebpf_map_create_with_flags(&map_name, &map_definition, ebpf_handle_invalid, BPF_F_NUMA_NODE, 2, &local_map) ==
+        EBPF_INVALID_ARGUMENT);
+    ebpf_map_definition_in_memory_t lru_definition{BPF_MAP_TYPE_LRU_HASH, sizeof(uint32_t), sizeof(uint64_t), 16};
+    REQUIRE(
+        ebpf_map_create_with_flags(
+            &map_name, &lru_definition, ebpf_handle_invalid, BPF_F_NUMA_REPLICATED, 0, &local_map) ==
+        EBPF_OPERATION_NOT_SUPPORTED);
+
+    // A map placed on a node behaves like any other map.
+    {
+        map_ptr map;
+        REQUIRE(
+            ebpf_map_create_with_flags(
+                &map_name, &map_definition, ebpf_handle_invalid, BPF_F_NUMA_NODE, 1, &local_map) == EBPF_SUCCESS);
+        map.reset(local_map);
+        uint32_t key = 1;
+        uint64_t value = 2;
+        REQUIRE(
+            ebpf_map_update_entry(
+                map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, EBPF_ANY, 0) == EBPF_SUCCESS);
+        value = 0;
+        REQUIRE(
+            ebpf_map_find_entry(map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, 0) ==
+            EBPF_SUCCESS);
+        REQUIRE(value == 2);
+    }
+
+    for (auto map_type : {BPF_MAP_TYPE_ARRAY, BPF_MAP_TYPE_HASH}) {
+        map_definition.type = map_type;
+        map_ptr map;
+        REQUIRE(
+            ebpf_map_create_with_flags(
+                &map_name, &map_definition, ebpf_handle_invalid, BPF_F_NUMA_REPLICATED, 0, &local_map) ==
+            EBPF_SUCCESS);
+        map.reset(local_map);
+
+        // Updates are applied to every replica.
+        for (uint32_t key = 0; key < map_definition.max_entries; key++) {
+            uint64_t value = static_cast<uint64_t>(key) * key;
+            REQUIRE(
+                ebpf_map_update_entry(
+                    map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, EBPF_ANY, 0) ==
+                EBPF_SUCCESS);
+        }
+
+        // Each node reads the same values from its own copy.
+        uint8_t* node_value_address[2] = {};
+        for (uint32_t node = 0; node < 2; node++) {
+            run_on_node(node, [&]() {
+                for (uint32_t key = 0; key < map_definition.max_entries; key++) {
+                    uint64_t value = 0;
+                    REQUIRE(
+                        ebpf_map_find_entry(
+                            map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, 0) ==
+                        EBPF_SUCCESS);
+                    REQUIRE(value == static_cast<uint64_t>(key) * key);
+                }
+                uint32_t key = 3;
+                REQUIRE(
+                    ebpf_map_find_entry(
+                        map.get(),
+                        0,
+                        (uint8_t*)&key,
+                        sizeof(uint8_t*),
+                        (uint8_t*)&node_value_address[node],
+                        EBPF_MAP_FLAG_HELPER) == EBPF_SUCCESS);
+                REQUIRE(*(uint64_t*)node_value_address[node] == 9);
+            });
+        }
+        REQUIRE(node_value_address[0] != node_value_address[1]);
+
+        // Known limitation: a program writing through the lookup pointer only changes the replica of its own node.
+        // The next update from user mode makes the replicas agree again.
+        *(uint64_t*)node_value_address[0] = 1234;
+        for (uint32_t node = 0; node < 2; node++) {
+            run_on_node(node, [&]() {
+                uint32_t key = 3;
+                uint64_t value = 0;
+                REQUIRE(
+                    ebpf_map_find_entry(map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, 0) ==
+                    EBPF_SUCCESS);
+                REQUIRE(value == ((node == 0) ? 1234 : 9));
+            });
+        }
+        {
+            uint32_t key = 3;
+            uint64_t value = 9;
+            REQUIRE(
+                ebpf_map_update_entry(
+                    map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, EBPF_ANY, 0) ==
+                EBPF_SUCCESS);
+        }
+        for (uint32_t node = 0; node < 2; node++) {
+            run_on_node(node, [&]() {
+                uint32_t key = 3;
+                uint64_t value = 0;
+                REQUIRE(
+                    ebpf_map_find_entry(map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, 0) ==
+                    EBPF_SUCCESS);
+                REQUIRE(value == 9);
+            });
+        }
+
+        // An update that fails on the first replica leaves every replica unchanged.
+        if (map_type == BPF_MAP_TYPE_HASH) {
+            uint32_t key = map_definition.max_entries;
+            uint64_t value = 1;
+            REQUIRE(
+                ebpf_map_update_entry(
+                    map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, EBPF_ANY, 0) ==
+                EBPF_OUT_OF_SPACE);
+            for (uint32_t node = 0; node < 2; node++) {
+                run_on_node(node, [&]() {
+                    REQUIRE(
+                        ebpf_map_find_entry(
+                            map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, 0) ==
+                        EBPF_OBJECT_NOT_FOUND);
+                });
+            }
+        }
+
+        // Deletes are applied to every replica.
+        if (map_type == BPF_MAP_TYPE_HASH) {
+            uint32_t key = 3;
+            REQUIRE(ebpf_map_delete_entry(map.get(), sizeof(key), (uint8_t*)&key, 0) == EBPF_SUCCESS);
+            for (uint32_t node = 0; node < 2; node++) {
+                run_on_node(node, [&]() {
+                    uint64_t value = 0;
+                    REQUIRE(
+                        ebpf_map_find_entry(
+                            map.get(), sizeof(key), (uint8_t*)&key, sizeof(value), (uint8_t*)&value, 0) ==
+                        EBPF_OBJECT_NOT_FOUND);
+                });
+            }
+        }
+
+        // The replicas can't be replaced atomically as a whole.
+        REQUIRE(ebpf_map_stage_contents(map.get(), true, 0, nullptr) == EBPF_OPERATION_NOT_SUPPORTED);
+
+        struct bpf_map_info info;
+        uint16_t info_size = sizeof(info);
+        REQUIRE(ebpf_map_get_info(map.get(), (uint8_t*)&info, &info_size) == EBPF_SUCCESS);
+        REQUIRE(info.map_flags == BPF_F_NUMA_REPLICATED);
+    }
+
+    _ebpf_platform_numa_node_count = 1;
+}
+
 std::vector<GUID> _program_types = {
     EBPF_PROGRAM_TYPE_XDP,
     EBPF_PROGRAM_TYPE_BIND,
@@ -1211,7 +1470,7 @@ create_various_objects(std::vector<ebpf_handle_t>& program_handles, std::map<std
         if (def.inner_map_id != 0) {
             inner_handle = map_handles.begin()->second;
         }
-        REQUIRE(ebpf_core_create_map(&utf8_name, &def, inner_handle, &handle) == EBPF_SUCCESS);
+        REQUIRE(ebpf_core_create_map(&utf8_name, &def, inner_handle, 0, 0, &handle) == EBPF_SUCCESS);
         map_handles.insert({name, handle});
     }
 }
@@ -1382,6 +1641,62 @@ TEST_CASE("EBPF_OPERATION_RESOLVE_MAP", "[execution_context][negative]")
     resolve_map_request->program_handle = program_handles[0];
     REQUIRE(invoke_protocol(EBPF_OPERATION_RESOLVE_MAP, request, reply) == EBPF_INVALID_ARGUMENT);
 }
+
+TEST_CASE("EBPF_OPERATION_RESOLVE_PROGRAM", "[execution_context][negative]")
+{
+    NEGATIVE_TEST_PROLOG();
+
+    // One map that is referenced once and no helper functions.
+    std::vector<uint8_t> request(
+        EBPF_OFFSET_OF(ebpf_operation_resolve_program_request_t, data) + sizeof(ebpf_handle_t) + sizeof(uint32_t));
+    std::vector<uint8_t> reply(
+        EBPF_OFFSET_OF(ebpf_operation_resolve_program_reply_t, data) + sizeof(uintptr_t) +
+        sizeof(ebpf_operation_resolve_program_map_definition_t));
+    auto resolve_program_request = reinterpret_cast<ebpf_operation_resolve_program_request_t*>(request.data());
+    auto resolve_program_reply = reinterpret_cast<ebpf_operation_resolve_program_reply_t*>(reply.data());
+    auto map_handle = reinterpret_cast<ebpf_handle_t*>(resolve_program_request->data);
+    auto map_reference_index = reinterpret_cast<uint32_t*>(resolve_program_request->data + sizeof(ebpf_handle_t));
+    resolve_program_request->map_count = 1;
+    resolve_program_request->map_reference_count = 1;
+    *map_reference_index = 0;
+
+    // Invalid program handle.
+    resolve_program_request->program_handle = ebpf_handle_invalid;
+    *map_handle = map_handles["BPF_MAP_TYPE_HASH"];
+    REQUIRE(invoke_protocol(EBPF_OPERATION_RESOLVE_PROGRAM, request, reply) == EBPF_INVALID_OBJECT);
+
+    // Invalid map handle.
+    resolve_program_request->program_handle = program_handles[0];
+    *map_handle = ebpf_handle_invalid;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_RESOLVE_PROGRAM, request, reply) == EBPF_INVALID_OBJECT);
+
+    // Map reference out of range.
+    *map_handle = map_handles["BPF_MAP_TYPE_HASH"];
+    *map_reference_index = 1;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_RESOLVE_PROGRAM, request, reply) == EBPF_INVALID_ARGUMENT);
+    *map_reference_index = 0;
+
+    // More maps than the request contains.
+    resolve_program_request->map_count = 2;
+    REQUIRE(invoke_protocol(EBPF_OPERATION_RESOLVE_PROGRAM, request, reply) == EBPF_INVALID_ARGUMENT);
+    resolve_program_request->map_count = 1;
+
+    // Reply too small.
+    reply.resize(EBPF_OFFSET_OF(ebpf_operation_resolve_program_reply_t, data) + sizeof(uintptr_t));
+    REQUIRE(invoke_protocol(EBPF_OPERATION_RESOLVE_PROGRAM, request, reply) == EBPF_INVALID_ARGUMENT);
+
+    reply.resize(
+        EBPF_OFFSET_OF(ebpf_operation_resolve_program_reply_t, data) + sizeof(uintptr_t) +
+        sizeof(ebpf_operation_resolve_program_map_definition_t));
+    resolve_program_reply = reinterpret_cast<ebpf_operation_resolve_program_reply_t*>(reply.data());
+    REQUIRE(invoke_protocol(EBPF_OPERATION_RESOLVE_PROGRAM, request, reply) == EBPF_SUCCESS);
+    REQUIRE(resolve_program_reply->log_function_address != 0);
+    REQUIRE(*reinterpret_cast<uintptr_t*>(resolve_program_reply->data) != 0);
+    auto map_definition = reinterpret_cast<ebpf_operation_resolve_program_map_definition_t*>(
+        resolve_program_reply->data + sizeof(uintptr_t));
+    REQUIRE(map_definition->type == BPF_MAP_TYPE_HASH);
+    REQUIRE(map_definition->id != 0);
+}
 #else
 TEST_CASE("EBPF_OPERATION_RESOLVE_HELPER", "[execution_context][negative]")
 {
@@ -1392,6 +1707,11 @@ TEST_CASE("EBPF_OPERATION_RESOLVE_MAP", "[execution_context][negative]")
 {
     test_blocked_by_policy(EBPF_OPERATION_RESOLVE_MAP);
 }
+
+TEST_CASE("EBPF_OPERATION_RESOLVE_PROGRAM", "[execution_context][negative]")
+{
+    test_blocked_by_policy(EBPF_OPERATION_RESOLVE_PROGRAM);
+}
 #endif // !defined(CONFIG_BPF_JIT_DISABLED)
 
 #if !defined(CONFIG_BPF_JIT_DISABLED) || !defined(CONFIG_BPF_INTERPRETER_DISABLED)
@@ -0,0 +1,219 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+#include "ebpf_clock.h"
+#include "ebpf_platform.h"
+
+// The cycle counter is only used once it has been calibrated over at least this long, so that the
+// 100 ns granularity of the interrupt time introduces less than 10 ppm of error.
+#define EBPF_CLOCK_MINIMUM_CALIBRATION_NS (10 * 1000 * 1000)
+
+// How often the calibration is corrected against the interrupt time.
+#define EBPF_CLOCK_RECALIBRATION_INTERVAL_NS (1000 * 1000 * 1000)
+
+// Conversion from cycle counter to time since boot, shared by all CPUs so that the time read on one CPU is never
+// ahead of the time read later on another. It is published with a sequence lock: the sequence is odd while the
+// calibration is being updated, and readers retry if it changed while they read.
+typedef __declspec(align(EBPF_CACHE_LINE_SIZE)) struct _ebpf_clock_calibration
+{
+    volatile int64_t sequence;         ///< Odd while the calibration is being updated.
+    volatile uint64_t cycle_base;      ///< Cycle counter value at the last calibration.
+    volatile uint64_t ns_base;         ///< Time since boot in nanoseconds at the last calibration.
+    volatile uint64_t ns_per_cycle_32; ///< Nanoseconds per cycle in 32.32 fixed point, or 0 if not yet calibrated.
+} ebpf_clock_calibration_t;
+
+static ebpf_clock_calibration_t _ebpf_clock_calibration = {0};
+// Set while a CPU is updating the calibration, so that only one does.
+static volatile long _ebpf_clock_recalibrating = 0;
+static bool _ebpf_clock_use_cycle_counter = false;
+
+// Cycle counter and interrupt time captured when the clock was initiated. Calibration measures the
+// cycle counter frequency over the whole interval since then, so accuracy improves with uptime.
+static uint64_t _ebpf_clock_reference_cycles = 0;
+static uint64_t _ebpf_clock_reference_ns = 0;
+
+static uint64_t
+_ebpf_clock_query_precise_ns()
+{
+    return ebpf_query_time_since_boot(false) * EBPF_NS_PER_FILETIME;
+}
+
+static bool
+_ebpf_clock_has_invariant_cycle_counter()
+{
+#if defined(_M_X64)
+    int registers[4];
+
+    // CPUID.80000007H:EDX[8] indicates that the TSC runs at a constant rate in all ACPI P-, C- and T-states.
+    __cpuid(registers, 0x80000000);
+    if ((uint32_t)registers[0] < 0x80000007) {
+        return false;
+    }
+    __cpuid(registers, 0x80000007);
+    return (registers[3] & (1 << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+#if defined(_M_X64)
+static inline uint64_t
+_ebpf_clock_cycles_to_ns(uint64_t cycles, uint64_t ns_per_cycle_32)
+{
+    uint64_t high;
+    uint64_t low = _umul128(cycles, ns_per_cycle_32, &high);
+    return (high << 32) | (low >> 32);
+}
+
+/**
+ * @brief Read the cycle counter after all earlier instructions, including the load of the sequence, have completed,
+ * and before any later one starts.
+ */
+static inline uint64_t
+_ebpf_clock_read_cycles_ordered()
+{
+    _mm_lfence();
+    uint64_t cycles = __rdtsc();
+    _mm_lfence();
+    return cycles;
+}
+
+/**
+ * @brief Correct the shared calibration against the interrupt time.
+ *
+ * @param[out] now_ns Current time since boot in nanoseconds.
+ * @retval true The calibration was updated and now_ns is set.
+ * @retval false Another CPU is updating the calibration.
+ */
+static bool
+_ebpf_clock_recalibrate(_Out_ uint64_t* now_ns)
+{
+    ebpf_clock_calibration_t* calibration = &_ebpf_clock_calibration;
+
+    if (InterlockedCompareExchange(&_ebpf_clock_recalibrating, 1, 0) != 0) {
+        *now_ns = 0;
+        return false;
+    }
+
+    // Readers spin while the sequence is odd, so don't get preempted while holding it.
+    KIRQL old_irql = KeGetCurrentIrql();
+    if (old_irql < DISPATCH_LEVEL) {
+        old_irql = KeRaiseIrqlToDpcLevel();
+    }
+
+    // The cycle counter is read after the sequence is made odd. Any reader that still uses the previous calibration
+    // therefore read a smaller cycle count, and the time it returned is at most the new base computed below.
+    InterlockedIncrement64(&calibration->sequence);
+    uint64_t cycles = _ebpf_clock_read_cycles_ordered();
+    uint64_t precise_ns = _ebpf_clock_query_precise_ns();
+    uint64_t elapsed_ns = precise_ns - _ebpf_clock_reference_ns;
+    uint64_t elapsed_cycles = cycles - _ebpf_clock_reference_cycles;
+
+    if (elapsed_ns >= EBPF_CLOCK_MINIMUM_CALIBRATION_NS && elapsed_cycles > (elapsed_ns >> 32)) {
+        // Never step backwards when the calibration is corrected.
+        uint64_t base_ns = precise_ns;
+        if (calibration->ns_per_cycle_32 != 0) {
+            uint64_t extrapolated_ns = calibration->ns_base + _ebpf_clock_cycles_to_ns(
+                                                                  cycles - calibration->cycle_base,
+                                                                  calibration->ns_per_cycle_32);
+            if (extrapolated_ns > base_ns) {
+                base_ns = extrapolated_ns;
+            }
+        }
+
+        uint64_t remainder;
+        calibration->ns_per_cycle_32 = _udiv128(elapsed_ns >> 32, elapsed_ns << 32, elapsed_cycles, &remainder);
+        calibration->cycle_base = cycles;
+        calibration->ns_base = base_ns;
+        precise_ns = base_ns;
+    }
+
+    InterlockedIncrement64(&calibration->sequence);
+
+    if (old_irql < DISPATCH_LEVEL) {
+        KeLowerIrql(old_irql);
+    }
+    InterlockedExchange(&_ebpf_clock_recalibrating, 0);
+
+    *now_ns = precise_ns;
+    return true;
+}
+#endif
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_clock_initiate()
+{
+    memset((void*)&_ebpf_clock_calibration, 0, sizeof(_ebpf_clock_calibration));
+    _ebpf_clock_recalibrating = 0;
+
+#if defined(_M_X64)
+    _ebpf_clock_use_cycle_counter = _ebpf_clock_has_invariant_cycle_counter();
+    if (_ebpf_clock_use_cycle_counter) {
+        _ebpf_clock_reference_ns = _ebpf_clock_query_precise_ns();
+        _ebpf_clock_reference_cycles = __rdtsc();
+    }
+#endif
+    return EBPF_SUCCESS;
+}
+
+void
+ebpf_clock_terminate()
+{
+    _ebpf_clock_use_cycle_counter = false;
+}
+
+uint64_t
+ebpf_clock_get_coarse_ns()
+{
+    // KeQueryInterruptTime returns the interrupt time as of the last clock tick, which the kernel
+    // keeps in shared memory, so no timer hardware is read.
+    return KeQueryInterruptTime() * EBPF_NS_PER_FILETIME;
+}
+
+uint64_t
+ebpf_clock_get_fast_ns()
+{
+#if defined(_M_X64)
+    if (!_ebpf_clock_use_cycle_counter) {
+        return _ebpf_clock_query_precise_ns();
+    }
+
+    const ebpf_clock_calibration_t* calibration = &_ebpf_clock_calibration;
+    for (;;) {
+        int64_t sequence = ReadAcquire64(&calibration->sequence);
+        if ((sequence & 1) != 0) {
+            // Another CPU is updating the calibration.
+            YieldProcessor();
+            continue;
+        }
+
+        uint64_t cycle_base = calibration->cycle_base;
+        uint64_t ns_base = calibration->ns_base;
+        uint64_t ns_per_cycle_32 = calibration->ns_per_cycle_32;
+        uint64_t cycles = _ebpf_clock_read_cycles_ordered();
+        if (ReadAcquire64(&calibration->sequence) != sequence) {
+            continue;
+        }
+
+        if (ns_per_cycle_32 != 0) {
+            uint64_t elapsed_ns = _ebpf_clock_cycles_to_ns(cycles - cycle_base, ns_per_cycle_32);
+            if (elapsed_ns < EBPF_CLOCK_RECALIBRATION_INTERVAL_NS) {
+                return ns_base + elapsed_ns;
+            }
+        } else {
+            // Until enough time has passed to calibrate accurately, use the precise clock.
+            uint64_t precise_ns = _ebpf_clock_query_precise_ns();
+            if (precise_ns - _ebpf_clock_reference_ns < EBPF_CLOCK_MINIMUM_CALIBRATION_NS) {
+                return precise_ns;
+            }
+        }
+
+        uint64_t now_ns;
+        if (_ebpf_clock_recalibrate(&now_ns)) {
+            return now_ns;
+        }
+    }
+#else
+    return _ebpf_clock_query_precise_ns();
+#endif
+}
@@ -0,0 +1,54 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+#include "ebpf_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Initialize the clock sources used by the time helper functions.
+     *
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this
+     *  operation.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_clock_initiate();
+
+    /**
+     * @brief Terminate the clock sources used by the time helper functions.
+     */
+    void
+    ebpf_clock_terminate();
+
+    /**
+     * @brief Return time elapsed since boot in nanoseconds, excluding time spent
+     * suspended, as of the most recent clock tick. The value is only updated once
+     * per clock tick, but is much cheaper to read than the precise time.
+     *
+     * @return Time elapsed since boot in nanoseconds.
+     */
+    EBPF_INLINE_HINT
+    uint64_t
+    ebpf_clock_get_coarse_ns();
+
+    /**
+     * @brief Return time elapsed since boot in nanoseconds, excluding time spent
+     * suspended, derived from the invariant cycle counter. All CPUs scale the cycle
+     * counter with one shared calibration, which is periodically corrected against the
+     * precise interrupt time, so the time never goes backwards even across CPUs. Falls
+     * back to the precise interrupt time if the CPU does not have an invariant cycle
+     * counter.
+     *
+     * @return Time elapsed since boot in nanoseconds.
+     */
+    EBPF_INLINE_HINT
+    uint64_t
+    ebpf_clock_get_fast_ns();
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,10 +10,13 @@
  * Each thread that accesses memory that needs to be reclaimed is associated with an epoch via ebpf_epoch_enter() and
  * ebpf_epoch_exit().
  * Each CPU maintains a list of threads that are currently in an epoch. When a thread enters an epoch, it is added to
- * the per-CPU list. When a thread exits an epoch, it is removed from the per-CPU list and the CPU checks if the per-CPU
- * list is empty. If it is empty, then the CPU checks if the timer is armed. If the timer is not armed, then the CPU
- * arms the timer. When the timer expires, the release epoch computation is initiated. The release epoch computation is
- * a three-phase process.
+ * the per-CPU list. Threads that enter at IRQL < DISPATCH_LEVEL can be preempted and migrated to another CPU before
+ * they exit, so they are tracked on a separate per-CPU list guarded by a per-CPU spin lock. A migrated thread removes
+ * its entry from the original CPU's list directly instead of messaging that CPU and waiting for it to respond.
+ * When a thread exits an epoch, it is removed from the per-CPU list and the CPU checks if the per-CPU list is empty.
+ * If it is empty, then the CPU checks if the timer is armed. If the timer is not armed, then the CPU arms the timer.
+ * When the timer expires, the release epoch computation is initiated. The release epoch computation is a three-phase
+ * process.
  * 1) Each CPU determines the minimum epoch of all threads on the CPU.
  * 2) The minimum epoch is committed as the release epoch and any memory that is older than the release epoch is
  * released.
@@ -40,11 +43,14 @@
 /**
  * @brief Per-CPU state.
  * Each entry is only accessed by the CPU that owns it and only at IRQL >= DISPATCH_LEVEL.
- * This ensures that no locks are required to access the per CPU state.
+ * This ensures that no locks are required to access the per CPU state. The only exception is
+ * passive_epoch_state_list, which a migrated thread may modify from another CPU while holding passive_epoch_state_lock.
  */
 typedef __declspec(align(EBPF_CACHE_LINE_SIZE)) struct _ebpf_epoch_cpu_entry
 {
-    LIST_ENTRY epoch_state_list;           ///< Per-CPU list of thread entries.
+    LIST_ENTRY epoch_state_list;           ///< Per-CPU list of thread entries that entered at DISPATCH_LEVEL.
+    LIST_ENTRY passive_epoch_state_list;   ///< Per-CPU list of thread entries that entered below DISPATCH_LEVEL.
+    ebpf_lock_t passive_epoch_state_lock;  ///< Lock protecting passive_epoch_state_list.
     ebpf_list_entry_t free_list;           ///< Per-CPU free list.
     int64_t current_epoch;                 ///< The current epoch for this CPU.
     int64_t released_epoch;                ///< The newest epoch that can be released.
@@ -93,10 +99,6 @@ typedef enum _ebpf_epoch_cpu_message_type
                                                       ///< to CPU 0.
     EBPF_EPOCH_CPU_MESSAGE_TYPE_PROPOSE_EPOCH_COMPLETE, ///< This message is sent only to CPU 0 to signal that epoch
                                                         ///< computation is complete.
-    EBPF_EPOCH_CPU_MESSAGE_TYPE_EXIT_EPOCH, ///< This message is used when a thread running with IRQL < DISPATCH calls
-                                            ///< ebpf_epoch_exit on a different CPU than ebpf_epoch_enter. It is sent
-                                            ///< from the CPU where the thread called ebpf_epoch_exit to the CPU where
-                                            ///< the thread called ebpf_epoch_enter.
     EBPF_EPOCH_CPU_MESSAGE_TYPE_RUNDOWN_IN_PROGRESS, ///< This message is sent to each CPU to notify it that epoch code
                                                      ///< is shutting down and that no future timers should be armed and
                                                      ///< future messages should be ignored.
@@ -124,10 +126,6 @@ typedef struct _ebpf_epoch_cpu_message
             uint64_t released_epoch; ///< The newest epoch that can be released.
         } commit_epoch;
         struct
-        {
-            ebpf_epoch_state_t* epoch_state; ///< Epoch state to remove.
-        } exit_epoch;
-        struct
         {
             uint8_t unused; ///< Unused.
         } rundown_in_progress;
@@ -285,6 +283,8 @@ ebpf_epoch_initiate()
         ebpf_epoch_cpu_entry_t* cpu_entry = &_ebpf_epoch_cpu_table[cpu_id];
         cpu_entry->current_epoch = 1;
         ebpf_list_initialize(&cpu_entry->epoch_state_list);
+        ebpf_list_initialize(&cpu_entry->passive_epoch_state_list);
+        ebpf_lock_create(&cpu_entry->passive_epoch_state_lock);
         ebpf_list_initialize(&cpu_entry->free_list);
     }
 
@@ -348,6 +348,7 @@ ebpf_epoch_terminate()
         _ebpf_epoch_release_free_list(cpu_entry, MAXINT64);
         ebpf_assert(ebpf_list_is_empty(&cpu_entry->free_list));
         ebpf_timed_work_queue_destroy(cpu_entry->work_queue);
+        ebpf_lock_destroy(&cpu_entry->passive_epoch_state_lock);
     }
 
     // Wait for all work items to complete.
@@ -373,7 +374,14 @@ ebpf_epoch_enter(_Out_ ebpf_epoch_state_t* epoch_state)
 
     ebpf_epoch_cpu_entry_t* cpu_entry = &_ebpf_epoch_cpu_table[epoch_state->cpu_id];
     epoch_state->epoch = cpu_entry->current_epoch;
-    ebpf_list_insert_tail(&cpu_entry->epoch_state_list, &epoch_state->epoch_list_entry);
+    if (epoch_state->irql_at_enter < DISPATCH_LEVEL) {
+        // The thread may be migrated to another CPU before it calls ebpf_epoch_exit().
+        ebpf_lock_state_t state = ebpf_lock_lock(&cpu_entry->passive_epoch_state_lock);
+        ebpf_list_insert_tail(&cpu_entry->passive_epoch_state_list, &epoch_state->epoch_list_entry);
+        ebpf_lock_unlock(&cpu_entry->passive_epoch_state_lock, state);
+    } else {
+        ebpf_list_insert_tail(&cpu_entry->epoch_state_list, &epoch_state->epoch_list_entry);
+    }
 
     _ebpf_epoch_lower_to_previous_irql(epoch_state->irql_at_enter);
 }
@@ -393,36 +401,20 @@ ebpf_epoch_exit(_In_ ebpf_epoch_state_t* epoch_state)
 
     uint32_t cpu_id = ebpf_get_current_cpu();
 
-    // Special case: Thread has moved to a different CPU since entering the epoch.
-    if (cpu_id != epoch_state->cpu_id) {
-        // Assert that the IRQL is < DISPATCH_LEVEL. If it is DISPATCH_LEVEL, then the thread moved to a different CPU
-        // (by dropping below DISPATCH_LEVEL) and calling ebpf_epoch_exit(). This is not allowed.
-        EBPF_EPOCH_FAIL_FAST(FAST_FAIL_INVALID_ARG, epoch_state->irql_at_enter < DISPATCH_LEVEL);
-
-        // Signal the other CPU to remove the thread entry.
-        if (old_irql < DISPATCH_LEVEL) {
-            KeLowerIrql(old_irql);
-        }
-
-        ebpf_epoch_cpu_message_t message = {0};
-        message.message_type = EBPF_EPOCH_CPU_MESSAGE_TYPE_EXIT_EPOCH;
-        message.message.exit_epoch.epoch_state = epoch_state;
-        message.wake_behavior = EBPF_WORK_QUEUE_WAKEUP_ON_INSERT;
-
-        // The other CPU will call ebpf_epoch_exit() on our behalf.
-        // The epoch was entered at < DISPATCH_LEVEL but will now exit at DISPATCH_LEVEL. To prevent the assert above
-        // from triggering, we need to set the irql_at_enter to DISPATCH_LEVEL.
-        KIRQL saved_irql = epoch_state->irql_at_enter;
-        epoch_state->irql_at_enter = DISPATCH_LEVEL;
-
-        _ebpf_epoch_send_message_and_wait(&message, epoch_state->cpu_id);
-
-        // Restore the irql at enter.
-        epoch_state->irql_at_enter = saved_irql;
-        return;
+    if (epoch_state->irql_at_enter < DISPATCH_LEVEL) {
+        // The thread may have moved to a different CPU since entering the epoch. The entry is removed from the list of
+        // the CPU it entered on under that CPU's lock, so no message needs to be sent to that CPU.
+        ebpf_epoch_cpu_entry_t* enter_cpu_entry = &_ebpf_epoch_cpu_table[epoch_state->cpu_id];
+        ebpf_lock_state_t state = ebpf_lock_lock(&enter_cpu_entry->passive_epoch_state_lock);
+        ebpf_list_remove_entry(&epoch_state->epoch_list_entry);
+        ebpf_lock_unlock(&enter_cpu_entry->passive_epoch_state_lock, state);
+    } else {
+        // The thread entered the epoch at DISPATCH_LEVEL. If it is now on a different CPU, then it dropped below
+        // DISPATCH_LEVEL while in the epoch. This is not allowed.
+        EBPF_EPOCH_FAIL_FAST(FAST_FAIL_INVALID_ARG, cpu_id == epoch_state->cpu_id);
+        ebpf_list_remove_entry(&epoch_state->epoch_list_entry);
     }
 
-    ebpf_list_remove_entry(&epoch_state->epoch_list_entry);
     _ebpf_epoch_arm_timer_if_needed(&_ebpf_epoch_cpu_table[cpu_id]);
 
     // If there are items in the work queue, flush them.
@@ -774,6 +766,16 @@ _ebpf_epoch_messenger_propose_release_epoch(
         entry = entry->Flink;
     }
 
+    // Threads that entered at IRQL < DISPATCH_LEVEL on this CPU may be exiting concurrently on other CPUs.
+    ebpf_lock_state_t state = ebpf_lock_lock(&cpu_entry->passive_epoch_state_lock);
+    entry = cpu_entry->passive_epoch_state_list.Flink;
+    while (entry != &cpu_entry->passive_epoch_state_list) {
+        epoch_state = CONTAINING_RECORD(entry, ebpf_epoch_state_t, epoch_list_entry);
+        minimum_epoch = min(minimum_epoch, epoch_state->epoch);
+        entry = entry->Flink;
+    }
+    ebpf_lock_unlock(&cpu_entry->passive_epoch_state_lock, state);
+
     // Set the proposed release epoch to the minimum epoch seen so far.
     message->message.propose_epoch.proposed_release_epoch = minimum_epoch;
 
@@ -855,28 +857,6 @@ _ebpf_epoch_messenger_compute_epoch_complete(
     }
 }
 
-/**
- * @brief Remove the provided thread from this CPU's thread list and signal the completion event.
- * EBPF_EPOCH_CPU_MESSAGE_TYPE_EXIT_EPOCH message:
- * Message is sent from a thread that is exiting the epoch to the CPU that ebpf_epoch_enter was called on.
- * The CPU removes the ebpf_epoch_state_t from the per-CPU thread list and signals the KEVENT associated with the
- * message to signal any waiting threads that the operation is completed.
- *
- * @param[in] cpu_entry CPU entry to call ebpf_epoch_exit() for.
- * @param[in] message Message to process.
- * @param[in] current_cpu Current CPU.
- */
-void
-_ebpf_epoch_messenger_exit_epoch(
-    _Inout_ ebpf_epoch_cpu_entry_t* cpu_entry, _Inout_ ebpf_epoch_cpu_message_t* message, uint32_t current_cpu)
-{
-    UNREFERENCED_PARAMETER(current_cpu);
-    UNREFERENCED_PARAMETER(cpu_entry);
-
-    ebpf_epoch_exit(message->message.exit_epoch.epoch_state);
-    KeSetEvent(&message->completion_event, 0, FALSE);
-}
-
 /**
  * @brief Message to notify each CPU that rundown is in progress.
  * EBPF_EPOCH_CPU_MESSAGE_TYPE_RUNDOWN_IN_PROGRESS message:
@@ -933,7 +913,6 @@ static ebpf_epoch_messenger_worker_t _ebpf_epoch_messenger_workers[] = {
     _ebpf_epoch_messenger_propose_release_epoch,
     _ebpf_epoch_messenger_commit_release_epoch,
     _ebpf_epoch_messenger_compute_epoch_complete,
-    _ebpf_epoch_messenger_exit_epoch,
     _ebpf_epoch_messenger_rundown_in_progress,
     _ebpf_epoch_messenger_is_free_list_empty};
 
@@ -664,6 +664,172 @@ ebpf_hash_table_destroy(_In_opt_ _Post_ptr_invalid_ ebpf_hash_table_t* hash_tabl
     hash_table->free(hash_table);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_hash_table_create_from_records(
+    _In_ const ebpf_hash_table_t* template_table,
+    size_t record_count,
+    _In_opt_ const uint8_t* records,
+    _Outptr_ ebpf_hash_table_t** hash_table)
+{
+    ebpf_result_t result;
+    ebpf_hash_table_t* table = NULL;
+    uint32_t* bucket_indices = NULL;
+    uint32_t* bucket_sizes = NULL;
+    size_t key_size = template_table->key_size;
+    size_t value_size = template_table->value_size;
+    size_t record_size = key_size + value_size;
+    size_t entry_size = EBPF_OFFSET_OF(ebpf_hash_bucket_entry_t, key) + key_size;
+    size_t allocation_size;
+
+    *hash_table = NULL;
+
+    const ebpf_hash_table_creation_options_t options = {
+        .key_size = key_size,
+        .value_size = value_size,
+        .extract_function = template_table->extract,
+        .allocate = template_table->allocate,
+        .free = template_table->free,
+        .minimum_bucket_count = template_table->bucket_count,
+        .max_entries = template_table->max_entry_count,
+        .supplemental_value_size = template_table->supplemental_value_size,
+        .notification_context = template_table->notification_context,
+        .notification_callback = template_table->notification_callback,
+    };
+
+    result = ebpf_hash_table_create(&table, &options);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+
+    if (record_count == 0) {
+        goto Done;
+    }
+
+    if (record_count > UINT32_MAX) {
+        result = EBPF_OUT_OF_SPACE;
+        goto Done;
+    }
+
+    result = ebpf_safe_size_t_multiply(record_count, sizeof(uint32_t), &allocation_size);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+    bucket_indices = ebpf_allocate_with_tag(allocation_size, EBPF_POOL_TAG_DEFAULT);
+    if (!bucket_indices) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    result = ebpf_safe_size_t_multiply(table->bucket_count, sizeof(uint32_t), &allocation_size);
+    if (result != EBPF_SUCCESS) {
+        goto Done;
+    }
+    bucket_sizes = ebpf_allocate_with_tag(allocation_size, EBPF_POOL_TAG_DEFAULT);
+    if (!bucket_sizes) {
+        result = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    // Compute the bucket of each record and the final size of each bucket.
+    for (size_t index = 0; index < record_count; index++) {
+        uint32_t bucket_index = _ebpf_hash_table_compute_bucket_index(table, records + index * record_size);
+        bucket_indices[index] = bucket_index;
+        bucket_sizes[bucket_index]++;
+    }
+
+    // Allocate each bucket once, sized for all of its records.
+    for (size_t bucket_index = 0; bucket_index < table->bucket_count; bucket_index++) {
+        if (bucket_sizes[bucket_index] == 0) {
+            continue;
+        }
+        ebpf_hash_bucket_header_t* bucket =
+            table->allocate(entry_size * bucket_sizes[bucket_index] + sizeof(ebpf_hash_bucket_header_t));
+        if (!bucket) {
+            result = EBPF_NO_MEMORY;
+            goto Done;
+        }
+        bucket->count = 0;
+        table->buckets[bucket_index].header = bucket;
+    }
+
+    // Append each record to its bucket. The buckets are not yet visible to readers, so they are filled in place.
+    for (size_t index = 0; index < record_count; index++) {
+        const uint8_t* key = records + index * record_size;
+        ebpf_hash_bucket_header_t* bucket = table->buckets[bucket_indices[index]].header;
+        size_t entry_index;
+
+        uint8_t* data = table->allocate(value_size + table->supplemental_value_size);
+        if (!data) {
+            result = EBPF_NO_MEMORY;
+            goto Done;
+        }
+        memcpy(data, key + key_size, value_size);
+        memset(data + value_size, 0, table->supplemental_value_size);
+        if (table->notification_callback) {
+            table->notification_callback(
+                table->notification_context, EBPF_HASH_TABLE_NOTIFICATION_TYPE_ALLOCATE, key, data);
+        }
+
+        for (entry_index = 0; entry_index < bucket->count; entry_index++) {
+            const ebpf_hash_bucket_entry_t* existing_entry =
+                _ebpf_hash_table_bucket_entry(key_size, bucket, entry_index);
+            if (_ebpf_hash_table_compare(table, key, existing_entry->key) == 0) {
+                break;
+            }
+        }
+
+        ebpf_hash_bucket_entry_t* entry = _ebpf_hash_table_bucket_entry(key_size, bucket, entry_index);
+        if (entry_index < bucket->count) {
+            // Duplicate key, the last record wins.
+            uint8_t* old_data = entry->data;
+            entry->data = data;
+            if (table->notification_callback) {
+                table->notification_callback(
+                    table->notification_context, EBPF_HASH_TABLE_NOTIFICATION_TYPE_FREE, key, old_data);
+            }
+            table->free(old_data);
+            continue;
+        }
+
+        ebpf_hash_bucket_header_t* backup_bucket = NULL;
+        if (table->max_entry_count != EBPF_HASH_TABLE_NO_LIMIT && table->entry_count >= table->max_entry_count) {
+            result = EBPF_OUT_OF_SPACE;
+        } else if (bucket->count > 0) {
+            // Bucket at index N > 0 has a backup bucket of size N, used when an entry is later deleted.
+            backup_bucket = table->allocate(entry_size * bucket->count + sizeof(ebpf_hash_bucket_header_t));
+            if (!backup_bucket) {
+                result = EBPF_NO_MEMORY;
+            } else {
+                backup_bucket->count = bucket->count;
+            }
+        }
+        if (result != EBPF_SUCCESS) {
+            if (table->notification_callback) {
+                table->notification_callback(
+                    table->notification_context, EBPF_HASH_TABLE_NOTIFICATION_TYPE_FREE, key, data);
+            }
+            table->free(data);
+            goto Done;
+        }
+
+        entry->data = data;
+        entry->backup_bucket = backup_bucket;
+        memcpy(entry->key, key, key_size);
+        bucket->count++;
+        table->entry_count++;
+    }
+
+Done:
+    ebpf_free(bucket_indices);
+    ebpf_free(bucket_sizes);
+    if (result == EBPF_SUCCESS) {
+        *hash_table = table;
+    } else {
+        ebpf_hash_table_destroy(table);
+    }
+    return result;
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_hash_table_find(_In_ const ebpf_hash_table_t* hash_table, _In_ const uint8_t* key, _Outptr_ uint8_t** value)
 {
@@ -874,6 +1040,19 @@ ebpf_hash_table_key_count(_In_ const ebpf_hash_table_t* hash_table)
     return hash_table->entry_count;
 }
 
+size_t
+ebpf_hash_table_longest_bucket_length(_In_ const ebpf_hash_table_t* hash_table)
+{
+    size_t longest_bucket_length = 0;
+    for (size_t bucket_index = 0; bucket_index < hash_table->bucket_count; bucket_index++) {
+        const ebpf_hash_bucket_header_t* bucket_header = hash_table->buckets[bucket_index].header;
+        if (bucket_header && bucket_header->count > longest_bucket_length) {
+            longest_bucket_length = bucket_header->count;
+        }
+    }
+    return longest_bucket_length;
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_hash_table_iterate(
     _In_ const ebpf_hash_table_t* hash_table,
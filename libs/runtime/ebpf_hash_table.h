@@ -89,6 +89,33 @@ extern "C"
     void
     ebpf_hash_table_destroy(_In_opt_ _Post_ptr_invalid_ ebpf_hash_table_t* hash_table);
 
+    /**
+     * @brief Allocate a hash table with the same configuration as an existing
+     * hash table and populate it from an array of records. Each bucket is
+     * allocated once at its final size instead of being copied on every
+     * insert, so this is much cheaper than calling ebpf_hash_table_update for
+     * each record. The new table must not be visible to other threads until
+     * this function returns.
+     *
+     * @param[in] template_table Hash table whose configuration is copied.
+     * @param[in] record_count Number of records.
+     * @param[in] records Array of records, each a key immediately followed by
+     *  its value. If a key appears more than once, the last record wins.
+     * @param[out] hash_table Pointer to memory that will contain the new hash
+     *  table on success.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this
+     *  hash table.
+     * @retval EBPF_OUT_OF_SPACE The records exceed the maximum number of
+     *  entries of the hash table.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_hash_table_create_from_records(
+        _In_ const ebpf_hash_table_t* template_table,
+        size_t record_count,
+        _In_opt_ const uint8_t* records,
+        _Outptr_ ebpf_hash_table_t** hash_table);
+
     /**
      * @brief Find an element in the hash table.
      *
@@ -216,6 +243,16 @@ extern "C"
     size_t
     ebpf_hash_table_key_count(_In_ const ebpf_hash_table_t* hash_table);
 
+    /**
+     * @brief Get the number of entries in the fullest bucket of the hash table.
+     * This walks every bucket, so it is intended for diagnostics only.
+     *
+     * @param[in] hash_table Hash-table to query.
+     * @return Count of entries in the largest bucket.
+     */
+    size_t
+    ebpf_hash_table_longest_bucket_length(_In_ const ebpf_hash_table_t* hash_table);
+
     /**
      * @brief Returns the next (key, value) pair in the hash table in lexicographical order.
      * The keys are sorted using the supplied comparison function and filtered using the supplied filter function.
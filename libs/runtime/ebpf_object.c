@@ -394,6 +394,54 @@ ebpf_object_get_next_id(ebpf_id_t start_id, ebpf_object_type_t object_type, _Out
     }
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_object_get_next_ids(
+    ebpf_id_t start_id,
+    ebpf_object_type_t object_type,
+    _Inout_ uint32_t* id_count,
+    _Out_writes_to_(*id_count, *id_count) ebpf_id_t* ids)
+{
+    uint32_t capacity = *id_count;
+    uint32_t count = 0;
+    ebpf_id_entry_t* entry = NULL;
+    ebpf_id_t previous_key = 0;
+    ebpf_id_t next_key;
+    bool first = true;
+
+    if (capacity == 0) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    // Walk the table once in hash order, keeping the smallest matching IDs in sorted order.
+    for (;;) {
+        ebpf_result_t result = ebpf_hash_table_next_key_and_value(
+            _ebpf_id_table, first ? NULL : (const uint8_t*)&previous_key, (uint8_t*)&next_key, (uint8_t**)&entry);
+        if (result != EBPF_SUCCESS) {
+            break;
+        }
+        first = false;
+        previous_key = next_key;
+
+        if (entry->type != object_type || next_key <= start_id) {
+            continue;
+        }
+        if (count == capacity && next_key >= ids[count - 1]) {
+            continue;
+        }
+
+        // Insert the ID, evicting the largest one if the array is full.
+        uint32_t position = (count < capacity) ? count++ : count - 1;
+        while (position > 0 && ids[position - 1] > next_key) {
+            ids[position] = ids[position - 1];
+            position--;
+        }
+        ids[position] = next_key;
+    }
+
+    *id_count = count;
+    return (count > 0) ? EBPF_SUCCESS : EBPF_NO_MORE_KEYS;
+}
+
 void
 ebpf_object_reference_next_object(
     _In_opt_ const ebpf_core_object_t* previous_object,
@@ -287,6 +287,25 @@ extern "C"
     _Must_inspect_result_ ebpf_result_t
     ebpf_object_get_next_id(ebpf_id_t start_id, ebpf_object_type_t object_type, _Out_ ebpf_id_t* next_id);
 
+    /**
+     * @brief Find up to *id_count IDs of objects of a given type that are greater than a given ID, in ascending
+     * order, using a single walk of the ID table.
+     *
+     * @param[in] start_id ID to look for IDs after.  The start_id need not exist.
+     * @param[in] object_type Object type to match.
+     * @param[in, out] id_count On input, the capacity of ids. On output, the number of IDs returned.
+     * @param[out] ids Array that receives the IDs.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT The capacity of ids is zero.
+     * @retval EBPF_NO_MORE_KEYS No such IDs found.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_object_get_next_ids(
+        ebpf_id_t start_id,
+        ebpf_object_type_t object_type,
+        _Inout_ uint32_t* id_count,
+        _Out_writes_to_(*id_count, *id_count) ebpf_id_t* ids);
+
     /**
      * @brief Find the corresponding handle in the handle table, verify the type matches,
      *  acquire a reference to the object and return it.
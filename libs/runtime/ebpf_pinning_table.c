@@ -49,6 +49,23 @@ _ebpf_pinning_entry_free(_Frees_ptr_opt_ ebpf_pinning_entry_t* pinning_entry)
     ebpf_free(pinning_entry);
 }
 
+static bool
+_ebpf_pinning_table_is_valid_path(_In_ const cxplat_utf8_string_t* path)
+{
+    if (path->length >= EBPF_MAX_PIN_PATH_LENGTH || path->length == 0) {
+        return false;
+    }
+
+    // Block embedded null terminators
+    for (size_t index = 0; index < path->length; index++) {
+        if (path->value[index] == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_pinning_table_allocate(ebpf_pinning_table_t** pinning_table)
 {
@@ -124,17 +141,10 @@ ebpf_pinning_table_insert(
     cxplat_utf8_string_t* new_key;
     ebpf_pinning_entry_t* new_pinning_entry;
 
-    if (path->length >= EBPF_MAX_PIN_PATH_LENGTH || path->length == 0) {
+    if (!_ebpf_pinning_table_is_valid_path(path)) {
         EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
     }
 
-    // Block embedded null terminators
-    for (size_t index = 0; index < path->length; index++) {
-        if (path->value[index] == 0) {
-            EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
-        }
-    }
-
     new_pinning_entry = ebpf_allocate(sizeof(ebpf_pinning_entry_t));
     if (!new_pinning_entry) {
         return_value = EBPF_NO_MEMORY;
@@ -175,6 +185,103 @@ Done:
     EBPF_RETURN_RESULT(return_value);
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_pinning_table_insert_batch(
+    _Inout_ ebpf_pinning_table_t* pinning_table,
+    size_t entry_count,
+    _In_reads_(entry_count) const ebpf_pinning_entry_t* entries)
+{
+    EBPF_LOG_ENTRY();
+    ebpf_lock_state_t state;
+    ebpf_result_t return_value = EBPF_SUCCESS;
+    ebpf_pinning_entry_t** new_pinning_entries = NULL;
+    size_t inserted_count = 0;
+
+    if (entry_count == 0) {
+        EBPF_RETURN_RESULT(EBPF_SUCCESS);
+    }
+
+    for (size_t index = 0; index < entry_count; index++) {
+        if (!_ebpf_pinning_table_is_valid_path(&entries[index].path)) {
+            EBPF_RETURN_RESULT(EBPF_INVALID_ARGUMENT);
+        }
+    }
+
+    new_pinning_entries = ebpf_allocate(entry_count * sizeof(ebpf_pinning_entry_t*));
+    if (!new_pinning_entries) {
+        return_value = EBPF_NO_MEMORY;
+        goto Done;
+    }
+
+    // Build all entries before acquiring the lock, so that the lock is only held for the hash table updates.
+    for (size_t index = 0; index < entry_count; index++) {
+        ebpf_pinning_entry_t* new_pinning_entry = ebpf_allocate(sizeof(ebpf_pinning_entry_t));
+        if (!new_pinning_entry) {
+            return_value = EBPF_NO_MEMORY;
+            goto Done;
+        }
+
+        return_value = ebpf_duplicate_utf8_string(&new_pinning_entry->path, &entries[index].path);
+        if (return_value != EBPF_SUCCESS) {
+            ebpf_free(new_pinning_entry);
+            goto Done;
+        }
+
+        new_pinning_entry->object = entries[index].object;
+        EBPF_OBJECT_ACQUIRE_REFERENCE(new_pinning_entry->object);
+        new_pinning_entries[index] = new_pinning_entry;
+    }
+
+    state = ebpf_lock_lock(&pinning_table->lock);
+
+    for (; inserted_count < entry_count; inserted_count++) {
+        cxplat_utf8_string_t* new_key = &new_pinning_entries[inserted_count]->path;
+        return_value = ebpf_hash_table_update(
+            pinning_table->hash_table,
+            (const uint8_t*)&new_key,
+            (const uint8_t*)&new_pinning_entries[inserted_count],
+            EBPF_HASH_TABLE_OPERATION_INSERT);
+        if (return_value != EBPF_SUCCESS) {
+            if (return_value == EBPF_KEY_ALREADY_EXISTS) {
+                return_value = EBPF_OBJECT_ALREADY_EXISTS;
+            }
+            break;
+        }
+    }
+
+    if (return_value != EBPF_SUCCESS) {
+        // Roll back the entries inserted by this call. The entries themselves are freed below.
+        while (inserted_count > 0) {
+            inserted_count--;
+            cxplat_utf8_string_t* key = &new_pinning_entries[inserted_count]->path;
+            ebpf_assert_success(ebpf_hash_table_delete(pinning_table->hash_table, (const uint8_t*)&key));
+        }
+    } else {
+        for (size_t index = 0; index < entry_count; index++) {
+            ebpf_interlocked_increment_int32(&new_pinning_entries[index]->object->pinned_path_count);
+        }
+    }
+
+    ebpf_lock_unlock(&pinning_table->lock, state);
+
+Done:
+    if (new_pinning_entries) {
+        if (return_value == EBPF_SUCCESS) {
+            for (size_t index = 0; index < entry_count; index++) {
+                EBPF_LOG_MESSAGE_UTF8_STRING(
+                    EBPF_TRACELOG_LEVEL_VERBOSE, EBPF_TRACELOG_KEYWORD_BASE, "Pinned object", &entries[index].path);
+            }
+        } else {
+            for (size_t index = 0; index < entry_count; index++) {
+                _ebpf_pinning_entry_free(new_pinning_entries[index]);
+            }
+        }
+        ebpf_free(new_pinning_entries);
+    }
+
+    EBPF_RETURN_RESULT(return_value);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_pinning_table_find(
     ebpf_pinning_table_t* pinning_table, const cxplat_utf8_string_t* path, ebpf_core_object_t** object)
@@ -55,6 +55,26 @@ extern "C"
     ebpf_pinning_table_insert(
         ebpf_pinning_table_t* pinning_table, const cxplat_utf8_string_t* path, ebpf_core_object_t* object);
 
+    /**
+     * @brief Insert a set of entries into the pinning table under a single
+     *  acquisition of the pinning table lock and acquire a reference on each
+     *  object. Either all entries are inserted or none are.
+     *
+     * @param[in, out] pinning_table Pinning table to update.
+     * @param[in] entry_count Number of entries to insert.
+     * @param[in] entries Array of paths and the objects to associate with them.
+     * @retval EBPF_SUCCESS The operation was successful.
+     * @retval EBPF_INVALID_ARGUMENT One of the paths is not valid.
+     * @retval EBPF_OBJECT_ALREADY_EXISTS One of the paths is already present in
+     *  the pinning table or appears more than once in entries.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for the entries.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_pinning_table_insert_batch(
+        _Inout_ ebpf_pinning_table_t* pinning_table,
+        size_t entry_count,
+        _In_reads_(entry_count) const ebpf_pinning_entry_t* entries);
+
     /**
      * @brief Find an entry in the pinning table and acquire a reference on the
      *  object associate with it.
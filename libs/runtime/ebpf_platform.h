@@ -263,6 +263,49 @@ extern "C"
     uint32_t
     ebpf_get_current_cpu();
 
+    /**
+     * @brief Query the platform for the number of NUMA nodes.
+     * @return The count of NUMA nodes in the system, at least 1.
+     */
+    _Ret_range_(>, 0) uint32_t ebpf_get_numa_node_count();
+
+    /**
+     * @brief Query the platform to determine which NUMA node this execution is running on.
+     * @retval Zero based index of the NUMA node, less than ebpf_get_numa_node_count().
+     */
+    uint32_t
+    ebpf_get_current_numa_node();
+
+    /**
+     * @brief Query the platform to determine which NUMA node a CPU belongs to.
+     *
+     * @param[in] cpu_id Zero based index of the CPU.
+     * @retval Zero based index of the NUMA node, less than ebpf_get_numa_node_count().
+     */
+    uint32_t
+    ebpf_get_cpu_numa_node(uint32_t cpu_id);
+
+    /**
+     * @brief Bind the current thread to the processors of a NUMA node, whichever processor group they are in.
+     *
+     * @param[in] numa_node Zero based index of the NUMA node.
+     * @param[out] old_thread_affinity Affinity to pass to ebpf_restore_current_thread_group_affinity.
+     * @retval EBPF_SUCCESS The thread now runs on the node.
+     * @retval EBPF_INVALID_ARGUMENT The node does not exist.
+     * @retval EBPF_NO_MEMORY Unable to allocate resources for this operation.
+     * @retval EBPF_OPERATION_NOT_SUPPORTED The thread can't be moved to the node.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_set_current_thread_numa_node(uint32_t numa_node, _Out_ GROUP_AFFINITY* old_thread_affinity);
+
+    /**
+     * @brief Restore the affinity of the current thread saved by ebpf_set_current_thread_numa_node.
+     *
+     * @param[in] old_thread_affinity Affinity returned by ebpf_set_current_thread_numa_node.
+     */
+    void
+    ebpf_restore_current_thread_group_affinity(_In_ const GROUP_AFFINITY* old_thread_affinity);
+
     /**
      * @brief Query the platform to determine an opaque identifier for the
      *   current thread. Only valid if ebpf_is_preemptible() == false.
@@ -178,6 +178,124 @@ ebpf_get_code_integrity_state(_Out_ ebpf_code_integrity_state_t* state)
     }
 }
 
+_Ret_range_(>, 0) uint32_t ebpf_get_numa_node_count() { return (uint32_t)KeQueryHighestNodeNumber() + 1; }
+
+uint32_t
+ebpf_get_current_numa_node()
+{
+    return KeGetCurrentNodeNumber();
+}
+
+/**
+ * @brief Query the active processors of a NUMA node in every processor group the node spans.
+ *
+ * @param[in] numa_node Zero based index of the NUMA node.
+ * @param[out] affinities Array of group affinities, to be freed with ebpf_free.
+ * @param[out] affinity_count Number of entries in affinities.
+ * @retval EBPF_SUCCESS The operation was successful.
+ * @retval EBPF_NO_MEMORY Unable to allocate resources for this operation.
+ * @retval EBPF_INVALID_ARGUMENT The node does not exist.
+ */
+static _Must_inspect_result_ ebpf_result_t
+_ebpf_query_numa_node_affinities(
+    uint32_t numa_node,
+    _Outptr_result_buffer_(*affinity_count) GROUP_AFFINITY** affinities,
+    _Out_ USHORT* affinity_count)
+{
+    USHORT required_count = 0;
+    *affinities = NULL;
+    *affinity_count = 0;
+
+    // A node can span several processor groups, so it can have more than 64 processors.
+    NTSTATUS status = KeQueryNodeActiveAffinity2((USHORT)numa_node, NULL, 0, &required_count);
+    if (status != STATUS_BUFFER_TOO_SMALL || required_count == 0) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    GROUP_AFFINITY* local_affinities = (GROUP_AFFINITY*)ebpf_allocate(required_count * sizeof(GROUP_AFFINITY));
+    if (local_affinities == NULL) {
+        return EBPF_NO_MEMORY;
+    }
+
+    status = KeQueryNodeActiveAffinity2((USHORT)numa_node, local_affinities, required_count, &required_count);
+    if (!NT_SUCCESS(status)) {
+        ebpf_free(local_affinities);
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    *affinities = local_affinities;
+    *affinity_count = required_count;
+    return EBPF_SUCCESS;
+}
+
+uint32_t
+ebpf_get_cpu_numa_node(uint32_t cpu_id)
+{
+    PROCESSOR_NUMBER processor_number;
+    if (!NT_SUCCESS(KeGetProcessorNumberFromIndex(cpu_id, &processor_number))) {
+        return 0;
+    }
+
+    uint32_t node_count = ebpf_get_numa_node_count();
+    for (uint32_t node = 0; node < node_count; node++) {
+        GROUP_AFFINITY* affinities;
+        USHORT affinity_count;
+        if (_ebpf_query_numa_node_affinities(node, &affinities, &affinity_count) != EBPF_SUCCESS) {
+            continue;
+        }
+        bool found = false;
+        for (USHORT index = 0; index < affinity_count; index++) {
+            if (affinities[index].Group == processor_number.Group &&
+                (affinities[index].Mask & ((KAFFINITY)1 << processor_number.Number)) != 0) {
+                found = true;
+                break;
+            }
+        }
+        ebpf_free(affinities);
+        if (found) {
+            return node;
+        }
+    }
+    return 0;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_set_current_thread_numa_node(uint32_t numa_node, _Out_ GROUP_AFFINITY* old_thread_affinity)
+{
+    GROUP_AFFINITY* affinities;
+    USHORT affinity_count;
+    ebpf_result_t result;
+
+    memset(old_thread_affinity, 0, sizeof(*old_thread_affinity));
+    if (KeGetCurrentIrql() >= DISPATCH_LEVEL) {
+        return EBPF_OPERATION_NOT_SUPPORTED;
+    }
+
+    result = _ebpf_query_numa_node_affinities(numa_node, &affinities, &affinity_count);
+    if (result != EBPF_SUCCESS) {
+        return result;
+    }
+
+    // A thread can only be affinitized to a single group, so use the first group that has active processors.
+    result = EBPF_OPERATION_NOT_SUPPORTED;
+    for (USHORT index = 0; index < affinity_count; index++) {
+        if (affinities[index].Mask != 0) {
+            KeSetSystemGroupAffinityThread(&affinities[index], old_thread_affinity);
+            result = EBPF_SUCCESS;
+            break;
+        }
+    }
+
+    ebpf_free(affinities);
+    return result;
+}
+
+void
+ebpf_restore_current_thread_group_affinity(_In_ const GROUP_AFFINITY* old_thread_affinity)
+{
+    KeRevertToUserGroupAffinityThread((GROUP_AFFINITY*)old_thread_affinity);
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_access_check(
     _In_ const ebpf_security_descriptor_t* security_descriptor,
@@ -7,6 +7,7 @@
 #include "catch_wrapper.hpp"
 #include "ebpf_async.h"
 #include "ebpf_bitmap.h"
+#include "ebpf_clock.h"
 #include "ebpf_epoch.h"
 #include "ebpf_hash_table.h"
 #include "ebpf_nethooks.h"
@@ -24,6 +25,7 @@
 #include <winsock2.h>
 #include <Windows.h>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <complex>
@@ -359,6 +361,81 @@ TEST_CASE("hash_table_test", "[platform]")
     REQUIRE(ebpf_hash_table_key_count(table.get()) == 0);
 }
 
+TEST_CASE("hash_table_create_from_records", "[platform]")
+{
+    _test_helper test_helper;
+    test_helper.initialize();
+
+    const size_t record_count = 1000;
+    const ebpf_hash_table_creation_options_t options = {
+        .key_size = sizeof(uint32_t),
+        .value_size = sizeof(uint64_t),
+        .allocate = ebpf_allocate,
+        .free = ebpf_free,
+        .minimum_bucket_count = 64,
+        .max_entries = record_count,
+    };
+
+    ebpf_hash_table_t* raw_ptr = nullptr;
+    REQUIRE(ebpf_hash_table_create(&raw_ptr, &options) == EBPF_SUCCESS);
+    ebpf_hash_table_ptr template_table(raw_ptr);
+
+    // Build records with one duplicate key at the end, which should replace the first value.
+#pragma pack(push, 1)
+    struct _packed_record
+    {
+        uint32_t key;
+        uint64_t value;
+    };
+#pragma pack(pop)
+    std::vector<_packed_record> records(record_count + 1);
+    for (uint32_t index = 0; index < record_count; index++) {
+        records[index] = {index, static_cast<uint64_t>(index) * 7};
+    }
+    records[record_count] = {0, 42};
+
+    raw_ptr = nullptr;
+    REQUIRE(
+        ebpf_hash_table_create_from_records(
+            template_table.get(), records.size(), reinterpret_cast<const uint8_t*>(records.data()), &raw_ptr) ==
+        EBPF_SUCCESS);
+    ebpf_hash_table_ptr table(raw_ptr);
+    REQUIRE(ebpf_hash_table_key_count(table.get()) == record_count);
+    REQUIRE(ebpf_hash_table_key_count(template_table.get()) == 0);
+    REQUIRE(ebpf_hash_table_longest_bucket_length(template_table.get()) == 0);
+    REQUIRE(ebpf_hash_table_longest_bucket_length(table.get()) > 0);
+    REQUIRE(ebpf_hash_table_longest_bucket_length(table.get()) < record_count);
+
+    for (uint32_t index = 0; index < record_count; index++) {
+        uint8_t* value = nullptr;
+        REQUIRE(ebpf_hash_table_find(table.get(), reinterpret_cast<uint8_t*>(&index), &value) == EBPF_SUCCESS);
+        REQUIRE(*reinterpret_cast<uint64_t*>(value) == (index == 0 ? 42 : static_cast<uint64_t>(index) * 7));
+    }
+
+    // The bulk built table supports the regular update and delete operations.
+    for (uint32_t index = 0; index < record_count; index += 2) {
+        REQUIRE(ebpf_hash_table_delete(table.get(), reinterpret_cast<uint8_t*>(&index)) == EBPF_SUCCESS);
+    }
+    REQUIRE(ebpf_hash_table_key_count(table.get()) == record_count / 2);
+    uint32_t key = 0;
+    uint64_t value = 1;
+    REQUIRE(
+        ebpf_hash_table_update(
+            table.get(),
+            reinterpret_cast<uint8_t*>(&key),
+            reinterpret_cast<uint8_t*>(&value),
+            EBPF_HASH_TABLE_OPERATION_INSERT) == EBPF_SUCCESS);
+
+    // Exceeding the maximum number of entries fails.
+    records.push_back({static_cast<uint32_t>(record_count), 0});
+    raw_ptr = nullptr;
+    REQUIRE(
+        ebpf_hash_table_create_from_records(
+            template_table.get(), records.size(), reinterpret_cast<const uint8_t*>(records.data()), &raw_ptr) ==
+        EBPF_OUT_OF_SPACE);
+    REQUIRE(raw_ptr == nullptr);
+}
+
 void
 run_in_epoch(std::function<void()> function)
 {
@@ -506,6 +583,24 @@ TEST_CASE("pinning_test", "[platform]")
     REQUIRE(ebpf_pinning_table_delete(pinning_table.get(), &foo) == EBPF_SUCCESS);
     REQUIRE(another_object.object.base.reference_count == 2);
 
+    // A batch that collides with an existing path must not insert any of its entries.
+    cxplat_utf8_string_t baz = CXPLAT_UTF8_STRING_FROM_CONST_STRING("baz");
+    ebpf_pinning_entry_t colliding_entries[] = {{foo, &an_object.object}, {bar, &an_object.object}};
+    REQUIRE(
+        ebpf_pinning_table_insert_batch(pinning_table.get(), _countof(colliding_entries), colliding_entries) ==
+        EBPF_OBJECT_ALREADY_EXISTS);
+    REQUIRE(an_object.object.base.reference_count == 1);
+    REQUIRE(an_object.object.pinned_path_count == 0);
+    REQUIRE(ebpf_pinning_table_find(pinning_table.get(), &foo, (ebpf_core_object_t**)&some_object) != EBPF_SUCCESS);
+
+    ebpf_pinning_entry_t entries[] = {{foo, &an_object.object}, {baz, &an_object.object}};
+    REQUIRE(ebpf_pinning_table_insert_batch(pinning_table.get(), _countof(entries), entries) == EBPF_SUCCESS);
+    REQUIRE(an_object.object.base.reference_count == 3);
+    REQUIRE(an_object.object.pinned_path_count == 2);
+    REQUIRE(ebpf_pinning_table_find(pinning_table.get(), &baz, (ebpf_core_object_t**)&some_object) == EBPF_SUCCESS);
+    REQUIRE(some_object == &an_object);
+    EBPF_OBJECT_RELEASE_REFERENCE(&some_object->object);
+
     ebpf_pinning_table_free(pinning_table.release());
     REQUIRE(an_object.object.base.reference_count == 1);
     REQUIRE(another_object.object.base.reference_count == 1);
@@ -607,6 +702,111 @@ TEST_CASE("epoch_test_stale_items", "[platform]")
     }
 }
 
+/**
+ * @brief Verify that a thread that is migrated to another CPU while in an epoch can exit the epoch on the new CPU and
+ * that reclamation still waits for it.
+ */
+TEST_CASE("epoch_test_migrated_exit", "[platform]")
+{
+    _test_helper test_helper;
+    test_helper.initialize();
+    _signal signal_entered;
+
+    if (ebpf_get_cpu_count() < 2) {
+        return;
+    }
+
+    std::atomic<bool> synchronize_complete = false;
+    bool synchronize_completed_early = true;
+
+    auto reader = [&]() {
+        uintptr_t old_thread_affinity;
+        ebpf_assert_success(ebpf_set_current_thread_affinity(1, &old_thread_affinity));
+        ebpf_epoch_scope_t epoch_scope;
+        signal_entered.signal();
+
+        // ebpf_epoch_synchronize must not complete while this thread is still in the epoch.
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        synchronize_completed_early = synchronize_complete;
+
+        // Move to a different CPU and exit the epoch there.
+        ebpf_assert_success(ebpf_set_current_thread_affinity(2, &old_thread_affinity));
+        epoch_scope.exit();
+    };
+    auto writer = [&]() {
+        signal_entered.wait();
+        ebpf_epoch_synchronize();
+        synchronize_complete = true;
+    };
+
+    std::thread reader_thread(reader);
+    std::thread writer_thread(writer);
+    reader_thread.join();
+    writer_thread.join();
+
+    REQUIRE(!synchronize_completed_early);
+    REQUIRE(synchronize_complete);
+}
+
+/**
+ * @brief Stress epoch enter/exit with threads that are moved to a different CPU on every iteration while in the epoch,
+ * concurrently with epoch computation.
+ */
+TEST_CASE("epoch_test_migration_stress", "[platform]")
+{
+    _test_helper test_helper;
+    test_helper.initialize();
+
+    uint32_t cpu_count = ebpf_get_cpu_count();
+    if (cpu_count < 2) {
+        return;
+    }
+
+    size_t const test_iterations = 1000;
+    std::atomic<bool> stop = false;
+
+    auto worker = [&](uint32_t thread_index) {
+        uintptr_t old_thread_affinity;
+        for (size_t iteration = 0; iteration < test_iterations; iteration++) {
+            uint32_t enter_cpu = (uint32_t)((thread_index + iteration) % cpu_count);
+            uint32_t exit_cpu = (enter_cpu + 1) % cpu_count;
+            ebpf_assert_success(ebpf_set_current_thread_affinity((uintptr_t)1 << enter_cpu, &old_thread_affinity));
+            ebpf_epoch_scope_t epoch_scope;
+            void* memory = ebpf_epoch_allocate(10);
+            ebpf_epoch_free(memory);
+            ebpf_assert_success(ebpf_set_current_thread_affinity((uintptr_t)1 << exit_cpu, &old_thread_affinity));
+            epoch_scope.exit();
+        }
+    };
+    auto synchronizer = [&]() {
+        while (!stop) {
+            ebpf_epoch_synchronize();
+        }
+    };
+
+    std::thread synchronizer_thread(synchronizer);
+    std::vector<std::thread> threads;
+    for (uint32_t thread_index = 0; thread_index < cpu_count * 2; thread_index++) {
+        threads.emplace_back(worker, thread_index);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stop = true;
+    synchronizer_thread.join();
+
+    ebpf_epoch_synchronize();
+    for (uint32_t cpu_id = 0; cpu_id < cpu_count; cpu_id++) {
+        for (size_t retry = 0; retry < 100; retry++) {
+            if (ebpf_epoch_is_free_list_empty(cpu_id)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(ebpf_epoch_is_free_list_empty(cpu_id));
+    }
+}
+
 static auto provider_function = []() { return EBPF_SUCCESS; };
 
 TEST_CASE("trampoline_test", "[platform]")
@@ -1346,6 +1546,77 @@ TEST_CASE("verify random", "[platform]")
     }
 }
 
+TEST_CASE("verify clock", "[platform]")
+{
+    REQUIRE(ebpf_platform_initiate() == EBPF_SUCCESS);
+    REQUIRE(ebpf_clock_initiate() == EBPF_SUCCESS);
+
+    // Let enough time pass for the cycle counter to be calibrated.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    {
+        _raise_irql_to_dpc_helper irql_helper;
+
+        // The fast clock has the same time base as the precise clock and never goes backwards.
+        uint64_t previous_fast_ns = ebpf_clock_get_fast_ns();
+        for (size_t i = 0; i < 1000; i++) {
+            uint64_t precise_ns = ebpf_query_time_since_boot(false) * EBPF_NS_PER_FILETIME;
+            uint64_t fast_ns = ebpf_clock_get_fast_ns();
+            REQUIRE(fast_ns >= previous_fast_ns);
+            REQUIRE(fast_ns + 1000000 > precise_ns);
+            REQUIRE(fast_ns < precise_ns + 1000000);
+            previous_fast_ns = fast_ns;
+        }
+
+        // The coarse clock lags the precise clock by at most one clock tick.
+        uint64_t coarse_ns = ebpf_clock_get_coarse_ns();
+        uint64_t precise_ns = ebpf_query_time_since_boot(false) * EBPF_NS_PER_FILETIME;
+        REQUIRE(coarse_ns <= precise_ns);
+        REQUIRE(precise_ns - coarse_ns < 100000000);
+    }
+
+    ebpf_clock_terminate();
+    ebpf_platform_terminate();
+}
+
+TEST_CASE("verify clock across cpus", "[platform]")
+{
+    REQUIRE(ebpf_platform_initiate() == EBPF_SUCCESS);
+    REQUIRE(ebpf_clock_initiate() == EBPF_SUCCESS);
+
+    // Run across a recalibration on threads bound to different CPUs. A time read after another thread published its
+    // time must never be smaller, whichever CPU either read was made on.
+    uint32_t thread_count = std::min(ebpf_get_cpu_count(), 4u);
+    std::atomic<uint64_t> latest_ns = 0;
+    std::atomic<bool> went_backwards = false;
+    auto end_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(1500);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < thread_count; i++) {
+        threads.emplace_back([&, i]() {
+            SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << i);
+            while (std::chrono::steady_clock::now() < end_time) {
+                for (size_t j = 0; j < 1000; j++) {
+                    uint64_t published_ns = latest_ns.load();
+                    uint64_t now_ns = ebpf_clock_get_fast_ns();
+                    if (now_ns < published_ns) {
+                        went_backwards = true;
+                    }
+                    uint64_t expected_ns = published_ns;
+                    while (expected_ns < now_ns && !latest_ns.compare_exchange_weak(expected_ns, now_ns)) {
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(!went_backwards);
+
+    ebpf_clock_terminate();
+    ebpf_platform_terminate();
+}
+
 TEST_CASE("work_queue", "[platform]")
 {
     _test_helper test_helper;
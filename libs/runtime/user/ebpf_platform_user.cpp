@@ -22,6 +22,8 @@
 // Global variables used to override behavior for testing.
 // Permit the test to simulate both Hyper-V Code Integrity.
 bool _ebpf_platform_code_integrity_enabled = false;
+// Permit the test to simulate a system with multiple NUMA nodes.
+uint32_t _ebpf_platform_numa_node_count = 1;
 
 extern "C" size_t ebpf_fuzzing_memory_limit = MAXSIZE_T;
 
@@ -39,6 +41,71 @@ ebpf_get_code_integrity_state(_Out_ ebpf_code_integrity_state_t* state)
     EBPF_RETURN_RESULT(EBPF_SUCCESS);
 }
 
+// User mode simulates NUMA nodes by splitting the CPUs into contiguous blocks of equal size.
+_Ret_range_(>, 0) uint32_t ebpf_get_numa_node_count()
+{
+    uint32_t cpu_count = ebpf_get_cpu_count();
+    if (_ebpf_platform_numa_node_count == 0) {
+        return 1;
+    }
+    return (_ebpf_platform_numa_node_count < cpu_count) ? _ebpf_platform_numa_node_count : cpu_count;
+}
+
+uint32_t
+ebpf_get_cpu_numa_node(uint32_t cpu_id)
+{
+    uint32_t cpu_count = ebpf_get_cpu_count();
+    if (cpu_id >= cpu_count) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)cpu_id * ebpf_get_numa_node_count()) / cpu_count);
+}
+
+uint32_t
+ebpf_get_current_numa_node()
+{
+    return ebpf_get_cpu_numa_node(ebpf_get_current_cpu());
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_set_current_thread_numa_node(uint32_t numa_node, _Out_ GROUP_AFFINITY* old_thread_affinity)
+{
+    memset(old_thread_affinity, 0, sizeof(*old_thread_affinity));
+    if (numa_node >= ebpf_get_numa_node_count()) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    // Find the first CPU of the simulated node, then the processor group it belongs to.
+    uint32_t cpu_count = ebpf_get_cpu_count();
+    uint32_t cpu_id = 0;
+    while (cpu_id < cpu_count && ebpf_get_cpu_numa_node(cpu_id) != numa_node) {
+        cpu_id++;
+    }
+
+    GROUP_AFFINITY affinity = {0};
+    WORD group_count = GetActiveProcessorGroupCount();
+    for (WORD group = 0; group < group_count; group++) {
+        DWORD group_cpu_count = GetActiveProcessorCount(group);
+        if (cpu_id < group_cpu_count) {
+            affinity.Group = group;
+            affinity.Mask = (KAFFINITY)1 << cpu_id;
+            break;
+        }
+        cpu_id -= group_cpu_count;
+    }
+
+    if (affinity.Mask == 0 || !SetThreadGroupAffinity(GetCurrentThread(), &affinity, old_thread_affinity)) {
+        return EBPF_OPERATION_NOT_SUPPORTED;
+    }
+    return EBPF_SUCCESS;
+}
+
+void
+ebpf_restore_current_thread_group_affinity(_In_ const GROUP_AFFINITY* old_thread_affinity)
+{
+    (void)SetThreadGroupAffinity(GetCurrentThread(), old_thread_affinity, nullptr);
+}
+
 struct _ebpf_ring_descriptor
 {
     void* primary_view;
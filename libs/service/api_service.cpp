@@ -3,6 +3,7 @@
 
 #include "api_common.hpp"
 #include "api_service.h"
+#include "byte_code_optimizer.h"
 #include "device_helper.hpp"
 #include "ebpf_protocol.h"
 #include "ebpf_shared_framework.h"
@@ -16,6 +17,7 @@ extern "C"
 #include "verifier_service.h"
 #include "windows_platform.hpp"
 
+#include <algorithm>
 #include <map>
 #include <stdexcept>
 
@@ -26,41 +28,92 @@ extern "C"
 // but doesn't expose the define to callers, so we define it here.
 #define UBPF_MAX_EXT_FUNCS 64
 
+// Calls with this src value target a local (BPF-to-BPF) function and carry no helper id.
+#define EBPF_CALL_LOCAL 0x01
+
+// Maps, helper functions and the log function used by a program, as resolved by the execution context.
+typedef struct _resolved_program
+{
+    std::vector<size_t> map_instruction_offsets; // 0-based instruction number of each map load.
+    std::vector<uint64_t> map_addresses;         // Address of the map loaded by each instruction.
+    std::map<uint32_t, uint64_t> helper_id_to_address;
+    uint64_t log_function_address = 0;
+} resolved_program_t;
+
+// Query the map descriptors, resolve the helper functions and maps used by the byte code, and get the log function
+// address in a single round trip to the execution context.
 static ebpf_result_t
-_resolve_helper_functions(
+_resolve_program(
     ebpf_handle_t program_handle,
-    _In_reads_(instruction_count) ebpf_inst* instructions,
+    _In_reads_(handle_map_count) const original_fd_handle_map_t* handle_map,
+    uint32_t handle_map_count,
+    _In_reads_(instruction_count) const ebpf_inst* instructions,
     uint32_t instruction_count,
-    std::map<uint32_t, uint64_t>& helper_id_to_address)
+    resolved_program_t& resolved_program)
 {
-    // Note:
-    // eBPF supports helper IDs in the range [1, MAXUINT32]
-    // uBPF jitter only supports helper IDs in the range [0,63]
-    // Build a table to map [1, MAXUINT32] -> [0,63]
+    std::vector<uint32_t> map_reference_indices; // Index into handle_map of the map used by each map load.
+
     for (size_t index = 0; index < instruction_count; index++) {
-        ebpf_inst& instruction = instructions[index];
-        if (instruction.opcode != INST_OP_CALL) {
+        const ebpf_inst& instruction = instructions[index];
+        if (instruction.opcode == INST_OP_CALL && instruction.src != EBPF_CALL_LOCAL) {
+            resolved_program.helper_id_to_address[instruction.imm] = 0;
+            continue;
+        }
+        if (instruction.opcode != INST_OP_LDDW_IMM) {
+            continue;
+        }
+        // A truncated LDDW is left for the verifier to reject.
+        if (index + 1 >= instruction_count) {
+            break;
+        }
+        index++;
+
+        // Check for LD_MAP flag.
+        if (instruction.src != 1) {
             continue;
         }
-        helper_id_to_address[instruction.imm] = 0;
-    }
 
-    ebpf_protocol_buffer_t request_buffer(
-        offsetof(ebpf_operation_resolve_helper_request_t, helper_id) + sizeof(uint32_t) * helper_id_to_address.size());
+        // An unknown map fd has no descriptor, so the verifier rejects the program before the map is needed.
+        for (uint32_t map_index = 0; map_index < handle_map_count; map_index++) {
+            if (handle_map[map_index].original_fd == static_cast<uint32_t>(instruction.imm)) {
+                resolved_program.map_instruction_offsets.push_back(index - 1);
+                map_reference_indices.push_back(map_index);
+                break;
+            }
+        }
+    }
 
-    ebpf_protocol_buffer_t reply_buffer(
-        offsetof(ebpf_operation_resolve_helper_reply_t, address) + sizeof(uint64_t) * helper_id_to_address.size());
+    size_t map_reference_count = map_reference_indices.size();
+    size_t helper_count = resolved_program.helper_id_to_address.size();
+    size_t request_size = EBPF_OFFSET_OF(ebpf_operation_resolve_program_request_t, data) +
+                          handle_map_count * sizeof(ebpf_handle_t) + map_reference_count * sizeof(uint32_t) +
+                          helper_count * sizeof(uint32_t);
+    size_t reply_size = EBPF_OFFSET_OF(ebpf_operation_resolve_program_reply_t, data) +
+                        (map_reference_count + helper_count) * sizeof(uint64_t) +
+                        handle_map_count * sizeof(ebpf_operation_resolve_program_map_definition_t);
+    if (request_size > UINT16_MAX || reply_size > UINT16_MAX) {
+        return EBPF_INVALID_ARGUMENT;
+    }
 
-    auto request = reinterpret_cast<ebpf_operation_resolve_helper_request_t*>(request_buffer.data());
-    auto reply = reinterpret_cast<ebpf_operation_resolve_helper_reply_t*>(reply_buffer.data());
-    request->header.id = ebpf_operation_id_t::EBPF_OPERATION_RESOLVE_HELPER;
+    ebpf_protocol_buffer_t request_buffer(request_size);
+    ebpf_protocol_buffer_t reply_buffer(reply_size);
+    auto request = reinterpret_cast<ebpf_operation_resolve_program_request_t*>(request_buffer.data());
+    auto reply = reinterpret_cast<ebpf_operation_resolve_program_reply_t*>(reply_buffer.data());
+    request->header.id = ebpf_operation_id_t::EBPF_OPERATION_RESOLVE_PROGRAM;
     request->header.length = static_cast<uint16_t>(request_buffer.size());
     request->program_handle = program_handle;
-
-    uint32_t index = 0;
-    for (auto& [helper_id, address] : helper_id_to_address) {
-        request->helper_id[index] = helper_id;
-        index++;
+    request->map_count = handle_map_count;
+    request->map_reference_count = static_cast<uint32_t>(map_reference_count);
+
+    auto map_handles = reinterpret_cast<ebpf_handle_t*>(request->data);
+    auto request_map_reference_indices = reinterpret_cast<uint32_t*>(map_handles + handle_map_count);
+    auto helper_ids = request_map_reference_indices + map_reference_count;
+    for (uint32_t map_index = 0; map_index < handle_map_count; map_index++) {
+        map_handles[map_index] = reinterpret_cast<ebpf_handle_t>(handle_map[map_index].handle);
+    }
+    std::copy(map_reference_indices.begin(), map_reference_indices.end(), request_map_reference_indices);
+    for (auto& [helper_id, address] : resolved_program.helper_id_to_address) {
+        *helper_ids++ = helper_id;
     }
 
     uint32_t result = invoke_ioctl(request_buffer, reply_buffer);
@@ -68,9 +121,32 @@ _resolve_helper_functions(
         return win32_error_code_to_ebpf_result(result);
     }
 
-    index = 0;
-    for (auto& [helper_id, helper_address] : helper_id_to_address) {
-        helper_address = reply->address[index++];
+    if (reply->header.id != ebpf_operation_id_t::EBPF_OPERATION_RESOLVE_PROGRAM) {
+        return EBPF_INVALID_ARGUMENT;
+    }
+
+    auto addresses = reinterpret_cast<const uint64_t*>(reply->data);
+    resolved_program.map_addresses.assign(addresses, addresses + map_reference_count);
+    addresses += map_reference_count;
+    for (auto& [helper_id, helper_address] : resolved_program.helper_id_to_address) {
+        helper_address = *addresses++;
+    }
+    resolved_program.log_function_address = reply->log_function_address;
+
+    auto map_definitions = reinterpret_cast<const ebpf_operation_resolve_program_map_definition_t*>(addresses);
+    for (uint32_t map_index = 0; map_index < handle_map_count; map_index++) {
+        const ebpf_operation_resolve_program_map_definition_t& definition = map_definitions[map_index];
+        cache_map_original_file_descriptor_with_handle(
+            handle_map[map_index].original_fd,
+            handle_map[map_index].id,
+            definition.type,
+            definition.key_size,
+            definition.value_size,
+            definition.max_entries,
+            handle_map[map_index].inner_map_original_fd,
+            handle_map[map_index].inner_id,
+            reinterpret_cast<ebpf_handle_t>(handle_map[map_index].handle),
+            0);
     }
 
     return EBPF_SUCCESS;
@@ -107,7 +183,7 @@ _build_helper_id_to_address_map(
     // Replace old helper_ids in range [1, MAXUINT32] with new helper ids in range [0,63]
     for (index = 0; index < instruction_count; index++) {
         ebpf_inst& instruction = instructions[index];
-        if (instruction.opcode != INST_OP_CALL) {
+        if (instruction.opcode != INST_OP_CALL || instruction.src == EBPF_CALL_LOCAL) {
             continue;
         }
         instruction.imm = helper_id_mapping[instruction.imm];
@@ -124,135 +200,22 @@ _build_helper_id_to_address_map(
     return EBPF_SUCCESS;
 }
 
-static ebpf_result_t
-_resolve_ec_function(ebpf_ec_function_t function, uint64_t* address)
-{
-    ebpf_operation_get_ec_function_request_t request = {sizeof(request), EBPF_OPERATION_GET_EC_FUNCTION, function};
-    ebpf_operation_get_ec_function_reply_t reply;
-
-    uint32_t result = invoke_ioctl(request, reply);
-    if (result != ERROR_SUCCESS) {
-        return win32_error_code_to_ebpf_result(result);
-    }
-
-    if (reply.header.id != ebpf_operation_id_t::EBPF_OPERATION_GET_EC_FUNCTION) {
-        return EBPF_INVALID_ARGUMENT;
-    }
-
-    *address = reply.address;
-
-    return EBPF_SUCCESS;
-}
-
 // Replace map fds with map addresses.
-static ebpf_result_t
-_resolve_maps_in_byte_code(
-    ebpf_handle_t program_handle, _In_reads_(instruction_count) ebpf_inst* instructions, uint32_t instruction_count)
+static void
+_relocate_maps_in_byte_code(_Inout_ ebpf_inst* instructions, const resolved_program_t& resolved_program)
 {
-    // Create parallel vectors indexed by # of occurrence in the instructions.
-    std::vector<size_t> instruction_offsets; // 0-based instruction number.
-    std::vector<fd_t> map_fds;               // map_fd used in the bytecode.
-
-    for (size_t index = 0; index < instruction_count; index++) {
-        ebpf_inst& first_instruction = instructions[index];
-        if (first_instruction.opcode != INST_OP_LDDW_IMM) {
-            continue;
-        }
-        if (index + 1 >= instruction_count) {
-            return EBPF_INVALID_ARGUMENT;
-        }
-        index++;
-
-        // Check for LD_MAP flag
-        if (first_instruction.src != 1) {
-            continue;
-        }
-
-        fd_t map_fd = static_cast<fd_t>(first_instruction.imm);
-        instruction_offsets.push_back(index - 1);
-        map_fds.push_back(map_fd);
-    }
-
-    if (map_fds.empty()) {
-        return EBPF_SUCCESS;
-    }
-
-    ebpf_protocol_buffer_t request_buffer(
-        offsetof(ebpf_operation_resolve_map_request_t, map_handle) + sizeof(uint64_t) * map_fds.size());
-
-    ebpf_protocol_buffer_t reply_buffer(
-        offsetof(ebpf_operation_resolve_map_reply_t, address) + sizeof(uint64_t) * map_fds.size());
-
-    auto request = reinterpret_cast<ebpf_operation_resolve_map_request_t*>(request_buffer.data());
-    auto reply = reinterpret_cast<ebpf_operation_resolve_map_reply_t*>(reply_buffer.data());
-    request->header.id = ebpf_operation_id_t::EBPF_OPERATION_RESOLVE_MAP;
-    request->header.length = static_cast<uint16_t>(request_buffer.size());
-    request->program_handle = program_handle;
-
-    for (size_t index = 0; index < map_fds.size(); index++) {
-        request->map_handle[index] = get_map_handle(map_fds[index]);
-    }
-
-    uint32_t result = invoke_ioctl(request_buffer, reply_buffer);
-    if (result != ERROR_SUCCESS) {
-        return win32_error_code_to_ebpf_result(result);
-    }
-
-    for (size_t index = 0; index < map_fds.size(); index++) {
-        ebpf_inst& first_instruction = instructions[instruction_offsets[index]];
-        ebpf_inst& second_instruction = instructions[instruction_offsets[index] + 1];
+    for (size_t index = 0; index < resolved_program.map_instruction_offsets.size(); index++) {
+        ebpf_inst& first_instruction = instructions[resolved_program.map_instruction_offsets[index]];
+        ebpf_inst& second_instruction = instructions[resolved_program.map_instruction_offsets[index] + 1];
 
         // Clear LD_MAP flag
         first_instruction.src = 0;
 
         // Replace handle with address
-        uint64_t new_imm = reply->address[index];
+        uint64_t new_imm = resolved_program.map_addresses[index];
         first_instruction.imm = static_cast<uint32_t>(new_imm);
         second_instruction.imm = static_cast<uint32_t>(new_imm >> 32);
     }
-
-    return EBPF_SUCCESS;
-}
-
-static ebpf_result_t
-_query_and_cache_map_descriptors(
-    _In_reads_(handle_map_count) original_fd_handle_map_t* handle_map, uint32_t handle_map_count)
-{
-    ebpf_result_t result;
-    EbpfMapDescriptor descriptor;
-
-    if (handle_map_count > 0) {
-        for (uint32_t i = 0; i < handle_map_count; i++) {
-            descriptor = {0};
-            ebpf_id_t id;
-            ebpf_id_t inner_map_id;
-            result = query_map_definition(
-                reinterpret_cast<ebpf_handle_t>(handle_map[i].handle),
-                &id,
-                &descriptor.type,
-                &descriptor.key_size,
-                &descriptor.value_size,
-                &descriptor.max_entries,
-                &inner_map_id);
-            if (result != EBPF_SUCCESS) {
-                return result;
-            }
-
-            cache_map_original_file_descriptor_with_handle(
-                handle_map[i].original_fd,
-                handle_map[i].id,
-                descriptor.type,
-                descriptor.key_size,
-                descriptor.value_size,
-                descriptor.max_entries,
-                handle_map[i].inner_map_original_fd,
-                handle_map[i].inner_id,
-                reinterpret_cast<ebpf_handle_t>(handle_map[i].handle),
-                0);
-        }
-    }
-
-    return EBPF_SUCCESS;
 }
 
 _Must_inspect_result_ ebpf_result_t
@@ -270,7 +233,6 @@ ebpf_verify_and_load_program(
 {
     ebpf_result_t result = EBPF_SUCCESS;
     int error = 0;
-    uint64_t log_function_address;
     struct ubpf_vm* vm = nullptr;
     ebpf_protocol_buffer_t request_buffer;
     ebpf_operation_load_code_request_t* request = nullptr;
@@ -292,15 +254,11 @@ ebpf_verify_and_load_program(
 
     clear_map_descriptors();
 
-    // Query map descriptors from execution context.
     try {
-        result = _query_and_cache_map_descriptors(handle_map, handle_map_count);
-        if (result != EBPF_SUCCESS) {
-            goto Exit;
-        }
-
-        std::map<uint32_t, uint64_t> helper_id_to_address;
-        result = _resolve_helper_functions(program_handle, instructions, instruction_count, helper_id_to_address);
+        // Query map descriptors and resolve maps and helpers in one request to the execution context.
+        resolved_program_t resolved_program;
+        result = _resolve_program(
+            program_handle, handle_map, handle_map_count, instructions, instruction_count, resolved_program);
         if (result != EBPF_SUCCESS) {
             goto Exit;
         }
@@ -314,24 +272,17 @@ ebpf_verify_and_load_program(
             }
         }
 
-        result = _resolve_maps_in_byte_code(program_handle, instructions, instruction_count);
-        if (result != EBPF_SUCCESS) {
-            goto Exit;
-        }
-
-        result = _resolve_ec_function(EBPF_EC_FUNCTION_LOG, &log_function_address);
-        if (result != EBPF_SUCCESS) {
-            goto Exit;
-        }
+        _relocate_maps_in_byte_code(instructions, resolved_program);
 
         uint32_t unwind_index;
-        result = _build_helper_id_to_address_map(instructions, instruction_count, helper_id_to_address, unwind_index);
+        result = _build_helper_id_to_address_map(
+            instructions, instruction_count, resolved_program.helper_id_to_address, unwind_index);
         if (result != EBPF_SUCCESS) {
             goto Exit;
         }
 
         std::vector<uint64_t> helper_id_address;
-        for (auto& [helper_id, address] : helper_id_to_address) {
+        for (auto& [helper_id, address] : resolved_program.helper_id_to_address) {
             helper_id_address.push_back(address);
         }
 
@@ -363,7 +314,15 @@ ebpf_verify_and_load_program(
             }
 
             ubpf_set_error_print(
-                vm, reinterpret_cast<int (*)(FILE * stream, const char* format, ...)>(log_function_address));
+                vm,
+                reinterpret_cast<int (*)(FILE * stream, const char* format, ...)>(
+                    resolved_program.log_function_address));
+
+            // Native images are optimized by the C compiler, but the JIT translates instructions one at a time, so
+            // optimize the verified byte code first.
+            uint32_t optimized_instruction_count = instruction_count;
+            optimize_byte_code(instructions, &optimized_instruction_count, nullptr);
+            byte_code_size = optimized_instruction_count * sizeof(*instructions);
 
             if (ubpf_load(
                     vm, byte_code_data, static_cast<uint32_t>(byte_code_size), const_cast<char**>(error_message)) < 0) {
@@ -0,0 +1,924 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+// Optimization pass over verified byte code that runs before the uBPF JIT compiler translates it. Native images are
+// optimized by the C compiler, but the JIT translates one instruction at a time, so without this pass every redundant
+// move, constant computation and repeated comparison that clang emitted ends up in the machine code.
+//
+// Each round of the pass does the following, and rounds are repeated until the program stops changing:
+// 1. Constants are propagated along straight-line code and into jump targets that have a single predecessor. ALU
+//    instructions on known values become constant loads, and loads of a value the register already holds are dropped.
+//    Conditional jumps are folded when both operands are known, or when the same comparison was already made on the
+//    only path leading to them, which removes repeated bounds checks of the same registers.
+// 2. Jumps to unconditional jumps are threaded to the final target, and jumps to the next instruction are dropped.
+// 3. Instructions that can no longer be reached are removed.
+// 4. ALU instructions and constant loads whose result is never read are removed.
+// Loads, stores and helper calls are never removed or reordered.
+
+#include "byte_code_optimizer.h"
+#include "ebpf.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// Calls with this src value target a local (BPF-to-BPF) function and carry no helper id.
+#define EBPF_CALL_LOCAL 0x01
+
+// Operation field of ALU and JMP class instructions.
+#define BYTE_CODE_OPERATION_MASK 0xf0
+#define BYTE_CODE_ALU_ADD 0x00
+#define BYTE_CODE_ALU_SUB 0x10
+#define BYTE_CODE_ALU_MUL 0x20
+#define BYTE_CODE_ALU_OR 0x40
+#define BYTE_CODE_ALU_AND 0x50
+#define BYTE_CODE_ALU_LSH 0x60
+#define BYTE_CODE_ALU_RSH 0x70
+#define BYTE_CODE_ALU_NEG 0x80
+#define BYTE_CODE_ALU_XOR 0xa0
+#define BYTE_CODE_ALU_MOV 0xb0
+#define BYTE_CODE_ALU_ARSH 0xc0
+#define BYTE_CODE_JMP_JA 0x00
+#define BYTE_CODE_JMP_JEQ 0x10
+#define BYTE_CODE_JMP_JGT 0x20
+#define BYTE_CODE_JMP_JGE 0x30
+#define BYTE_CODE_JMP_JSET 0x40
+#define BYTE_CODE_JMP_JNE 0x50
+#define BYTE_CODE_JMP_JSGT 0x60
+#define BYTE_CODE_JMP_JSGE 0x70
+#define BYTE_CODE_JMP_CALL 0x80
+#define BYTE_CODE_JMP_EXIT 0x90
+#define BYTE_CODE_JMP_JLT 0xa0
+#define BYTE_CODE_JMP_JLE 0xb0
+#define BYTE_CODE_JMP_JSLT 0xc0
+#define BYTE_CODE_JMP_JSLE 0xd0
+
+// Mode field of load and store class instructions.
+#define BYTE_CODE_MODE_MASK 0xe0
+#define BYTE_CODE_MODE_ATOMIC 0xc0
+
+#define BYTE_CODE_REGISTER_COUNT 11
+#define BYTE_CODE_REGISTER(index) ((uint16_t)(1 << (index)))
+#define BYTE_CODE_ALL_REGISTERS ((uint16_t)(BYTE_CODE_REGISTER(BYTE_CODE_REGISTER_COUNT) - 1))
+#define BYTE_CODE_RETURN_REGISTER BYTE_CODE_REGISTER(0)
+#define BYTE_CODE_ARGUMENT_REGISTERS ((uint16_t)0x003e)    // r1-r5
+#define BYTE_CODE_CALLER_SAVED_REGISTERS ((uint16_t)0x003f) // r0-r5
+
+// Each round can expose more work for the next one, but programs normally stop changing after two or three rounds.
+#define BYTE_CODE_OPTIMIZER_MAX_ROUNDS 8
+
+// Maximum number of branch outcomes remembered along a path.
+#define BYTE_CODE_MAX_BRANCH_FACTS 8
+
+// Maximum number of unconditional jumps followed when threading a jump.
+#define BYTE_CODE_MAX_THREADING_DEPTH 8
+
+typedef struct _branch_fact
+{
+    uint8_t opcode;
+    uint8_t dst;
+    uint8_t src;
+    int32_t imm;
+    bool taken;
+} branch_fact_t;
+
+// What is known about the registers at a point of the program, on every path that reaches it.
+typedef struct _path_state
+{
+    uint16_t known_registers;
+    uint64_t value[BYTE_CODE_REGISTER_COUNT];
+    uint32_t fact_count;
+    branch_fact_t facts[BYTE_CODE_MAX_BRANCH_FACTS];
+} path_state_t;
+
+typedef struct _program_graph
+{
+    std::vector<uint32_t> predecessor_count;
+    std::vector<bool> fallthrough_predecessor;
+    std::vector<bool> entry_point;
+} program_graph_t;
+
+static inline uint8_t
+_class(const ebpf_inst& instruction)
+{
+    return instruction.opcode & EBPF_CLS_MASK;
+}
+
+static inline uint8_t
+_operation(const ebpf_inst& instruction)
+{
+    return instruction.opcode & BYTE_CODE_OPERATION_MASK;
+}
+
+static inline bool
+_is_alu(const ebpf_inst& instruction)
+{
+    return _class(instruction) == EBPF_CLS_ALU || _class(instruction) == EBPF_CLS_ALU64;
+}
+
+static inline bool
+_is_jump_class(const ebpf_inst& instruction)
+{
+    return _class(instruction) == EBPF_CLS_JMP || _class(instruction) == EBPF_CLS_JMP32;
+}
+
+static inline bool
+_is_unconditional_jump(const ebpf_inst& instruction)
+{
+    return _is_jump_class(instruction) && _operation(instruction) == BYTE_CODE_JMP_JA;
+}
+
+static inline bool
+_is_conditional_jump(const ebpf_inst& instruction)
+{
+    if (!_is_jump_class(instruction)) {
+        return false;
+    }
+    uint8_t operation = _operation(instruction);
+    return operation != BYTE_CODE_JMP_JA && operation != BYTE_CODE_JMP_CALL && operation != BYTE_CODE_JMP_EXIT;
+}
+
+static inline bool
+_is_local_call(const ebpf_inst& instruction)
+{
+    return instruction.opcode == EBPF_OP_CALL && instruction.src == EBPF_CALL_LOCAL;
+}
+
+static inline bool
+_is_constant_load(const ebpf_inst& instruction)
+{
+    return (instruction.opcode == EBPF_OP_MOV64_IMM || instruction.opcode == EBPF_OP_MOV_IMM) &&
+           instruction.offset == 0;
+}
+
+static inline size_t
+_slots(const ebpf_inst& instruction)
+{
+    return (instruction.opcode == EBPF_OP_LDDW) ? 2 : 1;
+}
+
+// Get the target of an instruction that transfers control relative to itself.
+static bool
+_get_target(const std::vector<ebpf_inst>& code, size_t index, _Out_ size_t* target)
+{
+    const ebpf_inst& instruction = code[index];
+    int64_t offset;
+
+    *target = 0;
+    if (_is_local_call(instruction)) {
+        offset = instruction.imm;
+    } else if (_is_unconditional_jump(instruction) && _class(instruction) == EBPF_CLS_JMP32) {
+        // JA32 carries its offset in the immediate.
+        offset = instruction.imm;
+    } else if (_is_unconditional_jump(instruction) || _is_conditional_jump(instruction)) {
+        offset = instruction.offset;
+    } else {
+        return false;
+    }
+
+    int64_t destination = static_cast<int64_t>(index) + 1 + offset;
+    if (destination < 0 || destination > static_cast<int64_t>(code.size())) {
+        return false;
+    }
+    *target = static_cast<size_t>(destination);
+    return true;
+}
+
+static void
+_set_offset(ebpf_inst& instruction, int64_t offset)
+{
+    if (_is_local_call(instruction) || (_class(instruction) == EBPF_CLS_JMP32 && _is_unconditional_jump(instruction))) {
+        instruction.imm = static_cast<int32_t>(offset);
+    } else {
+        instruction.offset = static_cast<int16_t>(offset);
+    }
+}
+
+// Get the instructions that can execute right after the one at index. Calls continue at the next instruction.
+static size_t
+_get_successors(const std::vector<ebpf_inst>& code, size_t index, _Out_writes_(2) size_t successors[2])
+{
+    const ebpf_inst& instruction = code[index];
+    size_t count = 0;
+    size_t target;
+
+    if (instruction.opcode == EBPF_OP_EXIT) {
+        return 0;
+    }
+    if (!_is_unconditional_jump(instruction) && index + _slots(instruction) < code.size()) {
+        successors[count++] = index + _slots(instruction);
+    }
+    if ((_is_unconditional_jump(instruction) || _is_conditional_jump(instruction)) &&
+        _get_target(code, index, &target) && target < code.size()) {
+        successors[count++] = target;
+    }
+    return count;
+}
+
+static uint16_t
+_registers_read(const ebpf_inst& instruction)
+{
+    uint16_t source = (instruction.opcode & EBPF_SRC_REG) ? BYTE_CODE_REGISTER(instruction.src) : 0;
+
+    switch (_class(instruction)) {
+    case EBPF_CLS_ALU:
+    case EBPF_CLS_ALU64:
+        if (_operation(instruction) == BYTE_CODE_ALU_MOV) {
+            return source;
+        }
+        if (_operation(instruction) == BYTE_CODE_ALU_NEG) {
+            return BYTE_CODE_REGISTER(instruction.dst);
+        }
+        return BYTE_CODE_REGISTER(instruction.dst) | source;
+    case EBPF_CLS_LD:
+        // Legacy packet loads implicitly read the context.
+        return (instruction.opcode == EBPF_OP_LDDW) ? 0 : BYTE_CODE_ALL_REGISTERS;
+    case EBPF_CLS_LDX:
+        return BYTE_CODE_REGISTER(instruction.src);
+    case EBPF_CLS_ST:
+        return BYTE_CODE_REGISTER(instruction.dst);
+    case EBPF_CLS_STX:
+        if ((instruction.opcode & BYTE_CODE_MODE_MASK) == BYTE_CODE_MODE_ATOMIC) {
+            // Compare-exchange also reads r0.
+            return BYTE_CODE_REGISTER(instruction.dst) | BYTE_CODE_REGISTER(instruction.src) |
+                   BYTE_CODE_RETURN_REGISTER;
+        }
+        return BYTE_CODE_REGISTER(instruction.dst) | BYTE_CODE_REGISTER(instruction.src);
+    default:
+        break;
+    }
+
+    // Jump class.
+    switch (_operation(instruction)) {
+    case BYTE_CODE_JMP_JA:
+        return 0;
+    case BYTE_CODE_JMP_CALL:
+        // Helpers take at most five arguments. A local call preserves r6-r9 for the caller, as the verifier assumes.
+        return BYTE_CODE_ARGUMENT_REGISTERS;
+    case BYTE_CODE_JMP_EXIT:
+        return BYTE_CODE_RETURN_REGISTER;
+    default:
+        return BYTE_CODE_REGISTER(instruction.dst) | source;
+    }
+}
+
+static uint16_t
+_registers_written(const ebpf_inst& instruction)
+{
+    switch (_class(instruction)) {
+    case EBPF_CLS_ALU:
+    case EBPF_CLS_ALU64:
+    case EBPF_CLS_LDX:
+        return BYTE_CODE_REGISTER(instruction.dst);
+    case EBPF_CLS_LD:
+        return (instruction.opcode == EBPF_OP_LDDW) ? BYTE_CODE_REGISTER(instruction.dst) : BYTE_CODE_ALL_REGISTERS;
+    case EBPF_CLS_ST:
+        return 0;
+    case EBPF_CLS_STX:
+        if ((instruction.opcode & BYTE_CODE_MODE_MASK) == BYTE_CODE_MODE_ATOMIC) {
+            // Fetch variants write the old value to src, compare-exchange writes it to r0.
+            return BYTE_CODE_REGISTER(instruction.src) | BYTE_CODE_RETURN_REGISTER;
+        }
+        return 0;
+    default:
+        break;
+    }
+
+    if (_operation(instruction) == BYTE_CODE_JMP_CALL) {
+        return BYTE_CODE_CALLER_SAVED_REGISTERS;
+    }
+    return 0;
+}
+
+// Instructions without side effects that only compute a value in dst.
+static bool
+_is_removable_if_unused(const ebpf_inst& instruction)
+{
+    if (instruction.dst >= BYTE_CODE_REGISTER_COUNT - 1) {
+        return false;
+    }
+    return _is_alu(instruction) || (instruction.opcode == EBPF_OP_LDDW && instruction.src == 0);
+}
+
+static void
+_forget_registers(path_state_t& state, uint16_t registers)
+{
+    state.known_registers &= ~registers;
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < state.fact_count; i++) {
+        const branch_fact_t& fact = state.facts[i];
+        uint16_t used = BYTE_CODE_REGISTER(fact.dst);
+        if (fact.opcode & EBPF_SRC_REG) {
+            used |= BYTE_CODE_REGISTER(fact.src);
+        }
+        if ((used & registers) == 0) {
+            state.facts[kept++] = fact;
+        }
+    }
+    state.fact_count = kept;
+}
+
+static void
+_set_register(path_state_t& state, uint8_t destination, uint64_t value)
+{
+    _forget_registers(state, BYTE_CODE_REGISTER(destination));
+    state.known_registers |= BYTE_CODE_REGISTER(destination);
+    state.value[destination] = value;
+}
+
+static bool
+_is_known(const path_state_t& state, uint8_t index)
+{
+    return (state.known_registers & BYTE_CODE_REGISTER(index)) != 0;
+}
+
+static void
+_add_fact(path_state_t& state, const ebpf_inst& instruction, bool taken)
+{
+    if (state.fact_count == BYTE_CODE_MAX_BRANCH_FACTS) {
+        // Drop the oldest fact.
+        for (uint32_t i = 1; i < state.fact_count; i++) {
+            state.facts[i - 1] = state.facts[i];
+        }
+        state.fact_count--;
+    }
+
+    branch_fact_t& fact = state.facts[state.fact_count++];
+    fact.opcode = instruction.opcode;
+    fact.dst = instruction.dst;
+    fact.src = (instruction.opcode & EBPF_SRC_REG) ? instruction.src : 0;
+    fact.imm = (instruction.opcode & EBPF_SRC_REG) ? 0 : instruction.imm;
+    fact.taken = taken;
+}
+
+static uint8_t
+_complement_operation(uint8_t operation)
+{
+    switch (operation) {
+    case BYTE_CODE_JMP_JEQ:
+        return BYTE_CODE_JMP_JNE;
+    case BYTE_CODE_JMP_JNE:
+        return BYTE_CODE_JMP_JEQ;
+    case BYTE_CODE_JMP_JGT:
+        return BYTE_CODE_JMP_JLE;
+    case BYTE_CODE_JMP_JLE:
+        return BYTE_CODE_JMP_JGT;
+    case BYTE_CODE_JMP_JGE:
+        return BYTE_CODE_JMP_JLT;
+    case BYTE_CODE_JMP_JLT:
+        return BYTE_CODE_JMP_JGE;
+    case BYTE_CODE_JMP_JSGT:
+        return BYTE_CODE_JMP_JSLE;
+    case BYTE_CODE_JMP_JSLE:
+        return BYTE_CODE_JMP_JSGT;
+    case BYTE_CODE_JMP_JSGE:
+        return BYTE_CODE_JMP_JSLT;
+    case BYTE_CODE_JMP_JSLT:
+        return BYTE_CODE_JMP_JSGE;
+    default:
+        // JSET has no complement.
+        return BYTE_CODE_JMP_JA;
+    }
+}
+
+// Check whether the same comparison, or its complement, was already made on every path reaching the instruction.
+static bool
+_lookup_fact(const path_state_t& state, const ebpf_inst& instruction, _Out_ bool* taken)
+{
+    uint8_t operation = _operation(instruction);
+    uint8_t complement = _complement_operation(operation);
+    bool register_source = (instruction.opcode & EBPF_SRC_REG) != 0;
+
+    *taken = false;
+    for (uint32_t i = 0; i < state.fact_count; i++) {
+        const branch_fact_t& fact = state.facts[i];
+        if ((fact.opcode & ~BYTE_CODE_OPERATION_MASK) != (instruction.opcode & ~BYTE_CODE_OPERATION_MASK) ||
+            fact.dst != instruction.dst) {
+            continue;
+        }
+        if (register_source ? (fact.src != instruction.src) : (fact.imm != instruction.imm)) {
+            continue;
+        }
+        if ((fact.opcode & BYTE_CODE_OPERATION_MASK) == operation) {
+            *taken = fact.taken;
+            return true;
+        }
+        if (complement != BYTE_CODE_JMP_JA && (fact.opcode & BYTE_CODE_OPERATION_MASK) == complement) {
+            *taken = !fact.taken;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool
+_evaluate_condition(const ebpf_inst& instruction, uint64_t left, uint64_t right, _Out_ bool* taken)
+{
+    if (_class(instruction) == EBPF_CLS_JMP32) {
+        left = static_cast<uint32_t>(left);
+        right = static_cast<uint32_t>(right);
+    }
+    int64_t signed_left = (_class(instruction) == EBPF_CLS_JMP32) ? static_cast<int32_t>(left)
+                                                                   : static_cast<int64_t>(left);
+    int64_t signed_right = (_class(instruction) == EBPF_CLS_JMP32) ? static_cast<int32_t>(right)
+                                                                    : static_cast<int64_t>(right);
+
+    *taken = false;
+    switch (_operation(instruction)) {
+    case BYTE_CODE_JMP_JEQ:
+        *taken = left == right;
+        break;
+    case BYTE_CODE_JMP_JNE:
+        *taken = left != right;
+        break;
+    case BYTE_CODE_JMP_JGT:
+        *taken = left > right;
+        break;
+    case BYTE_CODE_JMP_JGE:
+        *taken = left >= right;
+        break;
+    case BYTE_CODE_JMP_JLT:
+        *taken = left < right;
+        break;
+    case BYTE_CODE_JMP_JLE:
+        *taken = left <= right;
+        break;
+    case BYTE_CODE_JMP_JSET:
+        *taken = (left & right) != 0;
+        break;
+    case BYTE_CODE_JMP_JSGT:
+        *taken = signed_left > signed_right;
+        break;
+    case BYTE_CODE_JMP_JSGE:
+        *taken = signed_left >= signed_right;
+        break;
+    case BYTE_CODE_JMP_JSLT:
+        *taken = signed_left < signed_right;
+        break;
+    case BYTE_CODE_JMP_JSLE:
+        *taken = signed_left <= signed_right;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+// Compute the result of an ALU instruction if its operands are known.
+static bool
+_evaluate_alu(const path_state_t& state, const ebpf_inst& instruction, _Out_ uint64_t* result)
+{
+    bool is_64_bit = _class(instruction) == EBPF_CLS_ALU64;
+    uint8_t operation = _operation(instruction);
+    uint64_t destination = 0;
+    uint64_t source;
+    uint64_t value;
+
+    *result = 0;
+
+    // A non-zero offset selects the signed division and sign extending move variants, which are left alone.
+    if (instruction.offset != 0) {
+        return false;
+    }
+    if (operation != BYTE_CODE_ALU_MOV) {
+        if (!_is_known(state, instruction.dst)) {
+            return false;
+        }
+        destination = state.value[instruction.dst];
+    }
+    if (instruction.opcode & EBPF_SRC_REG) {
+        if (operation == BYTE_CODE_ALU_NEG || !_is_known(state, instruction.src)) {
+            return false;
+        }
+        source = state.value[instruction.src];
+    } else {
+        source = static_cast<uint64_t>(static_cast<int64_t>(instruction.imm));
+    }
+    if (!is_64_bit) {
+        destination = static_cast<uint32_t>(destination);
+        source = static_cast<uint32_t>(source);
+    }
+
+    uint64_t width = is_64_bit ? 64 : 32;
+    switch (operation) {
+    case BYTE_CODE_ALU_ADD:
+        value = destination + source;
+        break;
+    case BYTE_CODE_ALU_SUB:
+        value = destination - source;
+        break;
+    case BYTE_CODE_ALU_MUL:
+        value = destination * source;
+        break;
+    case BYTE_CODE_ALU_OR:
+        value = destination | source;
+        break;
+    case BYTE_CODE_ALU_AND:
+        value = destination & source;
+        break;
+    case BYTE_CODE_ALU_XOR:
+        value = destination ^ source;
+        break;
+    case BYTE_CODE_ALU_NEG:
+        value = 0 - destination;
+        break;
+    case BYTE_CODE_ALU_MOV:
+        value = source;
+        break;
+    case BYTE_CODE_ALU_LSH:
+        if (source >= width) {
+            return false;
+        }
+        value = destination << source;
+        break;
+    case BYTE_CODE_ALU_RSH:
+        if (source >= width) {
+            return false;
+        }
+        value = destination >> source;
+        break;
+    case BYTE_CODE_ALU_ARSH:
+        if (source >= width) {
+            return false;
+        }
+        value = is_64_bit ? static_cast<uint64_t>(static_cast<int64_t>(destination) >> source)
+                          : static_cast<uint32_t>(static_cast<int32_t>(destination) >> source);
+        break;
+    default:
+        // Division and modulo have helper specific semantics for a zero divisor, and byte swaps are rare.
+        return false;
+    }
+
+    *result = is_64_bit ? value : static_cast<uint32_t>(value);
+    return true;
+}
+
+// Replace an ALU instruction with a load of its result, if the result can be encoded as an immediate.
+static bool
+_rewrite_as_constant_load(ebpf_inst& instruction, uint64_t value)
+{
+    if (value == static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(value)))) {
+        instruction.opcode = EBPF_OP_MOV64_IMM;
+    } else if (value <= UINT32_MAX) {
+        // The 32-bit move zero extends into the upper half.
+        instruction.opcode = EBPF_OP_MOV_IMM;
+    } else {
+        return false;
+    }
+    instruction.src = 0;
+    instruction.offset = 0;
+    instruction.imm = static_cast<int32_t>(static_cast<uint32_t>(value));
+    return true;
+}
+
+static void
+_build_graph(const std::vector<ebpf_inst>& code, program_graph_t& graph)
+{
+    graph.predecessor_count.assign(code.size(), 0);
+    graph.fallthrough_predecessor.assign(code.size(), false);
+    graph.entry_point.assign(code.size(), false);
+    if (!code.empty()) {
+        graph.entry_point[0] = true;
+    }
+
+    for (size_t index = 0; index < code.size(); index += _slots(code[index])) {
+        const ebpf_inst& instruction = code[index];
+        size_t successors[2];
+        size_t count = _get_successors(code, index, successors);
+        for (size_t i = 0; i < count; i++) {
+            graph.predecessor_count[successors[i]]++;
+            graph.fallthrough_predecessor[successors[i]] =
+                !_is_unconditional_jump(instruction) && successors[i] == index + _slots(instruction);
+        }
+        size_t target;
+        if (_is_local_call(instruction) && _get_target(code, index, &target) && target < code.size()) {
+            graph.entry_point[target] = true;
+        }
+    }
+}
+
+// Remove the marked instructions and fix up the offsets of the remaining jumps and local calls. A jump to a removed
+// instruction continues at the next instruction that was kept, so only instructions that do nothing on every path
+// reaching them, or that cannot be reached at all, may be removed.
+static uint32_t
+_compact(std::vector<ebpf_inst>& code, const std::vector<bool>& removed)
+{
+    std::vector<size_t> new_index(code.size() + 1);
+    size_t kept = 0;
+
+    for (size_t index = 0; index < code.size(); index++) {
+        new_index[index] = kept;
+        if (!removed[index]) {
+            kept++;
+        }
+    }
+    new_index[code.size()] = kept;
+    if (kept == code.size()) {
+        return 0;
+    }
+
+    for (size_t index = 0; index < code.size(); index += _slots(code[index])) {
+        size_t target;
+        if (!removed[index] && _get_target(code, index, &target)) {
+            _set_offset(
+                code[index],
+                static_cast<int64_t>(new_index[target]) - static_cast<int64_t>(new_index[index]) - 1);
+        }
+    }
+
+    size_t next = 0;
+    for (size_t index = 0; index < code.size(); index++) {
+        if (!removed[index]) {
+            code[next++] = code[index];
+        }
+    }
+    uint32_t removed_count = static_cast<uint32_t>(code.size() - kept);
+    code.resize(kept);
+    return removed_count;
+}
+
+static void
+_remove(const std::vector<ebpf_inst>& code, std::vector<bool>& removed, size_t index)
+{
+    for (size_t slot = 0; slot < _slots(code[index]); slot++) {
+        removed[index + slot] = true;
+    }
+}
+
+static bool
+_propagate_constants(
+    std::vector<ebpf_inst>& code, std::vector<bool>& removed, byte_code_optimizer_statistics_t& statistics)
+{
+    program_graph_t graph;
+    std::map<size_t, path_state_t> pending;
+    path_state_t state = {};
+    bool changed = false;
+
+    _build_graph(code, graph);
+    for (size_t index = 0; index < code.size(); index += _slots(code[index])) {
+        ebpf_inst& instruction = code[index];
+
+        // Establish what holds on every path reaching this instruction. The state is only carried over from a single
+        // predecessor that was already visited.
+        if (graph.entry_point[index] || graph.predecessor_count[index] != 1) {
+            state = {};
+        } else if (!graph.fallthrough_predecessor[index]) {
+            auto it = pending.find(index);
+            if (it == pending.end()) {
+                state = {};
+            } else {
+                state = it->second;
+                pending.erase(it);
+            }
+        }
+
+        if (_is_alu(instruction)) {
+            if (instruction.opcode == EBPF_OP_MOV64_REG && instruction.dst == instruction.src &&
+                instruction.offset == 0) {
+                _remove(code, removed, index);
+                changed = true;
+                continue;
+            }
+
+            uint64_t value;
+            if (!_evaluate_alu(state, instruction, &value)) {
+                _forget_registers(state, BYTE_CODE_REGISTER(instruction.dst));
+                continue;
+            }
+            if (_is_known(state, instruction.dst) && state.value[instruction.dst] == value) {
+                // The register already holds the result.
+                _remove(code, removed, index);
+                changed = true;
+                continue;
+            }
+            if (!_is_constant_load(instruction) && _rewrite_as_constant_load(instruction, value)) {
+                statistics.constants_folded++;
+                changed = true;
+            }
+            _set_register(state, instruction.dst, value);
+        } else if (instruction.opcode == EBPF_OP_LDDW && instruction.src == 0) {
+            uint64_t value = static_cast<uint32_t>(instruction.imm) |
+                             (static_cast<uint64_t>(static_cast<uint32_t>(code[index + 1].imm)) << 32);
+            if (_is_known(state, instruction.dst) && state.value[instruction.dst] == value) {
+                _remove(code, removed, index);
+                changed = true;
+                continue;
+            }
+            _set_register(state, instruction.dst, value);
+        } else if (_is_conditional_jump(instruction)) {
+            size_t target;
+            bool target_valid = _get_target(code, index, &target) && target < code.size();
+            bool register_source = (instruction.opcode & EBPF_SRC_REG) != 0;
+            bool taken;
+            bool outcome_known = false;
+
+            if (_is_known(state, instruction.dst) && (!register_source || _is_known(state, instruction.src))) {
+                uint64_t right = register_source ? state.value[instruction.src]
+                                                 : static_cast<uint64_t>(static_cast<int64_t>(instruction.imm));
+                outcome_known = _evaluate_condition(instruction, state.value[instruction.dst], right, &taken);
+            }
+            if (!outcome_known) {
+                outcome_known = _lookup_fact(state, instruction, &taken);
+            }
+
+            if (outcome_known) {
+                statistics.branches_folded++;
+                changed = true;
+                if (taken) {
+                    // The fall through path is now unreachable and is removed later.
+                    int16_t offset = instruction.offset;
+                    instruction = {};
+                    instruction.opcode = EBPF_OP_JA;
+                    instruction.offset = offset;
+                    if (target_valid && target > index) {
+                        pending[target] = state;
+                    }
+                } else {
+                    _remove(code, removed, index);
+                }
+                continue;
+            }
+
+            if (target_valid && target > index) {
+                path_state_t target_state = state;
+                _add_fact(target_state, instruction, true);
+                pending[target] = target_state;
+            }
+            _add_fact(state, instruction, false);
+        } else if (_is_unconditional_jump(instruction)) {
+            size_t target;
+            if (_get_target(code, index, &target) && target < code.size() && target > index) {
+                pending[target] = state;
+            }
+        } else {
+            _forget_registers(state, _registers_written(instruction));
+        }
+    }
+
+    return changed;
+}
+
+static bool
+_thread_jumps(std::vector<ebpf_inst>& code, std::vector<bool>& removed, byte_code_optimizer_statistics_t& statistics)
+{
+    bool changed = false;
+
+    for (size_t index = 0; index < code.size(); index += _slots(code[index])) {
+        ebpf_inst& instruction = code[index];
+        size_t target;
+        if ((!_is_unconditional_jump(instruction) && !_is_conditional_jump(instruction)) ||
+            !_get_target(code, index, &target) || target >= code.size()) {
+            continue;
+        }
+
+        size_t final_target = target;
+        for (int depth = 0; depth < BYTE_CODE_MAX_THREADING_DEPTH; depth++) {
+            size_t next;
+            if (!_is_unconditional_jump(code[final_target]) || !_get_target(code, final_target, &next) ||
+                next >= code.size() || next == final_target || next == index) {
+                break;
+            }
+            final_target = next;
+        }
+
+        int64_t offset = static_cast<int64_t>(final_target) - static_cast<int64_t>(index) - 1;
+        bool offset_in_immediate = _class(instruction) == EBPF_CLS_JMP32 && _is_unconditional_jump(instruction);
+        if (final_target != target && (offset_in_immediate || (offset >= INT16_MIN && offset <= INT16_MAX))) {
+            _set_offset(instruction, offset);
+            statistics.jumps_threaded++;
+            changed = true;
+        } else {
+            offset = static_cast<int64_t>(target) - static_cast<int64_t>(index) - 1;
+        }
+
+        // A jump to the next instruction does nothing, whether or not it is taken.
+        if (offset == 0) {
+            _remove(code, removed, index);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+static bool
+_remove_unreachable(std::vector<ebpf_inst>& code, std::vector<bool>& removed, byte_code_optimizer_statistics_t&)
+{
+    std::vector<bool> reachable(code.size(), false);
+    std::vector<size_t> stack;
+    bool changed = false;
+
+    if (!code.empty()) {
+        stack.push_back(0);
+    }
+    while (!stack.empty()) {
+        size_t index = stack.back();
+        stack.pop_back();
+        if (reachable[index]) {
+            continue;
+        }
+        reachable[index] = true;
+
+        size_t successors[2];
+        size_t count = _get_successors(code, index, successors);
+        for (size_t i = 0; i < count; i++) {
+            stack.push_back(successors[i]);
+        }
+        size_t target;
+        if (_is_local_call(code[index]) && _get_target(code, index, &target) && target < code.size()) {
+            stack.push_back(target);
+        }
+    }
+
+    for (size_t index = 0; index < code.size(); index += _slots(code[index])) {
+        if (!reachable[index]) {
+            _remove(code, removed, index);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// Remove instructions whose result is never read. An instruction that is itself about to be removed does not keep its
+// inputs alive, so whole chains of unused computations are removed at once.
+static bool
+_remove_unused_results(std::vector<ebpf_inst>& code, std::vector<bool>& removed, byte_code_optimizer_statistics_t&)
+{
+    std::vector<size_t> starts;
+    std::vector<uint16_t> live_in(code.size(), 0);
+    std::vector<uint16_t> live_out(code.size(), 0);
+    bool updated = true;
+    bool changed = false;
+
+    for (size_t index = 0; index < code.size(); index += _slots(code[index])) {
+        starts.push_back(index);
+    }
+
+    while (updated) {
+        updated = false;
+        for (auto it = starts.rbegin(); it != starts.rend(); it++) {
+            size_t index = *it;
+            const ebpf_inst& instruction = code[index];
+            size_t successors[2];
+            size_t count = _get_successors(code, index, successors);
+            uint16_t out = 0;
+            for (size_t i = 0; i < count; i++) {
+                out |= live_in[successors[i]];
+            }
+
+            uint16_t in;
+            if (_is_removable_if_unused(instruction) && !(out & BYTE_CODE_REGISTER(instruction.dst))) {
+                in = out;
+            } else {
+                in = _registers_read(instruction) | (out & ~_registers_written(instruction));
+            }
+            live_out[index] = out;
+            if (in != live_in[index]) {
+                live_in[index] = in;
+                updated = true;
+            }
+        }
+    }
+
+    for (size_t index : starts) {
+        if (_is_removable_if_unused(code[index]) && !(live_out[index] & BYTE_CODE_REGISTER(code[index].dst))) {
+            _remove(code, removed, index);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void
+optimize_byte_code(
+    _Inout_updates_(*instruction_count) ebpf_inst* instructions,
+    _Inout_ uint32_t* instruction_count,
+    _Out_opt_ byte_code_optimizer_statistics_t* statistics)
+{
+    byte_code_optimizer_statistics_t local_statistics = {};
+    std::vector<ebpf_inst> code(instructions, instructions + *instruction_count);
+    std::vector<bool> removed;
+    typedef bool (*pass_t)(std::vector<ebpf_inst>&, std::vector<bool>&, byte_code_optimizer_statistics_t&);
+    pass_t passes[] = {_propagate_constants, _thread_jumps, _remove_unreachable, _remove_unused_results};
+
+    for (int round = 0; round < BYTE_CODE_OPTIMIZER_MAX_ROUNDS; round++) {
+        bool changed = false;
+        for (pass_t pass : passes) {
+            removed.assign(code.size(), false);
+            if (pass(code, removed, local_statistics)) {
+                changed = true;
+                local_statistics.instructions_removed += _compact(code, removed);
+            }
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    std::copy(code.begin(), code.end(), instructions);
+    *instruction_count = static_cast<uint32_t>(code.size());
+    if (statistics != nullptr) {
+        *statistics = local_statistics;
+    }
+}
@@ -0,0 +1,36 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdint.h>
+
+struct ebpf_inst;
+
+typedef struct _byte_code_optimizer_statistics
+{
+    uint32_t instructions_removed; ///< Instruction slots removed from the program.
+    uint32_t constants_folded;     ///< ALU instructions replaced by a load of their constant result.
+    uint32_t branches_folded;      ///< Conditional jumps whose outcome was known and that were resolved.
+    uint32_t jumps_threaded;       ///< Jumps retargeted past an unconditional jump.
+} byte_code_optimizer_statistics_t;
+
+/**
+ * @brief Optimize verified byte code before it is JIT compiled.
+ *
+ * Only transformations that hold on every path through the program are applied, so the optimized program returns the
+ * same value, calls the same helpers and performs the same loads and stores as the verified program. The program is
+ * not verified again, so this must only be called after the verifier accepted the byte code and after map and helper
+ * references were resolved.
+ *
+ * @param[in,out] instructions Byte code to optimize. The optimized program is written back to the start of the array.
+ * @param[in,out] instruction_count On input, the number of instructions in the array. On output, the number of
+ * instructions in the optimized program, which is never larger.
+ * @param[out] statistics Optional counters describing the changes that were made.
+ * @throws std::bad_alloc Insufficient memory for the analysis. The instructions are unchanged.
+ */
+void
+optimize_byte_code(
+    _Inout_updates_(*instruction_count) ebpf_inst* instructions,
+    _Inout_ uint32_t* instruction_count,
+    _Out_opt_ byte_code_optimizer_statistics_t* statistics);
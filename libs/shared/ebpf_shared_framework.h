@@ -110,6 +110,21 @@ bool
 ebpf_validate_helper_function_prototype_array(
     _In_reads_(count) const ebpf_helper_function_prototype_t* helper_prototype, uint32_t count);
 
+/**
+ * @brief Validate a bpf_trace_printk format string.
+ *
+ * The conversion specifiers are limited to:
+ * %d, %i, %u, %x, %ld, %li, %lu, %lx, %lld, %lli, %llu, %llx.
+ * No modifier (size of field, padding with zeroes, etc.) is available.
+ *
+ * @param[in] format Null-terminated format string.
+ * @param[out] specifier_count Number of conversion specifiers in the format string.
+ * @retval true The format string only uses supported conversion specifiers.
+ * @retval false The format string is invalid.
+ */
+bool
+ebpf_validate_printk_format(_In_z_ const char* format, _Out_ int* specifier_count);
+
 /**
  * @brief Helper Function to free ebpf_program_info_t.
  *
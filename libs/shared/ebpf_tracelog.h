@@ -25,6 +25,8 @@ extern "C"
 #define EBPF_TRACELOG_EVENT_GENERIC_ERROR "EbpfGenericError"
 #define EBPF_TRACELOG_EVENT_GENERIC_MESSAGE "EbpfGenericMessage"
 #define EBPF_TRACELOG_EVENT_API_ERROR "EbpfApiError"
+#define EBPF_TRACELOG_EVENT_PRINTK_FORMAT "EbpfPrintkFormat"
+#define EBPF_TRACELOG_EVENT_PRINTK "EbpfPrintk"
 
 #define EBPF_TRACELOG_KEYWORD_FUNCTION_ENTRY_EXIT 0x1
 #define EBPF_TRACELOG_KEYWORD_BASE 0x2
@@ -37,6 +39,8 @@ extern "C"
 #define EBPF_TRACELOG_KEYWORD_API 0x100
 #define EBPF_TRACELOG_KEYWORD_PRINTK 0x200
 #define EBPF_TRACELOG_KEYWORD_NATIVE 0x400
+// Binary bpf_trace_printk records, formatted in user mode. Only used when EBPF_TRACELOG_KEYWORD_PRINTK is disabled.
+#define EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED 0x800
 
 #define EBPF_TRACELOG_LEVEL_LOG_ALWAYS WINEVENT_LEVEL_LOG_ALWAYS
 #define EBPF_TRACELOG_LEVEL_CRITICAL WINEVENT_LEVEL_CRITICAL
@@ -76,6 +80,18 @@ extern "C"
     void
     ebpf_trace_terminate();
 
+    typedef void (*ebpf_trace_printk_format_rundown_t)();
+
+    /**
+     * @brief Set the function that logs every registered deferred bpf_trace_printk format again.
+     * It is invoked when a session enables EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED or requests a
+     * state capture, so that the session can decode records of formats registered before it started.
+     *
+     * @param[in] rundown Function to invoke, or NULL to stop invoking the previous one.
+     */
+    void
+    ebpf_trace_set_printk_format_rundown(_In_opt_ ebpf_trace_printk_format_rundown_t rundown);
+
 #define EBPF_LOG_FUNCTION_SUCCESS()                                                             \
     if (TraceLoggingProviderEnabled(                                                            \
             ebpf_tracelog_provider, EBPF_TRACELOG_LEVEL_VERBOSE, EBPF_TRACELOG_KEYWORD_BASE)) { \
@@ -303,6 +319,28 @@ extern "C"
         ebpf_log_message_uint64_uint64(_##trace_level##, _##keyword##, message, value1, value2); \
     }
 
+    /**
+     * @brief Log the registration of a deferred bpf_trace_printk format string.
+     *
+     * @param[in] format_id Identifier that EbpfPrintk events use to refer to this format.
+     * @param[in] format Null-terminated format string, with any trailing newline removed.
+     */
+    void
+    ebpf_log_printk_format(uint32_t format_id, _In_z_ const char* format);
+
+    /**
+     * @brief Log a deferred bpf_trace_printk record. The record carries only the format identifier
+     * and the raw arguments; formatting happens in user mode via ebpf_format_deferred_printk.
+     *
+     * @param[in] format_id Identifier of a format previously logged by ebpf_log_printk_format.
+     * @param[in] argument_count Number of valid arguments.
+     * @param[in] arg1 First argument, or 0 if not present.
+     * @param[in] arg2 Second argument, or 0 if not present.
+     * @param[in] arg3 Third argument, or 0 if not present.
+     */
+    void
+    ebpf_log_printk_deferred(uint32_t format_id, uint32_t argument_count, uint64_t arg1, uint64_t arg2, uint64_t arg3);
+
     void
     ebpf_log_message_error(
         ebpf_tracelog_level_t trace_level,
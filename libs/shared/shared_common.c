@@ -51,7 +51,8 @@ size_t _ebpf_program_info_supported_size[] = {EBPF_PROGRAM_INFO_SIZE_0};
 size_t _ebpf_helper_function_addresses_supported_size[] = {EBPF_HELPER_FUNCTION_ADDRESSES_SIZE_0};
 
 #define EBPF_PROGRAM_DATA_SIZE_0 EBPF_OFFSET_OF(ebpf_program_data_t, required_irql) + sizeof(uint8_t)
-size_t _ebpf_program_data_supported_size[] = {EBPF_PROGRAM_DATA_SIZE_0};
+#define EBPF_PROGRAM_DATA_SIZE_1 EBPF_SIZE_INCLUDING_FIELD(ebpf_program_data_t, capabilities)
+size_t _ebpf_program_data_supported_size[] = {EBPF_PROGRAM_DATA_SIZE_0, EBPF_PROGRAM_DATA_SIZE_1};
 
 #define EBPF_PROGRAM_SECTION_SIZE_0 EBPF_SIZE_INCLUDING_FIELD(ebpf_program_section_info_t, bpf_attach_type)
 size_t _ebpf_program_section_supported_size[] = {EBPF_PROGRAM_SECTION_SIZE_0};
@@ -195,6 +196,60 @@ ebpf_validate_program_section_info(_In_ const ebpf_program_section_info_t* secti
         (section_info->attach_type != NULL));
 }
 
+// Only integers are currently supported.
+#define PRINTK_SPECIFIER_CHARS "diux"
+
+bool
+ebpf_validate_printk_format(_In_z_ const char* format, _Out_ int* specifier_count)
+{
+    const char* p;
+    *specifier_count = 0;
+    for (p = format; *p; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        if (p[1] == 0) {
+            break;
+        }
+        if (p[1] == '%') {
+            // Allow a %% escape.
+            p++;
+            continue;
+        }
+
+        // We found a specifier.  Verify that it is in the legal set.
+        if (strchr(PRINTK_SPECIFIER_CHARS, p[1])) {
+            // We found a legal one character specifier.
+            p++;
+            (*specifier_count)++;
+            continue;
+        }
+
+        if (p[1] != 'l' || p[2] == 0) {
+            break;
+        }
+        if (strchr(PRINTK_SPECIFIER_CHARS, p[2])) {
+            // We found a legal two character specifier.
+            p += 2;
+            (*specifier_count)++;
+            continue;
+        }
+
+        if (p[2] != 'l' || p[3] == 0) {
+            break;
+        }
+        if (strchr(PRINTK_SPECIFIER_CHARS, p[3])) {
+            // We found a legal three character specifier.
+            p += 3;
+            (*specifier_count)++;
+            continue;
+        }
+        break;
+    }
+
+    return (*p == 0);
+}
+
 ebpf_result_t
 ebpf_result_from_cxplat_status(cxplat_status_t status)
 {
@@ -17,6 +17,40 @@ TRACELOGGING_DEFINE_PROVIDER(
     (0x394f321c, 0x5cf4, 0x404c, 0xaa, 0x34, 0x4d, 0xf1, 0x42, 0x8a, 0x7f, 0x9c));
 
 static bool _ebpf_trace_initiated = false;
+static volatile ebpf_trace_printk_format_rundown_t _ebpf_trace_printk_format_rundown = NULL;
+
+/**
+ * @brief Provider enable callback. A session that enables the deferred printk keyword after the
+ * formats were registered has not seen their EbpfPrintkFormat events, so log them again.
+ */
+static void NTAPI
+_ebpf_trace_enable_callback(
+    _In_ const GUID* source_id,
+    ULONG control_code,
+    UCHAR level,
+    ULONGLONG match_any_keyword,
+    ULONGLONG match_all_keyword,
+    _In_opt_ EVENT_FILTER_DESCRIPTOR* filter_data,
+    _Inout_opt_ void* callback_context)
+{
+    UNREFERENCED_PARAMETER(source_id);
+    UNREFERENCED_PARAMETER(match_all_keyword);
+    UNREFERENCED_PARAMETER(filter_data);
+    UNREFERENCED_PARAMETER(callback_context);
+
+    if (control_code != EVENT_CONTROL_CODE_ENABLE_PROVIDER && control_code != EVENT_CONTROL_CODE_CAPTURE_STATE) {
+        return;
+    }
+    if ((level != 0 && level < EBPF_TRACELOG_LEVEL_INFO) ||
+        (match_any_keyword != 0 && !(match_any_keyword & EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED))) {
+        return;
+    }
+
+    ebpf_trace_printk_format_rundown_t rundown = _ebpf_trace_printk_format_rundown;
+    if (rundown != NULL) {
+        rundown();
+    }
+}
 
 _Must_inspect_result_ ebpf_result_t
 ebpf_trace_initiate()
@@ -24,7 +58,7 @@ ebpf_trace_initiate()
     if (_ebpf_trace_initiated) {
         return EBPF_SUCCESS;
     }
-    TLG_STATUS status = TraceLoggingRegister(ebpf_tracelog_provider);
+    TLG_STATUS status = TraceLoggingRegisterEx(ebpf_tracelog_provider, _ebpf_trace_enable_callback, NULL);
     if (status != 0) {
         return EBPF_NO_MEMORY;
     } else {
@@ -46,6 +80,12 @@ ebpf_trace_terminate()
 }
 #pragma optimize("", on)
 
+void
+ebpf_trace_set_printk_format_rundown(_In_opt_ ebpf_trace_printk_format_rundown_t rundown)
+{
+    _ebpf_trace_printk_format_rundown = rundown;
+}
+
 // Keyword definitions
 #define KEYWORD_FUNCTION_ENTRY_EXIT EBPF_TRACELOG_KEYWORD_FUNCTION_ENTRY_EXIT
 #define KEYWORD_BASE EBPF_TRACELOG_KEYWORD_BASE
@@ -1103,4 +1143,31 @@ __declspec(noinline) void ebpf_log_ntstatus_wstring_api(
     }
 }
 
+void
+ebpf_log_printk_format(uint32_t format_id, _In_z_ const char* format)
+{
+    TraceLoggingWrite(
+        ebpf_tracelog_provider,
+        EBPF_TRACELOG_EVENT_PRINTK_FORMAT,
+        TraceLoggingLevel(EBPF_TRACELOG_LEVEL_INFO),
+        TraceLoggingKeyword(EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED),
+        TraceLoggingUInt32(format_id, "FormatId"),
+        TraceLoggingString(format, "Format"));
+}
+
+void
+ebpf_log_printk_deferred(uint32_t format_id, uint32_t argument_count, uint64_t arg1, uint64_t arg2, uint64_t arg3)
+{
+    TraceLoggingWrite(
+        ebpf_tracelog_provider,
+        EBPF_TRACELOG_EVENT_PRINTK,
+        TraceLoggingLevel(EBPF_TRACELOG_LEVEL_INFO),
+        TraceLoggingKeyword(EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED),
+        TraceLoggingUInt32(format_id, "FormatId"),
+        TraceLoggingUInt32(argument_count, "ArgumentCount"),
+        TraceLoggingUInt64(arg1, "Arg1"),
+        TraceLoggingUInt64(arg2, "Arg2"),
+        TraceLoggingUInt64(arg3, "Arg3"));
+}
+
 #pragma warning(pop)
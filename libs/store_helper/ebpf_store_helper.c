@@ -46,6 +46,20 @@ Exit:
     return result;
 }
 
+/**
+ * @brief Delete the program information snapshot under the provider key. Any change to the per-key layout must call
+ * this before modifying the store so that readers never see a snapshot that is older than the per-key layout.
+ */
+static ebpf_result_t
+_ebpf_store_delete_snapshot(ebpf_store_key_t provider_key)
+{
+    ebpf_result_t result = ebpf_delete_registry_value(provider_key, EBPF_STORE_SNAPSHOT);
+    if (result == EBPF_FILE_NOT_FOUND) {
+        result = EBPF_SUCCESS;
+    }
+    return result;
+}
+
 static ebpf_result_t
 _ebpf_store_update_helper_prototype(
     ebpf_store_key_t helper_info_key, _In_ const ebpf_helper_function_prototype_t* helper_info)
@@ -129,6 +143,12 @@ ebpf_store_update_global_helper_information(
         goto Exit;
     }
 
+    // The snapshot no longer matches the per-key layout.
+    result = _ebpf_store_delete_snapshot(provider_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
     // Open (or create) global helpers registry path.
     result =
         ebpf_create_registry_key(provider_key, EBPF_GLOBAL_HELPERS_REGISTRY_KEY, REG_CREATE_FLAGS, &helper_info_key);
@@ -168,6 +188,12 @@ ebpf_store_update_section_information(
         goto Exit;
     }
 
+    // The snapshot no longer matches the per-key layout.
+    result = _ebpf_store_delete_snapshot(provider_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
     // Open (or create) section data key.
     result = ebpf_create_registry_key(provider_key, EBPF_SECTIONS_REGISTRY_KEY, REG_CREATE_FLAGS, &section_info_key);
     if (!IS_SUCCESS(result)) {
@@ -370,6 +396,12 @@ ebpf_store_update_program_information_array(
         goto Exit;
     }
 
+    // The snapshot no longer matches the per-key layout.
+    result = _ebpf_store_delete_snapshot(provider_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
     // Open (or create) program data registry path.
     result =
         ebpf_create_registry_key(provider_key, EBPF_PROGRAM_DATA_REGISTRY_KEY, REG_CREATE_FLAGS, &program_data_key);
@@ -440,6 +472,12 @@ ebpf_store_delete_program_information(_In_ const ebpf_program_info_t* program_in
         goto Exit;
     }
 
+    // The snapshot no longer matches the per-key layout.
+    result = _ebpf_store_delete_snapshot(provider_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
     // Open program data registry path.
     result = ebpf_open_registry_key(provider_key, EBPF_PROGRAM_DATA_REGISTRY_KEY, REG_CREATE_FLAGS, &program_info_key);
     if (!IS_SUCCESS(result)) {
@@ -479,6 +517,12 @@ ebpf_store_delete_section_information(_In_ const ebpf_program_section_info_t* se
         goto Exit;
     }
 
+    // The snapshot no longer matches the per-key layout.
+    result = _ebpf_store_delete_snapshot(provider_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
     // Open (or create) section data key.
     result = ebpf_open_registry_key(provider_key, EBPF_SECTIONS_REGISTRY_KEY, REG_DELETE_FLAGS, &section_info_key);
     if (!IS_SUCCESS(result)) {
@@ -496,3 +540,275 @@ Exit:
 
     return result;
 }
+
+/**
+ * @brief Reserve a record in the snapshot buffer.
+ *
+ * @param[in] snapshot Snapshot buffer, or NULL to only compute the required length.
+ * @param[in, out] offset Offset of the record on input, offset of the next record on output.
+ * @param[in] type Type of the record.
+ * @param[in] length Length of the record data.
+ *
+ * @returns Pointer to the record data, or NULL if snapshot is NULL.
+ */
+static uint8_t*
+_ebpf_store_snapshot_append_record(_Inout_opt_ uint8_t* snapshot, _Inout_ size_t* offset, uint32_t type, size_t length)
+{
+    uint8_t* data = NULL;
+    if (snapshot != NULL) {
+        ebpf_store_snapshot_record_t* record = (ebpf_store_snapshot_record_t*)(snapshot + *offset);
+        record->type = type;
+        record->length = (uint32_t)length;
+        data = record->data;
+    }
+    *offset += EBPF_PAD_8(EBPF_OFFSET_OF(ebpf_store_snapshot_record_t, data) + length);
+    return data;
+}
+
+/**
+ * @brief Write all records into the snapshot buffer, or compute the length of the snapshot if snapshot is NULL.
+ */
+static ebpf_result_t
+_ebpf_store_snapshot_write_records(
+    _In_reads_(program_info_count) ebpf_program_info_t* const* program_info,
+    uint32_t program_info_count,
+    _In_reads_(section_info_count) const ebpf_program_section_info_t* section_info,
+    uint32_t section_info_count,
+    _In_reads_(helper_info_count) const ebpf_helper_function_prototype_t* helper_info,
+    uint32_t helper_info_count,
+    _Inout_opt_ uint8_t* snapshot,
+    size_t snapshot_length,
+    _Out_ size_t* required_length)
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    size_t offset = sizeof(ebpf_store_snapshot_header_t);
+
+    *required_length = 0;
+
+    for (uint32_t i = 0; i < program_info_count; i++) {
+        size_t serialized_length = 0;
+        size_t program_info_length = 0;
+        uint8_t dummy = 0;
+
+        // Query the serialized length of the program information.
+        result = ebpf_serialize_program_info(program_info[i], &dummy, 0, &serialized_length, &program_info_length);
+        if (result != EBPF_INSUFFICIENT_BUFFER && !IS_SUCCESS(result)) {
+            return result;
+        }
+
+        uint8_t* data = _ebpf_store_snapshot_append_record(
+            snapshot, &offset, EBPF_STORE_SNAPSHOT_RECORD_PROGRAM_INFORMATION, program_info_length);
+        if (data != NULL) {
+            result = ebpf_serialize_program_info(
+                program_info[i], data, program_info_length, &serialized_length, &program_info_length);
+            if (!IS_SUCCESS(result)) {
+                return result;
+            }
+        }
+        result = EBPF_SUCCESS;
+    }
+
+    for (uint32_t i = 0; i < section_info_count; i++) {
+        size_t section_name_length = wcslen(section_info[i].section_name);
+        ebpf_store_snapshot_section_record_t* record =
+            (ebpf_store_snapshot_section_record_t*)_ebpf_store_snapshot_append_record(
+                snapshot,
+                &offset,
+                EBPF_STORE_SNAPSHOT_RECORD_SECTION_INFORMATION,
+                EBPF_OFFSET_OF(ebpf_store_snapshot_section_record_t, section_name) +
+                    section_name_length * sizeof(wchar_t));
+        if (record != NULL) {
+            record->header_version = section_info[i].header.version;
+            record->header_size = (uint32_t)section_info[i].header.size;
+            record->program_type = *section_info[i].program_type;
+            record->attach_type = *section_info[i].attach_type;
+            record->bpf_program_type = section_info[i].bpf_program_type;
+            record->bpf_attach_type = section_info[i].bpf_attach_type;
+            record->section_name_length = (uint32_t)section_name_length;
+            memcpy(record->section_name, section_info[i].section_name, section_name_length * sizeof(wchar_t));
+        }
+    }
+
+    for (uint32_t i = 0; i < helper_info_count; i++) {
+        size_t name_length = strlen(helper_info[i].name);
+        ebpf_store_snapshot_helper_record_t* record =
+            (ebpf_store_snapshot_helper_record_t*)_ebpf_store_snapshot_append_record(
+                snapshot,
+                &offset,
+                EBPF_STORE_SNAPSHOT_RECORD_GLOBAL_HELPER,
+                EBPF_OFFSET_OF(ebpf_store_snapshot_helper_record_t, name) + name_length);
+        if (record != NULL) {
+            record->header_version = helper_info[i].header.version;
+            record->header_size = (uint32_t)helper_info[i].header.size;
+            record->helper_id = helper_info[i].helper_id;
+            record->return_type = helper_info[i].return_type;
+            memcpy(record->arguments, helper_info[i].arguments, sizeof(record->arguments));
+            if (helper_info[i].header.size >= EBPF_SIZE_INCLUDING_FIELD(ebpf_helper_function_prototype_t, flags)) {
+                record->reallocate_packet = helper_info[i].flags.reallocate_packet ? 1 : 0;
+            }
+            record->name_length = (uint32_t)name_length;
+            memcpy(record->name, helper_info[i].name, name_length);
+        }
+    }
+
+    if (snapshot != NULL && offset > snapshot_length) {
+        // Internal error. The required length changed between the two passes.
+        return EBPF_FAILED;
+    }
+
+    *required_length = offset;
+    return result;
+}
+
+ebpf_result_t
+ebpf_store_update_snapshot(
+    _In_reads_(program_info_count) const ebpf_program_info_t* program_info,
+    uint32_t program_info_count,
+    _In_reads_(section_info_count) const ebpf_program_section_info_t* section_info,
+    uint32_t section_info_count,
+    _In_reads_(helper_info_count) const ebpf_helper_function_prototype_t* helper_info,
+    uint32_t helper_info_count)
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_store_key_t provider_key = NULL;
+    ebpf_program_info_t** new_program_info = NULL;
+    uint8_t* snapshot = NULL;
+    size_t snapshot_length = 0;
+    ebpf_store_snapshot_header_t* header = NULL;
+
+    if (helper_info_count > 0 && !ebpf_validate_helper_function_prototype_array(helper_info, helper_info_count)) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    for (uint32_t i = 0; i < section_info_count; i++) {
+        if (!ebpf_validate_program_section_info(&section_info[i])) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Exit;
+        }
+    }
+
+    if (program_info_count > 0) {
+        new_program_info = (ebpf_program_info_t**)ebpf_allocate(program_info_count * sizeof(ebpf_program_info_t*));
+        if (new_program_info == NULL) {
+            result = EBPF_NO_MEMORY;
+            goto Exit;
+        }
+    }
+
+    for (uint32_t i = 0; i < program_info_count; i++) {
+        if (!ebpf_validate_program_info(&program_info[i])) {
+            result = EBPF_INVALID_ARGUMENT;
+            goto Exit;
+        }
+
+        // Duplicate the program information to the latest version with safe defaults.
+        result = ebpf_duplicate_program_info(&program_info[i], &new_program_info[i]);
+        if (!IS_SUCCESS(result)) {
+            goto Exit;
+        }
+    }
+
+    // Compute the length of the snapshot.
+    result = _ebpf_store_snapshot_write_records(
+        new_program_info,
+        program_info_count,
+        section_info,
+        section_info_count,
+        helper_info,
+        helper_info_count,
+        NULL,
+        0,
+        &snapshot_length);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
+    if (snapshot_length > MAXULONG) {
+        result = EBPF_INVALID_ARGUMENT;
+        goto Exit;
+    }
+
+    snapshot = (uint8_t*)ebpf_allocate(snapshot_length);
+    if (snapshot == NULL) {
+        result = EBPF_NO_MEMORY;
+        goto Exit;
+    }
+
+    result = _ebpf_store_snapshot_write_records(
+        new_program_info,
+        program_info_count,
+        section_info,
+        section_info_count,
+        helper_info,
+        helper_info_count,
+        snapshot,
+        snapshot_length,
+        &snapshot_length);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
+    header = (ebpf_store_snapshot_header_t*)snapshot;
+    header->magic = EBPF_STORE_SNAPSHOT_MAGIC;
+    header->version = EBPF_STORE_SNAPSHOT_CURRENT_VERSION;
+    header->length = snapshot_length;
+    header->record_count = program_info_count + section_info_count + helper_info_count;
+    header->hash = ebpf_store_snapshot_hash(
+        snapshot + sizeof(ebpf_store_snapshot_header_t), snapshot_length - sizeof(ebpf_store_snapshot_header_t));
+
+    // Open (or create) provider registry path.
+    result = _ebpf_store_open_or_create_provider_registry_key(&provider_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
+    result = ebpf_write_registry_value_binary(provider_key, EBPF_STORE_SNAPSHOT, snapshot, snapshot_length);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
+Exit:
+    ebpf_close_registry_key(provider_key);
+    ebpf_free(snapshot);
+    if (new_program_info != NULL) {
+        for (uint32_t i = 0; i < program_info_count; i++) {
+            ebpf_program_info_free(new_program_info[i]);
+        }
+        ebpf_free(new_program_info);
+    }
+
+    return result;
+}
+
+ebpf_result_t
+ebpf_store_delete_snapshot()
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    ebpf_store_key_t root_key = NULL;
+    ebpf_store_key_t provider_key = NULL;
+
+    // Open root registry path.
+    result = ebpf_open_registry_key(ebpf_store_root_key, ebpf_store_root_sub_key, REG_CREATE_FLAGS, &root_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
+    // Open provider registry path.
+    result = ebpf_open_registry_key(root_key, EBPF_PROVIDERS_REGISTRY_KEY, REG_CREATE_FLAGS, &provider_key);
+    if (!IS_SUCCESS(result)) {
+        goto Exit;
+    }
+
+    result = _ebpf_store_delete_snapshot(provider_key);
+
+Exit:
+    if (result == EBPF_FILE_NOT_FOUND) {
+        // There is no store, so there is no snapshot.
+        result = EBPF_SUCCESS;
+    }
+    ebpf_close_registry_key(provider_key);
+    ebpf_close_registry_key(root_key);
+
+    return result;
+}
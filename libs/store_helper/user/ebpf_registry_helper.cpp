@@ -178,6 +178,58 @@ Exit:
     return result;
 }
 
+_Must_inspect_result_ ebpf_result_t
+ebpf_read_registry_value_binary_allocated(
+    ebpf_store_key_t key,
+    _In_z_ const wchar_t* value_name,
+    _Outptr_result_bytebuffer_(*value_size) uint8_t** value,
+    _Out_ size_t* value_size)
+{
+    ebpf_result_t result = EBPF_SUCCESS;
+    unsigned long type = REG_BINARY;
+    // Start with a buffer that is large enough for typical values, so that the value is read with a single call.
+    unsigned long local_value_size = 64 * 1024;
+    uint8_t* local_value = nullptr;
+
+    *value = nullptr;
+    *value_size = 0;
+
+    for (;;) {
+        local_value = (uint8_t*)ebpf_allocate(local_value_size);
+        if (local_value == nullptr) {
+            return EBPF_NO_MEMORY;
+        }
+
+        uint32_t status = RegQueryValueEx(key, value_name, 0, &type, local_value, &local_value_size);
+        if (status == ERROR_MORE_DATA) {
+            // local_value_size now contains the required size.
+            ebpf_free(local_value);
+            local_value = nullptr;
+            continue;
+        }
+        result = _EBPF_RESULT(status);
+        break;
+    }
+
+    if (result == EBPF_SUCCESS && type != REG_BINARY) {
+        result = EBPF_INVALID_ARGUMENT;
+    }
+    if (result != EBPF_SUCCESS) {
+        ebpf_free(local_value);
+        return result;
+    }
+
+    *value = local_value;
+    *value_size = local_value_size;
+    return result;
+}
+
+_Must_inspect_result_ ebpf_result_t
+ebpf_delete_registry_value(ebpf_store_key_t key, _In_z_ const wchar_t* value_name)
+{
+    return _EBPF_RESULT(RegDeleteValue(key, value_name));
+}
+
 _Must_inspect_result_ ebpf_result_t
 ebpf_convert_guid_to_string(_In_ const GUID* guid, _Out_writes_all_(string_size) wchar_t* string, size_t string_size)
 {
@@ -61,6 +61,26 @@ extern "C"
         _Out_writes_(value_size) uint8_t* value,
         size_t value_size);
 
+    /**
+     * @brief Read a binary registry value of unknown size.
+     *
+     * @param[in] key Registry key to read from.
+     * @param[in] value_name Name of the value to read.
+     * @param[out] value Buffer allocated with ebpf_allocate containing the value.
+     * @param[out] value_size Size of the value in bytes.
+     *
+     * @returns Status of the operation.
+     */
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_read_registry_value_binary_allocated(
+        ebpf_store_key_t key,
+        _In_z_ const wchar_t* value_name,
+        _Outptr_result_bytebuffer_(*value_size) uint8_t** value,
+        _Out_ size_t* value_size);
+
+    _Must_inspect_result_ ebpf_result_t
+    ebpf_delete_registry_value(ebpf_store_key_t key, _In_z_ const wchar_t* value_name);
+
     _Must_inspect_result_ ebpf_result_t
     ebpf_convert_guid_to_string(
         _In_ const GUID* guid, _Out_writes_all_(string_size) wchar_t* string, size_t string_size);
@@ -23,6 +23,9 @@ Environment:
 #include "net_ebpf_ext_sock_ops.h"
 #include "net_ebpf_ext_xdp.h"
 
+#include <bcrypt.h>
+#pragma comment(lib, "bcrypt")
+
 #define SUBLAYER_WEIGHT_MAXIMUM 0xFFFF
 
 // Globals.
@@ -35,6 +38,9 @@ static bool _net_ebpf_bind_providers_registered = false;
 static bool _net_ebpf_sock_addr_providers_registered = false;
 static bool _net_ebpf_sock_ops_providers_registered = false;
 
+// Random key for the application ID hash, generated each time the extension is loaded.
+static uint64_t _net_ebpf_ext_app_id_key[2] = {0};
+
 static net_ebpf_ext_sublayer_info_t _net_ebpf_ext_sublayers[] = {
     {&EBPF_DEFAULT_SUBLAYER, L"EBPF Sub-Layer", L"Sub-Layer for use by eBPF callouts", 0, SUBLAYER_WEIGHT_MAXIMUM},
     {&EBPF_HOOK_CGROUP_CONNECT_V4_SUBLAYER,
@@ -350,6 +356,105 @@ net_ebpf_extension_get_callout_id_for_hook(net_ebpf_extension_hook_id_t hook_id)
 
     return callout_id;
 }
+
+#define NET_EBPF_EXT_ROTATE_LEFT_64(value, bits) (((value) << (bits)) | ((value) >> (64 - (bits))))
+
+static inline void
+_net_ebpf_ext_sip_round(_Inout_updates_(4) uint64_t* v)
+{
+    v[0] += v[1];
+    v[1] = NET_EBPF_EXT_ROTATE_LEFT_64(v[1], 13);
+    v[1] ^= v[0];
+    v[0] = NET_EBPF_EXT_ROTATE_LEFT_64(v[0], 32);
+    v[2] += v[3];
+    v[3] = NET_EBPF_EXT_ROTATE_LEFT_64(v[3], 16);
+    v[3] ^= v[2];
+    v[0] += v[3];
+    v[3] = NET_EBPF_EXT_ROTATE_LEFT_64(v[3], 21);
+    v[3] ^= v[0];
+    v[2] += v[1];
+    v[1] = NET_EBPF_EXT_ROTATE_LEFT_64(v[1], 17);
+    v[1] ^= v[2];
+    v[2] = NET_EBPF_EXT_ROTATE_LEFT_64(v[2], 32);
+}
+
+static inline void
+_net_ebpf_ext_sip_compress(_Inout_updates_(4) uint64_t* v, uint64_t message)
+{
+    v[3] ^= message;
+    _net_ebpf_ext_sip_round(v);
+    _net_ebpf_ext_sip_round(v);
+    v[0] ^= message;
+}
+
+/**
+ * @brief SipHash-2-4 of a buffer with a 128-bit key.
+ */
+static uint64_t
+_net_ebpf_ext_siphash_2_4(_In_reads_(2) const uint64_t* key, _In_reads_bytes_(size) const uint8_t* data, size_t size)
+{
+    uint64_t v[4] = {
+        key[0] ^ 0x736f6d6570736575ull,
+        key[1] ^ 0x646f72616e646f6dull,
+        key[0] ^ 0x6c7967656e657261ull,
+        key[1] ^ 0x7465646279746573ull,
+    };
+    size_t tail_size = size % sizeof(uint64_t);
+    const uint8_t* tail = data + (size - tail_size);
+    uint64_t message;
+
+    for (; data != tail; data += sizeof(uint64_t)) {
+        memcpy(&message, data, sizeof(message));
+        _net_ebpf_ext_sip_compress(v, message);
+    }
+
+    // The last block holds the remaining bytes and the low byte of the size.
+    message = ((uint64_t)size) << 56;
+    for (size_t index = 0; index < tail_size; index++) {
+        message |= ((uint64_t)tail[index]) << (8 * index);
+    }
+    _net_ebpf_ext_sip_compress(v, message);
+
+    v[2] ^= 0xff;
+    for (int round = 0; round < 4; round++) {
+        _net_ebpf_ext_sip_round(v);
+    }
+    return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+static NTSTATUS
+_net_ebpf_ext_initialize_app_id_key()
+{
+    NTSTATUS status = BCryptGenRandom(
+        NULL, (uint8_t*)_net_ebpf_ext_app_id_key, sizeof(_net_ebpf_ext_app_id_key), BCRYPT_USE_SYSTEM_PREFERRED_RNG);
+    if (!NT_SUCCESS(status)) {
+        NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(NET_EBPF_EXT_TRACELOG_KEYWORD_EXTENSION, "BCryptGenRandom", status);
+    }
+    return status;
+}
+
+uint64_t
+net_ebpf_extension_get_app_id(_In_reads_bytes_opt_(app_id_size) const uint8_t* app_id, size_t app_id_size)
+{
+    if (app_id == NULL || app_id_size == 0) {
+        return 0;
+    }
+
+    uint64_t hash = _net_ebpf_ext_siphash_2_4(_net_ebpf_ext_app_id_key, app_id, app_id_size);
+
+    // Reserve 0 for "no application".
+    return (hash != 0) ? hash : 1;
+}
+
+_Ret_maybenull_ const FWP_BYTE_BLOB*
+net_ebpf_extension_get_app_id_blob(_In_ const FWPS_INCOMING_VALUE0* incoming_value)
+{
+    if (incoming_value->value.type != FWP_BYTE_BLOB_TYPE || incoming_value->value.byteBlob == NULL) {
+        return NULL;
+    }
+    return incoming_value->value.byteBlob;
+}
+
 void
 net_ebpf_extension_delete_wfp_filters(
     uint32_t filter_count, _Frees_ptr_ _In_count_(filter_count) net_ebpf_ext_wfp_filter_id_t* filter_ids)
@@ -799,6 +904,11 @@ net_ebpf_ext_register_providers()
 
     NET_EBPF_EXT_LOG_ENTRY();
 
+    status = _net_ebpf_ext_initialize_app_id_key();
+    if (!NT_SUCCESS(status)) {
+        goto Exit;
+    }
+
     status = net_ebpf_ext_xdp_register_providers();
     if (!NT_SUCCESS(status)) {
         NET_EBPF_EXT_LOG_MESSAGE_NTSTATUS(
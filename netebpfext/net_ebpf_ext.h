@@ -45,6 +45,7 @@ typedef struct _wfp_ale_layer_fields
     uint16_t interface_luid_field;
     uint16_t user_id_field;
     uint16_t flags_field;
+    uint16_t app_id_field;
 } wfp_ale_layer_fields_t;
 
 typedef struct _net_ebpf_extension_wfp_filter_parameters
@@ -193,6 +194,31 @@ net_ebpf_extension_get_hook_id_from_wfp_layer_id(uint16_t wfp_layer_id);
 uint32_t
 net_ebpf_extension_get_callout_id_for_hook(net_ebpf_extension_hook_id_t hook_id);
 
+/**
+ * @brief Map a WFP ALE application ID (the UTF-16 NT path of the application image) to a 64-bit application ID.
+ * The ID is the SipHash-2-4 of the application ID bytes, keyed with a random key generated when the extension is
+ * loaded. It needs no shared state, is stable until the extension is reloaded, and can't be predicted without the key.
+ * User mode resolves a path to its ID with IOCTL_NET_EBPF_EXT_CTL_GET_APP_ID. The ID is a 64-bit hash, so two
+ * applications can collide: it is not a security boundary.
+ *
+ * @param[in] app_id Pointer to the application ID bytes.
+ * @param[in] app_id_size Size in bytes of the application ID.
+ *
+ * @returns The 64-bit application ID, or 0 if app_id_size is 0.
+ */
+uint64_t
+net_ebpf_extension_get_app_id(_In_reads_bytes_opt_(app_id_size) const uint8_t* app_id, size_t app_id_size);
+
+/**
+ * @brief Helper function to return the application ID blob from a WFP incoming value.
+ *
+ * @param[in] incoming_value WFP incoming value for the ALE_APP_ID field.
+ *
+ * @returns The application ID blob, or NULL if the value does not contain one.
+ */
+_Ret_maybenull_ const FWP_BYTE_BLOB*
+net_ebpf_extension_get_app_id_blob(_In_ const FWPS_INCOMING_VALUE0* incoming_value);
+
 /**
  * @brief Add WFP filters with specified conditions at specified layers.
  *
@@ -37,6 +37,14 @@ const net_ebpf_extension_wfp_filter_parameters_t _net_ebpf_extension_bind_wfp_fi
 
 #define NET_EBPF_BIND_FILTER_COUNT EBPF_COUNT_OF(_net_ebpf_extension_bind_wfp_filter_parameters)
 
+typedef struct _net_ebpf_bind_md
+{
+    bind_md_t base;
+    const uint8_t* app_id;    ///< Full (untruncated) application ID.
+    size_t app_id_size;       ///< Size in bytes of the application ID.
+    uint64_t interned_app_id; ///< Application ID computed on first use, or 0.
+} net_ebpf_bind_md_t;
+
 static ebpf_result_t
 _ebpf_bind_context_create(
     _In_reads_bytes_opt_(data_size_in) const uint8_t* data_in,
@@ -53,12 +61,33 @@ _ebpf_bind_context_destroy(
     _Out_writes_bytes_to_(*context_size_out, *context_size_out) uint8_t* context_out,
     _Inout_ size_t* context_size_out);
 
+//
+// Bind helper functions.
+//
+static uint64_t
+_ebpf_bind_get_current_app_id(_In_ const bind_md_t* ctx)
+{
+    net_ebpf_bind_md_t* bind_ctx = CONTAINING_RECORD(ctx, net_ebpf_bind_md_t, base);
+    if (bind_ctx->interned_app_id == 0) {
+        bind_ctx->interned_app_id = net_ebpf_extension_get_app_id(bind_ctx->app_id, bind_ctx->app_id_size);
+    }
+    return bind_ctx->interned_app_id;
+}
+
+static const void* _ebpf_bind_global_helper_functions[] = {(void*)_ebpf_bind_get_current_app_id};
+
+static ebpf_helper_function_addresses_t _ebpf_bind_global_helper_function_address_table = {
+    EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
+    EBPF_COUNT_OF(_ebpf_bind_global_helper_functions),
+    (uint64_t*)_ebpf_bind_global_helper_functions};
+
 //
 // Bind Program Information NPI Provider.
 //
 static ebpf_program_data_t _ebpf_bind_program_data = {
     .header = EBPF_PROGRAM_DATA_HEADER,
     .program_info = &_ebpf_bind_program_info,
+    .global_helper_function_addresses = &_ebpf_bind_global_helper_function_address_table,
     .context_create = _ebpf_bind_context_create,
     .context_destroy = _ebpf_bind_context_destroy,
     .required_irql = PASSIVE_LEVEL,
@@ -215,16 +244,30 @@ net_ebpf_ext_bind_unregister_providers()
 static void
 _net_ebpf_ext_resource_truncate_appid(bind_md_t* ctx)
 {
-    wchar_t* last_separator = (wchar_t*)ctx->app_id_start;
-    for (wchar_t* position = (wchar_t*)ctx->app_id_start; position < (wchar_t*)ctx->app_id_end; position++) {
-        if (*position == '\\') {
-            last_separator = position;
+    // Only the file name after the last separator is passed to the program, so scan backwards from the end.
+    wchar_t* start = (wchar_t*)ctx->app_id_start;
+    wchar_t* position = (wchar_t*)ctx->app_id_end;
+    while (position > start) {
+        if (*(position - 1) == '\\') {
+            break;
         }
+        position--;
     }
-    if (*last_separator == '\\') {
-        last_separator++;
-    }
-    ctx->app_id_start = (uint8_t*)last_separator;
+    ctx->app_id_start = (uint8_t*)position;
+}
+
+static void
+_net_ebpf_ext_resource_set_appid(
+    _In_ const FWPS_INCOMING_VALUES* incoming_fixed_values, uint16_t app_id_field, _Out_ net_ebpf_bind_md_t* ctx)
+{
+    const FWP_BYTE_BLOB* app_id = incoming_fixed_values->incomingValue[app_id_field].value.byteBlob;
+
+    ctx->app_id = app_id->data;
+    ctx->app_id_size = app_id->size;
+    ctx->interned_app_id = 0;
+    ctx->base.app_id_start = app_id->data;
+    ctx->base.app_id_end = app_id->data + app_id->size;
+    _net_ebpf_ext_resource_truncate_appid(&ctx->base);
 }
 
 void
@@ -239,7 +282,7 @@ net_ebpf_ext_resource_allocation_classify(
 {
     SOCKADDR_IN addr = {AF_INET};
     uint32_t result;
-    bind_md_t ctx;
+    net_ebpf_bind_md_t ctx;
     net_ebpf_extension_wfp_filter_context_t* filter_context = NULL;
     net_ebpf_extension_hook_client_t* attached_client = NULL;
 
@@ -280,20 +323,15 @@ net_ebpf_ext_resource_allocation_classify(
     addr.sin_addr.S_un.S_addr =
         incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_ASSIGNMENT_V4_IP_LOCAL_ADDRESS].value.uint32;
 
-    ctx.process_id = incoming_metadata_values->processId;
-    memcpy(&ctx.socket_address, &addr, sizeof(addr));
-    ctx.socket_address_length = sizeof(addr);
-    ctx.operation = BIND_OPERATION_BIND;
-    ctx.protocol = incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_ASSIGNMENT_V4_IP_PROTOCOL].value.uint8;
+    ctx.base.process_id = incoming_metadata_values->processId;
+    memcpy(&ctx.base.socket_address, &addr, sizeof(addr));
+    ctx.base.socket_address_length = sizeof(addr);
+    ctx.base.operation = BIND_OPERATION_BIND;
+    ctx.base.protocol =
+        incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_ASSIGNMENT_V4_IP_PROTOCOL].value.uint8;
 
-    ctx.app_id_start =
-        incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_ASSIGNMENT_V4_ALE_APP_ID].value.byteBlob->data;
-    ctx.app_id_end =
-        ctx.app_id_start +
-        incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_ASSIGNMENT_V4_ALE_APP_ID].value.byteBlob->size;
-
-    _net_ebpf_ext_resource_truncate_appid(&ctx);
-    if (net_ebpf_extension_hook_invoke_program(attached_client, &ctx, &result) == EBPF_SUCCESS) {
+    _net_ebpf_ext_resource_set_appid(incoming_fixed_values, FWPS_FIELD_ALE_RESOURCE_ASSIGNMENT_V4_ALE_APP_ID, &ctx);
+    if (net_ebpf_extension_hook_invoke_program(attached_client, &ctx.base, &result) == EBPF_SUCCESS) {
         switch (result) {
         case BIND_PERMIT:
         case BIND_REDIRECT:
@@ -330,7 +368,7 @@ net_ebpf_ext_resource_release_classify(
 {
     SOCKADDR_IN addr = {AF_INET};
     uint32_t result;
-    bind_md_t ctx;
+    net_ebpf_bind_md_t ctx;
     net_ebpf_extension_wfp_filter_context_t* filter_context = NULL;
     net_ebpf_extension_hook_client_t* attached_client = NULL;
 
@@ -370,22 +408,17 @@ net_ebpf_ext_resource_release_classify(
     addr.sin_addr.S_un.S_addr =
         incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_RELEASE_V4_IP_LOCAL_ADDRESS].value.uint32;
 
-    ctx.process_id = incoming_metadata_values->processId;
-    memcpy(&ctx.socket_address, &addr, sizeof(addr));
-    ctx.socket_address_length = sizeof(addr);
-    ctx.operation = BIND_OPERATION_UNBIND;
-    ctx.protocol = incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_RELEASE_V4_IP_PROTOCOL].value.uint8;
-
-    ctx.app_id_start =
-        incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_RELEASE_V4_ALE_APP_ID].value.byteBlob->data;
-    ctx.app_id_end =
-        ctx.app_id_start +
-        incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_RELEASE_V4_ALE_APP_ID].value.byteBlob->size;
+    ctx.base.process_id = incoming_metadata_values->processId;
+    memcpy(&ctx.base.socket_address, &addr, sizeof(addr));
+    ctx.base.socket_address_length = sizeof(addr);
+    ctx.base.operation = BIND_OPERATION_UNBIND;
+    ctx.base.protocol =
+        incoming_fixed_values->incomingValue[FWPS_FIELD_ALE_RESOURCE_RELEASE_V4_IP_PROTOCOL].value.uint8;
 
-    _net_ebpf_ext_resource_truncate_appid(&ctx);
+    _net_ebpf_ext_resource_set_appid(incoming_fixed_values, FWPS_FIELD_ALE_RESOURCE_RELEASE_V4_ALE_APP_ID, &ctx);
 
     // Ignore the result of this call as we don't want to block the unbind.
-    (void)net_ebpf_extension_hook_invoke_program(attached_client, &ctx, &result);
+    (void)net_ebpf_extension_hook_invoke_program(attached_client, &ctx.base, &result);
 
     classify_output->actionType = FWP_ACTION_PERMIT;
 
@@ -406,7 +439,7 @@ _ebpf_bind_context_create(
 {
     NET_EBPF_EXT_LOG_ENTRY();
     ebpf_result_t result;
-    bind_md_t* bind_context = NULL;
+    net_ebpf_bind_md_t* bind_context = NULL;
 
     *context = NULL;
 
@@ -417,18 +450,21 @@ _ebpf_bind_context_create(
         goto Exit;
     }
 
-    bind_context =
-        (bind_md_t*)ExAllocatePoolUninitialized(NonPagedPoolNx, sizeof(bind_md_t), NET_EBPF_EXTENSION_POOL_TAG);
+    bind_context = (net_ebpf_bind_md_t*)ExAllocatePoolUninitialized(
+        NonPagedPoolNx, sizeof(net_ebpf_bind_md_t), NET_EBPF_EXTENSION_POOL_TAG);
     NET_EBPF_EXT_BAIL_ON_ALLOC_FAILURE_RESULT(NET_EBPF_EXT_TRACELOG_KEYWORD_BIND, bind_context, "bind_context", result);
 
     // Copy the context from the caller.
-    memcpy(bind_context, context_in, sizeof(bind_md_t));
+    memcpy(&bind_context->base, context_in, sizeof(bind_md_t));
 
     // Replace the app_id_start and app_id_end with pointers to data_in.
-    bind_context->app_id_start = (uint8_t*)data_in;
-    bind_context->app_id_end = (uint8_t*)data_in + data_size_in;
+    bind_context->base.app_id_start = (uint8_t*)data_in;
+    bind_context->base.app_id_end = (uint8_t*)data_in + data_size_in;
+    bind_context->app_id = data_in;
+    bind_context->app_id_size = data_size_in;
+    bind_context->interned_app_id = 0;
 
-    *context = bind_context;
+    *context = &bind_context->base;
     bind_context = NULL;
     result = EBPF_SUCCESS;
 
@@ -477,7 +513,7 @@ _ebpf_bind_context_destroy(
         *data_size_out = 0;
     }
 
-    ExFreePool(bind_context);
+    ExFreePool(CONTAINING_RECORD(bind_context, net_ebpf_bind_md_t, base));
 
 Exit:
     NET_EBPF_EXT_LOG_EXIT();
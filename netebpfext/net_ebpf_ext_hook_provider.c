@@ -24,6 +24,8 @@ typedef struct _net_ebpf_extension_hook_client
     const void* client_binding_context;            ///< Client supplied context to be passed when invoking eBPF program.
     const ebpf_extension_data_t* client_data;      ///< Client supplied attach parameters.
     ebpf_program_invoke_function_t invoke_program; ///< Pointer to function to invoke eBPF program.
+    ebpf_program_get_state_generation_function_t
+        get_state_generation; ///< Pointer to function returning the program state generation. May be NULL.
     void* provider_data; ///< Opaque pointer to hook specific data associated with this client.
     struct _net_ebpf_extension_hook_provider* provider_context; ///< Pointer to the hook NPI provider context.
     PIO_WORKITEM detach_work_item;              ///< Pointer to IO work item that is invoked to detach the client.
@@ -212,6 +214,18 @@ net_ebpf_extension_hook_invoke_program(
     NET_EBPF_EXT_RETURN_RESULT(invoke_result);
 }
 
+_Must_inspect_result_ bool
+net_ebpf_extension_hook_client_get_state_generation(
+    _In_ const net_ebpf_extension_hook_client_t* client, _Out_ uint64_t* generation)
+{
+    if (client->get_state_generation == NULL) {
+        *generation = 0;
+        return false;
+    }
+    *generation = client->get_state_generation(client->client_binding_context);
+    return true;
+}
+
 _Must_inspect_result_ ebpf_result_t
 net_ebpf_extension_hook_check_attach_parameter(
     size_t attach_parameter_size,
@@ -354,6 +368,11 @@ _net_ebpf_extension_hook_provider_attach_client(
         goto Exit;
     }
     hook_client->invoke_program = client_dispatch_table->ebpf_program_invoke_function;
+    // Older clients do not report a state generation, which disables verdict caching for them.
+    if (client_dispatch_table->version >= EBPF_LINK_DISPATCH_TABLE_VERSION_2 &&
+        client_dispatch_table->count >= EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_2) {
+        hook_client->get_state_generation = client_dispatch_table->ebpf_program_get_state_generation_function;
+    }
     hook_client->provider_context = local_provider_context;
 
     status = _ebpf_ext_attach_init_rundown(hook_client);
@@ -151,6 +151,20 @@ _Must_inspect_result_ ebpf_result_t
 net_ebpf_extension_hook_invoke_program(
     _In_ const net_ebpf_extension_hook_client_t* client, _Inout_ void* context, _Out_ uint32_t* result);
 
+/**
+ * @brief Get the state generation of the eBPF program attached to this hook. A verdict the program returned for a
+ * given input may be reused for the same input only while the generation is unchanged. This must be called inside a
+ * net_ebpf_extension_hook_client_enter_rundown/net_ebpf_extension_hook_client_leave_rundown block.
+ *
+ * @param[in] client Pointer to Hook NPI Client (a.k.a. eBPF Link object).
+ * @param[out] generation The current state generation.
+ * @retval true The client reports a state generation.
+ * @retval false The client does not support state generations, so verdicts must not be cached.
+ */
+_Must_inspect_result_ bool
+net_ebpf_extension_hook_client_get_state_generation(
+    _In_ const net_ebpf_extension_hook_client_t* client, _Out_ uint64_t* generation);
+
 /**
  * @brief Return client attached to the hook NPI provider.
  * @param[in, out] provider_context Provider module's context.
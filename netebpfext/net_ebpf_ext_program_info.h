@@ -19,7 +19,19 @@ static const ebpf_helper_function_prototype_t _xdp_test_ebpf_extension_helper_fu
      EBPF_RETURN_TYPE_INTEGER,
      {EBPF_ARGUMENT_TYPE_PTR_TO_CTX, EBPF_ARGUMENT_TYPE_ANYTHING},
      // Flags.
-     {HELPER_FUNCTION_REALLOCATE_PACKET}}};
+     {HELPER_FUNCTION_REALLOCATE_PACKET}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     XDP_EXT_HELPER_FUNCTION_START + 2,
+     "bpf_xdp_adjust_meta",
+     EBPF_RETURN_TYPE_INTEGER,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_CTX, EBPF_ARGUMENT_TYPE_ANYTHING},
+     // Flags.
+     {HELPER_FUNCTION_REALLOCATE_PACKET}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     XDP_EXT_HELPER_FUNCTION_START + 3,
+     "bpf_xdp_parse_headers",
+     EBPF_RETURN_TYPE_INTEGER,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_CTX, EBPF_ARGUMENT_TYPE_PTR_TO_WRITABLE_MEM, EBPF_ARGUMENT_TYPE_CONST_SIZE}}};
 
 // XDP_TEST program information.
 static const ebpf_context_descriptor_t _ebpf_xdp_test_context_descriptor = {
@@ -49,6 +61,14 @@ static const ebpf_program_section_info_t _ebpf_xdp_test_section_info[] = {
      BPF_PROG_TYPE_XDP_TEST,
      BPF_XDP_TEST}};
 
+// BIND global helper function prototypes.
+static const ebpf_helper_function_prototype_t _ebpf_bind_global_helper_function_prototype[] = {
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_get_current_app_id,
+     "bpf_get_current_app_id",
+     EBPF_RETURN_TYPE_INTEGER,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_CTX}}};
+
 // Bind program information.
 static const ebpf_context_descriptor_t _ebpf_bind_context_descriptor = {
     sizeof(bind_md_t), EBPF_OFFSET_OF(bind_md_t, app_id_start), EBPF_OFFSET_OF(bind_md_t, app_id_end), -1};
@@ -61,7 +81,12 @@ static const ebpf_program_type_descriptor_t _ebpf_bind_program_type_descriptor =
     BPF_PROG_TYPE_BIND,
     0};
 static const ebpf_program_info_t _ebpf_bind_program_info = {
-    EBPF_PROGRAM_INFORMATION_HEADER, &_ebpf_bind_program_type_descriptor, 0, NULL, 0, NULL};
+    EBPF_PROGRAM_INFORMATION_HEADER,
+    &_ebpf_bind_program_type_descriptor,
+    0,
+    NULL,
+    EBPF_COUNT_OF(_ebpf_bind_global_helper_function_prototype),
+    _ebpf_bind_global_helper_function_prototype};
 
 static const ebpf_program_section_info_t _ebpf_bind_section_info[] = {
     {{EBPF_PROGRAM_SECTION_INFORMATION_CURRENT_VERSION, EBPF_PROGRAM_SECTION_INFORMATION_CURRENT_VERSION_SIZE},
@@ -100,6 +125,11 @@ static const ebpf_helper_function_prototype_t _ebpf_sock_addr_global_helper_func
      BPF_FUNC_get_socket_cookie,
      "bpf_get_socket_cookie",
      EBPF_RETURN_TYPE_INTEGER,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_CTX}},
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_get_current_app_id,
+     "bpf_get_current_app_id",
+     EBPF_RETURN_TYPE_INTEGER,
      {EBPF_ARGUMENT_TYPE_PTR_TO_CTX}}};
 
 // CGROUP_SOCK_ADDR program information.
@@ -151,6 +181,14 @@ static const ebpf_program_section_info_t _ebpf_sock_addr_section_info[] = {
      BPF_PROG_TYPE_CGROUP_SOCK_ADDR,
      BPF_CGROUP_INET6_RECV_ACCEPT}};
 
+// SOCK_OPS global helper function prototypes.
+static const ebpf_helper_function_prototype_t _ebpf_sock_ops_global_helper_function_prototype[] = {
+    {EBPF_HELPER_FUNCTION_PROTOTYPE_HEADER,
+     BPF_FUNC_get_current_app_id,
+     "bpf_get_current_app_id",
+     EBPF_RETURN_TYPE_INTEGER,
+     {EBPF_ARGUMENT_TYPE_PTR_TO_CTX}}};
+
 // SOCK_OPS program information.
 static const ebpf_context_descriptor_t _ebpf_sock_ops_context_descriptor = {
     sizeof(bpf_sock_ops_t),
@@ -167,7 +205,12 @@ static const ebpf_program_type_descriptor_t _ebpf_sock_ops_program_type_descript
     BPF_PROG_TYPE_SOCK_OPS,
     0};
 static const ebpf_program_info_t _ebpf_sock_ops_program_info = {
-    EBPF_PROGRAM_INFORMATION_HEADER, &_ebpf_sock_ops_program_type_descriptor, 0, NULL, 0, NULL};
+    EBPF_PROGRAM_INFORMATION_HEADER,
+    &_ebpf_sock_ops_program_type_descriptor,
+    0,
+    NULL,
+    EBPF_COUNT_OF(_ebpf_sock_ops_global_helper_function_prototype),
+    _ebpf_sock_ops_global_helper_function_prototype};
 
 static const ebpf_program_section_info_t _ebpf_sock_ops_section_info[] = {
     {{EBPF_PROGRAM_SECTION_INFORMATION_CURRENT_VERSION, EBPF_PROGRAM_SECTION_INFORMATION_CURRENT_VERSION_SIZE},
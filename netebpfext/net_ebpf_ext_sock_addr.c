@@ -14,6 +14,13 @@
 #define EXPIRY_TIME 60000 // 60 seconds in ms.
 #define CONVERT_100NS_UNITS_TO_MS(x) ((x) / 10000)
 #define LOW_MEMORY_CONNECTION_CONTEXT_COUNT 1000
+// Redirect contexts up to this size are kept in the classify context and only copied to pool memory if the
+// connection is actually redirected.
+#define NET_EBPF_EXT_SOCK_ADDR_INLINE_REDIRECT_CONTEXT_SIZE 64
+// Number of entries in each per-CPU verdict cache. Must be a power of 2.
+#define NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_SIZE 64
+#define NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_FLAGS \
+    (BPF_SOCK_ADDR_VERDICT_CACHE | BPF_SOCK_ADDR_VERDICT_CACHE_PER_PROCESS)
 
 #define NET_EBPF_EXT_SOCK_ADDR_CLASSIFY_MESSAGE "NetEbpfExtSockAddrClassify"
 
@@ -181,9 +188,12 @@ typedef struct _net_ebpf_bpf_sock_addr
     uint64_t process_id;
     uint32_t flags;
     net_ebpf_extension_hook_id_t hook_id;
-    void* redirect_context;
+    void* redirect_context; ///< Either inline_redirect_context or a pool allocation.
     uint32_t redirect_context_size;
+    uint8_t inline_redirect_context[NET_EBPF_EXT_SOCK_ADDR_INLINE_REDIRECT_CONTEXT_SIZE];
     uint64_t transport_endpoint_handle;
+    const FWP_BYTE_BLOB* app_id;
+    uint64_t interned_app_id; ///< Application ID computed on first use, or 0.
 } net_ebpf_sock_addr_t;
 
 /**
@@ -220,6 +230,8 @@ typedef struct _net_ebpf_ext_sock_addr_statistics
     volatile long block_connection_count;
     // Counter for the number of times a pre-allocated low memory context was used.
     volatile long low_memory_context_count;
+    // Counter for the number of verdicts served from the verdict cache instead of invoking the program.
+    volatile long verdict_cache_hit_count;
 } net_ebpf_ext_sock_addr_statistics_t;
 
 static net_ebpf_ext_sock_addr_statistics_t _net_ebpf_ext_statistics;
@@ -243,6 +255,57 @@ typedef struct _net_ebpf_ext_sock_addr_connection_contexts
 
 static net_ebpf_ext_sock_addr_connection_contexts_t _net_ebpf_ext_sock_addr_blocked_contexts = {0};
 
+/**
+ * Key of a cached verdict. The source port is deliberately not part of the key: it is usually ephemeral, so keying on
+ * it would make every new connection a miss. Programs that look at it must not mark their verdicts as cacheable.
+ */
+typedef struct _net_ebpf_ext_sock_addr_verdict_cache_key
+{
+    const net_ebpf_extension_hook_client_t* client;
+    uint64_t interface_luid;
+    uint32_t compartment_id;
+    uint32_t family;
+    uint32_t protocol;
+    uint32_t source_ip[4];
+    uint32_t destination_ip[4];
+    uint16_t destination_port;
+    uint16_t reserved;
+    uint64_t process_id; ///< Only compared for per-process entries. Must be the last field, as it is not hashed.
+} net_ebpf_ext_sock_addr_verdict_cache_key_t;
+
+typedef struct _net_ebpf_ext_sock_addr_verdict_cache_entry
+{
+    net_ebpf_ext_sock_addr_verdict_cache_key_t key;
+    uint64_t program_generation; ///< Program state generation at the time the program was invoked.
+    int64_t attach_generation;   ///< Value of _net_ebpf_ext_sock_addr_verdict_cache_attach_generation at that time.
+    uint32_t verdict;
+    bool valid;
+    bool per_process;
+} net_ebpf_ext_sock_addr_verdict_cache_entry_t;
+
+/**
+ * Direct mapped verdict cache, one per CPU, so that lookups never contend across processors. The lock only guards
+ * against the rare case of a thread being preempted and another thread being scheduled on the same CPU.
+ */
+typedef __declspec(align(EBPF_CACHE_LINE_SIZE)) struct _net_ebpf_ext_sock_addr_verdict_cache
+{
+    KSPIN_LOCK lock;
+    _Guarded_by_(lock)
+        net_ebpf_ext_sock_addr_verdict_cache_entry_t entries[NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_SIZE];
+} net_ebpf_ext_sock_addr_verdict_cache_t;
+
+static net_ebpf_ext_sock_addr_verdict_cache_t* _net_ebpf_ext_sock_addr_verdict_caches = NULL;
+static uint32_t _net_ebpf_ext_sock_addr_verdict_cache_count = 0;
+// Advanced whenever a client attaches or detaches, so that entries keyed on a client never outlive it even if a new
+// client is later allocated at the same address.
+static volatile int64_t _net_ebpf_ext_sock_addr_verdict_cache_attach_generation = 0;
+
+static void
+_net_ebpf_ext_sock_addr_verdict_cache_invalidate()
+{
+    InterlockedIncrement64(&_net_ebpf_ext_sock_addr_verdict_cache_attach_generation);
+}
+
 static SECURITY_DESCRIPTOR* _net_ebpf_ext_security_descriptor_admin = NULL;
 static ACL* _net_ebpf_ext_dacl_admin = NULL;
 static GENERIC_MAPPING _net_ebpf_ext_generic_mapping = {0};
@@ -286,6 +349,28 @@ _ebpf_sock_addr_get_socket_cookie(_In_ const bpf_sock_addr_t* ctx)
     return sock_addr_ctx->transport_endpoint_handle;
 }
 
+static uint64_t
+_ebpf_sock_addr_get_current_app_id(_In_ const bpf_sock_addr_t* ctx)
+{
+    net_ebpf_sock_addr_t* sock_addr_ctx = CONTAINING_RECORD(ctx, net_ebpf_sock_addr_t, base);
+    if (sock_addr_ctx->interned_app_id == 0 && sock_addr_ctx->app_id != NULL) {
+        sock_addr_ctx->interned_app_id =
+            net_ebpf_extension_get_app_id(sock_addr_ctx->app_id->data, sock_addr_ctx->app_id->size);
+    }
+    return sock_addr_ctx->interned_app_id;
+}
+
+static void
+_net_ebpf_ext_sock_addr_free_redirect_context(_Inout_ net_ebpf_sock_addr_t* sock_addr_ctx)
+{
+    if (sock_addr_ctx->redirect_context != NULL &&
+        sock_addr_ctx->redirect_context != sock_addr_ctx->inline_redirect_context) {
+        ExFreePool(sock_addr_ctx->redirect_context);
+    }
+    sock_addr_ctx->redirect_context = NULL;
+    sock_addr_ctx->redirect_context_size = 0;
+}
+
 static int
 _ebpf_sock_addr_set_redirect_context(_In_ const bpf_sock_addr_t* ctx, _In_ void* data, _In_ uint32_t data_size)
 {
@@ -310,8 +395,12 @@ _ebpf_sock_addr_set_redirect_context(_In_ const bpf_sock_addr_t* ctx, _In_ void*
         goto Exit;
     }
 
-    // Allocate buffer to store redirect context.
-    redirect_context = ExAllocatePoolUninitialized(NonPagedPoolNx, data_size, NET_EBPF_EXTENSION_POOL_TAG);
+    // Small contexts are kept inline; they are only copied to pool memory if the connection gets redirected.
+    if (data_size <= sizeof(sock_addr_ctx->inline_redirect_context)) {
+        redirect_context = sock_addr_ctx->inline_redirect_context;
+    } else {
+        redirect_context = ExAllocatePoolUninitialized(NonPagedPoolNx, data_size, NET_EBPF_EXTENSION_POOL_TAG);
+    }
     if (redirect_context == NULL) {
         NET_EBPF_EXT_LOG_MESSAGE(
             NET_EBPF_EXT_TRACELOG_LEVEL_ERROR,
@@ -322,9 +411,9 @@ _ebpf_sock_addr_set_redirect_context(_In_ const bpf_sock_addr_t* ctx, _In_ void*
     }
     memcpy(redirect_context, data, data_size);
 
-    // If a redirect context already exists, free the existing buffer.
-    if (sock_addr_ctx->redirect_context != NULL) {
-        ExFreePool(sock_addr_ctx->redirect_context);
+    // If a redirect context already exists in pool memory, free the existing buffer.
+    if (sock_addr_ctx->redirect_context != redirect_context) {
+        _net_ebpf_ext_sock_addr_free_redirect_context(sock_addr_ctx);
     }
 
     // Set the redirect context.
@@ -505,7 +594,8 @@ static ebpf_helper_function_addresses_t _ebpf_sock_addr_specific_helper_function
 static const void* _ebpf_sock_addr_global_helper_functions[] = {
     (void*)_ebpf_sock_addr_get_current_logon_id,
     (void*)_ebpf_sock_addr_is_current_admin,
-    (void*)_ebpf_sock_addr_get_socket_cookie};
+    (void*)_ebpf_sock_addr_get_socket_cookie,
+    (void*)_ebpf_sock_addr_get_current_app_id};
 
 static ebpf_helper_function_addresses_t _ebpf_sock_addr_global_helper_function_address_table = {
     EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
@@ -652,6 +742,9 @@ _net_ebpf_extension_sock_addr_on_client_attach(
     net_ebpf_extension_hook_client_set_provider_data(
         (net_ebpf_extension_hook_client_t*)attaching_client, filter_context);
 
+    // The client may reuse the address of a previously detached client, so drop any verdicts cached for that one.
+    _net_ebpf_ext_sock_addr_verdict_cache_invalidate();
+
 Exit:
     if (result != EBPF_SUCCESS) {
         if (filter_context != NULL) {
@@ -678,6 +771,7 @@ _net_ebpf_extension_sock_addr_on_client_detach(_In_ const net_ebpf_extension_hoo
         FwpsRedirectHandleDestroy(filter_context->redirect_handle);
     }
     net_ebpf_extension_wfp_filter_context_cleanup((net_ebpf_extension_wfp_filter_context_t*)filter_context);
+    _net_ebpf_ext_sock_addr_verdict_cache_invalidate();
     NET_EBPF_EXT_LOG_EXIT();
 }
 
@@ -1117,6 +1211,186 @@ Exit:
     NET_EBPF_EXT_RETURN_RESULT(result);
 }
 
+//
+// Verdict cache helpers.
+//
+
+static NTSTATUS
+_net_ebpf_ext_sock_addr_verdict_cache_initialize()
+{
+    uint32_t cpu_count = KeQueryMaximumProcessorCountEx(ALL_PROCESSOR_GROUPS);
+    size_t caches_size = sizeof(net_ebpf_ext_sock_addr_verdict_cache_t) * cpu_count;
+    net_ebpf_ext_sock_addr_verdict_cache_t* caches = (net_ebpf_ext_sock_addr_verdict_cache_t*)
+        ExAllocatePoolUninitialized(NonPagedPoolNx, caches_size, NET_EBPF_EXTENSION_POOL_TAG);
+    if (caches == NULL) {
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+    memset(caches, 0, caches_size);
+
+    for (uint32_t i = 0; i < cpu_count; i++) {
+        KeInitializeSpinLock(&caches[i].lock);
+    }
+
+    _net_ebpf_ext_sock_addr_verdict_cache_count = cpu_count;
+    _net_ebpf_ext_sock_addr_verdict_caches = caches;
+    return STATUS_SUCCESS;
+}
+
+static void
+_net_ebpf_ext_sock_addr_verdict_cache_uninitialize()
+{
+    net_ebpf_ext_sock_addr_verdict_cache_t* caches = _net_ebpf_ext_sock_addr_verdict_caches;
+    if (caches == NULL) {
+        return;
+    }
+    _net_ebpf_ext_sock_addr_verdict_caches = NULL;
+    _net_ebpf_ext_sock_addr_verdict_cache_count = 0;
+    ExFreePool(caches);
+}
+
+/**
+ * @brief Build the verdict cache key for a sock_addr context, as it was before the program was invoked.
+ *
+ * @param[in] client Hook client whose program produces the verdict.
+ * @param[in] sock_addr_ctx Context passed to the program.
+ * @param[out] key The key.
+ */
+static void
+_net_ebpf_ext_sock_addr_verdict_cache_initialize_key(
+    _In_ const net_ebpf_extension_hook_client_t* client,
+    _In_ const net_ebpf_sock_addr_t* sock_addr_ctx,
+    _Out_ net_ebpf_ext_sock_addr_verdict_cache_key_t* key)
+{
+    // Zero the whole key so that unused address bytes compare equal.
+    memset(key, 0, sizeof(*key));
+    key->client = client;
+    key->interface_luid = sock_addr_ctx->base.interface_luid;
+    key->compartment_id = sock_addr_ctx->base.compartment_id;
+    key->family = sock_addr_ctx->base.family;
+    key->protocol = sock_addr_ctx->base.protocol;
+    if (sock_addr_ctx->base.family == AF_INET) {
+        key->source_ip[0] = sock_addr_ctx->base.msg_src_ip4;
+        key->destination_ip[0] = sock_addr_ctx->base.user_ip4;
+    } else {
+        memcpy(key->source_ip, sock_addr_ctx->base.msg_src_ip6, sizeof(key->source_ip));
+        memcpy(key->destination_ip, sock_addr_ctx->base.user_ip6, sizeof(key->destination_ip));
+    }
+    key->destination_port = (uint16_t)sock_addr_ctx->base.user_port;
+    key->process_id = sock_addr_ctx->process_id;
+}
+
+static _Must_inspect_result_ bool
+_net_ebpf_ext_sock_addr_verdict_cache_key_matches(
+    _In_ const net_ebpf_ext_sock_addr_verdict_cache_entry_t* entry,
+    _In_ const net_ebpf_ext_sock_addr_verdict_cache_key_t* key)
+{
+    if (memcmp(&entry->key, key, FIELD_OFFSET(net_ebpf_ext_sock_addr_verdict_cache_key_t, process_id)) != 0) {
+        return false;
+    }
+    return !entry->per_process || (entry->key.process_id == key->process_id);
+}
+
+/**
+ * @brief Get the entry of the current CPU's verdict cache that the key maps to. The process ID is not hashed, since
+ * whether it is part of the key is only known once the program has returned its verdict.
+ */
+static _Ret_maybenull_ net_ebpf_ext_sock_addr_verdict_cache_entry_t*
+_net_ebpf_ext_sock_addr_verdict_cache_get_entry(
+    _In_ const net_ebpf_ext_sock_addr_verdict_cache_key_t* key, _Outptr_result_maybenull_ KSPIN_LOCK** lock)
+{
+    net_ebpf_ext_sock_addr_verdict_cache_t* caches = _net_ebpf_ext_sock_addr_verdict_caches;
+    net_ebpf_ext_sock_addr_verdict_cache_t* cache;
+    const uint8_t* data = (const uint8_t*)key;
+    uint32_t hash = 2166136261;
+
+    *lock = NULL;
+    if (caches == NULL) {
+        return NULL;
+    }
+    cache = &caches[KeGetCurrentProcessorNumberEx(NULL) % _net_ebpf_ext_sock_addr_verdict_cache_count];
+
+    // FNV-1a.
+    for (size_t i = 0; i < FIELD_OFFSET(net_ebpf_ext_sock_addr_verdict_cache_key_t, process_id); i++) {
+        hash = (hash ^ data[i]) * 16777619;
+    }
+
+    *lock = &cache->lock;
+    return &cache->entries[hash & (NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_SIZE - 1)];
+}
+
+/**
+ * @brief Look up a verdict in the current CPU's verdict cache.
+ *
+ * @param[in] key Key built from the context before the program would be invoked.
+ * @param[in] program_generation Current state generation of the program.
+ * @param[out] verdict The cached verdict, if found.
+ * @retval true A verdict cached by the same program with the same state was found.
+ * @retval false No usable verdict was found.
+ */
+static _Must_inspect_result_ bool
+_net_ebpf_ext_sock_addr_verdict_cache_lookup(
+    _In_ const net_ebpf_ext_sock_addr_verdict_cache_key_t* key, uint64_t program_generation, _Out_ uint32_t* verdict)
+{
+    KSPIN_LOCK* lock;
+    KIRQL old_irql;
+    bool found = false;
+    int64_t attach_generation = ReadNoFence64(&_net_ebpf_ext_sock_addr_verdict_cache_attach_generation);
+    net_ebpf_ext_sock_addr_verdict_cache_entry_t* entry = _net_ebpf_ext_sock_addr_verdict_cache_get_entry(key, &lock);
+
+    *verdict = BPF_SOCK_ADDR_VERDICT_REJECT;
+    if (entry == NULL) {
+        return false;
+    }
+
+    KeAcquireSpinLock(lock, &old_irql);
+    if (entry->valid && entry->program_generation == program_generation &&
+        entry->attach_generation == attach_generation &&
+        _net_ebpf_ext_sock_addr_verdict_cache_key_matches(entry, key)) {
+        *verdict = entry->verdict;
+        found = true;
+    }
+    KeReleaseSpinLock(lock, old_irql);
+
+    if (found) {
+        InterlockedIncrement(&_net_ebpf_ext_statistics.verdict_cache_hit_count);
+    }
+    return found;
+}
+
+/**
+ * @brief Store a verdict in the current CPU's verdict cache, replacing whatever entry the key maps to.
+ *
+ * @param[in] key Key built from the context before the program was invoked.
+ * @param[in] program_generation State generation of the program read before it was invoked.
+ * @param[in] verdict Verdict returned by the program, without the cache flags.
+ * @param[in] cache_flags Cache flags returned by the program.
+ */
+static void
+_net_ebpf_ext_sock_addr_verdict_cache_update(
+    _In_ const net_ebpf_ext_sock_addr_verdict_cache_key_t* key,
+    uint64_t program_generation,
+    uint32_t verdict,
+    uint32_t cache_flags)
+{
+    KSPIN_LOCK* lock;
+    KIRQL old_irql;
+    int64_t attach_generation = ReadNoFence64(&_net_ebpf_ext_sock_addr_verdict_cache_attach_generation);
+    net_ebpf_ext_sock_addr_verdict_cache_entry_t* entry = _net_ebpf_ext_sock_addr_verdict_cache_get_entry(key, &lock);
+
+    if (entry == NULL) {
+        return;
+    }
+
+    KeAcquireSpinLock(lock, &old_irql);
+    entry->key = *key;
+    entry->program_generation = program_generation;
+    entry->attach_generation = attach_generation;
+    entry->verdict = verdict;
+    entry->per_process = (cache_flags & BPF_SOCK_ADDR_VERDICT_CACHE_PER_PROCESS) != 0;
+    entry->valid = true;
+    KeReleaseSpinLock(lock, old_irql);
+}
+
 NTSTATUS
 net_ebpf_ext_sock_addr_register_providers()
 {
@@ -1149,6 +1423,16 @@ net_ebpf_ext_sock_addr_register_providers()
     }
     blocked_connection_contexts_initialized = true;
 
+    status = _net_ebpf_ext_sock_addr_verdict_cache_initialize();
+    if (!NT_SUCCESS(status)) {
+        NET_EBPF_EXT_LOG_MESSAGE_NTSTATUS(
+            NET_EBPF_EXT_TRACELOG_LEVEL_ERROR,
+            NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_ADDR,
+            "_net_ebpf_ext_sock_addr_verdict_cache_initialize failed.",
+            status);
+        goto Exit;
+    }
+
     status = net_ebpf_extension_program_info_provider_register(
         &program_info_provider_parameters, &_ebpf_sock_addr_program_info_provider_context);
     if (!NT_SUCCESS(status)) {
@@ -1219,6 +1503,7 @@ net_ebpf_ext_sock_addr_unregister_providers()
     }
 
     _net_ebpf_ext_uninitialize_blocked_connection_contexts();
+    _net_ebpf_ext_sock_addr_verdict_cache_uninitialize();
     _net_ebpf_sock_addr_clean_up_security_descriptor();
 }
 
@@ -1248,7 +1533,8 @@ const wfp_ale_layer_fields_t wfp_connection_fields[] = {
      FWPS_FIELD_ALE_AUTH_CONNECT_V4_COMPARTMENT_ID,
      FWPS_FIELD_ALE_AUTH_CONNECT_V4_IP_LOCAL_INTERFACE,
      FWPS_FIELD_ALE_AUTH_CONNECT_V4_ALE_USER_ID,
-     FWPS_FIELD_ALE_AUTH_CONNECT_V4_FLAGS},
+     FWPS_FIELD_ALE_AUTH_CONNECT_V4_FLAGS,
+     FWPS_FIELD_ALE_AUTH_CONNECT_V4_ALE_APP_ID},
 
     // EBPF_HOOK_ALE_AUTH_CONNECT_V6
     {FWPS_FIELD_ALE_AUTH_CONNECT_V6_IP_LOCAL_ADDRESS,
@@ -1260,7 +1546,8 @@ const wfp_ale_layer_fields_t wfp_connection_fields[] = {
      FWPS_FIELD_ALE_AUTH_CONNECT_V6_COMPARTMENT_ID,
      FWPS_FIELD_ALE_AUTH_CONNECT_V6_IP_LOCAL_INTERFACE,
      FWPS_FIELD_ALE_AUTH_CONNECT_V6_ALE_USER_ID,
-     FWPS_FIELD_ALE_AUTH_CONNECT_V6_FLAGS},
+     FWPS_FIELD_ALE_AUTH_CONNECT_V6_FLAGS,
+     FWPS_FIELD_ALE_AUTH_CONNECT_V6_ALE_APP_ID},
 
     // EBPF_HOOK_ALE_CONNECT_REDIRECT_V4
     {FWPS_FIELD_ALE_CONNECT_REDIRECT_V4_IP_LOCAL_ADDRESS,
@@ -1272,7 +1559,8 @@ const wfp_ale_layer_fields_t wfp_connection_fields[] = {
      FWPS_FIELD_ALE_CONNECT_REDIRECT_V4_COMPARTMENT_ID,
      0, // No interface luid in this layer.
      FWPS_FIELD_ALE_CONNECT_REDIRECT_V4_ALE_USER_ID,
-     FWPS_FIELD_ALE_CONNECT_REDIRECT_V4_FLAGS},
+     FWPS_FIELD_ALE_CONNECT_REDIRECT_V4_FLAGS,
+     FWPS_FIELD_ALE_CONNECT_REDIRECT_V4_ALE_APP_ID},
 
     // EBPF_HOOK_ALE_CONNECT_REDIRECT_V6
     {FWPS_FIELD_ALE_CONNECT_REDIRECT_V6_IP_LOCAL_ADDRESS,
@@ -1284,7 +1572,8 @@ const wfp_ale_layer_fields_t wfp_connection_fields[] = {
      FWPS_FIELD_ALE_CONNECT_REDIRECT_V6_COMPARTMENT_ID,
      0, // No interface luid in this layer.
      FWPS_FIELD_ALE_CONNECT_REDIRECT_V6_ALE_USER_ID,
-     FWPS_FIELD_ALE_CONNECT_REDIRECT_V6_FLAGS},
+     FWPS_FIELD_ALE_CONNECT_REDIRECT_V6_FLAGS,
+     FWPS_FIELD_ALE_CONNECT_REDIRECT_V6_ALE_APP_ID},
 
     // EBPF_HOOK_ALE_AUTH_RECV_ACCEPT_V4
     {FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V4_IP_LOCAL_ADDRESS,
@@ -1296,7 +1585,8 @@ const wfp_ale_layer_fields_t wfp_connection_fields[] = {
      FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V4_COMPARTMENT_ID,
      FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V4_IP_LOCAL_INTERFACE,
      FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V4_ALE_USER_ID,
-     FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V4_FLAGS},
+     FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V4_FLAGS,
+     FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V4_ALE_APP_ID},
 
     // EBPF_HOOK_ALE_AUTH_RECV_ACCEPT_V6
     {FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V6_IP_LOCAL_ADDRESS,
@@ -1308,7 +1598,8 @@ const wfp_ale_layer_fields_t wfp_connection_fields[] = {
      FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V6_COMPARTMENT_ID,
      FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V6_IP_LOCAL_INTERFACE,
      FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V6_ALE_USER_ID,
-     FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V6_FLAGS}};
+     FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V6_FLAGS,
+     FWPS_FIELD_ALE_AUTH_RECV_ACCEPT_V6_ALE_APP_ID}};
 
 static void
 _net_ebpf_extension_sock_addr_copy_wfp_connection_fields(
@@ -1368,6 +1659,10 @@ _net_ebpf_extension_sock_addr_copy_wfp_connection_fields(
     sock_addr_ctx->access_information =
         (TOKEN_ACCESS_INFORMATION*)(incoming_values[fields->user_id_field].value.byteBlob->data);
 
+    // The application ID is only hashed if a program asks for it.
+    sock_addr_ctx->app_id = net_ebpf_extension_get_app_id_blob(&incoming_values[fields->app_id_field]);
+    sock_addr_ctx->interned_app_id = 0;
+
     if (incoming_metadata_values->currentMetadataValues & FWPS_METADATA_FIELD_PROCESS_ID) {
         sock_addr_ctx->process_id = incoming_metadata_values->processId;
     } else {
@@ -1405,6 +1700,10 @@ net_ebpf_extension_sock_addr_authorize_recv_accept_classify(
     net_ebpf_sock_addr_t net_ebpf_sock_addr_ctx = {0};
     bpf_sock_addr_t* sock_addr_ctx = &net_ebpf_sock_addr_ctx.base;
     uint32_t compartment_id = UNSPECIFIED_COMPARTMENT_ID;
+    net_ebpf_ext_sock_addr_verdict_cache_key_t cache_key = {0};
+    uint64_t program_generation = 0;
+    bool cache_supported = false;
+    uint32_t cache_flags = 0;
 
     UNREFERENCED_PARAMETER(incoming_metadata_values);
     UNREFERENCED_PARAMETER(layer_data);
@@ -1460,10 +1759,25 @@ net_ebpf_extension_sock_addr_authorize_recv_accept_classify(
         goto Exit;
     }
 
-    if (net_ebpf_extension_hook_invoke_program(attached_client, sock_addr_ctx, &result) != EBPF_SUCCESS) {
-        // Block the request if we failed to invoke the eBPF program.
-        classify_output->actionType = FWP_ACTION_BLOCK;
-        goto Exit;
+    // A verdict cached by the same program with the same state for the same tuple is reused without invoking it.
+    cache_supported = net_ebpf_extension_hook_client_get_state_generation(attached_client, &program_generation);
+    if (cache_supported) {
+        _net_ebpf_ext_sock_addr_verdict_cache_initialize_key(attached_client, &net_ebpf_sock_addr_ctx, &cache_key);
+    }
+    if (!cache_supported || !_net_ebpf_ext_sock_addr_verdict_cache_lookup(&cache_key, program_generation, &result)) {
+        if (net_ebpf_extension_hook_invoke_program(attached_client, sock_addr_ctx, &result) != EBPF_SUCCESS) {
+            // Block the request if we failed to invoke the eBPF program.
+            classify_output->actionType = FWP_ACTION_BLOCK;
+            goto Exit;
+        }
+        // Without cache support the flags are not recognized, and the verdict is handled like any other unknown value.
+        if (cache_supported) {
+            cache_flags = result & NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_FLAGS;
+            result &= ~NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_FLAGS;
+        }
+        if (cache_flags != 0) {
+            _net_ebpf_ext_sock_addr_verdict_cache_update(&cache_key, program_generation, result, cache_flags);
+        }
     }
 
     classify_output->actionType = (result == BPF_SOCK_ADDR_VERDICT_PROCEED) ? FWP_ACTION_PERMIT : FWP_ACTION_BLOCK;
@@ -1587,7 +1901,7 @@ _net_ebpf_ext_process_redirect_verdict(
     _In_ const bpf_sock_addr_t* original_context,
     _In_ const bpf_sock_addr_t* redirected_context,
     _In_ const FWPS_FILTER* filter,
-    uint64_t classify_handle,
+    _In_opt_ const void* classify_context,
     HANDLE redirect_handle,
     _Out_ bool* redirected,
     _Inout_ FWPS_CLASSIFY_OUT* classify_output)
@@ -1595,15 +1909,57 @@ _net_ebpf_ext_process_redirect_verdict(
     NTSTATUS status = STATUS_SUCCESS;
     FWPS_CONNECT_REQUEST* connect_request = NULL;
     BOOLEAN commit_layer_data = FALSE;
+    uint64_t classify_handle = 0;
+    bool classify_handle_acquired = FALSE;
+    void* redirect_context = NULL;
     net_ebpf_sock_addr_t* sock_addr_ctx = CONTAINING_RECORD(redirected_context, net_ebpf_sock_addr_t, base);
 
     *redirected = FALSE;
 
-    // Check if destination IP and/or port have been modified.
+    // Check if destination IP and/or port have been modified. The classify handle, the writable layer data and the
+    // pool copy of the redirect context are only needed if they have, so connections that are not redirected do no
+    // allocation or WFP handle work.
     BOOLEAN address_changed = !_net_ebpf_ext_compare_destination_address(redirected_context, original_context);
     if (redirected_context->user_port != original_context->user_port || address_changed) {
         *redirected = TRUE;
 
+        // WFP takes ownership of the redirect context and frees it, so it must be in its own pool allocation.
+        if (sock_addr_ctx->redirect_context == sock_addr_ctx->inline_redirect_context) {
+            redirect_context = ExAllocatePoolUninitialized(
+                NonPagedPoolNx, sock_addr_ctx->redirect_context_size, NET_EBPF_EXTENSION_POOL_TAG);
+            if (redirect_context == NULL) {
+                status = STATUS_INSUFFICIENT_RESOURCES;
+                NET_EBPF_EXT_LOG_MESSAGE_NTSTATUS(
+                    NET_EBPF_EXT_TRACELOG_LEVEL_ERROR,
+                    NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_ADDR,
+                    "Failed to allocate memory for the redirect context.",
+                    status);
+                goto Exit;
+            }
+            memcpy(redirect_context, sock_addr_ctx->inline_redirect_context, sock_addr_ctx->redirect_context_size);
+        } else {
+            redirect_context = sock_addr_ctx->redirect_context;
+        }
+        sock_addr_ctx->redirect_context = NULL;
+
+#pragma warning(push)
+// SAL annotation for FwpsAcquireClassifyHandle for classify_context is _In_ whereas,
+// the SAL for the same parameter in classifyFn callback _In_opt_ which causes a SAL error.
+#pragma warning(suppress : 6387)
+        status = FwpsAcquireClassifyHandle((void*)classify_context, 0, &classify_handle);
+#pragma warning(pop)
+        if (!NT_SUCCESS(status)) {
+            NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE_UINT64_UINT64(
+                NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_ADDR,
+                "FwpsAcquireClassifyHandle",
+                status,
+                filter->filterId,
+                (uint64_t)redirected_context->compartment_id);
+
+            goto Exit;
+        }
+        classify_handle_acquired = TRUE;
+
         status = FwpsAcquireWritableLayerDataPointer(
             classify_handle, filter->filterId, 0, (PVOID*)&connect_request, classify_output);
         if (!NT_SUCCESS(status)) {
@@ -1641,10 +1997,10 @@ _net_ebpf_ext_process_redirect_verdict(
         connect_request->localRedirectTargetPID = TARGET_PROCESS_ID;
         connect_request->localRedirectHandle = redirect_handle;
 
-        connect_request->localRedirectContext = sock_addr_ctx->redirect_context;
+        connect_request->localRedirectContext = redirect_context;
         connect_request->localRedirectContextSize = sock_addr_ctx->redirect_context_size;
         // Ownership transferred to WFP.
-        sock_addr_ctx->redirect_context = NULL;
+        redirect_context = NULL;
         sock_addr_ctx->redirect_context_size = 0;
     }
 
@@ -1652,6 +2008,12 @@ Exit:
     if (commit_layer_data) {
         FwpsApplyModifiedLayerData(classify_handle, connect_request, 0);
     }
+    if (classify_handle_acquired) {
+        FwpsReleaseClassifyHandle(classify_handle);
+    }
+    if (redirect_context != NULL) {
+        ExFreePool(redirect_context);
+    }
 
     NET_EBPF_EXT_RETURN_NTSTATUS(status);
 }
@@ -1746,9 +2108,11 @@ net_ebpf_extension_sock_addr_redirect_connection_classify(
     bool v4_mapped = FALSE;
     FWPS_CONNECTION_REDIRECT_STATE redirect_state;
     HANDLE redirect_handle;
-    uint64_t classify_handle = 0;
-    bool classify_handle_acquired = FALSE;
     bool redirected = FALSE;
+    net_ebpf_ext_sock_addr_verdict_cache_key_t cache_key = {0};
+    uint64_t program_generation = 0;
+    bool cache_supported = false;
+    uint32_t cache_flags = 0;
 
     UNREFERENCED_PARAMETER(layer_data);
     UNREFERENCED_PARAMETER(flow_context);
@@ -1841,24 +2205,23 @@ net_ebpf_extension_sock_addr_redirect_connection_classify(
         goto Exit;
     }
 
-#pragma warning(push)
-// SAL annotation for FwpsAcquireClassifyHandle for classify_context is _In_ whereas,
-// the SAL for the same parameter in classifyFn callback _In_opt_ which causes a SAL error.
-#pragma warning(suppress : 6387)
-    // Acquire classify handle.
-    status = FwpsAcquireClassifyHandle((void*)classify_context, 0, &classify_handle);
-#pragma warning(pop)
-    if (!NT_SUCCESS(status)) {
-        NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE_UINT64_UINT64(
-            NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_ADDR,
-            "FwpsAcquireClassifyHandle",
-            status,
-            filter->filterId,
-            (uint64_t)sock_addr_ctx->compartment_id);
-
-        goto Exit;
+    // A cached verdict never redirects, so a hit skips straight to enforcing it.
+    cache_supported = net_ebpf_extension_hook_client_get_state_generation(attached_client, &program_generation);
+    if (cache_supported) {
+        _net_ebpf_ext_sock_addr_verdict_cache_initialize_key(attached_client, &net_ebpf_sock_addr_ctx, &cache_key);
+        if (_net_ebpf_ext_sock_addr_verdict_cache_lookup(&cache_key, program_generation, &verdict)) {
+            if (verdict == BPF_SOCK_ADDR_VERDICT_PROCEED) {
+                InterlockedIncrement(&_net_ebpf_ext_statistics.permit_connection_count);
+            }
+            _net_ebpf_ext_log_sock_addr_classify(
+                "connect_redirect_classify",
+                incoming_metadata_values->transportEndpointHandle,
+                &sock_addr_ctx_original,
+                NULL,
+                verdict);
+            goto Exit;
+        }
     }
-    classify_handle_acquired = TRUE;
 
     if (v4_mapped) {
         // Change sock_addr_ctx to using IPv4 address for the eBPF program.
@@ -1871,12 +2234,20 @@ net_ebpf_extension_sock_addr_redirect_connection_classify(
 
     result = net_ebpf_extension_hook_invoke_program(attached_client, sock_addr_ctx, &verdict);
     NET_EBPF_EXT_BAIL_ON_ERROR_RESULT(result);
+    // Without cache support the flags are not recognized, and the verdict is handled like any other unknown value.
+    if (cache_supported) {
+        cache_flags = verdict & NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_FLAGS;
+        verdict &= ~NET_EBPF_EXT_SOCK_ADDR_VERDICT_CACHE_FLAGS;
+    }
 
     if (verdict == BPF_SOCK_ADDR_VERDICT_REJECT) {
         NET_EBPF_EXT_LOG_MESSAGE(
             NET_EBPF_EXT_TRACELOG_LEVEL_WARNING,
             NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_ADDR,
             "cgroup_sock_addr eBPF program returned REJECT verdict.");
+        if (cache_flags != 0) {
+            _net_ebpf_ext_sock_addr_verdict_cache_update(&cache_key, program_generation, verdict, cache_flags);
+        }
         goto Exit;
     }
 
@@ -1891,7 +2262,7 @@ net_ebpf_extension_sock_addr_redirect_connection_classify(
             &sock_addr_ctx_original,
             sock_addr_ctx,
             filter,
-            classify_handle,
+            classify_context,
             redirect_handle,
             &redirected,
             classify_output);
@@ -1899,6 +2270,11 @@ net_ebpf_extension_sock_addr_redirect_connection_classify(
 
         (redirected) ? InterlockedIncrement(&_net_ebpf_ext_statistics.redirect_connection_count)
                      : InterlockedIncrement(&_net_ebpf_ext_statistics.permit_connection_count);
+
+        // Redirections are applied per connection and are never cached.
+        if (cache_flags != 0 && !redirected && net_ebpf_sock_addr_ctx.redirect_context == NULL) {
+            _net_ebpf_ext_sock_addr_verdict_cache_update(&cache_key, program_generation, verdict, cache_flags);
+        }
     }
 
     _net_ebpf_ext_log_sock_addr_classify(
@@ -1932,17 +2308,11 @@ Exit:
 
     classify_output->actionType = FWP_ACTION_PERMIT;
 
-    if (classify_handle_acquired) {
-        FwpsReleaseClassifyHandle(classify_handle);
-    }
-
     if (attached_client) {
         net_ebpf_extension_hook_client_leave_rundown(attached_client);
     }
 
-    if (net_ebpf_sock_addr_ctx.redirect_context != NULL) {
-        ExFreePool(net_ebpf_sock_addr_ctx.redirect_context);
-    }
+    _net_ebpf_ext_sock_addr_free_redirect_context(&net_ebpf_sock_addr_ctx);
 
     NET_EBPF_EXT_LOG_EXIT();
 }
@@ -1958,7 +2328,7 @@ _ebpf_sock_addr_context_create(
     NET_EBPF_EXT_LOG_ENTRY();
 
     ebpf_result_t result;
-    bpf_sock_addr_t* sock_addr_ctx = NULL;
+    net_ebpf_sock_addr_t* sock_addr_ctx = NULL;
 
     *context = NULL;
 
@@ -1978,15 +2348,17 @@ _ebpf_sock_addr_context_create(
         goto Exit;
     }
 
-    sock_addr_ctx = (bpf_sock_addr_t*)ExAllocatePoolUninitialized(
-        NonPagedPoolNx, sizeof(bpf_sock_addr_t), NET_EBPF_EXTENSION_POOL_TAG);
+    // Allocate the full extension context so that helpers using CONTAINING_RECORD stay within bounds.
+    sock_addr_ctx = (net_ebpf_sock_addr_t*)ExAllocatePoolUninitialized(
+        NonPagedPoolNx, sizeof(net_ebpf_sock_addr_t), NET_EBPF_EXTENSION_POOL_TAG);
     NET_EBPF_EXT_BAIL_ON_ALLOC_FAILURE_RESULT(
         NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_ADDR, sock_addr_ctx, "sock_addr_ctx", result);
+    memset(sock_addr_ctx, 0, sizeof(net_ebpf_sock_addr_t));
 
-    memcpy(sock_addr_ctx, context_in, sizeof(bpf_sock_addr_t));
+    memcpy(&sock_addr_ctx->base, context_in, sizeof(bpf_sock_addr_t));
 
     result = EBPF_SUCCESS;
-    *context = sock_addr_ctx;
+    *context = &sock_addr_ctx->base;
 
     sock_addr_ctx = NULL;
 
@@ -2022,7 +2394,7 @@ _ebpf_sock_addr_context_destroy(
     }
 
     if (context) {
-        ExFreePool(context);
+        ExFreePool(CONTAINING_RECORD(context, net_ebpf_sock_addr_t, base));
     }
     NET_EBPF_EXT_LOG_EXIT();
 }
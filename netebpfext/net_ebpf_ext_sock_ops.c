@@ -25,16 +25,49 @@ typedef struct _net_ebpf_extension_sock_ops_wfp_flow_context
     LIST_ENTRY link;                                         ///< Link to next flow context.
     net_ebpf_extension_flow_context_parameters_t parameters; ///< WFP flow parameters.
     struct _net_ebpf_extension_sock_ops_wfp_filter_context*
-        filter_context;     ///< WFP filter context associated with this flow.
-    bpf_sock_ops_t context; ///< sock_ops context.
+        filter_context;                   ///< WFP filter context associated with this flow.
+    uint64_t app_id;                      ///< Application ID of the flow, or 0 if not available.
+    ebpf_context_header_t context_header; ///< Per-flow local storage owned by the execution context.
+    bpf_sock_ops_t context;               ///< sock_ops context.
 } net_ebpf_extension_sock_ops_wfp_flow_context_t;
 
-typedef struct _net_ebpf_extension_sock_ops_wfp_flow_context_list
+// The execution context expects the context header immediately before the program context.
+C_ASSERT(
+    EBPF_OFFSET_OF(net_ebpf_extension_sock_ops_wfp_flow_context_t, context) ==
+    EBPF_OFFSET_OF(net_ebpf_extension_sock_ops_wfp_flow_context_t, context_header) + sizeof(ebpf_context_header_t));
+
+/**
+ * @brief Number of independently locked flow context lists per filter context. Flows are spread across the shards by
+ * flow ID so that establish and delete on different connections rarely contend for the same lock.
+ */
+#define NET_EBPF_SOCK_OPS_FLOW_CONTEXT_SHARD_COUNT 16
+
+/**
+ * @brief Maximum number of free flow contexts cached per CPU.
+ */
+#define NET_EBPF_SOCK_OPS_FLOW_CONTEXT_POOL_DEPTH 256
+
+typedef __declspec(align(EBPF_CACHE_LINE_SIZE)) struct _net_ebpf_extension_sock_ops_wfp_flow_context_list
 {
-    uint32_t count;       ///< Number of flow contexts in the list.
-    LIST_ENTRY list_head; ///< Head to the list of WFP flow contexts.
+    KSPIN_LOCK lock;                         ///< Lock for synchronization.
+    _Guarded_by_(lock) uint32_t count;       ///< Number of flow contexts in the list.
+    _Guarded_by_(lock) LIST_ENTRY list_head; ///< Head to the list of WFP flow contexts.
 } net_ebpf_extension_sock_ops_wfp_flow_context_list_t;
 
+/**
+ * @brief Per-CPU cache of free flow contexts. Flow contexts are returned to the cache of the CPU that deletes the flow
+ * and are drawn from the cache of the CPU that establishes it.
+ */
+typedef __declspec(align(EBPF_CACHE_LINE_SIZE)) struct _net_ebpf_extension_sock_ops_flow_context_pool
+{
+    KSPIN_LOCK lock;                         ///< Lock for synchronization.
+    _Guarded_by_(lock) uint32_t count;       ///< Number of free flow contexts in the cache.
+    _Guarded_by_(lock) LIST_ENTRY free_list; ///< Free flow contexts, linked through their link field.
+} net_ebpf_extension_sock_ops_flow_context_pool_t;
+
+static net_ebpf_extension_sock_ops_flow_context_pool_t* _net_ebpf_ext_sock_ops_flow_context_pool = NULL;
+static uint32_t _net_ebpf_ext_sock_ops_flow_context_pool_count = 0;
+
 const net_ebpf_extension_wfp_filter_parameters_t _net_ebpf_extension_sock_ops_wfp_filter_parameters[] = {
     {&FWPM_LAYER_ALE_FLOW_ESTABLISHED_V4,
      NULL, // Default sublayer.
@@ -53,11 +86,130 @@ typedef struct _net_ebpf_extension_sock_ops_wfp_filter_context
 {
     net_ebpf_extension_wfp_filter_context_t base;
     uint32_t compartment_id; ///< Compartment Id condition value for the filters (if any).
-    KSPIN_LOCK lock;         ///< Lock for synchronization.
-    _Guarded_by_(lock) net_ebpf_extension_sock_ops_wfp_flow_context_list_t
-        flow_context_list; ///< List of flow contexts associated with WFP flows.
+    net_ebpf_extension_sock_ops_wfp_flow_context_list_t
+        flow_context_shards[NET_EBPF_SOCK_OPS_FLOW_CONTEXT_SHARD_COUNT]; ///< Flow contexts associated with WFP flows.
 } net_ebpf_extension_sock_ops_wfp_filter_context_t;
 
+//
+// Flow context pool and shard helpers.
+//
+
+static NTSTATUS
+_net_ebpf_extension_sock_ops_flow_context_pool_initialize()
+{
+    uint32_t cpu_count = KeQueryMaximumProcessorCountEx(ALL_PROCESSOR_GROUPS);
+    size_t pool_size = sizeof(net_ebpf_extension_sock_ops_flow_context_pool_t) * cpu_count;
+    net_ebpf_extension_sock_ops_flow_context_pool_t* pool =
+        (net_ebpf_extension_sock_ops_flow_context_pool_t*)ExAllocatePoolUninitialized(
+            NonPagedPoolNx, pool_size, NET_EBPF_EXTENSION_POOL_TAG);
+    if (pool == NULL) {
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+    memset(pool, 0, pool_size);
+
+    for (uint32_t i = 0; i < cpu_count; i++) {
+        KeInitializeSpinLock(&pool[i].lock);
+        InitializeListHead(&pool[i].free_list);
+    }
+
+    _net_ebpf_ext_sock_ops_flow_context_pool_count = cpu_count;
+    _net_ebpf_ext_sock_ops_flow_context_pool = pool;
+    return STATUS_SUCCESS;
+}
+
+static void
+_net_ebpf_extension_sock_ops_flow_context_pool_uninitialize()
+{
+    net_ebpf_extension_sock_ops_flow_context_pool_t* pool = _net_ebpf_ext_sock_ops_flow_context_pool;
+    if (pool == NULL) {
+        return;
+    }
+    _net_ebpf_ext_sock_ops_flow_context_pool = NULL;
+
+    for (uint32_t i = 0; i < _net_ebpf_ext_sock_ops_flow_context_pool_count; i++) {
+        while (!IsListEmpty(&pool[i].free_list)) {
+            LIST_ENTRY* entry = RemoveHeadList(&pool[i].free_list);
+            ExFreePool(CONTAINING_RECORD(entry, net_ebpf_extension_sock_ops_wfp_flow_context_t, link));
+        }
+    }
+    _net_ebpf_ext_sock_ops_flow_context_pool_count = 0;
+    ExFreePool(pool);
+}
+
+static _Ret_maybenull_ net_ebpf_extension_sock_ops_flow_context_pool_t*
+_net_ebpf_extension_sock_ops_get_current_cpu_pool()
+{
+    net_ebpf_extension_sock_ops_flow_context_pool_t* pool = _net_ebpf_ext_sock_ops_flow_context_pool;
+    if (pool == NULL) {
+        return NULL;
+    }
+    return &pool[KeGetCurrentProcessorNumberEx(NULL) % _net_ebpf_ext_sock_ops_flow_context_pool_count];
+}
+
+static _Ret_maybenull_ net_ebpf_extension_sock_ops_wfp_flow_context_t*
+_net_ebpf_extension_sock_ops_allocate_flow_context()
+{
+    net_ebpf_extension_sock_ops_wfp_flow_context_t* flow_context = NULL;
+    net_ebpf_extension_sock_ops_flow_context_pool_t* pool = _net_ebpf_extension_sock_ops_get_current_cpu_pool();
+    KIRQL irql;
+
+    if (pool != NULL) {
+        KeAcquireSpinLock(&pool->lock, &irql);
+        if (!IsListEmpty(&pool->free_list)) {
+            LIST_ENTRY* entry = RemoveHeadList(&pool->free_list);
+            flow_context = CONTAINING_RECORD(entry, net_ebpf_extension_sock_ops_wfp_flow_context_t, link);
+            pool->count--;
+        }
+        KeReleaseSpinLock(&pool->lock, irql);
+    }
+
+    if (flow_context == NULL) {
+        flow_context = (net_ebpf_extension_sock_ops_wfp_flow_context_t*)ExAllocatePoolUninitialized(
+            NonPagedPoolNx, sizeof(net_ebpf_extension_sock_ops_wfp_flow_context_t), NET_EBPF_EXTENSION_POOL_TAG);
+        if (flow_context == NULL) {
+            return NULL;
+        }
+    }
+
+    memset(flow_context, 0, sizeof(net_ebpf_extension_sock_ops_wfp_flow_context_t));
+    return flow_context;
+}
+
+static void
+_net_ebpf_extension_sock_ops_free_flow_context(_Frees_ptr_ net_ebpf_extension_sock_ops_wfp_flow_context_t* flow_context)
+{
+    net_ebpf_extension_sock_ops_flow_context_pool_t* pool = _net_ebpf_extension_sock_ops_get_current_cpu_pool();
+    KIRQL irql;
+
+    // No program is invoked with this flow context past this point, so release its local storage.
+    if (flow_context->context_header.free_storage != NULL) {
+        flow_context->context_header.free_storage(&flow_context->context_header);
+    }
+
+    if (pool != NULL) {
+        KeAcquireSpinLock(&pool->lock, &irql);
+        if (pool->count < NET_EBPF_SOCK_OPS_FLOW_CONTEXT_POOL_DEPTH) {
+            InsertHeadList(&pool->free_list, &flow_context->link);
+            pool->count++;
+            flow_context = NULL;
+        }
+        KeReleaseSpinLock(&pool->lock, irql);
+    }
+
+    if (flow_context != NULL) {
+        ExFreePool(flow_context);
+    }
+}
+
+static net_ebpf_extension_sock_ops_wfp_flow_context_list_t*
+_net_ebpf_extension_sock_ops_get_flow_context_shard(
+    _In_ net_ebpf_extension_sock_ops_wfp_filter_context_t* filter_context, uint64_t flow_id)
+{
+    // Flow handles are not uniformly distributed in their low bits, so mix them before picking a shard.
+    uint64_t hash = flow_id * 0x9E3779B97F4A7C15ull;
+    return &filter_context->flow_context_shards[(hash >> 32) % NET_EBPF_SOCK_OPS_FLOW_CONTEXT_SHARD_COUNT];
+}
+
 //
 // SOCK_OPS Program Information NPI Provider.
 //
@@ -78,12 +230,32 @@ _ebpf_sock_ops_context_destroy(
     _Out_writes_bytes_to_(*context_size_out, *context_size_out) uint8_t* context_out,
     _Inout_ size_t* context_size_out);
 
+//
+// SOCK_OPS helper functions.
+//
+static uint64_t
+_ebpf_sock_ops_get_current_app_id(_In_ const bpf_sock_ops_t* ctx)
+{
+    net_ebpf_extension_sock_ops_wfp_flow_context_t* flow_context =
+        CONTAINING_RECORD(ctx, net_ebpf_extension_sock_ops_wfp_flow_context_t, context);
+    return flow_context->app_id;
+}
+
+static const void* _ebpf_sock_ops_global_helper_functions[] = {(void*)_ebpf_sock_ops_get_current_app_id};
+
+static ebpf_helper_function_addresses_t _ebpf_sock_ops_global_helper_function_address_table = {
+    EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
+    EBPF_COUNT_OF(_ebpf_sock_ops_global_helper_functions),
+    (uint64_t*)_ebpf_sock_ops_global_helper_functions};
+
 static ebpf_program_data_t _ebpf_sock_ops_program_data = {
     .header = EBPF_PROGRAM_DATA_HEADER,
     .program_info = &_ebpf_sock_ops_program_info,
+    .global_helper_function_addresses = &_ebpf_sock_ops_global_helper_function_address_table,
     .context_create = &_ebpf_sock_ops_context_create,
     .context_destroy = &_ebpf_sock_ops_context_destroy,
     .required_irql = DISPATCH_LEVEL,
+    .capabilities = {.supports_context_header = true},
 };
 
 // Set the program type as the provider module id.
@@ -170,8 +342,10 @@ net_ebpf_extension_sock_ops_on_client_attach(
     }
     filter_context->compartment_id = compartment_id;
     filter_context->base.filter_ids_count = NET_EBPF_SOCK_OPS_FILTER_COUNT;
-    KeInitializeSpinLock(&filter_context->lock);
-    InitializeListHead(&filter_context->flow_context_list.list_head);
+    for (uint32_t i = 0; i < NET_EBPF_SOCK_OPS_FLOW_CONTEXT_SHARD_COUNT; i++) {
+        KeInitializeSpinLock(&filter_context->flow_context_shards[i].lock);
+        InitializeListHead(&filter_context->flow_context_shards[i].list_head);
+    }
 
     // Add WFP filters at appropriate layers and set the hook NPI client as the filter's raw context.
     filter_count = NET_EBPF_SOCK_OPS_FILTER_COUNT;
@@ -213,17 +387,21 @@ _net_ebpf_extension_sock_ops_on_client_detach(_In_ const net_ebpf_extension_hook
     InitializeListHead(&local_list_head);
     net_ebpf_extension_delete_wfp_filters(filter_context->base.filter_ids_count, filter_context->base.filter_ids);
 
-    KeAcquireSpinLock(&filter_context->lock, &irql);
-    if (filter_context->flow_context_list.count > 0) {
+    for (uint32_t i = 0; i < NET_EBPF_SOCK_OPS_FLOW_CONTEXT_SHARD_COUNT; i++) {
+        net_ebpf_extension_sock_ops_wfp_flow_context_list_t* shard = &filter_context->flow_context_shards[i];
 
-        LIST_ENTRY* entry = filter_context->flow_context_list.list_head.Flink;
-        RemoveEntryList(&filter_context->flow_context_list.list_head);
-        InitializeListHead(&filter_context->flow_context_list.list_head);
-        AppendTailList(&local_list_head, entry);
+        KeAcquireSpinLock(&shard->lock, &irql);
+        if (shard->count > 0) {
 
-        filter_context->flow_context_list.count = 0;
+            LIST_ENTRY* entry = shard->list_head.Flink;
+            RemoveEntryList(&shard->list_head);
+            InitializeListHead(&shard->list_head);
+            AppendTailList(&local_list_head, entry);
+
+            shard->count = 0;
+        }
+        KeReleaseSpinLock(&shard->lock, irql);
     }
-    KeReleaseSpinLock(&filter_context->lock, irql);
 
     // Remove the flow context associated with the WFP flows.
     while (!IsListEmpty(&local_list_head)) {
@@ -259,6 +437,16 @@ net_ebpf_ext_sock_ops_register_providers()
 
     NET_EBPF_EXT_LOG_ENTRY();
 
+    status = _net_ebpf_extension_sock_ops_flow_context_pool_initialize();
+    if (!NT_SUCCESS(status)) {
+        NET_EBPF_EXT_LOG_MESSAGE_NTSTATUS(
+            NET_EBPF_EXT_TRACELOG_LEVEL_ERROR,
+            NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_OPS,
+            "_net_ebpf_extension_sock_ops_flow_context_pool_initialize failed.",
+            status);
+        goto Exit;
+    }
+
     status = net_ebpf_extension_program_info_provider_register(
         &program_info_provider_parameters, &_ebpf_sock_ops_program_info_provider_context);
     if (!NT_SUCCESS(status)) {
@@ -305,6 +493,8 @@ net_ebpf_ext_sock_ops_unregister_providers()
         net_ebpf_extension_program_info_provider_unregister(_ebpf_sock_ops_program_info_provider_context);
         _ebpf_sock_ops_program_info_provider_context = NULL;
     }
+    // All clients have detached and their flow contexts have been returned, so the cached contexts can be freed.
+    _net_ebpf_extension_sock_ops_flow_context_pool_uninitialize();
 }
 
 wfp_ale_layer_fields_t wfp_flow_established_fields[] = {
@@ -316,7 +506,10 @@ wfp_ale_layer_fields_t wfp_flow_established_fields[] = {
      FWPS_FIELD_ALE_FLOW_ESTABLISHED_V4_IP_PROTOCOL,
      FWPS_FIELD_ALE_FLOW_ESTABLISHED_V4_DIRECTION,
      FWPS_FIELD_ALE_FLOW_ESTABLISHED_V4_COMPARTMENT_ID,
-     FWPS_FIELD_ALE_FLOW_ESTABLISHED_V4_IP_LOCAL_INTERFACE},
+     FWPS_FIELD_ALE_FLOW_ESTABLISHED_V4_IP_LOCAL_INTERFACE,
+     0, // User ID is not used by this hook.
+     0, // No flags field in this layer.
+     FWPS_FIELD_ALE_FLOW_ESTABLISHED_V4_ALE_APP_ID},
     // EBPF_HOOK_ALE_FLOW_ESTABLISHED_V6
     {FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_IP_LOCAL_ADDRESS,
      FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_IP_LOCAL_PORT,
@@ -325,7 +518,10 @@ wfp_ale_layer_fields_t wfp_flow_established_fields[] = {
      FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_IP_PROTOCOL,
      FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_DIRECTION,
      FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_COMPARTMENT_ID,
-     FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_IP_LOCAL_INTERFACE}};
+     FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_IP_LOCAL_INTERFACE,
+     0, // User ID is not used by this hook.
+     0, // No flags field in this layer.
+     FWPS_FIELD_ALE_FLOW_ESTABLISHED_V6_ALE_APP_ID}};
 
 static void
 _net_ebpf_extension_sock_ops_copy_wfp_connection_fields(
@@ -383,6 +579,9 @@ net_ebpf_extension_sock_ops_flow_established_classify(
     net_ebpf_extension_hook_client_t* attached_client = NULL;
     net_ebpf_extension_sock_ops_wfp_flow_context_t* local_flow_context = NULL;
     bpf_sock_ops_t* sock_ops_context = NULL;
+    const FWP_BYTE_BLOB* app_id = NULL;
+    uint16_t app_id_field;
+    net_ebpf_extension_sock_ops_wfp_flow_context_list_t* shard = NULL;
     uint32_t client_compartment_id = UNSPECIFIED_COMPARTMENT_ID;
     net_ebpf_extension_hook_id_t hook_id =
         net_ebpf_extension_get_hook_id_from_wfp_layer_id(incoming_fixed_values->layerId);
@@ -420,11 +619,9 @@ net_ebpf_extension_sock_ops_flow_established_classify(
         goto Exit;
     }
 
-    local_flow_context = (net_ebpf_extension_sock_ops_wfp_flow_context_t*)ExAllocatePoolUninitialized(
-        NonPagedPoolNx, sizeof(net_ebpf_extension_sock_ops_wfp_flow_context_t), NET_EBPF_EXTENSION_POOL_TAG);
+    local_flow_context = _net_ebpf_extension_sock_ops_allocate_flow_context();
     NET_EBPF_EXT_BAIL_ON_ALLOC_FAILURE_RESULT(
         NET_EBPF_EXT_TRACELOG_KEYWORD_SOCK_OPS, local_flow_context, "flow_context", result);
-    memset(local_flow_context, 0, sizeof(net_ebpf_extension_sock_ops_wfp_flow_context_t));
 
     // Associate the filter context with the local flow context.
     REFERENCE_FILTER_CONTEXT(&filter_context->base);
@@ -433,6 +630,11 @@ net_ebpf_extension_sock_ops_flow_established_classify(
     sock_ops_context = &local_flow_context->context;
     _net_ebpf_extension_sock_ops_copy_wfp_connection_fields(incoming_fixed_values, sock_ops_context);
 
+    // The application ID blob is not available when the flow is deleted, so compute the ID up front.
+    app_id_field = wfp_flow_established_fields[hook_id - EBPF_HOOK_ALE_FLOW_ESTABLISHED_V4].app_id_field;
+    app_id = net_ebpf_extension_get_app_id_blob(&incoming_fixed_values->incomingValue[app_id_field]);
+    local_flow_context->app_id = (app_id != NULL) ? net_ebpf_extension_get_app_id(app_id->data, app_id->size) : 0;
+
     client_compartment_id = filter_context->compartment_id;
     ASSERT(
         (client_compartment_id == UNSPECIFIED_COMPARTMENT_ID) ||
@@ -478,10 +680,11 @@ net_ebpf_extension_sock_ops_flow_established_classify(
         "New flow created.",
         local_flow_context->parameters.flow_id);
 
-    KeAcquireSpinLock(&filter_context->lock, &irql);
-    InsertTailList(&filter_context->flow_context_list.list_head, &local_flow_context->link);
-    filter_context->flow_context_list.count++;
-    KeReleaseSpinLock(&filter_context->lock, irql);
+    shard = _net_ebpf_extension_sock_ops_get_flow_context_shard(filter_context, local_flow_context->parameters.flow_id);
+    KeAcquireSpinLock(&shard->lock, &irql);
+    InsertTailList(&shard->list_head, &local_flow_context->link);
+    shard->count++;
+    KeReleaseSpinLock(&shard->lock, irql);
     local_flow_context = NULL;
 
     classify_output->actionType = (result == 0) ? FWP_ACTION_PERMIT : FWP_ACTION_BLOCK;
@@ -494,7 +697,7 @@ Exit:
         if (local_flow_context->filter_context != NULL) {
             DEREFERENCE_FILTER_CONTEXT(&local_flow_context->filter_context->base);
         }
-        ExFreePool(local_flow_context);
+        _net_ebpf_extension_sock_ops_free_flow_context(local_flow_context);
     }
     if (attached_client != NULL) {
         net_ebpf_extension_hook_client_leave_rundown(attached_client);
@@ -507,6 +710,7 @@ net_ebpf_extension_sock_ops_flow_delete(uint16_t layer_id, uint32_t callout_id,
     net_ebpf_extension_sock_ops_wfp_flow_context_t* local_flow_context =
         (net_ebpf_extension_sock_ops_wfp_flow_context_t*)(uintptr_t)flow_context;
     net_ebpf_extension_sock_ops_wfp_filter_context_t* filter_context = NULL;
+    net_ebpf_extension_sock_ops_wfp_flow_context_list_t* shard = NULL;
     net_ebpf_extension_hook_client_t* attached_client = NULL;
     bpf_sock_ops_t* sock_ops_context = NULL;
     uint32_t result;
@@ -540,10 +744,11 @@ net_ebpf_extension_sock_ops_flow_delete(uint16_t layer_id, uint32_t callout_id,
         goto Exit;
     }
 
-    KeAcquireSpinLock(&filter_context->lock, &irql);
+    shard = _net_ebpf_extension_sock_ops_get_flow_context_shard(filter_context, local_flow_context->parameters.flow_id);
+    KeAcquireSpinLock(&shard->lock, &irql);
     RemoveEntryList(&local_flow_context->link);
-    filter_context->flow_context_list.count--;
-    KeReleaseSpinLock(&filter_context->lock, irql);
+    shard->count--;
+    KeReleaseSpinLock(&shard->lock, irql);
 
     NET_EBPF_EXT_LOG_MESSAGE_UINT64(
         NET_EBPF_EXT_TRACELOG_LEVEL_VERBOSE,
@@ -564,7 +769,7 @@ Exit:
     }
 
     if (local_flow_context != NULL) {
-        ExFreePool(local_flow_context);
+        _net_ebpf_extension_sock_ops_free_flow_context(local_flow_context);
     }
 
     if (attached_client != NULL) {
@@ -581,7 +786,7 @@ _ebpf_sock_ops_context_create(
     _Outptr_ void** context)
 {
     ebpf_result_t result;
-    bpf_sock_ops_t* sock_ops_context = NULL;
+    net_ebpf_extension_sock_ops_wfp_flow_context_t* flow_context = NULL;
 
     *context = NULL;
 
@@ -601,23 +806,25 @@ _ebpf_sock_ops_context_create(
         goto Exit;
     }
 
-    sock_ops_context = (bpf_sock_ops_t*)ExAllocatePoolUninitialized(
-        NonPagedPoolNx, sizeof(bpf_sock_ops_t), NET_EBPF_EXTENSION_POOL_TAG);
+    // Allocate a full flow context so that helpers using CONTAINING_RECORD stay within bounds.
+    flow_context = (net_ebpf_extension_sock_ops_wfp_flow_context_t*)ExAllocatePoolUninitialized(
+        NonPagedPoolNx, sizeof(net_ebpf_extension_sock_ops_wfp_flow_context_t), NET_EBPF_EXTENSION_POOL_TAG);
 
-    if (sock_ops_context == NULL) {
+    if (flow_context == NULL) {
         result = EBPF_NO_MEMORY;
         goto Exit;
     }
+    memset(flow_context, 0, sizeof(net_ebpf_extension_sock_ops_wfp_flow_context_t));
 
-    memcpy(sock_ops_context, context_in, sizeof(bpf_sock_ops_t));
+    memcpy(&flow_context->context, context_in, sizeof(bpf_sock_ops_t));
 
-    *context = sock_ops_context;
-    sock_ops_context = NULL;
+    *context = &flow_context->context;
+    flow_context = NULL;
     result = EBPF_SUCCESS;
 
 Exit:
-    if (sock_ops_context != NULL) {
-        ExFreePool(sock_ops_context);
+    if (flow_context != NULL) {
+        ExFreePool(flow_context);
     }
 
     NET_EBPF_EXT_RETURN_RESULT(result);
@@ -648,7 +855,12 @@ _ebpf_sock_ops_context_destroy(
         *context_size_out = 0;
     }
 
-    ExFreePool(context);
+    net_ebpf_extension_sock_ops_wfp_flow_context_t* flow_context =
+        CONTAINING_RECORD(context, net_ebpf_extension_sock_ops_wfp_flow_context_t, context);
+    if (flow_context->context_header.free_storage != NULL) {
+        flow_context->context_header.free_storage(&flow_context->context_header);
+    }
+    ExFreePool(flow_context);
 Exit:
     NET_EBPF_EXT_LOG_EXIT();
 }
@@ -8,6 +8,7 @@
 
 #include "ebpf_shared_framework.h"
 #include "net_ebpf_ext_xdp.h"
+#include "net_ebpf_ext_xdp_parse.h"
 
 //
 // Utility functions.
@@ -64,6 +65,12 @@ typedef struct _net_ebpf_extension_xdp_wfp_filter_context
 static int
 _net_ebpf_xdp_adjust_head(_Inout_ xdp_md_t* ctx, int delta);
 
+static int
+_net_ebpf_xdp_adjust_meta(_Inout_ xdp_md_t* ctx, int delta);
+
+static int
+_net_ebpf_xdp_parse_headers(_In_ const xdp_md_t* ctx, _Out_writes_bytes_(size) xdp_headers_t* headers, uint32_t size);
+
 static ebpf_result_t
 _ebpf_xdp_context_create(
     _In_reads_bytes_opt_(data_size_in) const uint8_t* data_in,
@@ -80,7 +87,8 @@ _ebpf_xdp_context_delete(
     _Out_writes_bytes_to_(*context_size_out, *context_size_out) uint8_t* context_out,
     _Inout_ size_t* context_size_out);
 
-static const void* _ebpf_xdp_test_helper_functions[] = {(void*)&_net_ebpf_xdp_adjust_head};
+static const void* _ebpf_xdp_test_helper_functions[] = {
+    (void*)&_net_ebpf_xdp_adjust_head, (void*)&_net_ebpf_xdp_adjust_meta, (void*)&_net_ebpf_xdp_parse_headers};
 
 static ebpf_helper_function_addresses_t _ebpf_xdp_test_helper_function_address_table = {
     EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
@@ -316,6 +324,12 @@ typedef struct _net_ebpf_xdp_md
 // NBL Clone Functions.
 //
 
+/**
+ * @brief Headroom reserved in front of the data of cloned NBLs, so that programs can still attach metadata with
+ * bpf_xdp_adjust_meta after the packet has been copied into a contiguous buffer.
+ */
+#define NET_EBPF_XDP_CLONED_NBL_HEADROOM XDP_METADATA_MAX
+
 static void
 _net_ebpf_ext_free_nbl(_Inout_ NET_BUFFER_LIST* nbl, BOOLEAN free_data);
 
@@ -328,6 +342,7 @@ _net_ebpf_ext_allocate_cloned_nbl(_Inout_ net_ebpf_xdp_md_t* net_xdp_ctx, uint32
     NET_BUFFER* old_net_buffer = NULL;
     NET_BUFFER_LIST* new_nbl = NULL;
     uint32_t cloned_net_buffer_length = 0;
+    uint32_t packet_buffer_length = 0;
     uint8_t* packet_buffer = NULL;
     MDL* mdl_chain = NULL;
 
@@ -355,20 +370,29 @@ _net_ebpf_ext_allocate_cloned_nbl(_Inout_ net_ebpf_xdp_md_t* net_xdp_ctx, uint32
         goto Exit;
     }
 
+    status = RtlULongAdd(
+        cloned_net_buffer_length, NET_EBPF_XDP_CLONED_NBL_HEADROOM, (unsigned long*)&packet_buffer_length);
+    if (!NT_SUCCESS(status)) {
+        NET_EBPF_EXT_LOG_MESSAGE_NTSTATUS(
+            NET_EBPF_EXT_TRACELOG_LEVEL_ERROR, NET_EBPF_EXT_TRACELOG_KEYWORD_XDP, "RtlULongAdd failed.", status);
+        goto Exit;
+    }
+
     packet_buffer =
-        (uint8_t*)ExAllocatePoolUninitialized(NonPagedPoolNx, cloned_net_buffer_length, NET_EBPF_EXTENSION_POOL_TAG);
+        (uint8_t*)ExAllocatePoolUninitialized(NonPagedPoolNx, packet_buffer_length, NET_EBPF_EXTENSION_POOL_TAG);
     NET_EBPF_EXT_BAIL_ON_ALLOC_FAILURE_STATUS(
         NET_EBPF_EXT_TRACELOG_KEYWORD_XDP, packet_buffer, "packet_buffer", status);
-    RtlZeroMemory(packet_buffer, cloned_net_buffer_length);
+    RtlZeroMemory(packet_buffer, packet_buffer_length);
 
+    uint8_t* cloned_data = packet_buffer + NET_EBPF_XDP_CLONED_NBL_HEADROOM;
     if (old_data != NULL) {
         // Copy the contents of the old NBL into the packet_buffer at the offset after any unused header.
-        RtlCopyMemory(packet_buffer + unused_header_length, old_data, old_net_buffer->DataLength);
+        RtlCopyMemory(cloned_data + unused_header_length, old_data, old_net_buffer->DataLength);
     } else {
         // This is the case when we received a NB with more than one MDL. Get contiguous data buffer
         // from NB and copy to packet_buffer at the offset after any unused header.
         uint8_t* buffer = (uint8_t*)NdisGetDataBuffer(
-            old_net_buffer, old_net_buffer->DataLength, packet_buffer + unused_header_length, 1, 0);
+            old_net_buffer, old_net_buffer->DataLength, cloned_data + unused_header_length, 1, 0);
         if (buffer == NULL) {
             status = STATUS_INSUFFICIENT_RESOURCES;
             NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(NET_EBPF_EXT_TRACELOG_KEYWORD_XDP, "NdisGetDataBuffer", status);
@@ -377,11 +401,11 @@ _net_ebpf_ext_allocate_cloned_nbl(_Inout_ net_ebpf_xdp_md_t* net_xdp_ctx, uint32
     }
 
     // Adjust the XDP context data pointers.
-    net_xdp_ctx->base.data = packet_buffer;
-    net_xdp_ctx->base.data_end = packet_buffer + cloned_net_buffer_length;
+    net_xdp_ctx->base.data = cloned_data;
+    net_xdp_ctx->base.data_end = cloned_data + cloned_net_buffer_length;
 
     // Create a MDL with the packet buffer.
-    mdl_chain = IoAllocateMdl(packet_buffer, cloned_net_buffer_length, FALSE, FALSE, NULL);
+    mdl_chain = IoAllocateMdl(packet_buffer, packet_buffer_length, FALSE, FALSE, NULL);
     if (mdl_chain == NULL) {
         status = STATUS_INSUFFICIENT_RESOURCES;
         NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(NET_EBPF_EXT_TRACELOG_KEYWORD_XDP, "IoAllocateMdl", status);
@@ -391,7 +415,13 @@ _net_ebpf_ext_allocate_cloned_nbl(_Inout_ net_ebpf_xdp_md_t* net_xdp_ctx, uint32
 
     // Now allocate the cloned NBL using this MDL chain.
     status = FwpsAllocateNetBufferAndNetBufferList(
-        _net_ebpf_ext_nbl_pool_handle, 0, 0, mdl_chain, 0, cloned_net_buffer_length, &new_nbl);
+        _net_ebpf_ext_nbl_pool_handle,
+        0,
+        0,
+        mdl_chain,
+        NET_EBPF_XDP_CLONED_NBL_HEADROOM,
+        cloned_net_buffer_length,
+        &new_nbl);
     if (!NT_SUCCESS(status)) {
         NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(
             NET_EBPF_EXT_TRACELOG_KEYWORD_XDP, "FwpsAllocateNetBufferAndNetBufferList", status);
@@ -436,6 +466,67 @@ _net_ebpf_ext_free_nbl(_Inout_ NET_BUFFER_LIST* nbl, BOOLEAN free_data)
 // XDP Helper Functions.
 //
 
+/**
+ * @brief Get the number of bytes of the current MDL that are available in front of the packet data.
+ */
+static uint32_t
+_net_ebpf_xdp_get_headroom(_In_ const net_ebpf_xdp_md_t* net_xdp_ctx)
+{
+    NET_BUFFER_LIST* nbl = (net_xdp_ctx->cloned_nbl != NULL) ? net_xdp_ctx->cloned_nbl : net_xdp_ctx->original_nbl;
+    if (nbl == NULL) {
+        return 0;
+    }
+    return NET_BUFFER_CURRENT_MDL_OFFSET(NET_BUFFER_LIST_FIRST_NB(nbl));
+}
+
+/**
+ * @brief Get the length of the metadata in front of the packet data.
+ *
+ * @param[in] ctx XDP context.
+ * @param[out] metadata_length Length of the metadata.
+ * @retval true data_meta points into the metadata area in front of data.
+ * @retval false data_meta was not set up by the extension (e.g. a test run context).
+ */
+static bool
+_net_ebpf_xdp_get_metadata_length(_In_ const xdp_md_t* ctx, _Out_ uint32_t* metadata_length)
+{
+    uint8_t* data = (uint8_t*)ctx->data;
+    uint8_t* data_meta = (uint8_t*)(uintptr_t)ctx->data_meta;
+    *metadata_length = 0;
+    if (data == NULL || data_meta > data || (size_t)(data - data_meta) > XDP_METADATA_MAX) {
+        return false;
+    }
+    *metadata_length = (uint32_t)(data - data_meta);
+    return true;
+}
+
+static int
+_net_ebpf_xdp_adjust_meta(_Inout_ xdp_md_t* ctx, int delta)
+{
+    int return_value = 0;
+    net_ebpf_xdp_md_t* net_xdp_ctx = (net_ebpf_xdp_md_t*)ctx;
+    uint8_t* data = (uint8_t*)ctx->data;
+    uint32_t current_length;
+    int64_t metadata_length;
+
+    if (!_net_ebpf_xdp_get_metadata_length(ctx, &current_length)) {
+        return_value = -1;
+        goto Exit;
+    }
+
+    metadata_length = (int64_t)current_length - delta;
+    if (metadata_length < 0 || metadata_length > XDP_METADATA_MAX || (metadata_length % sizeof(uint32_t)) != 0 ||
+        metadata_length > _net_ebpf_xdp_get_headroom(net_xdp_ctx)) {
+        return_value = -1;
+        goto Exit;
+    }
+
+    ctx->data_meta = (uint64_t)(uintptr_t)(data - metadata_length);
+
+Exit:
+    return return_value;
+}
+
 static int
 _net_ebpf_xdp_adjust_head(_Inout_ xdp_md_t* ctx, int delta)
 {
@@ -445,6 +536,9 @@ _net_ebpf_xdp_adjust_head(_Inout_ xdp_md_t* ctx, int delta)
     NET_BUFFER_LIST* nbl = NULL;
     NET_BUFFER* net_buffer = NULL;
     uint8_t* packet_buffer = NULL;
+    uint8_t metadata[XDP_METADATA_MAX];
+    uint32_t metadata_length;
+    bool metadata_present = _net_ebpf_xdp_get_metadata_length(ctx, &metadata_length);
 
     // Either original or cloned NBL must be present.
     if ((net_xdp_ctx->original_nbl == NULL) && (net_xdp_ctx->cloned_nbl == NULL)) {
@@ -460,6 +554,12 @@ _net_ebpf_xdp_adjust_head(_Inout_ xdp_md_t* ctx, int delta)
         // Nothing to do.
         goto Exit;
     }
+
+    // Save the metadata, as moving the data start may overwrite it or replace the buffer it lives in.
+    if (metadata_length > 0) {
+        memcpy(metadata, (uint8_t*)ctx->data - metadata_length, metadata_length);
+    }
+
     if (delta < 0) {
         uint32_t absolute_delta = -delta;
         ndis_status = NdisRetreatNetBufferDataStart(net_buffer, absolute_delta, 0, NULL);
@@ -487,6 +587,15 @@ _net_ebpf_xdp_adjust_head(_Inout_ xdp_md_t* ctx, int delta)
         net_xdp_ctx->base.data = packet_buffer;
     }
 
+    // Move the metadata in front of the new data start, dropping it if the headroom is now too small.
+    if (metadata_present) {
+        if (metadata_length > _net_ebpf_xdp_get_headroom(net_xdp_ctx)) {
+            metadata_length = 0;
+        }
+        memcpy((uint8_t*)ctx->data - metadata_length, metadata, metadata_length);
+        ctx->data_meta = (uint64_t)(uintptr_t)((uint8_t*)ctx->data - metadata_length);
+    }
+
 Exit:
     if (return_value == -1) {
         NET_EBPF_EXT_LOG_FUNCTION_ERROR(return_value);
@@ -495,6 +604,40 @@ Exit:
     return return_value;
 }
 
+static int
+_net_ebpf_xdp_parse_headers(_In_ const xdp_md_t* ctx, _Out_writes_bytes_(size) xdp_headers_t* headers, uint32_t size)
+{
+    const net_ebpf_xdp_md_t* net_xdp_ctx = (const net_ebpf_xdp_md_t*)ctx;
+    NET_BUFFER_LIST* nbl = NULL;
+    uint16_t vlan_id = 0;
+    uint32_t offload_flags = 0;
+
+    if (size != sizeof(xdp_headers_t)) {
+        return -1;
+    }
+
+    // The out-of-band information set by the NIC lives on the NBL that was indicated to the callout.
+    nbl = (net_xdp_ctx->original_nbl != NULL) ? net_xdp_ctx->original_nbl : net_xdp_ctx->cloned_nbl;
+    if (nbl != NULL) {
+        NDIS_NET_BUFFER_LIST_8021Q_INFO vlan_info;
+        NDIS_TCP_IP_CHECKSUM_NET_BUFFER_LIST_INFO checksum_info;
+
+        vlan_info.Value = NET_BUFFER_LIST_INFO(nbl, Ieee8021QNetBufferListInfo);
+        vlan_id = (uint16_t)vlan_info.TagHeader.VlanId;
+
+        checksum_info.Value = (ULONG)(ULONG_PTR)NET_BUFFER_LIST_INFO(nbl, TcpIpChecksumNetBufferListInfo);
+        if (checksum_info.Receive.IpChecksumSucceeded) {
+            offload_flags |= XDP_HEADERS_FLAG_L3_CHECKSUM_VALID;
+        }
+        if (checksum_info.Receive.TcpChecksumSucceeded || checksum_info.Receive.UdpChecksumSucceeded) {
+            offload_flags |= XDP_HEADERS_FLAG_L4_CHECKSUM_VALID;
+        }
+    }
+
+    return net_ebpf_ext_xdp_parse_headers(
+        (const uint8_t*)ctx->data, (uint8_t*)ctx->data_end - (uint8_t*)ctx->data, vlan_id, offload_flags, headers);
+}
+
 //
 // Packet Injection Routines.
 //
@@ -608,6 +751,40 @@ Exit:
     return;
 }
 
+/**
+ * @brief Map the NDIS RSS hash type of a received NBL to the XDP RSS hash type flags.
+ */
+static uint32_t
+_net_ebpf_xdp_get_rss_hash_type(_In_ const NET_BUFFER_LIST* nbl)
+{
+    if (NET_BUFFER_LIST_GET_HASH_FUNCTION(nbl) == 0) {
+        return XDP_RSS_TYPE_NONE;
+    }
+
+    switch (NET_BUFFER_LIST_GET_HASH_TYPE(nbl)) {
+    case NDIS_HASH_IPV4:
+        return XDP_RSS_L3_IPV4;
+    case NDIS_HASH_TCP_IPV4:
+        return XDP_RSS_L3_IPV4 | XDP_RSS_L4 | XDP_RSS_L4_TCP;
+    case NDIS_HASH_UDP_IPV4:
+        return XDP_RSS_L3_IPV4 | XDP_RSS_L4 | XDP_RSS_L4_UDP;
+    case NDIS_HASH_IPV6:
+        return XDP_RSS_L3_IPV6;
+    case NDIS_HASH_IPV6_EX:
+        return XDP_RSS_L3_IPV6 | XDP_RSS_L3_DYNHDR;
+    case NDIS_HASH_TCP_IPV6:
+        return XDP_RSS_L3_IPV6 | XDP_RSS_L4 | XDP_RSS_L4_TCP;
+    case NDIS_HASH_TCP_IPV6_EX:
+        return XDP_RSS_L3_IPV6 | XDP_RSS_L3_DYNHDR | XDP_RSS_L4 | XDP_RSS_L4_TCP;
+    case NDIS_HASH_UDP_IPV6:
+        return XDP_RSS_L3_IPV6 | XDP_RSS_L4 | XDP_RSS_L4_UDP;
+    case NDIS_HASH_UDP_IPV6_EX:
+        return XDP_RSS_L3_IPV6 | XDP_RSS_L3_DYNHDR | XDP_RSS_L4 | XDP_RSS_L4_UDP;
+    default:
+        return XDP_RSS_TYPE_NONE;
+    }
+}
+
 //
 // WFP Classify callback.
 //
@@ -719,6 +896,12 @@ net_ebpf_ext_layer_2_classify(
         net_xdp_ctx.base.data_end = packet_buffer + net_buffer->DataLength;
     }
 
+    // Start with empty metadata and expose the receive-side offload information recorded by the miniport.
+    net_xdp_ctx.base.data_meta = (uint64_t)(uintptr_t)net_xdp_ctx.base.data;
+    net_xdp_ctx.base.rx_hash = NET_BUFFER_LIST_GET_HASH_VALUE(nbl);
+    net_xdp_ctx.base.rx_hash_type = _net_ebpf_xdp_get_rss_hash_type(nbl);
+    net_xdp_ctx.base.rx_queue_index = NET_BUFFER_LIST_RECEIVE_QUEUE_ID(nbl);
+
     if (net_ebpf_extension_hook_invoke_program(attached_client, &net_xdp_ctx, &result) != EBPF_SUCCESS) {
         // Perform a default action if the program fails.
         result = XDP_DROP;
@@ -849,10 +1032,21 @@ _ebpf_xdp_context_create(
     new_context->base.data = (void*)data_in;
     new_context->base.data_end = (void*)(data_in + data_size_in);
 
-    if (context_in != NULL && context_size_in >= sizeof(xdp_md_t)) {
+    // Contexts from callers built before the receive-side fields were added are still accepted.
+    if (context_in != NULL && context_size_in >= EBPF_OFFSET_OF(xdp_md_t, rx_hash)) {
         xdp_md_t* xdp_context = (xdp_md_t*)context_in;
         new_context->base.data_meta = xdp_context->data_meta;
         new_context->base.ingress_ifindex = xdp_context->ingress_ifindex;
+        if (context_size_in >= sizeof(xdp_md_t)) {
+            new_context->base.rx_hash = xdp_context->rx_hash;
+            new_context->base.rx_hash_type = xdp_context->rx_hash_type;
+            new_context->base.rx_queue_index = xdp_context->rx_queue_index;
+        }
+    }
+
+    // A zero data_meta means the caller supplied no metadata, which bpf_xdp_adjust_meta can then grow.
+    if (new_context->base.data_meta == 0) {
+        new_context->base.data_meta = (uint64_t)(uintptr_t)new_context->base.data;
     }
 
     *context = new_context;
@@ -912,8 +1106,17 @@ _ebpf_xdp_context_delete(
         }
 
         xdp_md_t* xdp_context_out = (xdp_md_t*)context_out;
-        xdp_context_out->data_meta = xdp_context->base.data_meta;
+        uint32_t metadata_length;
+        // Metadata set up by the extension is described by a kernel address, which is not returned to the caller.
+        xdp_context_out->data_meta = _net_ebpf_xdp_get_metadata_length(&xdp_context->base, &metadata_length)
+                                         ? 0
+                                         : xdp_context->base.data_meta;
         xdp_context_out->ingress_ifindex = xdp_context->base.ingress_ifindex;
+        if (context_size == sizeof(xdp_md_t)) {
+            xdp_context_out->rx_hash = xdp_context->base.rx_hash;
+            xdp_context_out->rx_hash_type = xdp_context->base.rx_hash_type;
+            xdp_context_out->rx_queue_index = xdp_context->base.rx_queue_index;
+        }
         *context_size_out = context_size;
     } else {
         *context_size_out = 0;
@@ -0,0 +1,207 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+#pragma once
+
+/**
+ * @file
+ * @brief Packet header parser behind the bpf_xdp_parse_headers helper. It only depends on ebpf_nethooks.h so that the
+ * extension and the user mode test harness share the same implementation.
+ */
+
+#include "ebpf_nethooks.h"
+
+#include <string.h>
+
+#define NET_EBPF_EXT_ETHERNET_HEADER_LENGTH 14
+#define NET_EBPF_EXT_VLAN_TAG_LENGTH 4
+#define NET_EBPF_EXT_IPV4_HEADER_MIN_LENGTH 20
+#define NET_EBPF_EXT_IPV6_HEADER_LENGTH 40
+#define NET_EBPF_EXT_IPV6_EXTENSION_HEADER_MIN_LENGTH 8
+#define NET_EBPF_EXT_TCP_HEADER_MIN_LENGTH 20
+#define NET_EBPF_EXT_UDP_HEADER_LENGTH 8
+
+#define NET_EBPF_EXT_ETHERNET_TYPE_IPV4 0x0800
+#define NET_EBPF_EXT_ETHERNET_TYPE_IPV6 0x86dd
+#define NET_EBPF_EXT_ETHERNET_TYPE_8021Q 0x8100
+#define NET_EBPF_EXT_ETHERNET_TYPE_8021AD 0x88a8
+
+#define NET_EBPF_EXT_IPPROTO_HOPOPTS 0
+#define NET_EBPF_EXT_IPPROTO_TCP 6
+#define NET_EBPF_EXT_IPPROTO_UDP 17
+#define NET_EBPF_EXT_IPPROTO_ROUTING 43
+#define NET_EBPF_EXT_IPPROTO_FRAGMENT 44
+#define NET_EBPF_EXT_IPPROTO_DSTOPTS 60
+
+// Maximum number of stacked VLAN tags (QinQ) and IPv6 extension headers that are walked before giving up.
+#define NET_EBPF_EXT_MAX_VLAN_TAGS 2
+#define NET_EBPF_EXT_MAX_IPV6_EXTENSION_HEADERS 8
+
+static inline uint16_t
+_net_ebpf_ext_read_uint16_network_order(_In_reads_bytes_(sizeof(uint16_t)) const uint8_t* data)
+{
+    return (uint16_t)((data[0] << 8) | data[1]);
+}
+
+/**
+ * @brief Parse the L2 to L4 headers of an Ethernet frame.
+ *
+ * @param[in] data Start of the frame.
+ * @param[in] length Number of contiguous bytes available at data.
+ * @param[in] offloaded_vlan_id VLAN ID that the NIC stripped from the frame, or 0 if none.
+ * @param[in] offload_flags XDP_HEADERS_FLAG_L3_CHECKSUM_VALID and XDP_HEADERS_FLAG_L4_CHECKSUM_VALID as reported by
+ * the NIC. Each is only passed through if the corresponding header is found.
+ * @param[out] headers Parsed header information. Layers that are missing or truncated are zeroed.
+ * @retval 0 The frame contains at least an Ethernet header.
+ * @retval -1 The frame is shorter than an Ethernet header.
+ */
+static inline int
+net_ebpf_ext_xdp_parse_headers(
+    _In_reads_bytes_(length) const uint8_t* data,
+    size_t length,
+    uint16_t offloaded_vlan_id,
+    uint32_t offload_flags,
+    _Out_ xdp_headers_t* headers)
+{
+    size_t offset = NET_EBPF_EXT_ETHERNET_HEADER_LENGTH;
+    uint16_t ether_type;
+    uint8_t protocol = 0;
+    bool transport_present = true;
+
+    memset(headers, 0, sizeof(*headers));
+    if (length < NET_EBPF_EXT_ETHERNET_HEADER_LENGTH) {
+        return -1;
+    }
+
+    // Offsets are reported as 16-bit values, so only look at the first 64KB of the frame.
+    if (length > UINT16_MAX) {
+        length = UINT16_MAX;
+    }
+
+    if (offloaded_vlan_id != 0) {
+        headers->vlan_id = offloaded_vlan_id;
+        headers->flags |= XDP_HEADERS_FLAG_VLAN | XDP_HEADERS_FLAG_VLAN_OFFLOADED;
+    }
+
+    // Layer 2: Ethernet, followed by up to two in-band VLAN tags.
+    ether_type = _net_ebpf_ext_read_uint16_network_order(data + 12);
+    for (int i = 0; i < NET_EBPF_EXT_MAX_VLAN_TAGS; i++) {
+        if (ether_type != NET_EBPF_EXT_ETHERNET_TYPE_8021Q && ether_type != NET_EBPF_EXT_ETHERNET_TYPE_8021AD) {
+            break;
+        }
+        if (length < offset + NET_EBPF_EXT_VLAN_TAG_LENGTH) {
+            goto Exit;
+        }
+        if (!(headers->flags & XDP_HEADERS_FLAG_VLAN)) {
+            headers->vlan_id = _net_ebpf_ext_read_uint16_network_order(data + offset) & 0x0fff;
+            headers->flags |= XDP_HEADERS_FLAG_VLAN;
+        }
+        ether_type = _net_ebpf_ext_read_uint16_network_order(data + offset + 2);
+        offset += NET_EBPF_EXT_VLAN_TAG_LENGTH;
+    }
+    headers->ether_type = ether_type;
+
+    // Layer 3.
+    if (ether_type == NET_EBPF_EXT_ETHERNET_TYPE_IPV4) {
+        const uint8_t* ipv4_header = data + offset;
+        size_t header_length;
+        uint16_t fragment;
+
+        if (length < offset + NET_EBPF_EXT_IPV4_HEADER_MIN_LENGTH || (ipv4_header[0] >> 4) != 4) {
+            goto Exit;
+        }
+        header_length = (size_t)(ipv4_header[0] & 0x0f) * sizeof(uint32_t);
+        if (header_length < NET_EBPF_EXT_IPV4_HEADER_MIN_LENGTH || length < offset + header_length) {
+            goto Exit;
+        }
+
+        headers->l3_offset = (uint16_t)offset;
+        headers->ip_version = 4;
+        headers->flags |= (offload_flags & XDP_HEADERS_FLAG_L3_CHECKSUM_VALID);
+        memcpy(headers->source_address, ipv4_header + 12, sizeof(uint32_t));
+        memcpy(headers->destination_address, ipv4_header + 16, sizeof(uint32_t));
+        protocol = ipv4_header[9];
+
+        // More fragments flag or a non-zero fragment offset.
+        fragment = _net_ebpf_ext_read_uint16_network_order(ipv4_header + 6);
+        if (fragment & 0x3fff) {
+            headers->flags |= XDP_HEADERS_FLAG_FRAGMENT;
+            // Only the first fragment carries the transport header.
+            transport_present = ((fragment & 0x1fff) == 0);
+        }
+        offset += header_length;
+    } else if (ether_type == NET_EBPF_EXT_ETHERNET_TYPE_IPV6) {
+        const uint8_t* ipv6_header = data + offset;
+
+        if (length < offset + NET_EBPF_EXT_IPV6_HEADER_LENGTH || (ipv6_header[0] >> 4) != 6) {
+            goto Exit;
+        }
+
+        headers->l3_offset = (uint16_t)offset;
+        headers->ip_version = 6;
+        memcpy(headers->source_address, ipv6_header + 8, sizeof(headers->source_address));
+        memcpy(headers->destination_address, ipv6_header + 24, sizeof(headers->destination_address));
+        protocol = ipv6_header[6];
+        offset += NET_EBPF_EXT_IPV6_HEADER_LENGTH;
+
+        // Skip the extension headers that can precede the transport header.
+        for (int i = 0; i < NET_EBPF_EXT_MAX_IPV6_EXTENSION_HEADERS; i++) {
+            const uint8_t* extension_header = data + offset;
+
+            if (protocol != NET_EBPF_EXT_IPPROTO_HOPOPTS && protocol != NET_EBPF_EXT_IPPROTO_ROUTING &&
+                protocol != NET_EBPF_EXT_IPPROTO_DSTOPTS && protocol != NET_EBPF_EXT_IPPROTO_FRAGMENT) {
+                break;
+            }
+            if (length < offset + NET_EBPF_EXT_IPV6_EXTENSION_HEADER_MIN_LENGTH) {
+                transport_present = false;
+                break;
+            }
+            if (protocol == NET_EBPF_EXT_IPPROTO_FRAGMENT) {
+                headers->flags |= XDP_HEADERS_FLAG_FRAGMENT;
+                if ((_net_ebpf_ext_read_uint16_network_order(extension_header + 2) & 0xfff8) != 0) {
+                    transport_present = false;
+                }
+                offset += NET_EBPF_EXT_IPV6_EXTENSION_HEADER_MIN_LENGTH;
+            } else {
+                offset += ((size_t)extension_header[1] + 1) * NET_EBPF_EXT_IPV6_EXTENSION_HEADER_MIN_LENGTH;
+            }
+            protocol = extension_header[0];
+            if (!transport_present) {
+                break;
+            }
+        }
+    } else {
+        goto Exit;
+    }
+    headers->protocol = protocol;
+
+    // Layer 4.
+    if (!transport_present) {
+        goto Exit;
+    }
+    if (protocol == NET_EBPF_EXT_IPPROTO_TCP) {
+        size_t header_length;
+
+        if (length < offset + NET_EBPF_EXT_TCP_HEADER_MIN_LENGTH) {
+            goto Exit;
+        }
+        header_length = (size_t)(data[offset + 12] >> 4) * sizeof(uint32_t);
+        if (header_length < NET_EBPF_EXT_TCP_HEADER_MIN_LENGTH || length < offset + header_length) {
+            goto Exit;
+        }
+        headers->payload_offset = (uint16_t)(offset + header_length);
+    } else if (protocol == NET_EBPF_EXT_IPPROTO_UDP) {
+        if (length < offset + NET_EBPF_EXT_UDP_HEADER_LENGTH) {
+            goto Exit;
+        }
+        headers->payload_offset = (uint16_t)(offset + NET_EBPF_EXT_UDP_HEADER_LENGTH);
+    } else {
+        goto Exit;
+    }
+    headers->l4_offset = (uint16_t)offset;
+    headers->flags |= (offload_flags & XDP_HEADERS_FLAG_L4_CHECKSUM_VALID);
+    memcpy(&headers->source_port, data + offset, sizeof(uint16_t));
+    memcpy(&headers->destination_port, data + offset + 2, sizeof(uint16_t));
+
+Exit:
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include "ebpf_version.h"
 #include "git_commit_id.h"
 #include "net_ebpf_ext.h"
+#include "net_ebpf_ext_ioctls.h"
 
 #include <ntddk.h>
 #pragma warning(push)
@@ -25,6 +26,7 @@
 #pragma warning(pop)
 
 #define NET_EBPF_EXT_DEVICE_NAME L"\\Device\\NetEbpfExt"
+#define NET_EBPF_EXT_SYMBOLIC_DEVICE_NAME L"\\GLOBAL??\\" NET_EBPF_EXT_DEVICE_BASE_NAME
 
 // Driver global variables
 static WDFDEVICE _net_ebpf_ext_device = NULL;
@@ -36,8 +38,61 @@ const char net_ebpf_ext_version[] = EBPF_VERSION " " GIT_COMMIT_ID;
 //
 // Pre-Declarations
 //
+static EVT_WDF_IO_QUEUE_IO_DEVICE_CONTROL _net_ebpf_ext_driver_io_device_control;
 DRIVER_INITIALIZE DriverEntry;
 
+static void
+_net_ebpf_ext_driver_io_device_control(
+    _In_ const WDFQUEUE queue,
+    _In_ const WDFREQUEST request,
+    size_t output_buffer_length,
+    size_t input_buffer_length,
+    unsigned long io_control_code)
+{
+    NTSTATUS status = STATUS_SUCCESS;
+    void* input_buffer = NULL;
+    size_t actual_input_length = 0;
+    net_ebpf_ext_get_app_id_reply_t* reply = NULL;
+    uint64_t app_id = 0;
+    size_t information = 0;
+
+    UNREFERENCED_PARAMETER(queue);
+    UNREFERENCED_PARAMETER(output_buffer_length);
+
+    switch (io_control_code) {
+    case IOCTL_NET_EBPF_EXT_CTL_GET_APP_ID:
+        if (input_buffer_length == 0) {
+            status = STATUS_INVALID_PARAMETER;
+            goto Done;
+        }
+        status = WdfRequestRetrieveInputBuffer(request, input_buffer_length, &input_buffer, &actual_input_length);
+        if (!NT_SUCCESS(status)) {
+            NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(
+                NET_EBPF_EXT_TRACELOG_KEYWORD_BASE, "WdfRequestRetrieveInputBuffer", status);
+            goto Done;
+        }
+
+        // The reply overwrites the input buffer, so compute the ID before retrieving the output buffer.
+        app_id = net_ebpf_extension_get_app_id((const uint8_t*)input_buffer, actual_input_length);
+
+        status = WdfRequestRetrieveOutputBuffer(request, sizeof(*reply), (void**)&reply, NULL);
+        if (!NT_SUCCESS(status)) {
+            NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(
+                NET_EBPF_EXT_TRACELOG_KEYWORD_BASE, "WdfRequestRetrieveOutputBuffer", status);
+            goto Done;
+        }
+        reply->app_id = app_id;
+        information = sizeof(*reply);
+        break;
+    default:
+        status = STATUS_INVALID_DEVICE_REQUEST;
+        break;
+    }
+
+Done:
+    WdfRequestCompleteWithInformation(request, status, information);
+}
+
 static void
 _net_ebpf_ext_driver_uninitialize_objects()
 {
@@ -74,6 +129,8 @@ _net_ebpf_ext_driver_initialize_objects(_Inout_ DRIVER_OBJECT* driver_object, _I
     WDF_DRIVER_CONFIG driver_configuration;
     PWDFDEVICE_INIT device_initialize = NULL;
     UNICODE_STRING ebpf_device_name;
+    UNICODE_STRING ebpf_symbolic_device_name;
+    WDF_IO_QUEUE_CONFIG io_queue_configuration;
     WDFDRIVER driver;
 
     WDF_DRIVER_CONFIG_INIT(&driver_configuration, WDF_NO_EVENT_CALLBACK);
@@ -120,6 +177,24 @@ _net_ebpf_ext_driver_initialize_objects(_Inout_ DRIVER_OBJECT* driver_object, _I
         goto Exit;
     }
 
+    // Create symbolic link for control object for user mode.
+    RtlInitUnicodeString(&ebpf_symbolic_device_name, NET_EBPF_EXT_SYMBOLIC_DEVICE_NAME);
+    status = WdfDeviceCreateSymbolicLink(_net_ebpf_ext_device, &ebpf_symbolic_device_name);
+    if (!NT_SUCCESS(status)) {
+        NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(
+            NET_EBPF_EXT_TRACELOG_KEYWORD_BASE, "WdfDeviceCreateSymbolicLink", status);
+        goto Exit;
+    }
+
+    // Parallel default queue.
+    WDF_IO_QUEUE_CONFIG_INIT_DEFAULT_QUEUE(&io_queue_configuration, WdfIoQueueDispatchParallel);
+    io_queue_configuration.EvtIoDeviceControl = _net_ebpf_ext_driver_io_device_control;
+    status = WdfIoQueueCreate(_net_ebpf_ext_device, &io_queue_configuration, WDF_NO_OBJECT_ATTRIBUTES, WDF_NO_HANDLE);
+    if (!NT_SUCCESS(status)) {
+        NET_EBPF_EXT_LOG_NTSTATUS_API_FAILURE(NET_EBPF_EXT_TRACELOG_KEYWORD_BASE, "WdfIoQueueCreate", status);
+        goto Exit;
+    }
+
     _net_ebpf_ext_driver_device_object = WdfDeviceWdmGetDeviceObject(_net_ebpf_ext_device);
 
     status = net_ebpf_ext_initialize_ndis_handles((const DRIVER_OBJECT*)driver_object);
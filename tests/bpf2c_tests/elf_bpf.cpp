@@ -225,6 +225,7 @@ DECLARE_TEST("invalid_helpers", _test_mode::NoVerify);
 DECLARE_TEST("invalid_maps1", _test_mode::NoVerify);
 DECLARE_TEST("invalid_maps2", _test_mode::NoVerify);
 DECLARE_TEST("invalid_maps3", _test_mode::NoVerify);
+DECLARE_TEST("many_maps", _test_mode::Verify)
 DECLARE_TEST("map", _test_mode::NoVerify)
 DECLARE_TEST("map_in_map_btf", _test_mode::Verify)
 DECLARE_TEST("map_in_map_legacy_id", _test_mode::Verify)
@@ -236,7 +237,9 @@ DECLARE_TEST("printk", _test_mode::Verify)
 DECLARE_TEST("printk_legacy", _test_mode::Verify)
 DECLARE_TEST("printk_unsafe", _test_mode::NoVerify)
 DECLARE_TEST("reflect_packet", _test_mode::Verify)
+DECLARE_TEST("reflect_packet_parsed", _test_mode::Verify)
 DECLARE_TEST("sockops", _test_mode::Verify)
+DECLARE_TEST("subprogram", _test_mode::Verify)
 DECLARE_TEST("tail_call", _test_mode::Verify)
 DECLARE_TEST("tail_call_bad", _test_mode::Verify)
 DECLARE_TEST("tail_call_map", _test_mode::Verify)
@@ -0,0 +1,727 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+// Do not alter this generated file.
+// This file was generated from reflect_packet_parsed.o
+
+#include "bpf2c.h"
+
+#include <stdio.h>
+#define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+
+#define metadata_table reflect_packet_parsed##_metadata_table
+extern metadata_table_t metadata_table;
+
+bool APIENTRY
+DllMain(_In_ HMODULE hModule, unsigned int ul_reason_for_call, _In_ void* lpReserved)
+{
+    UNREFERENCED_PARAMETER(hModule);
+    UNREFERENCED_PARAMETER(lpReserved);
+    switch (ul_reason_for_call) {
+    case DLL_PROCESS_ATTACH:
+    case DLL_THREAD_ATTACH:
+    case DLL_THREAD_DETACH:
+    case DLL_PROCESS_DETACH:
+        break;
+    }
+    return TRUE;
+}
+
+__declspec(dllexport) metadata_table_t* get_metadata_table() { return &metadata_table; }
+
+#include "bpf2c.h"
+
+static void
+_get_hash(_Outptr_result_buffer_maybenull_(*size) const uint8_t** hash, _Out_ size_t* size)
+{
+    *hash = NULL;
+    *size = 0;
+}
+static void
+_get_maps(_Outptr_result_buffer_maybenull_(*count) map_entry_t** maps, _Out_ size_t* count)
+{
+    *maps = NULL;
+    *count = 0;
+}
+
+static helper_function_entry_t reflect_packet_parsed_helpers[] = {
+    {NULL, 65538, "helper_id_65538"},
+};
+
+static GUID reflect_packet_parsed_program_type_guid = {
+    0xce8ccef8, 0x4241, 0x4975, {0x98, 0x4d, 0xbb, 0x39, 0x21, 0xdf, 0xa7, 0x3c}};
+static GUID reflect_packet_parsed_attach_type_guid = {
+    0x0dccc15d, 0xa5f9, 0x4dc1, {0xac, 0x79, 0xfa, 0x25, 0xee, 0xf2, 0x15, 0xc3}};
+#pragma code_seg(push, "xdp_te~1")
+static uint64_t
+reflect_packet_parsed(void* context)
+#line 23 "sample/reflect_packet_parsed.c"
+{
+#line 23 "sample/reflect_packet_parsed.c"
+    // Prologue
+#line 23 "sample/reflect_packet_parsed.c"
+    uint64_t stack[(UBPF_STACK_SIZE + 7) / 8];
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r0 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r1 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r2 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r3 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r4 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r5 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r6 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r7 = 0;
+#line 23 "sample/reflect_packet_parsed.c"
+    register uint64_t r10 = 0;
+
+#line 23 "sample/reflect_packet_parsed.c"
+    r1 = (uintptr_t)context;
+#line 23 "sample/reflect_packet_parsed.c"
+    r10 = (uintptr_t)((uint8_t*)stack + sizeof(stack));
+
+    // EBPF_OP_LDXDW pc=0 dst=r7 src=r1 offset=8 imm=0
+#line 23 "sample/reflect_packet_parsed.c"
+    r7 = *(uint64_t*)(uintptr_t)(r1 + OFFSET(8));
+    // EBPF_OP_LDXDW pc=1 dst=r6 src=r1 offset=0 imm=0
+#line 27 "sample/reflect_packet_parsed.c"
+    r6 = *(uint64_t*)(uintptr_t)(r1 + OFFSET(0));
+    // EBPF_OP_MOV64_REG pc=2 dst=r2 src=r10 offset=0 imm=0
+#line 30 "sample/reflect_packet_parsed.c"
+    r2 = r10;
+    // EBPF_OP_ADD64_IMM pc=3 dst=r2 src=r0 offset=0 imm=-56
+#line 30 "sample/reflect_packet_parsed.c"
+    r2 += IMMEDIATE(-56);
+    // EBPF_OP_MOV64_IMM pc=4 dst=r3 src=r0 offset=0 imm=52
+#line 30 "sample/reflect_packet_parsed.c"
+    r3 = IMMEDIATE(52);
+    // EBPF_OP_CALL pc=5 dst=r0 src=r0 offset=0 imm=65538
+#line 30 "sample/reflect_packet_parsed.c"
+    r0 = reflect_packet_parsed_helpers[0].address(r1, r2, r3, r4, r5);
+#line 30 "sample/reflect_packet_parsed.c"
+    if ((reflect_packet_parsed_helpers[0].tail_call) && (r0 == 0)) {
+#line 30 "sample/reflect_packet_parsed.c"
+        return 0;
+#line 30 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_MOV64_REG pc=6 dst=r1 src=r0 offset=0 imm=0
+#line 30 "sample/reflect_packet_parsed.c"
+    r1 = r0;
+    // EBPF_OP_MOV64_IMM pc=7 dst=r0 src=r0 offset=0 imm=1
+#line 30 "sample/reflect_packet_parsed.c"
+    r0 = IMMEDIATE(1);
+    // EBPF_OP_LSH64_IMM pc=8 dst=r1 src=r0 offset=0 imm=32
+#line 30 "sample/reflect_packet_parsed.c"
+    r1 <<= (IMMEDIATE(32) & 63);
+    // EBPF_OP_ARSH64_IMM pc=9 dst=r1 src=r0 offset=0 imm=32
+#line 30 "sample/reflect_packet_parsed.c"
+    r1 = (int64_t)r1 >> (uint32_t)(IMMEDIATE(32) & 63);
+    // EBPF_OP_MOV64_IMM pc=10 dst=r2 src=r0 offset=0 imm=0
+#line 30 "sample/reflect_packet_parsed.c"
+    r2 = IMMEDIATE(0);
+    // EBPF_OP_JSGT_REG pc=11 dst=r2 src=r1 offset=169 imm=0
+#line 30 "sample/reflect_packet_parsed.c"
+    if ((int64_t)r2 > (int64_t)r1) {
+#line 30 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 30 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_LDXB pc=12 dst=r1 src=r10 offset=-45 imm=0
+#line 33 "sample/reflect_packet_parsed.c"
+    r1 = *(uint8_t*)(uintptr_t)(r10 + OFFSET(-45));
+    // EBPF_OP_JNE_IMM pc=13 dst=r1 src=r0 offset=167 imm=17
+#line 33 "sample/reflect_packet_parsed.c"
+    if (r1 != IMMEDIATE(17)) {
+#line 33 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 33 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_LDXH pc=14 dst=r2 src=r10 offset=-54 imm=0
+#line 33 "sample/reflect_packet_parsed.c"
+    r2 = *(uint16_t*)(uintptr_t)(r10 + OFFSET(-54));
+    // EBPF_OP_JEQ_IMM pc=15 dst=r2 src=r0 offset=165 imm=0
+#line 33 "sample/reflect_packet_parsed.c"
+    if (r2 == IMMEDIATE(0)) {
+#line 33 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 33 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_LDXH pc=16 dst=r1 src=r10 offset=-38 imm=0
+#line 34 "sample/reflect_packet_parsed.c"
+    r1 = *(uint16_t*)(uintptr_t)(r10 + OFFSET(-38));
+    // EBPF_OP_JNE_IMM pc=17 dst=r1 src=r0 offset=163 imm=7459
+#line 34 "sample/reflect_packet_parsed.c"
+    if (r1 != IMMEDIATE(7459)) {
+#line 34 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 34 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_MOV64_REG pc=18 dst=r1 src=r6 offset=0 imm=0
+#line 38 "sample/reflect_packet_parsed.c"
+    r1 = r6;
+    // EBPF_OP_ADD64_IMM pc=19 dst=r1 src=r0 offset=0 imm=14
+#line 38 "sample/reflect_packet_parsed.c"
+    r1 += IMMEDIATE(14);
+    // EBPF_OP_JGT_REG pc=20 dst=r1 src=r7 offset=160 imm=0
+#line 38 "sample/reflect_packet_parsed.c"
+    if (r1 > r7) {
+#line 38 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 38 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_MOV64_REG pc=21 dst=r1 src=r6 offset=0 imm=0
+#line 43 "sample/reflect_packet_parsed.c"
+    r1 = r6;
+    // EBPF_OP_ADD64_REG pc=22 dst=r1 src=r2 offset=0 imm=0
+#line 43 "sample/reflect_packet_parsed.c"
+    r1 += r2;
+    // EBPF_OP_MOV64_REG pc=23 dst=r2 src=r1 offset=0 imm=0
+#line 44 "sample/reflect_packet_parsed.c"
+    r2 = r1;
+    // EBPF_OP_ADD64_IMM pc=24 dst=r2 src=r0 offset=0 imm=8
+#line 44 "sample/reflect_packet_parsed.c"
+    r2 += IMMEDIATE(8);
+    // EBPF_OP_JGT_REG pc=25 dst=r2 src=r7 offset=155 imm=0
+#line 44 "sample/reflect_packet_parsed.c"
+    if (r2 > r7) {
+#line 44 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 44 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_LDXH pc=26 dst=r3 src=r10 offset=-56 imm=0
+#line 49 "sample/reflect_packet_parsed.c"
+    r3 = *(uint16_t*)(uintptr_t)(r10 + OFFSET(-56));
+    // EBPF_OP_MOV64_REG pc=27 dst=r2 src=r6 offset=0 imm=0
+#line 49 "sample/reflect_packet_parsed.c"
+    r2 = r6;
+    // EBPF_OP_ADD64_REG pc=28 dst=r2 src=r3 offset=0 imm=0
+#line 49 "sample/reflect_packet_parsed.c"
+    r2 += r3;
+    // EBPF_OP_LDXB pc=29 dst=r3 src=r10 offset=-46 imm=0
+#line 48 "sample/reflect_packet_parsed.c"
+    r3 = *(uint8_t*)(uintptr_t)(r10 + OFFSET(-46));
+    // EBPF_OP_JNE_IMM pc=30 dst=r3 src=r0 offset=8 imm=4
+#line 48 "sample/reflect_packet_parsed.c"
+    if (r3 != IMMEDIATE(4)) {
+#line 48 "sample/reflect_packet_parsed.c"
+        goto label_1;
+#line 48 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_MOV64_REG pc=31 dst=r3 src=r2 offset=0 imm=0
+#line 50 "sample/reflect_packet_parsed.c"
+    r3 = r2;
+    // EBPF_OP_ADD64_IMM pc=32 dst=r3 src=r0 offset=0 imm=20
+#line 50 "sample/reflect_packet_parsed.c"
+    r3 += IMMEDIATE(20);
+    // EBPF_OP_JGT_REG pc=33 dst=r3 src=r7 offset=147 imm=0
+#line 50 "sample/reflect_packet_parsed.c"
+    if (r3 > r7) {
+#line 50 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 50 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_LDXW pc=34 dst=r3 src=r2 offset=16 imm=0
+#line 23 "sample/./xdp_common.h"
+    r3 = *(uint32_t*)(uintptr_t)(r2 + OFFSET(16));
+    // EBPF_OP_LDXW pc=35 dst=r4 src=r2 offset=12 imm=0
+#line 24 "sample/./xdp_common.h"
+    r4 = *(uint32_t*)(uintptr_t)(r2 + OFFSET(12));
+    // EBPF_OP_STXW pc=36 dst=r2 src=r4 offset=16 imm=0
+#line 24 "sample/./xdp_common.h"
+    *(uint32_t*)(uintptr_t)(r2 + OFFSET(16)) = (uint32_t)r4;
+    // EBPF_OP_STXW pc=37 dst=r2 src=r3 offset=12 imm=0
+#line 25 "sample/./xdp_common.h"
+    *(uint32_t*)(uintptr_t)(r2 + OFFSET(12)) = (uint32_t)r3;
+    // EBPF_OP_JA pc=38 dst=r0 src=r0 offset=101 imm=0
+#line 53 "sample/reflect_packet_parsed.c"
+    goto label_2;
+label_1:
+    // EBPF_OP_MOV64_REG pc=39 dst=r3 src=r2 offset=0 imm=0
+#line 56 "sample/reflect_packet_parsed.c"
+    r3 = r2;
+    // EBPF_OP_ADD64_IMM pc=40 dst=r3 src=r0 offset=0 imm=40
+#line 56 "sample/reflect_packet_parsed.c"
+    r3 += IMMEDIATE(40);
+    // EBPF_OP_JGT_REG pc=41 dst=r3 src=r7 offset=139 imm=0
+#line 56 "sample/reflect_packet_parsed.c"
+    if (r3 > r7) {
+#line 56 "sample/reflect_packet_parsed.c"
+        goto label_3;
+#line 56 "sample/reflect_packet_parsed.c"
+    }
+    // EBPF_OP_LDXB pc=42 dst=r4 src=r2 offset=33 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(33));
+    // EBPF_OP_LSH64_IMM pc=43 dst=r4 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r4 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=44 dst=r3 src=r2 offset=32 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(32));
+    // EBPF_OP_OR64_REG pc=45 dst=r4 src=r3 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 |= r3;
+    // EBPF_OP_LDXB pc=46 dst=r3 src=r2 offset=35 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(35));
+    // EBPF_OP_LSH64_IMM pc=47 dst=r3 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r3 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=48 dst=r5 src=r2 offset=34 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(34));
+    // EBPF_OP_OR64_REG pc=49 dst=r3 src=r5 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 |= r5;
+    // EBPF_OP_LSH64_IMM pc=50 dst=r3 src=r0 offset=0 imm=16
+#line 32 "sample/./xdp_common.h"
+    r3 <<= (IMMEDIATE(16) & 63);
+    // EBPF_OP_OR64_REG pc=51 dst=r3 src=r4 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 |= r4;
+    // EBPF_OP_LDXB pc=52 dst=r5 src=r2 offset=37 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(37));
+    // EBPF_OP_LSH64_IMM pc=53 dst=r5 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r5 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=54 dst=r4 src=r2 offset=36 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(36));
+    // EBPF_OP_OR64_REG pc=55 dst=r5 src=r4 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 |= r4;
+    // EBPF_OP_LDXB pc=56 dst=r4 src=r2 offset=39 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(39));
+    // EBPF_OP_LSH64_IMM pc=57 dst=r4 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r4 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=58 dst=r0 src=r2 offset=38 imm=0
+#line 32 "sample/./xdp_common.h"
+    r0 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(38));
+    // EBPF_OP_OR64_REG pc=59 dst=r4 src=r0 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 |= r0;
+    // EBPF_OP_LSH64_IMM pc=60 dst=r4 src=r0 offset=0 imm=16
+#line 32 "sample/./xdp_common.h"
+    r4 <<= (IMMEDIATE(16) & 63);
+    // EBPF_OP_OR64_REG pc=61 dst=r4 src=r5 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 |= r5;
+    // EBPF_OP_LSH64_IMM pc=62 dst=r4 src=r0 offset=0 imm=32
+#line 32 "sample/./xdp_common.h"
+    r4 <<= (IMMEDIATE(32) & 63);
+    // EBPF_OP_OR64_REG pc=63 dst=r4 src=r3 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 |= r3;
+    // EBPF_OP_LDXB pc=64 dst=r5 src=r2 offset=25 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(25));
+    // EBPF_OP_LSH64_IMM pc=65 dst=r5 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r5 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=66 dst=r3 src=r2 offset=24 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(24));
+    // EBPF_OP_OR64_REG pc=67 dst=r5 src=r3 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 |= r3;
+    // EBPF_OP_LDXB pc=68 dst=r3 src=r2 offset=27 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(27));
+    // EBPF_OP_LSH64_IMM pc=69 dst=r3 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r3 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=70 dst=r0 src=r2 offset=26 imm=0
+#line 32 "sample/./xdp_common.h"
+    r0 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(26));
+    // EBPF_OP_OR64_REG pc=71 dst=r3 src=r0 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 |= r0;
+    // EBPF_OP_STXDW pc=72 dst=r10 src=r4 offset=-64 imm=0
+#line 32 "sample/./xdp_common.h"
+    *(uint64_t*)(uintptr_t)(r10 + OFFSET(-64)) = (uint64_t)r4;
+    // EBPF_OP_LSH64_IMM pc=73 dst=r3 src=r0 offset=0 imm=16
+#line 32 "sample/./xdp_common.h"
+    r3 <<= (IMMEDIATE(16) & 63);
+    // EBPF_OP_OR64_REG pc=74 dst=r3 src=r5 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r3 |= r5;
+    // EBPF_OP_LDXB pc=75 dst=r4 src=r2 offset=29 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(29));
+    // EBPF_OP_LSH64_IMM pc=76 dst=r4 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r4 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=77 dst=r5 src=r2 offset=28 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(28));
+    // EBPF_OP_OR64_REG pc=78 dst=r4 src=r5 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r4 |= r5;
+    // EBPF_OP_LDXB pc=79 dst=r5 src=r2 offset=31 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(31));
+    // EBPF_OP_LSH64_IMM pc=80 dst=r5 src=r0 offset=0 imm=8
+#line 32 "sample/./xdp_common.h"
+    r5 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=81 dst=r0 src=r2 offset=30 imm=0
+#line 32 "sample/./xdp_common.h"
+    r0 = *(uint8_t*)(uintptr_t)(r2 + OFFSET(30));
+    // EBPF_OP_OR64_REG pc=82 dst=r5 src=r0 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 |= r0;
+    // EBPF_OP_LSH64_IMM pc=83 dst=r5 src=r0 offset=0 imm=16
+#line 32 "sample/./xdp_common.h"
+    r5 <<= (IMMEDIATE(16) & 63);
+    // EBPF_OP_OR64_REG pc=84 dst=r5 src=r4 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 |= r4;
+    // EBPF_OP_LSH64_IMM pc=85 dst=r5 src=r0 offset=0 imm=32
+#line 32 "sample/./xdp_common.h"
+    r5 <<= (IMMEDIATE(32) & 63);
+    // EBPF_OP_OR64_REG pc=86 dst=r5 src=r3 offset=0 imm=0
+#line 32 "sample/./xdp_common.h"
+    r5 |= r3;
+    // EBPF_OP_STXDW pc=87 dst=r10 src=r5 offset=-72 imm=0
+#line 32 "sample/./xdp_common.h"
+    *(uint64_t*)(uintptr_t)(r10 + OFFSET(-72)) = (uint64_t)r5;
+    // EBPF_OP_LDXW pc=88 dst=r3 src=r2 offset=8 imm=0
+#line 33 "sample/./xdp_common.h"
+    r3 = *(uint32_t*)(uintptr_t)(r2 + OFFSET(8));
+    // EBPF_OP_STXW pc=89 dst=r2 src=r3 offset=24 imm=0
+#line 33 "sample/./xdp_common.h"
+    *(uint32_t*)(uintptr_t)(r2 + OFFSET(24)) = (uint32_t)r3;
+    // EBPF_OP_LDXW pc=90 dst=r3 src=r2 offset=12 imm=0
+#line 33 "sample/./xdp_common.h"
+    r3 = *(uint32_t*)(uintptr_t)(r2 + OFFSET(12));
+    // EBPF_OP_STXW pc=91 dst=r2 src=r3 offset=28 imm=0
+#line 33 "sample/./xdp_common.h"
+    *(uint32_t*)(uintptr_t)(r2 + OFFSET(28)) = (uint32_t)r3;
+    // EBPF_OP_LDXW pc=92 dst=r3 src=r2 offset=16 imm=0
+#line 33 "sample/./xdp_common.h"
+    r3 = *(uint32_t*)(uintptr_t)(r2 + OFFSET(16));
+    // EBPF_OP_STXW pc=93 dst=r2 src=r3 offset=32 imm=0
+#line 33 "sample/./xdp_common.h"
+    *(uint32_t*)(uintptr_t)(r2 + OFFSET(32)) = (uint32_t)r3;
+    // EBPF_OP_LDXW pc=94 dst=r3 src=r2 offset=20 imm=0
+#line 33 "sample/./xdp_common.h"
+    r3 = *(uint32_t*)(uintptr_t)(r2 + OFFSET(20));
+    // EBPF_OP_STXW pc=95 dst=r2 src=r3 offset=36 imm=0
+#line 33 "sample/./xdp_common.h"
+    *(uint32_t*)(uintptr_t)(r2 + OFFSET(36)) = (uint32_t)r3;
+    // EBPF_OP_LDXDW pc=96 dst=r3 src=r10 offset=-72 imm=0
+#line 34 "sample/./xdp_common.h"
+    r3 = *(uint64_t*)(uintptr_t)(r10 + OFFSET(-72));
+    // EBPF_OP_MOV64_REG pc=97 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=98 dst=r4 src=r0 offset=0 imm=48
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(48) & 63);
+    // EBPF_OP_STXB pc=99 dst=r2 src=r4 offset=14 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(14)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=100 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=101 dst=r4 src=r0 offset=0 imm=56
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(56) & 63);
+    // EBPF_OP_STXB pc=102 dst=r2 src=r4 offset=15 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(15)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=103 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=104 dst=r4 src=r0 offset=0 imm=32
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(32) & 63);
+    // EBPF_OP_STXB pc=105 dst=r2 src=r4 offset=12 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(12)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=106 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=107 dst=r4 src=r0 offset=0 imm=40
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(40) & 63);
+    // EBPF_OP_STXB pc=108 dst=r2 src=r4 offset=13 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(13)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=109 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=110 dst=r4 src=r0 offset=0 imm=16
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(16) & 63);
+    // EBPF_OP_STXB pc=111 dst=r2 src=r4 offset=10 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(10)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=112 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=113 dst=r4 src=r0 offset=0 imm=24
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(24) & 63);
+    // EBPF_OP_STXB pc=114 dst=r2 src=r4 offset=11 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(11)) = (uint8_t)r4;
+    // EBPF_OP_STXB pc=115 dst=r2 src=r3 offset=8 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(8)) = (uint8_t)r3;
+    // EBPF_OP_RSH64_IMM pc=116 dst=r3 src=r0 offset=0 imm=8
+#line 34 "sample/./xdp_common.h"
+    r3 >>= (IMMEDIATE(8) & 63);
+    // EBPF_OP_STXB pc=117 dst=r2 src=r3 offset=9 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(9)) = (uint8_t)r3;
+    // EBPF_OP_LDXDW pc=118 dst=r3 src=r10 offset=-64 imm=0
+#line 34 "sample/./xdp_common.h"
+    r3 = *(uint64_t*)(uintptr_t)(r10 + OFFSET(-64));
+    // EBPF_OP_MOV64_REG pc=119 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=120 dst=r4 src=r0 offset=0 imm=48
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(48) & 63);
+    // EBPF_OP_STXB pc=121 dst=r2 src=r4 offset=22 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(22)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=122 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=123 dst=r4 src=r0 offset=0 imm=56
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(56) & 63);
+    // EBPF_OP_STXB pc=124 dst=r2 src=r4 offset=23 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(23)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=125 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=126 dst=r4 src=r0 offset=0 imm=32
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(32) & 63);
+    // EBPF_OP_STXB pc=127 dst=r2 src=r4 offset=20 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(20)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=128 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=129 dst=r4 src=r0 offset=0 imm=40
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(40) & 63);
+    // EBPF_OP_STXB pc=130 dst=r2 src=r4 offset=21 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(21)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=131 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=132 dst=r4 src=r0 offset=0 imm=16
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(16) & 63);
+    // EBPF_OP_STXB pc=133 dst=r2 src=r4 offset=18 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(18)) = (uint8_t)r4;
+    // EBPF_OP_MOV64_REG pc=134 dst=r4 src=r3 offset=0 imm=0
+#line 34 "sample/./xdp_common.h"
+    r4 = r3;
+    // EBPF_OP_RSH64_IMM pc=135 dst=r4 src=r0 offset=0 imm=24
+#line 34 "sample/./xdp_common.h"
+    r4 >>= (IMMEDIATE(24) & 63);
+    // EBPF_OP_STXB pc=136 dst=r2 src=r4 offset=19 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(19)) = (uint8_t)r4;
+    // EBPF_OP_STXB pc=137 dst=r2 src=r3 offset=16 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(16)) = (uint8_t)r3;
+    // EBPF_OP_RSH64_IMM pc=138 dst=r3 src=r0 offset=0 imm=8
+#line 34 "sample/./xdp_common.h"
+    r3 >>= (IMMEDIATE(8) & 63);
+    // EBPF_OP_STXB pc=139 dst=r2 src=r3 offset=17 imm=0
+#line 34 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r2 + OFFSET(17)) = (uint8_t)r3;
+label_2:
+    // EBPF_OP_LDXB pc=140 dst=r2 src=r6 offset=5 imm=0
+#line 15 "sample/./xdp_common.h"
+    r2 = *(uint8_t*)(uintptr_t)(r6 + OFFSET(5));
+    // EBPF_OP_LSH64_IMM pc=141 dst=r2 src=r0 offset=0 imm=8
+#line 15 "sample/./xdp_common.h"
+    r2 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=142 dst=r3 src=r6 offset=4 imm=0
+#line 15 "sample/./xdp_common.h"
+    r3 = *(uint8_t*)(uintptr_t)(r6 + OFFSET(4));
+    // EBPF_OP_OR64_REG pc=143 dst=r2 src=r3 offset=0 imm=0
+#line 15 "sample/./xdp_common.h"
+    r2 |= r3;
+    // EBPF_OP_STXH pc=144 dst=r10 src=r2 offset=-68 imm=0
+#line 15 "sample/./xdp_common.h"
+    *(uint16_t*)(uintptr_t)(r10 + OFFSET(-68)) = (uint16_t)r2;
+    // EBPF_OP_LDXB pc=145 dst=r2 src=r6 offset=1 imm=0
+#line 15 "sample/./xdp_common.h"
+    r2 = *(uint8_t*)(uintptr_t)(r6 + OFFSET(1));
+    // EBPF_OP_LSH64_IMM pc=146 dst=r2 src=r0 offset=0 imm=8
+#line 15 "sample/./xdp_common.h"
+    r2 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=147 dst=r3 src=r6 offset=0 imm=0
+#line 15 "sample/./xdp_common.h"
+    r3 = *(uint8_t*)(uintptr_t)(r6 + OFFSET(0));
+    // EBPF_OP_OR64_REG pc=148 dst=r2 src=r3 offset=0 imm=0
+#line 15 "sample/./xdp_common.h"
+    r2 |= r3;
+    // EBPF_OP_LDXB pc=149 dst=r3 src=r6 offset=3 imm=0
+#line 15 "sample/./xdp_common.h"
+    r3 = *(uint8_t*)(uintptr_t)(r6 + OFFSET(3));
+    // EBPF_OP_LSH64_IMM pc=150 dst=r3 src=r0 offset=0 imm=8
+#line 15 "sample/./xdp_common.h"
+    r3 <<= (IMMEDIATE(8) & 63);
+    // EBPF_OP_LDXB pc=151 dst=r4 src=r6 offset=2 imm=0
+#line 15 "sample/./xdp_common.h"
+    r4 = *(uint8_t*)(uintptr_t)(r6 + OFFSET(2));
+    // EBPF_OP_OR64_REG pc=152 dst=r3 src=r4 offset=0 imm=0
+#line 15 "sample/./xdp_common.h"
+    r3 |= r4;
+    // EBPF_OP_LSH64_IMM pc=153 dst=r3 src=r0 offset=0 imm=16
+#line 15 "sample/./xdp_common.h"
+    r3 <<= (IMMEDIATE(16) & 63);
+    // EBPF_OP_OR64_REG pc=154 dst=r3 src=r2 offset=0 imm=0
+#line 15 "sample/./xdp_common.h"
+    r3 |= r2;
+    // EBPF_OP_STXW pc=155 dst=r10 src=r3 offset=-72 imm=0
+#line 15 "sample/./xdp_common.h"
+    *(uint32_t*)(uintptr_t)(r10 + OFFSET(-72)) = (uint32_t)r3;
+    // EBPF_OP_LDXH pc=156 dst=r2 src=r6 offset=6 imm=0
+#line 16 "sample/./xdp_common.h"
+    r2 = *(uint16_t*)(uintptr_t)(r6 + OFFSET(6));
+    // EBPF_OP_STXH pc=157 dst=r6 src=r2 offset=0 imm=0
+#line 16 "sample/./xdp_common.h"
+    *(uint16_t*)(uintptr_t)(r6 + OFFSET(0)) = (uint16_t)r2;
+    // EBPF_OP_LDXH pc=158 dst=r2 src=r6 offset=8 imm=0
+#line 16 "sample/./xdp_common.h"
+    r2 = *(uint16_t*)(uintptr_t)(r6 + OFFSET(8));
+    // EBPF_OP_STXH pc=159 dst=r6 src=r2 offset=2 imm=0
+#line 16 "sample/./xdp_common.h"
+    *(uint16_t*)(uintptr_t)(r6 + OFFSET(2)) = (uint16_t)r2;
+    // EBPF_OP_LDXH pc=160 dst=r2 src=r6 offset=10 imm=0
+#line 16 "sample/./xdp_common.h"
+    r2 = *(uint16_t*)(uintptr_t)(r6 + OFFSET(10));
+    // EBPF_OP_STXH pc=161 dst=r6 src=r2 offset=4 imm=0
+#line 16 "sample/./xdp_common.h"
+    *(uint16_t*)(uintptr_t)(r6 + OFFSET(4)) = (uint16_t)r2;
+    // EBPF_OP_LDXW pc=162 dst=r2 src=r10 offset=-72 imm=0
+#line 17 "sample/./xdp_common.h"
+    r2 = *(uint32_t*)(uintptr_t)(r10 + OFFSET(-72));
+    // EBPF_OP_MOV64_REG pc=163 dst=r3 src=r2 offset=0 imm=0
+#line 17 "sample/./xdp_common.h"
+    r3 = r2;
+    // EBPF_OP_RSH64_IMM pc=164 dst=r3 src=r0 offset=0 imm=16
+#line 17 "sample/./xdp_common.h"
+    r3 >>= (IMMEDIATE(16) & 63);
+    // EBPF_OP_STXB pc=165 dst=r6 src=r3 offset=8 imm=0
+#line 17 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r6 + OFFSET(8)) = (uint8_t)r3;
+    // EBPF_OP_MOV64_REG pc=166 dst=r3 src=r2 offset=0 imm=0
+#line 17 "sample/./xdp_common.h"
+    r3 = r2;
+    // EBPF_OP_RSH64_IMM pc=167 dst=r3 src=r0 offset=0 imm=24
+#line 17 "sample/./xdp_common.h"
+    r3 >>= (IMMEDIATE(24) & 63);
+    // EBPF_OP_STXB pc=168 dst=r6 src=r3 offset=9 imm=0
+#line 17 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r6 + OFFSET(9)) = (uint8_t)r3;
+    // EBPF_OP_STXB pc=169 dst=r6 src=r2 offset=6 imm=0
+#line 17 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r6 + OFFSET(6)) = (uint8_t)r2;
+    // EBPF_OP_RSH64_IMM pc=170 dst=r2 src=r0 offset=0 imm=8
+#line 17 "sample/./xdp_common.h"
+    r2 >>= (IMMEDIATE(8) & 63);
+    // EBPF_OP_STXB pc=171 dst=r6 src=r2 offset=7 imm=0
+#line 17 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r6 + OFFSET(7)) = (uint8_t)r2;
+    // EBPF_OP_LDXH pc=172 dst=r2 src=r10 offset=-68 imm=0
+#line 17 "sample/./xdp_common.h"
+    r2 = *(uint16_t*)(uintptr_t)(r10 + OFFSET(-68));
+    // EBPF_OP_STXB pc=173 dst=r6 src=r2 offset=10 imm=0
+#line 17 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r6 + OFFSET(10)) = (uint8_t)r2;
+    // EBPF_OP_RSH64_IMM pc=174 dst=r2 src=r0 offset=0 imm=8
+#line 17 "sample/./xdp_common.h"
+    r2 >>= (IMMEDIATE(8) & 63);
+    // EBPF_OP_STXB pc=175 dst=r6 src=r2 offset=11 imm=0
+#line 17 "sample/./xdp_common.h"
+    *(uint8_t*)(uintptr_t)(r6 + OFFSET(11)) = (uint8_t)r2;
+    // EBPF_OP_LDXH pc=176 dst=r2 src=r1 offset=2 imm=0
+#line 40 "sample/./xdp_common.h"
+    r2 = *(uint16_t*)(uintptr_t)(r1 + OFFSET(2));
+    // EBPF_OP_LDXH pc=177 dst=r3 src=r1 offset=0 imm=0
+#line 41 "sample/./xdp_common.h"
+    r3 = *(uint16_t*)(uintptr_t)(r1 + OFFSET(0));
+    // EBPF_OP_STXH pc=178 dst=r1 src=r3 offset=2 imm=0
+#line 41 "sample/./xdp_common.h"
+    *(uint16_t*)(uintptr_t)(r1 + OFFSET(2)) = (uint16_t)r3;
+    // EBPF_OP_STXH pc=179 dst=r1 src=r2 offset=0 imm=0
+#line 42 "sample/./xdp_common.h"
+    *(uint16_t*)(uintptr_t)(r1 + OFFSET(0)) = (uint16_t)r2;
+    // EBPF_OP_MOV64_IMM pc=180 dst=r0 src=r0 offset=0 imm=3
+#line 63 "sample/reflect_packet_parsed.c"
+    r0 = IMMEDIATE(3);
+label_3:
+    // EBPF_OP_EXIT pc=181 dst=r0 src=r0 offset=0 imm=0
+#line 66 "sample/reflect_packet_parsed.c"
+    return r0;
+#line 66 "sample/reflect_packet_parsed.c"
+}
+#pragma code_seg(pop)
+#line __LINE__ __FILE__
+
+#pragma data_seg(push, "programs")
+static program_entry_t _programs[] = {
+    {
+        0,
+        reflect_packet_parsed,
+        "xdp_te~1",
+        "xdp_test/reflect",
+        "reflect_packet_parsed",
+        NULL,
+        0,
+        reflect_packet_parsed_helpers,
+        1,
+        182,
+        &reflect_packet_parsed_program_type_guid,
+        &reflect_packet_parsed_attach_type_guid,
+    },
+};
+#pragma data_seg(pop)
+
+static void
+_get_programs(_Outptr_result_buffer_(*count) program_entry_t** programs, _Out_ size_t* count)
+{
+    *programs = _programs;
+    *count = 1;
+}
+
+static void
+_get_version(_Out_ bpf2c_version_t* version)
+{
+    version->major = 0;
+    version->minor = 17;
+    version->revision = 0;
+}
+
+static void
+_get_map_initial_values(_Outptr_result_buffer_(*count) map_initial_values_t** map_initial_values, _Out_ size_t* count)
+{
+    *map_initial_values = NULL;
+    *count = 0;
+}
+
+metadata_table_t reflect_packet_parsed_metadata_table = {
+    sizeof(metadata_table_t), _get_programs, _get_maps, _get_hash, _get_version, _get_map_initial_values};
@@ -4,6 +4,7 @@
 #define CATCH_CONFIG_MAIN
 
 #include "bpf_code_generator.h"
+#include "byte_code_optimizer.h"
 #include "catch_wrapper.hpp"
 #include "test_helpers.h"
 #include "watchdog.h"
@@ -197,6 +198,50 @@ run_ubpf_interpret_test(const std::string& data_file)
 
     ubpf_destroy(vm);
 }
+
+uint64_t
+run_ubpf_interpreter(const std::vector<ebpf_inst>& instructions, std::vector<uint8_t> input_buffer)
+{
+    ubpf_vm* vm = prepare_ubpf_vm(instructions);
+    uint64_t result;
+    REQUIRE(ubpf_exec(vm, input_buffer.data(), input_buffer.size(), &result) == 0);
+    ubpf_destroy(vm);
+    return result;
+}
+
+std::vector<ebpf_inst>
+optimize_instructions(const std::vector<ebpf_inst>& instructions, byte_code_optimizer_statistics_t& statistics)
+{
+    std::vector<ebpf_inst> optimized = instructions;
+    uint32_t instruction_count = static_cast<uint32_t>(optimized.size());
+    optimize_byte_code(optimized.data(), &instruction_count, &statistics);
+    REQUIRE(instruction_count <= instructions.size());
+    REQUIRE(statistics.instructions_removed == instructions.size() - instruction_count);
+    optimized.resize(instruction_count);
+    return optimized;
+}
+
+void
+run_ubpf_optimized_test(const std::string& data_file)
+{
+    auto [prefix, mem, result, instructions] = parse_test_file(data_file);
+    byte_code_optimizer_statistics_t statistics;
+    std::vector<ebpf_inst> optimized = optimize_instructions(instructions, statistics);
+
+    std::vector<uint8_t> input_buffer;
+
+    if (!mem.empty()) {
+        std::stringstream ss(mem);
+        uint32_t value;
+        while (ss >> std::hex >> value) {
+            input_buffer.push_back(static_cast<uint8_t>(value));
+        }
+    }
+
+    uint64_t expected_result = std::stoull(result, nullptr, 16);
+
+    REQUIRE(run_ubpf_interpreter(optimized, input_buffer) == expected_result);
+}
 #endif
 
 void
@@ -258,10 +303,24 @@ run_bpf_code_generator_test(const std::string& data_file)
 #define DECLARE_INTERPRET_TEST(FILE)
 #endif
 
-#define DECLARE_TEST(FILE)    \
-    DECLARE_NATIVE_TEST(FILE) \
-    DECLARE_JIT_TEST(FILE)    \
-    DECLARE_INTERPRET_TEST(FILE)
+// Runs the byte code through the optimizer that precedes JIT compilation and checks that the interpreter still
+// produces the expected result.
+#if !defined(CONFIG_BPF_INTERPRETER_DISABLED)
+#define DECLARE_OPTIMIZED_TEST(FILE)                                                                                  \
+    TEST_CASE(FILE "_optimized", "[byte_code_optimizer]")                                                             \
+    {                                                                                                                 \
+        run_ubpf_optimized_test(".." SEPARATOR ".." SEPARATOR "external" SEPARATOR "ubpf" SEPARATOR "tests" SEPARATOR \
+                                "" FILE ".data");                                                                     \
+    }
+#else
+#define DECLARE_OPTIMIZED_TEST(FILE)
+#endif
+
+#define DECLARE_TEST(FILE)       \
+    DECLARE_NATIVE_TEST(FILE)    \
+    DECLARE_JIT_TEST(FILE)       \
+    DECLARE_INTERPRET_TEST(FILE) \
+    DECLARE_OPTIMIZED_TEST(FILE)
 
 // Tests are dependent on the collateral from the https://github.com/iovisor/ubpf project.
 // Most uBPF tests are declared as a block of assembly, an expected result and a block of memory
@@ -478,6 +537,66 @@ TEST_CASE("invalid register", "[raw_bpf_code_gen][negative]")
     verify_invalid_opcode_sequence({{EBPF_OP_DIV_REG, 15, 14, 0, 0}}, "invalid register id");
 }
 
+TEST_CASE("local call invalid target", "[raw_bpf_code_gen][negative]")
+{
+    // Call target > end of program
+    verify_invalid_opcode_sequence(
+        {{EBPF_OP_CALL, 0, 1, 0, 5}, {EBPF_OP_EXIT, 0, 0, 0, 0}}, "invalid call target at offset 0");
+}
+
+TEST_CASE("local call jump across function boundary", "[raw_bpf_code_gen][negative]")
+{
+    // Jump from the main program into the subprogram starting at offset 3
+    verify_invalid_opcode_sequence(
+        {{EBPF_OP_JA, 0, 0, 2, 0},
+         {EBPF_OP_CALL, 0, 1, 0, 1},
+         {EBPF_OP_EXIT, 0, 0, 0, 0},
+         {EBPF_OP_MOV64_IMM, 0, 0, 0, 0},
+         {EBPF_OP_EXIT, 0, 0, 0, 0}},
+        "invalid jump target at offset 0");
+}
+
+TEST_CASE("local call tail call from subprogram", "[raw_bpf_code_gen][negative]")
+{
+    // Helper 5 is bpf_tail_call
+    verify_invalid_opcode_sequence(
+        {{EBPF_OP_CALL, 0, 1, 0, 1},
+         {EBPF_OP_EXIT, 0, 0, 0, 0},
+         {EBPF_OP_CALL, 0, 0, 0, 5},
+         {EBPF_OP_EXIT, 0, 0, 0, 0}},
+        "tail calls from subprograms are not supported at offset 2");
+}
+
+TEST_CASE("local call", "[raw_bpf_code_gen]")
+{
+    // r0 = subprogram(5), where the subprogram returns r1 + 1 and stores to an 8 byte stack slot.
+    bpf_code_generator code(
+        "test",
+        {{EBPF_OP_MOV64_IMM, 1, 0, 0, 5},
+         {EBPF_OP_CALL, 0, 1, 0, 1},
+         {EBPF_OP_EXIT, 0, 0, 0, 0},
+         {EBPF_OP_MOV64_REG, 0, 1, 0, 0},
+         {EBPF_OP_ADD64_IMM, 0, 0, 0, 1},
+         {EBPF_OP_STXDW, 10, 0, -8, 0},
+         {EBPF_OP_EXIT, 0, 0, 0, 0}});
+    code.generate("test", "test");
+    std::stringstream stream;
+    code.emit_c_code(stream);
+    std::string c_code = stream.str();
+
+    std::string signature =
+        "static uint64_t\ntest_subprogram_3(uint64_t r1, uint64_t r2, uint64_t r3, uint64_t r4, uint64_t r5)";
+    REQUIRE(c_code.find(signature + ";") != std::string::npos);
+    REQUIRE(c_code.find(signature + "\n{") != std::string::npos);
+    REQUIRE(c_code.find("r0 = test_subprogram_3(r1, r2, r3, r4, r5);") != std::string::npos);
+
+    // The subprogram only reserves the stack it uses.
+    std::string subprogram = c_code.substr(c_code.find(signature + "\n{"));
+    REQUIRE(subprogram.find("uint64_t stack[1];") != std::string::npos);
+    REQUIRE(subprogram.find("(void)r2;") != std::string::npos);
+    REQUIRE(subprogram.find("r0 += IMMEDIATE(1);") != std::string::npos);
+}
+
 TEST_CASE("invalid ELF stream", "[raw_bpf_code_gen][negative]")
 {
     // An empty stream is not valid
@@ -490,3 +609,97 @@ TEST_CASE("invalid ELF stream", "[raw_bpf_code_gen][negative]")
         REQUIRE(ex.what() == std::string("can't process ELF file test"));
     }
 }
+
+#if !defined(CONFIG_BPF_INTERPRETER_DISABLED)
+TEST_CASE("optimizer constant branch", "[byte_code_optimizer]")
+{
+    // r1 is known when it is compared, so the jump is always taken and the program reduces to r0 = 2.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 0},
+        {EBPF_OP_MOV64_IMM, 1, 0, 0, 5},
+        {EBPF_OP_JEQ_IMM, 1, 0, 1, 5},
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 1},
+        {EBPF_OP_ADD64_IMM, 0, 0, 0, 2},
+        {EBPF_OP_MOV64_REG, 0, 0, 0, 0},
+        {EBPF_OP_EXIT, 0, 0, 0, 0}};
+    byte_code_optimizer_statistics_t statistics;
+    std::vector<ebpf_inst> optimized = optimize_instructions(instructions, statistics);
+
+    REQUIRE(optimized.size() == 2);
+    REQUIRE(optimized[0].opcode == EBPF_OP_MOV64_IMM);
+    REQUIRE(optimized[0].imm == 2);
+    REQUIRE(statistics.branches_folded == 1);
+    REQUIRE(statistics.constants_folded == 1);
+    REQUIRE(run_ubpf_interpreter(instructions, {}) == 2);
+    REQUIRE(run_ubpf_interpreter(optimized, {}) == 2);
+}
+
+TEST_CASE("optimizer repeated comparison", "[byte_code_optimizer]")
+{
+    // The second comparison is the complement of the first one on the only path that reaches it.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 1},
+        {EBPF_OP_LDXB, 2, 1, 0, 0},
+        {EBPF_OP_LDXB, 3, 1, 1, 0},
+        {EBPF_OP_JGT_REG, 2, 3, 3, 0},
+        {EBPF_OP_JLE_REG, 2, 3, 1, 0},
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 2},
+        {EBPF_OP_EXIT, 0, 0, 0, 0},
+        {EBPF_OP_MOV64_IMM, 0, 0, 0, 3},
+        {EBPF_OP_EXIT, 0, 0, 0, 0}};
+    byte_code_optimizer_statistics_t statistics;
+    std::vector<ebpf_inst> optimized = optimize_instructions(instructions, statistics);
+
+    REQUIRE(optimized.size() == 7);
+    REQUIRE(statistics.branches_folded == 1);
+    std::vector<std::vector<uint8_t>> inputs = {{1, 2}, {2, 1}, {2, 2}};
+    for (auto& memory : inputs) {
+        REQUIRE(run_ubpf_interpreter(optimized, memory) == run_ubpf_interpreter(instructions, memory));
+    }
+}
+
+TEST_CASE("optimizer repeated constant load", "[byte_code_optimizer]")
+{
+    // The second load of the same 64-bit constant is dropped, and the shift is folded into a constant.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_LDDW, 1, 0, 0, 2},
+        {0, 0, 0, 0, 1},
+        {EBPF_OP_LDDW, 1, 0, 0, 2},
+        {0, 0, 0, 0, 1},
+        {EBPF_OP_MOV64_REG, 0, 1, 0, 0},
+        {EBPF_OP_RSH64_IMM, 0, 0, 0, 32},
+        {EBPF_OP_EXIT, 0, 0, 0, 0}};
+    byte_code_optimizer_statistics_t statistics;
+    std::vector<ebpf_inst> optimized = optimize_instructions(instructions, statistics);
+
+    REQUIRE(optimized.size() == 2);
+    REQUIRE(run_ubpf_interpreter(instructions, {}) == 1);
+    REQUIRE(run_ubpf_interpreter(optimized, {}) == 1);
+}
+
+TEST_CASE("optimizer keeps side effects", "[byte_code_optimizer]")
+{
+    // Stores, helper calls and their arguments are kept even though no register result is used, and jumps over
+    // removed instructions are adjusted.
+    std::vector<ebpf_inst> instructions = {
+        {EBPF_OP_MOV64_IMM, 6, 0, 0, 7},
+        {EBPF_OP_JA, 0, 0, 2, 0},
+        {EBPF_OP_MOV64_IMM, 6, 0, 0, 8},
+        {EBPF_OP_MOV64_IMM, 6, 0, 0, 9},
+        {EBPF_OP_MOV64_IMM, 7, 0, 0, 1},
+        {EBPF_OP_STXB, 1, 6, 0, 0},
+        {EBPF_OP_MOV64_REG, 2, 7, 0, 0},
+        {EBPF_OP_CALL, 0, 0, 0, 1},
+        {EBPF_OP_LDXB, 0, 1, 0, 0},
+        {EBPF_OP_EXIT, 0, 0, 0, 0}};
+    byte_code_optimizer_statistics_t statistics;
+    std::vector<ebpf_inst> optimized = optimize_instructions(instructions, statistics);
+
+    // The unreachable moves, the jump over them and the copy of r7 are removed. Helper 1 xors the byte with 42.
+    REQUIRE(optimized.size() == 6);
+    REQUIRE(optimized[2].opcode == EBPF_OP_MOV64_IMM);
+    REQUIRE(statistics.constants_folded == 1);
+    REQUIRE(run_ubpf_interpreter(instructions, {0}) == (7 ^ 42));
+    REQUIRE(run_ubpf_interpreter(optimized, {0}) == (7 ^ 42));
+}
+#endif
@@ -7,6 +7,7 @@
 #include "catch_wrapper.hpp"
 #include "ebpf_api.h"
 
+#include <chrono>
 #include <iostream>
 
 #define SAMPLE_PATH ""
@@ -68,3 +69,19 @@ TEST_CASE("verify_dsr_program", "[cilium][xdp]")
 {
     verify_program(SAMPLE_PATH "bpf_xdp_dsr.o", CILIUM_XDP_SECTIONS_DSR);
 }
+
+// Report the average time taken to open (parse) each object, which dominates agent start-up for large objects.
+TEST_CASE("open_time", "[.][cilium][performance]")
+{
+    const int iterations = 20;
+    for (const char* file : {SAMPLE_PATH "bpf_xdp_snat.o", SAMPLE_PATH "bpf_xdp_dsr.o"}) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            struct bpf_object* object = bpf_object__open(file);
+            REQUIRE(object != nullptr);
+            bpf_object__close(object);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << file << ": " << elapsed.count() / iterations << " us per open" << std::endl;
+    }
+}
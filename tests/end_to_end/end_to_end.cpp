@@ -1709,7 +1709,8 @@ TEST_CASE("create_map_name", "[end_to_end]")
 }
 
 static void
-_xdp_reflect_packet_test(ebpf_execution_type_t execution_type, ADDRESS_FAMILY address_family)
+_xdp_reflect_packet_test(
+    ebpf_execution_type_t execution_type, ADDRESS_FAMILY address_family, const char* program_name = "reflect_packet")
 {
     _test_helper_end_to_end test_helper;
     test_helper.initialize();
@@ -1718,10 +1719,10 @@ _xdp_reflect_packet_test(ebpf_execution_type_t execution_type, ADDRESS_FAMILY ad
     program_info_provider_t xdp_program_info;
     REQUIRE(xdp_program_info.initialize(EBPF_PROGRAM_TYPE_XDP_TEST) == EBPF_SUCCESS);
     uint32_t ifindex = 0;
-    const char* file_name = (execution_type == EBPF_EXECUTION_NATIVE ? "reflect_packet_um.dll" : "reflect_packet.o");
+    std::string file_name = std::string(program_name) + (execution_type == EBPF_EXECUTION_NATIVE ? "_um.dll" : ".o");
     program_load_attach_helper_t program_helper;
     program_helper.initialize(
-        file_name, BPF_PROG_TYPE_XDP_TEST, "reflect_packet", execution_type, &ifindex, sizeof(ifindex), hook);
+        file_name.c_str(), BPF_PROG_TYPE_XDP_TEST, program_name, execution_type, &ifindex, sizeof(ifindex), hook);
 
     // Dummy UDP datagram with fake IP and MAC addresses.
     udp_packet_t packet(address_family);
@@ -1760,6 +1761,18 @@ _xdp_reflect_packet_test_v6(ebpf_execution_type_t execution_type)
     _xdp_reflect_packet_test(execution_type, AF_INET6);
 }
 
+static void
+_xdp_reflect_packet_parsed_test_v4(ebpf_execution_type_t execution_type)
+{
+    _xdp_reflect_packet_test(execution_type, AF_INET, "reflect_packet_parsed");
+}
+
+static void
+_xdp_reflect_packet_parsed_test_v6(ebpf_execution_type_t execution_type)
+{
+    _xdp_reflect_packet_test(execution_type, AF_INET6, "reflect_packet_parsed");
+}
+
 static void
 _xdp_encap_reflect_packet_test(ebpf_execution_type_t execution_type, ADDRESS_FAMILY address_family)
 {
@@ -1881,8 +1894,29 @@ TEST_CASE("printk", "[end_to_end]")
 }
 #endif
 
+TEST_CASE("printk_deferred_format", "[end_to_end]")
+{
+    char output[64];
+    uint64_t arguments[] = {0xFFFFFFFFFFFFFFFF, 0x100000002, 42};
+
+    REQUIRE(ebpf_format_deferred_printk("Hello, world", 0, nullptr, output, sizeof(output)) == EBPF_SUCCESS);
+    REQUIRE(std::string(output) == "Hello, world");
+
+    // Only %ll consumes all 64 bits of an argument, matching the text path.
+    REQUIRE(ebpf_format_deferred_printk("%d %lx %llu", 3, arguments, output, sizeof(output)) == EBPF_SUCCESS);
+    REQUIRE(std::string(output) == "-1 2 42");
+    REQUIRE(ebpf_format_deferred_printk("%lld 100%%", 1, arguments, output, sizeof(output)) == EBPF_SUCCESS);
+    REQUIRE(std::string(output) == "-1 100%");
+
+    REQUIRE(ebpf_format_deferred_printk("%d", 0, nullptr, output, sizeof(output)) == EBPF_INVALID_ARGUMENT);
+    REQUIRE(ebpf_format_deferred_printk("%s", 1, arguments, output, sizeof(output)) == EBPF_INVALID_ARGUMENT);
+    REQUIRE(ebpf_format_deferred_printk("Hello, world", 0, nullptr, output, 4) == EBPF_INSUFFICIENT_BUFFER);
+}
+
 DECLARE_ALL_TEST_CASES("xdp-reflect-v4", "[xdp_tests]", _xdp_reflect_packet_test_v4);
 DECLARE_ALL_TEST_CASES("xdp-reflect-v6", "[xdp_tests]", _xdp_reflect_packet_test_v6);
+DECLARE_ALL_TEST_CASES("xdp-reflect-parsed-v4", "[xdp_tests]", _xdp_reflect_packet_parsed_test_v4);
+DECLARE_ALL_TEST_CASES("xdp-reflect-parsed-v6", "[xdp_tests]", _xdp_reflect_packet_parsed_test_v6);
 DECLARE_ALL_TEST_CASES("xdp-encap-reflect-v4", "[xdp_tests]", _xdp_encap_reflect_packet_test_v4);
 DECLARE_ALL_TEST_CASES("xdp-encap-reflect-v6", "[xdp_tests]", _xdp_encap_reflect_packet_test_v6);
 
@@ -2429,6 +2463,144 @@ _map_reuse_3_test(ebpf_execution_type_t execution_type)
 
 DECLARE_JIT_TEST_CASES("map_reuse_3", "[end_to_end]", _map_reuse_3_test);
 
+// Measure how long it takes to create and pin the maps of a native module with a large number of maps. For comparison,
+// also time pinning the module's pinned maps one at a time, as the native loader used to, and as a single batch.
+TEST_CASE("native_many_maps_load_time", "[.][end_to_end][performance]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+    program_info_provider_t sample_program_info;
+    REQUIRE(sample_program_info.initialize(EBPF_PROGRAM_TYPE_SAMPLE) == EBPF_SUCCESS);
+
+    // Keep in sync with tests/sample/undocked/many_maps.c.
+    const size_t expected_map_count = 256 + 32 + 16 * 2;
+    const size_t expected_pinned_map_count = 32;
+    const int iterations = 20;
+    std::chrono::microseconds total_load_time{0};
+    std::chrono::microseconds total_per_map_pin_time{0};
+    std::chrono::microseconds total_batch_pin_time{0};
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        bpf_object* object = bpf_object__open("many_maps_um.dll");
+        REQUIRE(object != nullptr);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        REQUIRE(bpf_object__load(object) == 0);
+        auto end = std::chrono::high_resolution_clock::now();
+        total_load_time += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        size_t map_count = 0;
+        std::vector<ebpf_handle_t> pinned_map_handles;
+        std::vector<std::string> pin_paths;
+        bpf_map* map;
+        bpf_object__for_each_map(map, object)
+        {
+            REQUIRE(bpf_map__fd(map) > 0);
+            map_count++;
+            std::string name = bpf_map__name(map);
+            if (name.starts_with("pinned_")) {
+                pinned_map_handles.push_back((ebpf_handle_t)Platform::_get_osfhandle(bpf_map__fd(map)));
+                pin_paths.push_back("/ebpf/global/" + name);
+            }
+        }
+        REQUIRE(map_count == expected_map_count);
+        REQUIRE(pinned_map_handles.size() == expected_pinned_map_count);
+
+        std::vector<cxplat_utf8_string_t> paths;
+        for (const auto& pin_path : pin_paths) {
+            paths.push_back({(uint8_t*)pin_path.data(), pin_path.size()});
+        }
+        auto unpin_all = [&]() {
+            // The maps pinned by name must have been pinned, so each unpin must succeed.
+            for (const auto& pin_path : pin_paths) {
+                REQUIRE(ebpf_object_unpin(pin_path.c_str()) == EBPF_SUCCESS);
+            }
+        };
+        unpin_all();
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t index = 0; index < paths.size(); index++) {
+            REQUIRE(ebpf_core_update_pinning(pinned_map_handles[index], &paths[index]) == EBPF_SUCCESS);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        total_per_map_pin_time += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        unpin_all();
+
+        start = std::chrono::high_resolution_clock::now();
+        REQUIRE(ebpf_core_pin_objects(paths.size(), pinned_map_handles.data(), paths.data()) == EBPF_SUCCESS);
+        end = std::chrono::high_resolution_clock::now();
+        total_batch_pin_time += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        unpin_all();
+
+        bpf_object__close(object);
+    }
+
+    WARN(
+        "native_many_maps: map_count=" << expected_map_count << " load_us=" << total_load_time.count() / iterations
+                                       << " per_map_pin_us=" << total_per_map_pin_time.count() / iterations
+                                       << " batch_pin_us=" << total_batch_pin_time.count() / iterations);
+}
+
+#if !defined(CONFIG_BPF_JIT_DISABLED)
+// Measure how long it takes to JIT load an object with several programs and maps, and check that the maps and helpers
+// of each program are resolved with one IOCTL instead of one per map plus one per kind of resolution.
+TEST_CASE("jit_multi_program_load_time", "[end_to_end]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+    program_info_provider_t bind_program_info;
+    REQUIRE(bind_program_info.initialize(EBPF_PROGRAM_TYPE_BIND) == EBPF_SUCCESS);
+
+    const int iterations = 20;
+    std::chrono::microseconds total_load_time{0};
+    size_t total_ioctl_count = 0;
+    size_t program_count = 0;
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        const char* error_message = nullptr;
+        bpf_object_ptr unique_object;
+        fd_t program_fd;
+
+        reset_ioctl_counts();
+        auto start = std::chrono::high_resolution_clock::now();
+        int result = ebpf_program_load(
+            "bindmonitor_tailcall.o",
+            BPF_PROG_TYPE_UNSPEC,
+            EBPF_EXECUTION_JIT,
+            &unique_object,
+            &program_fd,
+            &error_message);
+        auto end = std::chrono::high_resolution_clock::now();
+        if (error_message) {
+            printf("ebpf_program_load failed with %s\n", error_message);
+            ebpf_free((void*)error_message);
+        }
+        REQUIRE(result == 0);
+        total_load_time += std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        total_ioctl_count += get_total_ioctl_count();
+
+        program_count = 0;
+        bpf_program* program;
+        bpf_object__for_each_program(program, unique_object.get())
+        {
+            program_count++;
+        }
+        REQUIRE(program_count > 1);
+        REQUIRE(get_ioctl_count(EBPF_OPERATION_RESOLVE_PROGRAM) == program_count);
+        REQUIRE(get_ioctl_count(EBPF_OPERATION_RESOLVE_HELPER) == 0);
+        REQUIRE(get_ioctl_count(EBPF_OPERATION_RESOLVE_MAP) == 0);
+        REQUIRE(get_ioctl_count(EBPF_OPERATION_GET_EC_FUNCTION) == 0);
+    }
+
+    printf("jit_multi_program_load,program_count,load_us,ioctl_count\n");
+    printf(
+        "jit_multi_program_load,%zu,%lld,%zu\n",
+        program_count,
+        total_load_time.count() / iterations,
+        total_ioctl_count / iterations);
+}
+#endif
+
 static void
 _create_service_helper(
     _In_z_ const wchar_t* file_name,
@@ -8,6 +8,7 @@
 #include "ebpf_platform.h"
 #include "ebpf_program_types.h"
 #include "net_ebpf_ext_program_info.h"
+#include "net_ebpf_ext_xdp_parse.h"
 #include "sample_ext_program_info.h"
 #include "usersim/ke.h"
 
@@ -343,16 +344,33 @@ typedef class xdp_md_helper : public xdp_md_t
         _original_nb.MdlChain = &_original_mdl;
         _original_mdl.byte_count = (unsigned long)packet.size();
         _original_mdl.start_va = packet.data();
+        data_meta = (uint64_t)(uintptr_t)data;
+    }
+
+    int
+    adjust_meta(int delta)
+    {
+        int64_t metadata_length = (int64_t)_metadata_length - delta;
+        if (metadata_length < 0 || metadata_length > XDP_METADATA_MAX || (metadata_length % sizeof(uint32_t)) != 0 ||
+            (size_t)metadata_length > _begin) {
+            return -1;
+        }
+        _metadata_length = (size_t)metadata_length;
+        data_meta = (uint64_t)(uintptr_t)((uint8_t*)data - _metadata_length);
+        return 0;
     }
 
     int
     adjust_head(int delta)
     {
         int return_value = 0;
+        uint8_t metadata[XDP_METADATA_MAX];
         if (delta == 0)
             // Nothing changes.
             goto Done;
 
+        memcpy(metadata, _packet->data() + _begin - _metadata_length, _metadata_length);
+
         if (delta > 0) {
             if (_begin + delta > _end) {
                 return_value = -1;
@@ -376,9 +394,14 @@ typedef class xdp_md_helper : public xdp_md_t
                 _end += additional_space_needed;
             }
         }
-        // Adjust xdp_md data pointers.
+        // Adjust xdp_md data pointers, keeping the metadata in front of data if it still fits.
         data = _packet->data() + _begin;
         data_end = _packet->data() + _end;
+        if (_metadata_length > _begin) {
+            _metadata_length = 0;
+        }
+        memcpy(_packet->data() + _begin - _metadata_length, metadata, _metadata_length);
+        data_meta = (uint64_t)(uintptr_t)((uint8_t*)data - _metadata_length);
     Done:
         return return_value;
     }
@@ -392,6 +415,7 @@ typedef class xdp_md_helper : public xdp_md_t
     std::vector<uint8_t>* _packet;
     size_t _begin;
     size_t _end;
+    size_t _metadata_length = 0;
 } xdp_md_helper_t;
 
 typedef class _test_xdp_helper
@@ -402,6 +426,24 @@ typedef class _test_xdp_helper
     {
         return ((xdp_md_helper_t*)ctx)->adjust_head(delta);
     }
+
+    static int
+    adjust_meta(_In_ const xdp_md_t* ctx, int delta)
+    {
+        return ((xdp_md_helper_t*)ctx)->adjust_meta(delta);
+    }
+
+    static int
+    parse_headers(_In_ const xdp_md_t* ctx, _Out_writes_bytes_(size) xdp_headers_t* headers, uint32_t size)
+    {
+        if (size != sizeof(xdp_headers_t)) {
+            return -1;
+        }
+        // There is no NBL in the mock, so no out-of-band information is available.
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(ctx->data);
+        return net_ebpf_ext_xdp_parse_headers(
+            data, reinterpret_cast<const uint8_t*>(ctx->data_end) - data, 0, 0, headers);
+    }
 } test_xdp_helper_t;
 
 // These are test xdp context creation functions.
@@ -428,6 +470,9 @@ _xdp_context_create(
         xdp_md_t* provided_context = (xdp_md_t*)context_in;
         xdp_context->ingress_ifindex = provided_context->ingress_ifindex;
         xdp_context->data_meta = provided_context->data_meta;
+        xdp_context->rx_hash = provided_context->rx_hash;
+        xdp_context->rx_hash_type = provided_context->rx_hash_type;
+        xdp_context->rx_queue_index = provided_context->rx_queue_index;
     }
 
     xdp_context->data = (void*)data_in;
@@ -469,6 +514,9 @@ _xdp_context_destroy(
         xdp_md_t* provided_context = (xdp_md_t*)context_out;
         provided_context->ingress_ifindex = xdp_context->ingress_ifindex;
         provided_context->data_meta = xdp_context->data_meta;
+        provided_context->rx_hash = xdp_context->rx_hash;
+        provided_context->rx_hash_type = xdp_context->rx_hash_type;
+        provided_context->rx_queue_index = xdp_context->rx_queue_index;
         *context_size_out = sizeof(xdp_md_t);
     }
 
@@ -609,7 +657,10 @@ _sample_test_context_destroy(
 // program info provider data for various program types.
 
 // Mock implementation of XDP.
-static const void* _mock_xdp_helper_functions[] = {(void*)&test_xdp_helper_t::adjust_head};
+static const void* _mock_xdp_helper_functions[] = {
+    (void*)&test_xdp_helper_t::adjust_head,
+    (void*)&test_xdp_helper_t::adjust_meta,
+    (void*)&test_xdp_helper_t::parse_headers};
 
 static ebpf_helper_function_addresses_t _mock_xdp_helper_function_address_table = {
     EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
@@ -647,7 +698,25 @@ static ebpf_program_data_t _ebpf_xdp_test_program_data = {
     _xdp_context_destroy};
 
 // Bind.
-static ebpf_program_data_t _ebpf_bind_program_data = {EBPF_PROGRAM_DATA_HEADER, &_ebpf_bind_program_info, NULL};
+static uint64_t
+_ebpf_bind_get_current_app_id(_In_ const bind_md_t* ctx)
+{
+    UNREFERENCED_PARAMETER(ctx);
+    return 0;
+}
+
+static const void* _ebpf_bind_global_helper_functions[] = {(void*)_ebpf_bind_get_current_app_id};
+
+static ebpf_helper_function_addresses_t _ebpf_bind_global_helper_function_address_table = {
+    EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
+    EBPF_COUNT_OF(_ebpf_bind_global_helper_functions),
+    (uint64_t*)_ebpf_bind_global_helper_functions};
+
+static ebpf_program_data_t _ebpf_bind_program_data = {
+    .header = EBPF_PROGRAM_DATA_HEADER,
+    .program_info = &_ebpf_bind_program_info,
+    .global_helper_function_addresses = &_ebpf_bind_global_helper_function_address_table,
+};
 
 // SOCK_ADDR.
 static int
@@ -687,6 +756,13 @@ _ebpf_sock_addr_get_socket_cookie(_In_ const bpf_sock_addr_t* ctx)
     return 0;
 }
 
+static uint64_t
+_ebpf_sock_addr_get_current_app_id(_In_ const bpf_sock_addr_t* ctx)
+{
+    UNREFERENCED_PARAMETER(ctx);
+    return 0;
+}
+
 static ebpf_result_t
 _ebpf_sock_addr_context_create(
     _In_reads_bytes_opt_(data_size_in) const uint8_t* data_in,
@@ -763,7 +839,8 @@ static ebpf_helper_function_addresses_t _ebpf_sock_addr_specific_helper_function
 static const void* _ebpf_sock_addr_global_helper_functions[] = {
     (void*)_ebpf_sock_addr_get_current_logon_id,
     (void*)_ebpf_sock_addr_is_current_admin,
-    (void*)_ebpf_sock_addr_get_socket_cookie};
+    (void*)_ebpf_sock_addr_get_socket_cookie,
+    (void*)_ebpf_sock_addr_get_current_app_id};
 
 static ebpf_helper_function_addresses_t _ebpf_sock_addr_global_helper_function_address_table = {
     EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
@@ -844,9 +921,24 @@ _ebpf_sock_ops_context_destroy(
     return;
 }
 
+static uint64_t
+_ebpf_sock_ops_get_current_app_id(_In_ const bpf_sock_ops_t* ctx)
+{
+    UNREFERENCED_PARAMETER(ctx);
+    return 0;
+}
+
+static const void* _ebpf_sock_ops_global_helper_functions[] = {(void*)_ebpf_sock_ops_get_current_app_id};
+
+static ebpf_helper_function_addresses_t _ebpf_sock_ops_global_helper_function_address_table = {
+    EBPF_HELPER_FUNCTION_ADDRESSES_HEADER,
+    EBPF_COUNT_OF(_ebpf_sock_ops_global_helper_functions),
+    (uint64_t*)_ebpf_sock_ops_global_helper_functions};
+
 static ebpf_program_data_t _ebpf_sock_ops_program_data = {
     .header = EBPF_PROGRAM_DATA_HEADER,
     .program_info = &_ebpf_sock_ops_program_info,
+    .global_helper_function_addresses = &_ebpf_sock_ops_global_helper_function_address_table,
     .context_create = &_ebpf_sock_ops_context_create,
     .context_destroy = &_ebpf_sock_ops_context_destroy,
     .required_irql = DISPATCH_LEVEL,
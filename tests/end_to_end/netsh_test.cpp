@@ -7,6 +7,7 @@
 #include "bpf/libbpf.h"
 #pragma warning(pop)
 #include "cxplat_fault_injection.h"
+#include "ebpf_api.h"
 #include "ebpf_epoch.h"
 #include "netsh_test_helper.h"
 #include "platform.h"
@@ -770,6 +771,40 @@ TEST_CASE("show maps", "[netsh][maps]")
                   "=======  ==================  ====  =====  =======  =====  ====  ========\n");
 }
 
+TEST_CASE("show maps verbose", "[netsh][maps]")
+{
+    _test_helper_netsh test_helper;
+    test_helper.initialize();
+
+    bpf_map_create_opts opts = {0};
+    opts.map_flags = BPF_F_STATISTICS;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, "stats_map", sizeof(uint32_t), sizeof(uint32_t), 2, &opts);
+    REQUIRE(map_fd > 0);
+    uint32_t key = 0;
+    uint32_t value = 0;
+    REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == 0);
+    key = 1;
+    REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == -ENOENT);
+
+    int result;
+    std::string output = _run_netsh_command(handle_ebpf_show_maps, L"level=verbose", nullptr, nullptr, &result);
+    REQUIRE(result == NO_ERROR);
+    REQUIRE(output.find("Name                : stats_map\n") != std::string::npos);
+    REQUIRE(output.find("Entries             : 1\n") != std::string::npos);
+    REQUIRE(output.find("Lookups             : 2\n") != std::string::npos);
+    REQUIRE(output.find("Lookup hits         : 1\n") != std::string::npos);
+    REQUIRE(output.find("Lookup misses       : 1\n") != std::string::npos);
+    REQUIRE(output.find("Updates             : 1\n") != std::string::npos);
+
+    REQUIRE(ebpf_map_set_statistics(map_fd, false) == EBPF_SUCCESS);
+    output = _run_netsh_command(handle_ebpf_show_maps, L"level=verbose", nullptr, nullptr, &result);
+    REQUIRE(result == NO_ERROR);
+    REQUIRE(output.find("Statistics          : disabled\n") != std::string::npos);
+
+    Platform::_close(map_fd);
+}
+
 TEST_CASE("show links", "[netsh][links]")
 {
     _test_helper_netsh test_helper;
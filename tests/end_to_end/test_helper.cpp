@@ -95,6 +95,9 @@ static uint32_t _ebpf_service_handle_counter = 0;
 _Guarded_by_(
     _service_path_to_context_mutex) static std::map<std::wstring, service_context_t*> _service_path_to_context_map;
 
+static std::mutex _ioctl_count_mutex;
+_Guarded_by_(_ioctl_count_mutex) static std::map<ebpf_operation_id_t, size_t> _ioctl_count;
+
 std::mutex _overlapped_buffers_mutex;
 typedef struct _overlapped_completion
 {
@@ -467,6 +470,10 @@ GlueDeviceIoControl(
     ebpf_operation_header_t* user_reply = nullptr;
     *bytes_returned = 0;
     auto request_id = user_request->id;
+    {
+        std::unique_lock lock(_ioctl_count_mutex);
+        _ioctl_count[request_id]++;
+    }
     size_t minimum_request_size = 0;
     size_t minimum_reply_size = 0;
     bool async = false;
@@ -859,6 +866,32 @@ get_native_module_failures()
     return _expect_native_module_load_failures || cxplat_fault_injection_is_enabled();
 }
 
+void
+reset_ioctl_counts()
+{
+    std::unique_lock lock(_ioctl_count_mutex);
+    _ioctl_count.clear();
+}
+
+size_t
+get_ioctl_count(ebpf_operation_id_t operation_id)
+{
+    std::unique_lock lock(_ioctl_count_mutex);
+    auto it = _ioctl_count.find(operation_id);
+    return (it == _ioctl_count.end()) ? 0 : it->second;
+}
+
+size_t
+get_total_ioctl_count()
+{
+    std::unique_lock lock(_ioctl_count_mutex);
+    size_t total = 0;
+    for (auto& [operation_id, count] : _ioctl_count) {
+        total += count;
+    }
+    return total;
+}
+
 _Must_inspect_result_ ebpf_result_t
 get_service_details_for_file(
     _In_ const std::wstring& file_path, _Out_ const wchar_t** service_name, _Out_ GUID* provider_guid)
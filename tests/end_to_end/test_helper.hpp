@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "ebpf_protocol.h"
+
 class _test_helper_end_to_end
 {
   public:
@@ -65,6 +67,16 @@ set_native_module_failures(bool expected);
 bool
 get_native_module_failures();
 
+// Counts of the IOCTLs issued through the test device, by operation.
+void
+reset_ioctl_counts();
+
+size_t
+get_ioctl_count(ebpf_operation_id_t operation_id);
+
+size_t
+get_total_ioctl_count();
+
 _Must_inspect_result_ ebpf_result_t
 get_service_details_for_file(
     _In_ const std::wstring& file_path, _Out_ const wchar_t** service_name, _Out_ GUID* provider_guid);
@@ -197,8 +197,14 @@ _netebpf_ext_helper::_hook_client_attach_provider(
     if (base_client_context == nullptr) {
         return STATUS_INVALID_PARAMETER;
     }
-    const ebpf_extension_dispatch_table_t client_dispatch_table = {
-        .version = 1, .count = 1, .function = base_client_context->helper->hook_invoke_function};
+    const bool legacy = base_client_context->legacy_dispatch_table;
+    const ebpf_extension_program_dispatch_table_t client_dispatch_table = {
+        .version = (uint16_t)(legacy ? EBPF_LINK_DISPATCH_TABLE_VERSION_1 : EBPF_LINK_DISPATCH_TABLE_VERSION_CURRENT),
+        .count = (uint16_t)(legacy ? EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_1
+                                   : EBPF_LINK_DISPATCH_TABLE_FUNCTION_COUNT_CURRENT),
+        .ebpf_program_invoke_function =
+            (ebpf_program_invoke_function_t)base_client_context->helper->hook_invoke_function,
+        .ebpf_program_get_state_generation_function = legacy ? nullptr : _hook_client_get_state_generation};
     auto provider_data = (const ebpf_attach_provider_data_t*)provider_registration_instance->NpiSpecificCharacteristics;
     if (base_client_context->desired_attach_type != BPF_ATTACH_TYPE_UNSPEC &&
         provider_data->bpf_attach_type != base_client_context->desired_attach_type) {
@@ -213,6 +219,13 @@ _netebpf_ext_helper::_hook_client_attach_provider(
         &provider_dispatch_table);
 }
 
+uint64_t
+_netebpf_ext_helper::_hook_client_get_state_generation(_In_ const void* client_binding_context)
+{
+    auto base_client_context = reinterpret_cast<const netebpfext_helper_base_client_context_t*>(client_binding_context);
+    return base_client_context->state_generation;
+}
+
 NTSTATUS
 _netebpf_ext_helper::_hook_client_detach_provider(_Inout_ void* client_binding_context)
 {
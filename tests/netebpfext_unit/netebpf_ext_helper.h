@@ -26,6 +26,8 @@ typedef struct _netebpfext_helper_base_client_context
     class _netebpf_ext_helper* helper;
     void* provider_binding_context;
     bpf_attach_type_t desired_attach_type; // BPF_ATTACH_TYPE_UNSPEC for any allowed.
+    volatile uint64_t state_generation;    // Reported to the extension as the program state generation.
+    bool legacy_dispatch_table;            // Attach with a version 1 dispatch table, which has no state generation.
 } netebpfext_helper_base_client_context_t;
 
 typedef class _netebpf_ext_helper
@@ -189,6 +191,9 @@ typedef class _netebpf_ext_helper
     static void
     _hook_client_cleanup_binding_context(_In_ void* client_binding_context);
 
+    static uint64_t
+    _hook_client_get_state_generation(_In_ const void* client_binding_context);
+
     NPI_CLIENT_CHARACTERISTICS hook_client{
         1,
         sizeof(NPI_PROVIDER_CHARACTERISTICS),
@@ -9,14 +9,22 @@
 #include "netebpf_ext_helper.h"
 #include "watchdog.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
 #include <map>
 #include <stop_token>
+#include <string>
 #include <thread>
+#include <vector>
 
 CATCH_REGISTER_LISTENER(_watchdog)
 CATCH_REGISTER_LISTENER(cxplat_passed_test_log)
 
 #define CONCURRENT_THREAD_RUN_TIME_IN_SECONDS 10
+#define CLASSIFY_BENCHMARK_ITERATIONS_PER_THREAD 20000
 
 typedef enum _sock_addr_test_type
 {
@@ -149,6 +157,33 @@ TEST_CASE("classify_packet", "[netebpfext]")
     REQUIRE(result == FWP_ACTION_BLOCK);
 }
 
+TEST_CASE("xdp_tx_throughput", "[.][netebpfext][performance]")
+{
+    const uint32_t packet_count = 100000;
+    NET_IFINDEX if_index = 0;
+    ebpf_extension_data_t npi_specific_characteristics = {.data = &if_index};
+    test_xdp_client_context_t client_context = {};
+    client_context.base.desired_attach_type = BPF_XDP_TEST;
+    client_context.xdp_action = XDP_TEST_ACTION_TX;
+
+    npi_specific_characteristics.header.size = sizeof(if_index);
+
+    netebpf_ext_helper_t helper(
+        &npi_specific_characteristics,
+        (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_xdp_program,
+        (netebpfext_helper_base_client_context_t*)&client_context);
+
+    // Every packet is bounced, so this measures the XDP_TX clone and send path.
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < packet_count; i++) {
+        FWP_ACTION_TYPE result = helper.classify_test_packet(&FWPM_LAYER_INBOUND_MAC_FRAME_NATIVE, if_index);
+        REQUIRE(result == FWP_ACTION_BLOCK);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "XDP_TX: " << elapsed.count() / packet_count << " ns per packet" << std::endl;
+}
+
 TEST_CASE("xdp_context", "[netebpfext]")
 {
     netebpf_ext_helper_t helper;
@@ -207,6 +242,154 @@ TEST_CASE("xdp_context", "[netebpfext]")
     REQUIRE(output_context.ingress_ifindex == 67889);
 }
 
+TEST_CASE("xdp_context_metadata", "[netebpfext]")
+{
+    netebpf_ext_helper_t helper;
+    auto xdp_program_data = helper.get_program_info_provider_data(EBPF_PROGRAM_TYPE_XDP_TEST);
+
+    std::vector<uint8_t> input_data(100);
+    std::vector<uint8_t> output_data(100);
+    size_t output_data_size = output_data.size();
+    xdp_md_t input_context = {};
+    size_t output_context_size = sizeof(xdp_md_t);
+    xdp_md_t output_context = {};
+    xdp_md_t* xdp_context = nullptr;
+
+    input_context.rx_hash = 0x12345678;
+    input_context.rx_hash_type = XDP_RSS_L3_IPV4 | XDP_RSS_L4 | XDP_RSS_L4_TCP;
+    input_context.rx_queue_index = 3;
+
+    REQUIRE(
+        xdp_program_data->context_create(
+            input_data.data(),
+            input_data.size(),
+            (const uint8_t*)&input_context,
+            sizeof(input_context),
+            (void**)&xdp_context) == EBPF_SUCCESS);
+
+    // No metadata has been supplied.
+    REQUIRE(xdp_context->data_meta == (uint64_t)(uintptr_t)xdp_context->data);
+    REQUIRE(xdp_context->rx_hash == input_context.rx_hash);
+    REQUIRE(xdp_context->rx_hash_type == input_context.rx_hash_type);
+    REQUIRE(xdp_context->rx_queue_index == input_context.rx_queue_index);
+
+    bpf_xdp_adjust_head_t adjust_head = reinterpret_cast<bpf_xdp_adjust_head_t>(
+        xdp_program_data->program_type_specific_helper_function_addresses->helper_function_address[0]);
+    bpf_xdp_adjust_meta_t adjust_meta = reinterpret_cast<bpf_xdp_adjust_meta_t>(
+        xdp_program_data->program_type_specific_helper_function_addresses->helper_function_address[1]);
+
+    // There is no headroom in front of the data yet.
+    REQUIRE(adjust_meta(xdp_context, -4) == -1);
+
+    REQUIRE(adjust_head(xdp_context, 20) == 0);
+
+    // Metadata must be a multiple of 4 bytes, fit in the headroom and not exceed XDP_METADATA_MAX.
+    REQUIRE(adjust_meta(xdp_context, -3) == -1);
+    REQUIRE(adjust_meta(xdp_context, -24) == -1);
+    REQUIRE(adjust_meta(xdp_context, 4) == -1);
+    REQUIRE(adjust_meta(xdp_context, -8) == 0);
+    REQUIRE(xdp_context->data_meta + 8 == (uint64_t)(uintptr_t)xdp_context->data);
+
+    // The metadata follows the data start when the head is moved.
+    uint8_t* metadata = (uint8_t*)(uintptr_t)xdp_context->data_meta;
+    memset(metadata, 0xab, 8);
+    REQUIRE(adjust_head(xdp_context, 4) == 0);
+    metadata = (uint8_t*)(uintptr_t)xdp_context->data_meta;
+    REQUIRE(metadata + 8 == (uint8_t*)xdp_context->data);
+    REQUIRE(metadata[0] == 0xab);
+    REQUIRE(metadata[7] == 0xab);
+
+    // Shrink the metadata back to nothing.
+    REQUIRE(adjust_meta(xdp_context, 8) == 0);
+    REQUIRE(xdp_context->data_meta == (uint64_t)(uintptr_t)xdp_context->data);
+
+    xdp_program_data->context_destroy(
+        xdp_context, output_data.data(), &output_data_size, (uint8_t*)&output_context, &output_context_size);
+
+    REQUIRE(output_data_size == 76);
+    REQUIRE(output_context_size == sizeof(xdp_md_t));
+    REQUIRE(output_context.data_meta == 0);
+    REQUIRE(output_context.rx_hash == input_context.rx_hash);
+    REQUIRE(output_context.rx_hash_type == input_context.rx_hash_type);
+    REQUIRE(output_context.rx_queue_index == input_context.rx_queue_index);
+}
+
+TEST_CASE("xdp_parse_headers", "[netebpfext]")
+{
+    netebpf_ext_helper_t helper;
+    auto xdp_program_data = helper.get_program_info_provider_data(EBPF_PROGRAM_TYPE_XDP_TEST);
+    bpf_xdp_parse_headers_t parse_headers = reinterpret_cast<bpf_xdp_parse_headers_t>(
+        xdp_program_data->program_type_specific_helper_function_addresses->helper_function_address[2]);
+    xdp_headers_t headers;
+    size_t output_data_size = 0;
+    size_t output_context_size = 0;
+
+    // Ethernet, one 802.1Q tag with VLAN 5, IPv4 and a TCP header with 4 bytes of options.
+    std::vector<uint8_t> tcp_packet = {
+        0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x81, 0x00, 0x00, 0x05, 0x08, 0x00,
+        0x45, 0x00, 0x00, 0x2c, 0x00, 0x00, 0x40, 0x00, 0x40, 0x06, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x01, 0x14, 0x00,
+        0x00, 0x01, 0x30, 0x39, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0x05, 0xb4};
+    // Ethernet, IPv6 and a fragment header for a non-first fragment of a UDP datagram.
+    std::vector<uint8_t> fragment_packet = {
+        0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x86, 0xdd, 0x60, 0x00, 0x00, 0x00,
+        0x00, 0x10, 0x2c, 0x40, 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01, 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+        0x11, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    xdp_md_t* xdp_context = nullptr;
+    REQUIRE(
+        xdp_program_data->context_create(tcp_packet.data(), tcp_packet.size(), nullptr, 0, (void**)&xdp_context) ==
+        EBPF_SUCCESS);
+
+    REQUIRE(parse_headers(xdp_context, &headers, sizeof(headers) - 1) == -1);
+    REQUIRE(parse_headers(xdp_context, &headers, sizeof(headers)) == 0);
+    REQUIRE(headers.ether_type == 0x0800);
+    REQUIRE(headers.vlan_id == 5);
+    REQUIRE(headers.flags == XDP_HEADERS_FLAG_VLAN);
+    REQUIRE(headers.l3_offset == 18);
+    REQUIRE(headers.ip_version == 4);
+    REQUIRE(headers.protocol == IPPROTO_TCP);
+    REQUIRE(headers.l4_offset == 38);
+    REQUIRE(headers.payload_offset == 62);
+    REQUIRE(headers.source_port == htons(12345));
+    REQUIRE(headers.destination_port == htons(80));
+    REQUIRE(memcmp(headers.source_address, &tcp_packet[30], sizeof(uint32_t)) == 0);
+    REQUIRE(memcmp(headers.destination_address, &tcp_packet[34], sizeof(uint32_t)) == 0);
+
+    // A truncated transport header is not reported.
+    xdp_context->data_end = (uint8_t*)xdp_context->data + 50;
+    REQUIRE(parse_headers(xdp_context, &headers, sizeof(headers)) == 0);
+    REQUIRE(headers.l3_offset == 18);
+    REQUIRE(headers.protocol == IPPROTO_TCP);
+    REQUIRE(headers.l4_offset == 0);
+    REQUIRE(headers.payload_offset == 0);
+
+    // Frames shorter than an Ethernet header are rejected.
+    xdp_context->data_end = (uint8_t*)xdp_context->data + 10;
+    REQUIRE(parse_headers(xdp_context, &headers, sizeof(headers)) == -1);
+    xdp_context->data_end = (uint8_t*)xdp_context->data + tcp_packet.size();
+
+    xdp_program_data->context_destroy(xdp_context, nullptr, &output_data_size, nullptr, &output_context_size);
+
+    xdp_context = nullptr;
+    REQUIRE(
+        xdp_program_data->context_create(
+            fragment_packet.data(), fragment_packet.size(), nullptr, 0, (void**)&xdp_context) == EBPF_SUCCESS);
+
+    REQUIRE(parse_headers(xdp_context, &headers, sizeof(headers)) == 0);
+    REQUIRE(headers.ether_type == 0x86dd);
+    REQUIRE(headers.l3_offset == 14);
+    REQUIRE(headers.ip_version == 6);
+    REQUIRE(headers.flags == XDP_HEADERS_FLAG_FRAGMENT);
+    REQUIRE(headers.protocol == IPPROTO_UDP);
+    REQUIRE(headers.l4_offset == 0);
+    REQUIRE(memcmp(headers.source_address, &fragment_packet[22], sizeof(headers.source_address)) == 0);
+    REQUIRE(memcmp(headers.destination_address, &fragment_packet[38], sizeof(headers.destination_address)) == 0);
+
+    xdp_program_data->context_destroy(xdp_context, nullptr, &output_data_size, nullptr, &output_context_size);
+}
+
 #pragma endregion xdp
 #pragma region bind
 
@@ -329,6 +512,53 @@ TEST_CASE("bind_context", "[netebpfext]")
     REQUIRE(output_context.protocol == IPPROTO_UDP);
 }
 
+TEST_CASE("bind_context_app_id", "[netebpfext]")
+{
+    netebpf_ext_helper_t helper;
+    auto bind_program_data = helper.get_program_info_provider_data(EBPF_PROGRAM_TYPE_BIND);
+    REQUIRE(bind_program_data->global_helper_function_addresses != nullptr);
+    REQUIRE(bind_program_data->global_helper_function_addresses->helper_function_count == 1);
+    auto get_current_app_id = reinterpret_cast<uint64_t (*)(const bind_md_t*)>(
+        bind_program_data->global_helper_function_addresses->helper_function_address[0]);
+
+    std::wstring app_id_1 = L"\\device\\harddiskvolume1\\windows\\system32\\svchost.exe";
+    std::wstring app_id_2 = L"\\device\\harddiskvolume1\\windows\\system32\\notepad.exe";
+    bind_md_t input_context = {};
+    size_t output_data_size = 0;
+    size_t output_context_size = 0;
+
+    auto compute_app_id = [&](const std::wstring& app_id) {
+        bind_md_t* bind_context = nullptr;
+        REQUIRE(
+            bind_program_data->context_create(
+                (const uint8_t*)app_id.data(),
+                app_id.size() * sizeof(wchar_t),
+                (const uint8_t*)&input_context,
+                sizeof(input_context),
+                (void**)&bind_context) == EBPF_SUCCESS);
+        uint64_t value = get_current_app_id(bind_context);
+        // The value is memoized in the context and must not change on subsequent calls.
+        REQUIRE(get_current_app_id(bind_context) == value);
+        bind_program_data->context_destroy(bind_context, nullptr, &output_data_size, nullptr, &output_context_size);
+        return value;
+    };
+
+    uint64_t value_1 = compute_app_id(app_id_1);
+    uint64_t value_2 = compute_app_id(app_id_2);
+
+    // The ID is derived from the full image path, so it is stable across contexts and distinguishes applications
+    // that share a directory.
+    REQUIRE(value_1 != 0);
+    REQUIRE(value_2 != 0);
+    REQUIRE(value_1 == compute_app_id(app_id_1));
+    REQUIRE(value_1 != value_2);
+
+    // User mode resolves a path through the same keyed hash.
+    REQUIRE(
+        value_1 ==
+        net_ebpf_extension_get_app_id((const uint8_t*)app_id_1.data(), app_id_1.size() * sizeof(wchar_t)));
+}
+
 #pragma endregion bind
 #pragma region cgroup_sock_addr
 
@@ -337,6 +567,9 @@ typedef struct test_sock_addr_client_context_t
     netebpfext_helper_base_client_context_t base;
     int sock_addr_action;
     bool validate_sock_addr_entries = true;
+    bool cacheable = false; // Mark verdicts with BPF_SOCK_ADDR_VERDICT_CACHE.
+    volatile long invoke_count = 0;
+    uint32_t redirect_context_size = 0; // Size of the redirect context to set when redirecting, or 0 for none.
 } test_sock_addr_client_context_t;
 
 static inline sock_addr_test_action_t
@@ -366,6 +599,8 @@ netebpfext_unit_invoke_sock_addr_program(
     int action = SOCK_ADDR_TEST_ACTION_BLOCK;
     int32_t is_admin = 0;
 
+    InterlockedIncrement(&client_context->invoke_count);
+
     auto sock_addr_program_data =
         client_context->base.helper->get_program_info_provider_data(EBPF_PROGRAM_TYPE_CGROUP_SOCK_ADDR);
 
@@ -405,6 +640,14 @@ netebpfext_unit_invoke_sock_addr_program(
         *result = BPF_SOCK_ADDR_VERDICT_REJECT;
         break;
     case SOCK_ADDR_TEST_ACTION_REDIRECT:
+        if (client_context->redirect_context_size > 0) {
+            std::vector<uint8_t> redirect_context(client_context->redirect_context_size, 0x42);
+            auto set_redirect_context = reinterpret_cast<bpf_sock_addr_set_redirect_context_t>(
+                sock_addr_program_data->program_type_specific_helper_function_addresses->helper_function_address[1]);
+            REQUIRE(
+                set_redirect_context(
+                    sock_addr_context, redirect_context.data(), (uint32_t)redirect_context.size()) == 0);
+        }
         sock_addr_context->user_port++;
         if (sock_addr_context->family == AF_INET) {
             sock_addr_context->user_ip4++;
@@ -421,6 +664,10 @@ netebpfext_unit_invoke_sock_addr_program(
         *result = BPF_SOCK_ADDR_VERDICT_REJECT;
     }
 
+    if (return_result == EBPF_SUCCESS && client_context->cacheable) {
+        *result |= BPF_SOCK_ADDR_VERDICT_CACHE;
+    }
+
     return return_result;
 }
 
@@ -512,6 +759,168 @@ TEST_CASE("sock_addr_invoke", "[netebpfext]")
     REQUIRE(result == FWP_ACTION_PERMIT);
 }
 
+TEST_CASE("sock_addr_redirect_context", "[netebpfext]")
+{
+    ebpf_extension_data_t npi_specific_characteristics = {};
+    test_sock_addr_client_context_t client_context = {};
+    fwp_classify_parameters_t parameters = {};
+
+    netebpf_ext_helper_t helper(
+        &npi_specific_characteristics,
+        (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_addr_program,
+        (netebpfext_helper_base_client_context_t*)&client_context);
+
+    netebpfext_initialize_fwp_classify_parameters(&parameters);
+    client_context.validate_sock_addr_entries = true;
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_REDIRECT;
+
+    // Small redirect contexts are kept inline and large ones are allocated by the helper. Both are handed to WFP
+    // when the connection is redirected.
+    for (uint32_t size : {1u, 64u, 65u, 1024u}) {
+        client_context.redirect_context_size = size;
+        REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+        REQUIRE(helper.test_cgroup_inet6_connect(&parameters) == FWP_ACTION_PERMIT);
+    }
+}
+
+TEST_CASE("sock_addr_verdict_cache", "[netebpfext]")
+{
+    ebpf_extension_data_t npi_specific_characteristics = {};
+    test_sock_addr_client_context_t client_context = {};
+    fwp_classify_parameters_t parameters = {};
+
+    // The verdict cache is per CPU, so keep this thread on one CPU to make hits deterministic.
+    DWORD_PTR previous_affinity = SetThreadAffinityMask(GetCurrentThread(), 1);
+    REQUIRE(previous_affinity != 0);
+
+    netebpf_ext_helper_t helper(
+        &npi_specific_characteristics,
+        (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_addr_program,
+        (netebpfext_helper_base_client_context_t*)&client_context);
+
+    netebpfext_initialize_fwp_classify_parameters(&parameters);
+    client_context.validate_sock_addr_entries = true;
+    client_context.cacheable = true;
+
+    // The first connection invokes the program; the second one reuses its verdict.
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_PERMIT;
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 1);
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 1);
+
+    // Each hook has its own program, so it has its own entries.
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 2);
+
+    // The cached verdict is used until the program state generation changes.
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_BLOCK;
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 2);
+    client_context.base.state_generation++;
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_BLOCK);
+    REQUIRE(client_context.invoke_count == 3);
+
+    // REJECT verdicts are cached and still enforced at the AUTH_CONNECT layer.
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_BLOCK);
+    REQUIRE(client_context.invoke_count == 3);
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_PERMIT);
+    client_context.base.state_generation++;
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_BLOCK);
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_BLOCK);
+    REQUIRE(client_context.invoke_count == 4);
+
+    // Redirected connections are never cached.
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_REDIRECT;
+    client_context.base.state_generation++;
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 6);
+
+    // Verdicts that are not marked cacheable are not cached.
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_PERMIT;
+    client_context.cacheable = false;
+    client_context.base.state_generation++;
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 8);
+
+    // A different destination is a different entry.
+    client_context.cacheable = true;
+    client_context.validate_sock_addr_entries = false;
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 9);
+    parameters.destination_port = htons(ntohs(parameters.destination_port) + 1);
+    REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 10);
+
+    SetThreadAffinityMask(GetCurrentThread(), previous_affinity);
+}
+
+TEST_CASE("sock_addr_verdict_cache_legacy_client", "[netebpfext]")
+{
+    ebpf_extension_data_t npi_specific_characteristics = {};
+    test_sock_addr_client_context_t client_context = {};
+    fwp_classify_parameters_t parameters = {};
+
+    // A client with a version 1 dispatch table does not support verdict caching, so the cache flags are not stripped
+    // from its verdicts and PROCEED combined with them is an unknown verdict, which is rejected.
+    client_context.base.legacy_dispatch_table = true;
+    netebpf_ext_helper_t helper(
+        &npi_specific_characteristics,
+        (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_addr_program,
+        (netebpfext_helper_base_client_context_t*)&client_context);
+
+    netebpfext_initialize_fwp_classify_parameters(&parameters);
+    client_context.validate_sock_addr_entries = true;
+    client_context.cacheable = true;
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_PERMIT;
+
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_BLOCK);
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_BLOCK);
+    REQUIRE(client_context.invoke_count == 2);
+
+    // Without the cache flags the verdict is honored.
+    client_context.cacheable = false;
+    REQUIRE(helper.test_cgroup_inet4_recv_accept(&parameters) == FWP_ACTION_PERMIT);
+    REQUIRE(client_context.invoke_count == 3);
+}
+
+TEST_CASE("sock_addr_connect_rate", "[.][netebpfext][performance]")
+{
+    const uint32_t connection_count = 100000;
+    ebpf_extension_data_t npi_specific_characteristics = {};
+    test_sock_addr_client_context_t client_context = {};
+    fwp_classify_parameters_t parameters = {};
+
+    netebpf_ext_helper_t helper(
+        &npi_specific_characteristics,
+        (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_addr_program,
+        (netebpfext_helper_base_client_context_t*)&client_context);
+
+    netebpfext_initialize_fwp_classify_parameters(&parameters);
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_PERMIT;
+    client_context.validate_sock_addr_entries = false;
+
+    // Compare the connect path with and without the verdict cache.
+    for (bool cacheable : {false, true}) {
+        client_context.cacheable = cacheable;
+        client_context.base.state_generation++;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < connection_count; i++) {
+            REQUIRE(helper.test_cgroup_inet4_connect(&parameters) == FWP_ACTION_PERMIT);
+        }
+        auto elapsed =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        WARN(
+            "sock_addr connect (" << (cacheable ? "cached" : "uncached")
+                                  << "): " << (connection_count * 1000000000ull) / (elapsed.count() + 1)
+                                  << " connections per second");
+    }
+}
+
 void
 sock_addr_thread_function(
     std::stop_token token,
@@ -690,6 +1099,58 @@ TEST_CASE("sock_addr_invoke_concurrent3", "[netebpfext_concurrent]")
     }
 }
 
+// Invoke SOCK_ADDR_CONNECT concurrently with cacheable verdicts while the program state generation keeps changing.
+TEST_CASE("sock_addr_invoke_concurrent_cached", "[netebpfext_concurrent]")
+{
+    ebpf_extension_data_t npi_specific_characteristics = {};
+    test_sock_addr_client_context_t client_context = {};
+    std::vector<std::jthread> threads;
+    std::vector<fwp_classify_parameters_t> parameters;
+
+    netebpf_ext_helper_t helper(
+        &npi_specific_characteristics,
+        (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_addr_program,
+        (netebpfext_helper_base_client_context_t*)&client_context);
+
+    // The round robin verdict only depends on the destination port, so it is safe to cache.
+    client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_ROUND_ROBIN;
+    client_context.validate_sock_addr_entries = false;
+    client_context.cacheable = true;
+
+    uint32_t thread_count = 2 * ebpf_get_cpu_count();
+    parameters.resize(thread_count);
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        netebpfext_initialize_fwp_classify_parameters(&parameters[i]);
+        threads.emplace_back(
+            sock_addr_thread_function,
+            &helper,
+            &parameters[i],
+            (i % 2) ? SOCK_ADDR_TEST_TYPE_RECV_ACCEPT : SOCK_ADDR_TEST_TYPE_CONNECT,
+            (uint16_t)(i * 100),
+            (uint16_t)(i * 100 + 100));
+    }
+    threads.emplace_back([&client_context](std::stop_token token) {
+        while (!token.stop_requested()) {
+            client_context.base.state_generation++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // Wait for 10 seconds.
+    std::this_thread::sleep_for(std::chrono::seconds(CONCURRENT_THREAD_RUN_TIME_IN_SECONDS));
+
+    // Stop all threads.
+    for (auto& thread : threads) {
+        thread.request_stop();
+    }
+
+    // Wait for all threads to stop.
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 TEST_CASE("sock_addr_context", "[netebpfext]")
 {
     netebpf_ext_helper_t helper;
@@ -878,4 +1339,323 @@ TEST_CASE("sock_ops_context", "[netebpfext]")
     REQUIRE(output_context.compartment_id == 0x12345679);
     REQUIRE(output_context.interface_luid == 0x1234567890abcdee);
 }
+
+typedef struct test_sock_ops_storage_client_context_t
+{
+    netebpfext_helper_base_client_context_t base;
+    uint32_t storage_created_count;
+    uint32_t storage_found_count;
+    uint32_t deleted_without_storage_count;
+} test_sock_ops_storage_client_context_t;
+
+static uint32_t _test_sock_ops_storage_freed_count = 0;
+
+static void
+_test_sock_ops_free_storage(_Inout_ ebpf_context_header_t* header)
+{
+    delete reinterpret_cast<uint32_t*>(header->storage);
+    header->storage = nullptr;
+    _test_sock_ops_storage_freed_count++;
+}
+
+// Counts invocations per flow in storage hung off the context header, the same way bpf_sk_storage_get with
+// BPF_SK_STORAGE_GET_F_CREATE does in the execution context.
+_Must_inspect_result_ ebpf_result_t
+netebpfext_unit_invoke_sock_ops_storage_program(
+    _In_ const void* client_binding_context, _In_ const void* context, _Out_ uint32_t* result)
+{
+    auto client_context = (test_sock_ops_storage_client_context_t*)client_binding_context;
+    auto sock_ops_context = (const bpf_sock_ops_t*)context;
+    auto header = (ebpf_context_header_t*)sock_ops_context - 1;
+
+    if (header->storage == nullptr) {
+        if (sock_ops_context->op == BPF_SOCK_OPS_CONNECTION_DELETED_CB) {
+            client_context->deleted_without_storage_count++;
+        }
+        header->storage = new uint32_t(0);
+        header->free_storage = _test_sock_ops_free_storage;
+        client_context->storage_created_count++;
+    } else {
+        client_context->storage_found_count++;
+    }
+    (*reinterpret_cast<uint32_t*>(header->storage))++;
+
+    *result = 0;
+    return EBPF_SUCCESS;
+}
+
+TEST_CASE("sock_ops_sk_storage", "[netebpfext]")
+{
+    ebpf_extension_data_t npi_specific_characteristics = {};
+    test_sock_ops_storage_client_context_t client_context = {};
+    fwp_classify_parameters_t parameters = {};
+    _test_sock_ops_storage_freed_count = 0;
+
+    {
+        netebpf_ext_helper_t helper(
+            &npi_specific_characteristics,
+            (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_ops_storage_program,
+            (netebpfext_helper_base_client_context_t*)&client_context);
+
+        netebpfext_initialize_fwp_classify_parameters(&parameters);
+
+        // Every new flow starts without storage.
+        REQUIRE(helper.test_sock_ops_v4(&parameters) == FWP_ACTION_PERMIT);
+        REQUIRE(helper.test_sock_ops_v6(&parameters) == FWP_ACTION_PERMIT);
+        REQUIRE(client_context.storage_created_count == 2);
+
+        // Storage created when a flow is established is still there when the same flow is deleted.
+        REQUIRE(client_context.deleted_without_storage_count == 0);
+
+        // Storage persists across invocations on one context and is released when the context is destroyed.
+        auto sock_ops_program_data = helper.get_program_info_provider_data(EBPF_PROGRAM_TYPE_SOCK_OPS);
+        bpf_sock_ops_t input_context = {};
+        input_context.op = BPF_SOCK_OPS_ACTIVE_ESTABLISHED_CB;
+        input_context.family = AF_INET;
+        bpf_sock_ops_t* sock_ops_context = nullptr;
+        REQUIRE(
+            sock_ops_program_data->context_create(
+                nullptr, 0, (const uint8_t*)&input_context, sizeof(input_context), (void**)&sock_ops_context) == 0);
+
+        uint32_t freed_count = _test_sock_ops_storage_freed_count;
+        uint32_t created_count = client_context.storage_created_count;
+        uint32_t found_count = client_context.storage_found_count;
+        uint32_t result;
+        for (uint32_t i = 0; i < 3; i++) {
+            REQUIRE(netebpfext_unit_invoke_sock_ops_storage_program(&client_context, sock_ops_context, &result) == 0);
+        }
+        REQUIRE(client_context.storage_created_count == created_count + 1);
+        REQUIRE(client_context.storage_found_count == found_count + 2);
+        REQUIRE(*reinterpret_cast<uint32_t*>(((ebpf_context_header_t*)sock_ops_context - 1)->storage) == 3);
+
+        size_t output_data_size = 0;
+        size_t output_context_size = 0;
+        sock_ops_program_data->context_destroy(
+            sock_ops_context, nullptr, &output_data_size, nullptr, &output_context_size);
+        REQUIRE(_test_sock_ops_storage_freed_count == freed_count + 1);
+    }
+
+    // Detaching the program releases the storage of every flow that is still open.
+    REQUIRE(_test_sock_ops_storage_freed_count == client_context.storage_created_count);
+}
 #pragma endregion sock_ops
+#pragma region classify_benchmark
+
+typedef struct _classify_benchmark_workload
+{
+    uint32_t thread_count;
+    uint32_t tuple_count;  ///< Number of distinct tuples each thread cycles through.
+    bool program_attached; ///< Whether a program is attached to the hook.
+} classify_benchmark_workload_t;
+
+// Classify one operation with the given port as the source and destination port of the tuple. Returns false if the
+// verdict was not the expected one.
+typedef std::function<bool(_Inout_ fwp_classify_parameters_t* parameters, uint16_t port)> classify_benchmark_function_t;
+
+static std::vector<classify_benchmark_workload_t>
+_get_classify_benchmark_workloads()
+{
+    uint32_t cpu_count = ebpf_get_cpu_count();
+    return {
+        {1, 1, false},
+        {1, 1, true},
+        {1, 1024, true},
+        {cpu_count, 1, true},
+        {cpu_count, 1024, true},
+    };
+}
+
+// Replay a synthetic classify workload against a hook on one or more threads and report the throughput and the
+// latency percentiles through the test reporter. Latencies include the cost of reading the clock around each classify.
+static void
+_run_classify_benchmark(
+    _In_z_ const char* hook_name,
+    _In_z_ const char* verdict_mix,
+    const classify_benchmark_workload_t& workload,
+    const classify_benchmark_function_t& classify)
+{
+    std::vector<std::vector<uint32_t>> latencies(workload.thread_count);
+    std::atomic<bool> go = false;
+    std::atomic<uint64_t> unexpected_verdict_count = 0;
+    std::vector<std::jthread> threads;
+    bool fault_injection_enabled = cxplat_fault_injection_is_enabled();
+
+    for (uint32_t thread_index = 0; thread_index < workload.thread_count; thread_index++) {
+        latencies[thread_index].resize(CLASSIFY_BENCHMARK_ITERATIONS_PER_THREAD);
+        threads.emplace_back([&, thread_index]() {
+            fwp_classify_parameters_t parameters;
+            netebpfext_initialize_fwp_classify_parameters(&parameters);
+
+            // Catch2 assertions are not thread safe, so only count unexpected verdicts here.
+            while (!go) {
+                std::this_thread::yield();
+            }
+            for (uint32_t i = 0; i < CLASSIFY_BENCHMARK_ITERATIONS_PER_THREAD; i++) {
+                // Each thread uses its own range of ports, so threads do not share tuples.
+                uint16_t port =
+                    (uint16_t)(1024 + (thread_index * workload.tuple_count + i % workload.tuple_count) % 60000);
+                parameters.source_port = htons(port);
+                parameters.destination_port = htons(port);
+
+                auto start = std::chrono::steady_clock::now();
+                bool expected = classify(&parameters, port);
+                auto end = std::chrono::steady_clock::now();
+
+                latencies[thread_index][i] =
+                    (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                if (!expected) {
+                    unexpected_verdict_count++;
+                }
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    // Injected faults change verdicts and distort timings, so there is nothing to check or report.
+    if (fault_injection_enabled) {
+        return;
+    }
+    REQUIRE(unexpected_verdict_count == 0);
+
+    std::vector<uint32_t> all_latencies;
+    for (const auto& thread_latencies : latencies) {
+        all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    }
+    std::sort(all_latencies.begin(), all_latencies.end());
+    auto percentile = [&](uint32_t percent) { return all_latencies[(all_latencies.size() - 1) * percent / 100]; };
+    uint64_t classify_count = all_latencies.size();
+
+    WARN(
+        hook_name << " " << verdict_mix << ": threads=" << workload.thread_count << " tuples=" << workload.tuple_count
+                  << " program=" << (workload.program_attached ? "attached" : "none")
+                  << " classifications_per_second=" << (classify_count * 1000000000ull) / (elapsed.count() + 1)
+                  << " p50_ns=" << percentile(50) << " p90_ns=" << percentile(90) << " p99_ns=" << percentile(99));
+}
+
+TEST_CASE("xdp_classify_benchmark", "[.][netebpfext][performance]")
+{
+    for (const auto& workload : _get_classify_benchmark_workloads()) {
+        for (xdp_test_action_t action : {XDP_TEST_ACTION_PASS, XDP_TEST_ACTION_DROP}) {
+            NET_IFINDEX if_index = 0;
+            ebpf_extension_data_t npi_specific_characteristics = {.data = &if_index};
+            test_xdp_client_context_t client_context = {};
+            client_context.base.desired_attach_type = BPF_XDP_TEST;
+            client_context.xdp_action = action;
+            npi_specific_characteristics.header.size = sizeof(if_index);
+
+            netebpf_ext_helper_t helper(
+                &npi_specific_characteristics,
+                workload.program_attached ? (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_xdp_program
+                                          : nullptr,
+                (netebpfext_helper_base_client_context_t*)&client_context);
+
+            // The test packet is fixed, so the tuple only varies for the other hooks.
+            FWP_ACTION_TYPE expected = (action == XDP_TEST_ACTION_PASS) ? FWP_ACTION_PERMIT : FWP_ACTION_BLOCK;
+            _run_classify_benchmark(
+                "xdp",
+                (action == XDP_TEST_ACTION_PASS) ? "pass" : "drop",
+                workload,
+                [&](_Inout_ fwp_classify_parameters_t* parameters, uint16_t port) {
+                    UNREFERENCED_PARAMETER(parameters);
+                    UNREFERENCED_PARAMETER(port);
+                    FWP_ACTION_TYPE result =
+                        helper.classify_test_packet(&FWPM_LAYER_INBOUND_MAC_FRAME_NATIVE, if_index);
+                    return !workload.program_attached || result == expected;
+                });
+        }
+    }
+}
+
+TEST_CASE("bind_classify_benchmark", "[.][netebpfext][performance]")
+{
+    for (const auto& workload : _get_classify_benchmark_workloads()) {
+        for (bind_action_t action : {BIND_PERMIT, BIND_DENY}) {
+            ebpf_extension_data_t npi_specific_characteristics = {};
+            test_bind_client_context_t client_context = {};
+            client_context.bind_action = action;
+
+            netebpf_ext_helper_t helper(
+                &npi_specific_characteristics,
+                workload.program_attached ? (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_bind_program
+                                          : nullptr,
+                (netebpfext_helper_base_client_context_t*)&client_context);
+
+            FWP_ACTION_TYPE expected = (action == BIND_PERMIT) ? FWP_ACTION_PERMIT : FWP_ACTION_BLOCK;
+            _run_classify_benchmark(
+                "bind",
+                (action == BIND_PERMIT) ? "permit" : "deny",
+                workload,
+                [&](_Inout_ fwp_classify_parameters_t* parameters, uint16_t port) {
+                    UNREFERENCED_PARAMETER(port);
+                    FWP_ACTION_TYPE result = helper.test_bind_ipv4(parameters);
+                    return !workload.program_attached || result == expected;
+                });
+        }
+    }
+}
+
+TEST_CASE("sock_addr_classify_benchmark", "[.][netebpfext][performance]")
+{
+    for (const auto& workload : _get_classify_benchmark_workloads()) {
+        ebpf_extension_data_t npi_specific_characteristics = {};
+        test_sock_addr_client_context_t client_context = {};
+        // Permit, block, redirect and fail in turn, based on the destination port.
+        client_context.sock_addr_action = SOCK_ADDR_TEST_ACTION_ROUND_ROBIN;
+        client_context.validate_sock_addr_entries = false;
+
+        netebpf_ext_helper_t helper(
+            &npi_specific_characteristics,
+            workload.program_attached ? (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_addr_program
+                                      : nullptr,
+            (netebpfext_helper_base_client_context_t*)&client_context);
+
+        _run_classify_benchmark(
+            "sock_addr_connect",
+            "round_robin",
+            workload,
+            [&](_Inout_ fwp_classify_parameters_t* parameters, uint16_t port) {
+                FWP_ACTION_TYPE result = helper.test_cgroup_inet4_connect(parameters);
+                return !workload.program_attached || result == _get_fwp_sock_addr_action(port);
+            });
+        _run_classify_benchmark(
+            "sock_addr_recv_accept",
+            "round_robin",
+            workload,
+            [&](_Inout_ fwp_classify_parameters_t* parameters, uint16_t port) {
+                FWP_ACTION_TYPE result = helper.test_cgroup_inet4_recv_accept(parameters);
+                return !workload.program_attached || result == _get_fwp_sock_addr_action(port);
+            });
+    }
+}
+
+TEST_CASE("sock_ops_classify_benchmark", "[.][netebpfext][performance]")
+{
+    for (const auto& workload : _get_classify_benchmark_workloads()) {
+        ebpf_extension_data_t npi_specific_characteristics = {};
+        test_sock_ops_client_context_t client_context = {};
+        client_context.sock_ops_action = 0;
+
+        netebpf_ext_helper_t helper(
+            &npi_specific_characteristics,
+            workload.program_attached ? (_ebpf_extension_dispatch_function)netebpfext_unit_invoke_sock_ops_program
+                                      : nullptr,
+            (netebpfext_helper_base_client_context_t*)&client_context);
+
+        _run_classify_benchmark(
+            "sock_ops",
+            "permit",
+            workload,
+            [&](_Inout_ fwp_classify_parameters_t* parameters, uint16_t port) {
+                UNREFERENCED_PARAMETER(port);
+                FWP_ACTION_TYPE result = helper.test_sock_ops_v4(parameters);
+                return !workload.program_attached || result == FWP_ACTION_PERMIT;
+            });
+    }
+}
+#pragma endregion classify_benchmark
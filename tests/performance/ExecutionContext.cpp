@@ -5,6 +5,7 @@
 
 #define TEST_AREA "ExecutionContext"
 
+#include "byte_code_optimizer.h"
 #include "performance.h"
 
 extern "C"
@@ -40,19 +41,27 @@ typedef class _ebpf_program_test_state
 
 #if !defined(CONFIG_BPF_JIT_DISABLED) || !defined(CONFIG_BPF_INTERPRETER_DISABLED)
     void
-    prepare_jit_program()
+    prepare_jit_program(bool optimize = false)
     {
         ubpf_vm* vm = ubpf_create();
         REQUIRE(vm != nullptr);
 
+        // Optimize the byte code the same way the service does before JIT compiling it.
+        std::vector<ebpf_instruction_t> jit_byte_code = byte_code;
+        if (optimize) {
+            uint32_t instruction_count = static_cast<uint32_t>(jit_byte_code.size());
+            optimize_byte_code(reinterpret_cast<ebpf_inst*>(jit_byte_code.data()), &instruction_count, nullptr);
+            jit_byte_code.resize(instruction_count);
+        }
+
         char* error_message = nullptr;
         std::vector<uint8_t> machine_code(1024);
         size_t machine_code_size = machine_code.size();
         REQUIRE(
             ubpf_load(
                 vm,
-                reinterpret_cast<uint8_t*>(byte_code.data()),
-                static_cast<uint32_t>(byte_code.size() * sizeof(ebpf_instruction_t)),
+                reinterpret_cast<uint8_t*>(jit_byte_code.data()),
+                static_cast<uint32_t>(jit_byte_code.size() * sizeof(ebpf_instruction_t)),
                 &error_message) == 0);
         REQUIRE(ubpf_translate(vm, machine_code.data(), &machine_code_size, &error_message) == 0);
         machine_code.resize(machine_code_size);
@@ -96,19 +105,24 @@ typedef class _ebpf_program_test_state
 typedef class _ebpf_map_test_state
 {
   public:
-    _ebpf_map_test_state(ebpf_map_type_t type, std::optional<uint32_t> map_size = {})
+    _ebpf_map_test_state(
+        ebpf_map_type_t type, std::optional<uint32_t> map_size = {}, bool statistics = false, uint32_t map_flags = 0)
     {
         cxplat_utf8_string_t name{(uint8_t*)"test", 4};
         REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
         ebpf_map_definition_in_memory_t definition{
             type, sizeof(uint32_t), sizeof(uint64_t), map_size.has_value() ? map_size.value() : ebpf_get_cpu_count()};
 
-        REQUIRE(ebpf_map_create(&name, &definition, ebpf_handle_invalid, &map) == EBPF_SUCCESS);
+        REQUIRE(
+            ebpf_map_create_with_flags(&name, &definition, ebpf_handle_invalid, map_flags, 0, &map) == EBPF_SUCCESS);
 
         for (uint32_t i = 0; i < definition.max_entries; i++) {
             uint64_t value = 0;
             (void)ebpf_map_update_entry(map, 0, (uint8_t*)&i, 0, (uint8_t*)&value, EBPF_ANY, EBPF_MAP_FLAG_HELPER);
         }
+        if (statistics) {
+            REQUIRE(ebpf_map_set_statistics_enabled(map, true) == EBPF_SUCCESS);
+        }
         // Make the active key range 10% of the map size.
         lru_key_range = definition.max_entries / 10;
         // Start at the end of the key range so that we start evicting keys.
@@ -400,6 +414,62 @@ test_bpf_map_update_elem(bool preemptible)
     measure.run_test();
 }
 
+// Measure the overhead of access statistics against test_bpf_map_lookup_elem_read and test_bpf_map_update_elem.
+template <ebpf_map_type_t map_type>
+void
+test_bpf_map_lookup_elem_read_with_statistics(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    ebpf_map_test_state_t map_test_state(map_type, {}, true);
+    _ebpf_map_test_state_instance = &map_test_state;
+    std::string name = __FUNCTION__;
+    name += "<";
+    name += _ebpf_map_type_t_to_string(map_type);
+    name += ">";
+    _performance_measure measure(name.c_str(), preemptible, _map_find_read_test, iterations);
+    measure.run_test();
+}
+
+template <ebpf_map_type_t map_type>
+void
+test_bpf_map_update_elem_with_statistics(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    ebpf_map_test_state_t map_test_state(map_type, {}, true);
+    _ebpf_map_test_state_instance = &map_test_state;
+    std::string name = __FUNCTION__;
+    name += "<";
+    name += _ebpf_map_type_t_to_string(map_type);
+    name += ">";
+    _performance_measure measure(name.c_str(), preemptible, _map_update_test, iterations);
+    measure.run_test();
+}
+
+extern uint32_t _ebpf_platform_numa_node_count;
+
+// Measure lookups served from the replica of the local NUMA node against test_bpf_map_lookup_elem_read. User mode
+// simulates two nodes, so this measures the cost of selecting the replica; on a multi-node system it also measures
+// the remote memory accesses avoided.
+template <ebpf_map_type_t map_type>
+void
+test_bpf_map_lookup_elem_read_numa_replicated(bool preemptible)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    uint32_t numa_node_count = _ebpf_platform_numa_node_count;
+    _ebpf_platform_numa_node_count = 2;
+    {
+        ebpf_map_test_state_t map_test_state(map_type, {}, false, BPF_F_NUMA_REPLICATED);
+        _ebpf_map_test_state_instance = &map_test_state;
+        std::string name = __FUNCTION__;
+        name += "<";
+        name += _ebpf_map_type_t_to_string(map_type);
+        name += ">";
+        _performance_measure measure(name.c_str(), preemptible, _map_find_read_test, iterations);
+        measure.run_test();
+    }
+    _ebpf_platform_numa_node_count = numa_node_count;
+}
+
 #define LRU_MAP_SIZE 8192
 
 template <ebpf_map_type_t map_type>
@@ -459,6 +529,66 @@ test_program_invoke_interpret(bool preemptible)
     _performance_measure measure(__FUNCTION__, preemptible, _ebpf_program_invoke, iterations);
     measure.run_test();
 }
+
+// Loop with the constant computations, redundant moves and repeated comparisons that clang leaves in programs, used
+// to compare the interpreter with the JIT before and after byte code optimization.
+static const std::vector<ebpf_instruction_t> _redundant_byte_code = {
+    {EBPF_OP_MOV64_IMM, 0, 0, 0, 0},
+    {EBPF_OP_MOV64_IMM, 6, 0, 0, 16},
+    {EBPF_OP_MOV64_REG, 7, 6, 0, 0},
+    {EBPF_OP_ADD64_IMM, 7, 0, 0, 4},
+    {EBPF_OP_MOV64_REG, 7, 7, 0, 0},
+    {EBPF_OP_JGT_IMM, 7, 0, 1, 8},
+    {EBPF_OP_MOV64_IMM, 0, 0, 0, 1},
+    {EBPF_OP_LDDW, 8, 0, 0, 0},
+    {0, 0, 0, 0, 1},
+    {EBPF_OP_LDDW, 8, 0, 0, 0},
+    {0, 0, 0, 0, 1},
+    {EBPF_OP_RSH64_IMM, 8, 0, 0, 32},
+    {EBPF_OP_MOV64_IMM, 1, 0, 0, 0},
+    // Loop: while (r1 < r6) { r0 += r8; r1++; }, with the bound checked twice.
+    {EBPF_OP_JGE_REG, 1, 6, 5, 0},
+    {EBPF_OP_JLT_REG, 1, 6, 1, 0},
+    {EBPF_OP_JA, 0, 0, 3, 0},
+    {EBPF_OP_ADD64_REG, 0, 8, 0, 0},
+    {EBPF_OP_ADD64_IMM, 1, 0, 0, 1},
+    {EBPF_OP_JA, 0, 0, -6, 0},
+    {EBPF_OP_EXIT}};
+
+static void
+_test_program_invoke_redundant(
+    _In_z_ const char* name, bool preemptible, ebpf_code_type_t code_type, bool optimize = false)
+{
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT * 10;
+    _ebpf_program_test_state program_state(_redundant_byte_code);
+    _ebpf_program_test_state_instance = &program_state;
+    if (code_type == EBPF_CODE_JIT) {
+        program_state.prepare_jit_program(optimize);
+    } else {
+        program_state.prepare_interpret_program();
+    }
+
+    _performance_measure measure(name, preemptible, _ebpf_program_invoke, iterations);
+    measure.run_test();
+}
+
+void
+test_redundant_program_invoke_jit(bool preemptible)
+{
+    _test_program_invoke_redundant(__FUNCTION__, preemptible, EBPF_CODE_JIT);
+}
+
+void
+test_redundant_program_invoke_jit_optimized(bool preemptible)
+{
+    _test_program_invoke_redundant(__FUNCTION__, preemptible, EBPF_CODE_JIT, true);
+}
+
+void
+test_redundant_program_invoke_interpret(bool preemptible)
+{
+    _test_program_invoke_redundant(__FUNCTION__, preemptible, EBPF_CODE_EBPF);
+}
 #endif
 
 template <size_t route_count>
@@ -480,9 +610,12 @@ test_lpm_trie_ipv4(bool preemptible)
 
 #if !defined(CONFIG_BPF_JIT_DISABLED)
 PERF_TEST(test_program_invoke_jit);
+PERF_TEST(test_redundant_program_invoke_jit);
+PERF_TEST(test_redundant_program_invoke_jit_optimized);
 #endif
 #if !defined(CONFIG_BPF_INTERPRETER_DISABLED)
 PERF_TEST(test_program_invoke_interpret);
+PERF_TEST(test_redundant_program_invoke_interpret);
 #endif
 PERF_TEST(test_bpf_map_lookup_elem_read<BPF_MAP_TYPE_HASH>);
 PERF_TEST(test_bpf_map_lookup_elem_read<BPF_MAP_TYPE_ARRAY>);
@@ -502,6 +635,17 @@ PERF_TEST(test_bpf_map_update_elem<BPF_MAP_TYPE_PERCPU_HASH>);
 PERF_TEST(test_bpf_map_update_elem<BPF_MAP_TYPE_PERCPU_ARRAY>);
 PERF_TEST(test_bpf_map_update_elem<BPF_MAP_TYPE_LRU_HASH>);
 
+PERF_TEST(test_bpf_map_lookup_elem_read_with_statistics<BPF_MAP_TYPE_HASH>);
+PERF_TEST(test_bpf_map_lookup_elem_read_with_statistics<BPF_MAP_TYPE_ARRAY>);
+PERF_TEST(test_bpf_map_lookup_elem_read_with_statistics<BPF_MAP_TYPE_LRU_HASH>);
+
+PERF_TEST(test_bpf_map_update_elem_with_statistics<BPF_MAP_TYPE_HASH>);
+PERF_TEST(test_bpf_map_update_elem_with_statistics<BPF_MAP_TYPE_ARRAY>);
+PERF_TEST(test_bpf_map_update_elem_with_statistics<BPF_MAP_TYPE_LRU_HASH>);
+
+PERF_TEST(test_bpf_map_lookup_elem_read_numa_replicated<BPF_MAP_TYPE_HASH>);
+PERF_TEST(test_bpf_map_lookup_elem_read_numa_replicated<BPF_MAP_TYPE_ARRAY>);
+
 PERF_TEST(test_bpf_map_update_lru_elem<BPF_MAP_TYPE_LRU_HASH>);
 PERF_TEST(test_bpf_map_lookup_lru_elem<BPF_MAP_TYPE_LRU_HASH>);
 
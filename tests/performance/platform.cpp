@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: MIT
 
 #define TEST_AREA "platform"
+#include "ebpf_clock.h"
 #include "ebpf_hash_table.h"
+#include "ebpf_tracelog.h"
 #include "performance.h"
 
 static void
@@ -13,6 +15,24 @@ _perf_epoch_enter_exit()
     ebpf_epoch_exit(&epoch_state);
 }
 
+static void
+_perf_epoch_enter_migrate_exit(uint32_t cpu_id)
+{
+    ebpf_epoch_state_t epoch_state;
+    ebpf_epoch_enter(&epoch_state);
+    // Only a thread that entered the epoch below DISPATCH_LEVEL can be moved to another CPU before it exits.
+    bool migrate = epoch_state.irql_at_enter < DISPATCH_LEVEL;
+    if (migrate) {
+        usersim_clear_affinity_and_priority_override();
+        usersim_set_affinity_and_priority_override((cpu_id + 1) % ebpf_get_cpu_count());
+    }
+    ebpf_epoch_exit(&epoch_state);
+    if (migrate) {
+        usersim_clear_affinity_and_priority_override();
+        usersim_set_affinity_and_priority_override(cpu_id);
+    }
+}
+
 static void
 _perf_epoch_enter_alloc_free_exit()
 {
@@ -60,6 +80,36 @@ _perf_bpf_ktime_get_ns()
     ebpf_epoch_exit(&epoch_state);
 }
 
+static void
+_perf_bpf_trace_printk()
+{
+    static const char format[] = "a=%llu b=%llx c=%d\n";
+    ebpf_epoch_state_t epoch_state;
+    ebpf_epoch_enter(&epoch_state);
+    (void)ebpf_core_trace_printk5(format, sizeof(format), 1, 2, 3);
+    ebpf_epoch_exit(&epoch_state);
+}
+
+static void
+_perf_bpf_ktime_get_coarse_ns()
+{
+    uint64_t time;
+    ebpf_epoch_state_t epoch_state;
+    ebpf_epoch_enter(&epoch_state);
+    time = ebpf_clock_get_coarse_ns();
+    ebpf_epoch_exit(&epoch_state);
+}
+
+static void
+_perf_bpf_ktime_get_fast_ns()
+{
+    uint64_t time;
+    ebpf_epoch_state_t epoch_state;
+    ebpf_epoch_enter(&epoch_state);
+    time = ebpf_clock_get_fast_ns();
+    ebpf_epoch_exit(&epoch_state);
+}
+
 static void
 _perf_bpf_get_smp_processor_id()
 {
@@ -258,6 +308,26 @@ test_bpf_ktime_get_ns(bool preemptible)
     ebpf_core_terminate();
 }
 
+void
+test_bpf_ktime_get_coarse_ns(bool preemptible)
+{
+    REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    _performance_measure measure(__FUNCTION__, preemptible, _perf_bpf_ktime_get_coarse_ns, iterations);
+    measure.run_test();
+    ebpf_core_terminate();
+}
+
+void
+test_bpf_ktime_get_fast_ns(bool preemptible)
+{
+    REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    _performance_measure measure(__FUNCTION__, preemptible, _perf_bpf_ktime_get_fast_ns, iterations);
+    measure.run_test();
+    ebpf_core_terminate();
+}
+
 void
 test_bpf_get_smp_processor_id(bool preemptible)
 {
@@ -268,6 +338,30 @@ test_bpf_get_smp_processor_id(bool preemptible)
     ebpf_core_terminate();
 }
 
+void
+test_bpf_trace_printk(bool preemptible)
+{
+    REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+    usersim_trace_logging_set_enabled(true, EBPF_TRACELOG_LEVEL_INFO, EBPF_TRACELOG_KEYWORD_PRINTK);
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT / 10;
+    _performance_measure measure(__FUNCTION__, preemptible, _perf_bpf_trace_printk, iterations);
+    measure.run_test();
+    usersim_trace_logging_set_enabled(false, 0, 0);
+    ebpf_core_terminate();
+}
+
+void
+test_bpf_trace_printk_deferred(bool preemptible)
+{
+    REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+    usersim_trace_logging_set_enabled(true, EBPF_TRACELOG_LEVEL_INFO, EBPF_TRACELOG_KEYWORD_PRINTK_DEFERRED);
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT / 10;
+    _performance_measure measure(__FUNCTION__, preemptible, _perf_bpf_trace_printk, iterations);
+    measure.run_test();
+    usersim_trace_logging_set_enabled(false, 0, 0);
+    ebpf_core_terminate();
+}
+
 void
 test_epoch_enter_exit(bool preemptible)
 {
@@ -278,6 +372,20 @@ test_epoch_enter_exit(bool preemptible)
     ebpf_core_terminate();
 }
 
+/**
+ * @brief Measure epoch enter/exit when every exit happens on a different CPU than the matching enter.
+ * The measured time includes the cost of moving the thread between CPUs.
+ */
+void
+test_epoch_enter_migrate_exit(bool preemptible)
+{
+    REQUIRE(ebpf_core_initiate() == EBPF_SUCCESS);
+    size_t iterations = PERFORMANCE_MEASURE_ITERATION_COUNT;
+    _performance_measure measure(__FUNCTION__, preemptible, _perf_epoch_enter_migrate_exit, iterations);
+    measure.run_test();
+    ebpf_core_terminate();
+}
+
 void
 test_epoch_enter_exit_alloc_free(bool preemptible)
 {
@@ -330,6 +438,7 @@ test_ebpf_hash_table_update_overlapping(bool preemptible)
 }
 
 PERF_TEST(test_epoch_enter_exit);
+PERF_TEST(test_epoch_enter_migrate_exit);
 PERF_TEST(test_epoch_enter_exit_alloc_free);
 PERF_TEST(test_ebpf_hash_table_find);
 PERF_TEST(test_ebpf_hash_table_next_key);
@@ -339,4 +448,8 @@ PERF_TEST(test_ebpf_hash_table_update_overlapping);
 PERF_TEST(test_bpf_get_prandom_u32);
 PERF_TEST(test_bpf_ktime_get_boot_ns);
 PERF_TEST(test_bpf_ktime_get_ns);
+PERF_TEST(test_bpf_ktime_get_coarse_ns);
+PERF_TEST(test_bpf_ktime_get_fast_ns);
 PERF_TEST(test_bpf_get_smp_processor_id);
+PERF_TEST(test_bpf_trace_printk);
+PERF_TEST(test_bpf_trace_printk_deferred);
@@ -0,0 +1,67 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+// Whenever this sample program changes, bpf2c_tests will fail unless the
+// expected files in tests\bpf2c_tests\expected are updated. The following
+// script can be used to regenerate the expected files:
+//     generate_expected_bpf2c_output.ps1
+//
+// Usage:
+// .\scripts\generate_expected_bpf2c_output.ps1 <build_output_path>
+// Example:
+// .\scripts\generate_expected_bpf2c_output.ps1 .\x64\Debug\
+
+#include "xdp_common.h"
+
+//
+// Same as reflect_packet, but the headers are located with the bpf_xdp_parse_headers helper instead of being walked
+// by the program. The verifier does not know the values the helper wrote, so each header access is still bounds
+// checked once against data_end.
+//
+SEC("xdp_test/reflect")
+int
+reflect_packet_parsed(xdp_md_t* ctx)
+{
+    int rc = XDP_PASS;
+    xdp_headers_t headers;
+    char* data = (char*)ctx->data;
+    char* data_end = (char*)ctx->data_end;
+
+    if (bpf_xdp_parse_headers(ctx, &headers, sizeof(headers)) < 0) {
+        goto Done;
+    }
+    if (headers.protocol != IPPROTO_UDP || headers.l4_offset == 0 ||
+        headers.destination_port != ntohs(REFLECTION_TEST_PORT)) {
+        goto Done;
+    }
+
+    if (data + sizeof(ETHERNET_HEADER) > data_end) {
+        goto Done;
+    }
+    ETHERNET_HEADER* ethernet_header = (ETHERNET_HEADER*)data;
+
+    UDP_HEADER* udp_header = (UDP_HEADER*)(data + headers.l4_offset);
+    if ((char*)(udp_header + 1) > data_end) {
+        goto Done;
+    }
+
+    if (headers.ip_version == 4) {
+        IPV4_HEADER* ipv4_header = (IPV4_HEADER*)(data + headers.l3_offset);
+        if ((char*)(ipv4_header + 1) > data_end) {
+            goto Done;
+        }
+        swap_ipv4_addresses(ipv4_header);
+    } else {
+        IPV6_HEADER* ipv6_header = (IPV6_HEADER*)(data + headers.l3_offset);
+        if ((char*)(ipv6_header + 1) > data_end) {
+            goto Done;
+        }
+        swap_ipv6_addresses(ipv6_header);
+    }
+    swap_mac_addresses(ethernet_header);
+    swap_ports(udp_header);
+    rc = XDP_TX;
+
+Done:
+    return rc;
+}
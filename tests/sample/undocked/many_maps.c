@@ -0,0 +1,99 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+// Whenever this sample program changes, bpf2c_tests will fail unless the
+// expected files in tests\bpf2c_tests\expected are updated. The following
+// script can be used to regenerate the expected files:
+//     generate_expected_bpf2c_output.ps1
+//
+// Usage:
+// .\scripts\generate_expected_bpf2c_output.ps1 <build_output_path>
+// Example:
+// .\scripts\generate_expected_bpf2c_output.ps1 .\x64\Debug\
+
+// Synthetic module with a large number of maps, used to measure how long it takes to create and pin the maps of a
+// native module. It contains 256 unpinned array maps, 32 array maps pinned by name and 16 array-of-maps maps, each
+// with its own inner map template.
+
+#include "bpf_helpers.h"
+#include "sample_ext_helpers.h"
+
+#define ARRAY_MAP(name)                   \
+    struct                                \
+    {                                     \
+        __uint(type, BPF_MAP_TYPE_ARRAY); \
+        __type(key, uint32_t);            \
+        __type(value, uint32_t);          \
+        __uint(max_entries, 1);           \
+    } name SEC(".maps");
+
+#define PINNED_ARRAY_MAP(name)               \
+    struct                                   \
+    {                                        \
+        __uint(type, BPF_MAP_TYPE_ARRAY);    \
+        __type(key, uint32_t);               \
+        __type(value, uint32_t);             \
+        __uint(max_entries, 1);              \
+        __uint(pinning, LIBBPF_PIN_BY_NAME); \
+    } name SEC(".maps");
+
+#define ARRAY_OF_MAPS(suffix)                     \
+    ARRAY_MAP(inner##suffix)                      \
+    struct                                        \
+    {                                             \
+        __uint(type, BPF_MAP_TYPE_ARRAY_OF_MAPS); \
+        __type(key, uint32_t);                    \
+        __type(value, uint32_t);                  \
+        __uint(max_entries, 1);                   \
+        __array(values, inner##suffix);           \
+    } outer##suffix SEC(".maps");
+
+#define MAPS_16(macro, prefix) \
+    macro(prefix##_0)          \
+    macro(prefix##_1)          \
+    macro(prefix##_2)          \
+    macro(prefix##_3)          \
+    macro(prefix##_4)          \
+    macro(prefix##_5)          \
+    macro(prefix##_6)          \
+    macro(prefix##_7)          \
+    macro(prefix##_8)          \
+    macro(prefix##_9)          \
+    macro(prefix##_a)          \
+    macro(prefix##_b)          \
+    macro(prefix##_c)          \
+    macro(prefix##_d)          \
+    macro(prefix##_e)          \
+    macro(prefix##_f)
+
+MAPS_16(ARRAY_MAP, array_0)
+MAPS_16(ARRAY_MAP, array_1)
+MAPS_16(ARRAY_MAP, array_2)
+MAPS_16(ARRAY_MAP, array_3)
+MAPS_16(ARRAY_MAP, array_4)
+MAPS_16(ARRAY_MAP, array_5)
+MAPS_16(ARRAY_MAP, array_6)
+MAPS_16(ARRAY_MAP, array_7)
+MAPS_16(ARRAY_MAP, array_8)
+MAPS_16(ARRAY_MAP, array_9)
+MAPS_16(ARRAY_MAP, array_a)
+MAPS_16(ARRAY_MAP, array_b)
+MAPS_16(ARRAY_MAP, array_c)
+MAPS_16(ARRAY_MAP, array_d)
+MAPS_16(ARRAY_MAP, array_e)
+MAPS_16(ARRAY_MAP, array_f)
+
+MAPS_16(PINNED_ARRAY_MAP, pinned_0)
+MAPS_16(PINNED_ARRAY_MAP, pinned_1)
+
+MAPS_16(ARRAY_OF_MAPS, )
+
+SEC("sample_ext") int lookup(sample_program_context_t* ctx)
+{
+    uint32_t key = 0;
+    uint32_t* value = (uint32_t*)bpf_map_lookup_elem(&array_0_0, &key);
+    if (value) {
+        return *value;
+    }
+    return 0;
+}
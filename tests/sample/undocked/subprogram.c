@@ -0,0 +1,46 @@
+// Copyright (c) eBPF for Windows contributors
+// SPDX-License-Identifier: MIT
+
+// Whenever this sample program changes, bpf2c_tests will fail unless the
+// expected files in tests\bpf2c_tests\expected are updated. The following
+// script can be used to regenerate the expected files:
+//     generate_expected_bpf2c_output.ps1
+//
+// Usage:
+// .\scripts\generate_expected_bpf2c_output.ps1 <build_output_path>
+// Example:
+// .\scripts\generate_expected_bpf2c_output.ps1 .\x64\Debug\
+
+// The map accesses are kept in __noinline functions in .text, so the program reaches them through BPF-to-BPF calls
+// and bpf2c has to apply the .text relocations to the subprograms it appends.
+
+#include "bpf_helpers.h"
+#include "sample_ext_helpers.h"
+
+struct
+{
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __type(key, uint32_t);
+    __type(value, uint32_t);
+    __uint(max_entries, 1);
+} counter_map SEC(".maps");
+
+static __noinline uint32_t
+read_counter(uint32_t key)
+{
+    uint32_t* value = (uint32_t*)bpf_map_lookup_elem(&counter_map, &key);
+    return value ? *value : 0;
+}
+
+static __noinline int
+write_counter(uint32_t key, uint32_t value)
+{
+    return (int)bpf_map_update_elem(&counter_map, &key, &value, 0);
+}
+
+SEC("sample_ext") int increment_counter(sample_program_context_t* ctx)
+{
+    uint32_t key = ctx->uint32_data;
+    uint32_t value = read_counter(key) + 1;
+    return write_counter(key, value);
+}
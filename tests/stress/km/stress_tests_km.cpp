@@ -1091,6 +1091,152 @@ _mt_sockaddr_invoke_program_test(const test_control_info& test_control_info)
     }
 }
 
+static void
+_close_socket_pair(std::pair<SOCKET, SOCKET>& socket_pair)
+{
+    if (socket_pair.first != INVALID_SOCKET) {
+        closesocket(socket_pair.first);
+        socket_pair.first = INVALID_SOCKET;
+    }
+    if (socket_pair.second != INVALID_SOCKET) {
+        closesocket(socket_pair.second);
+        socket_pair.second = INVALID_SOCKET;
+    }
+}
+
+static void
+_invoke_mt_sock_ops_connection_churn_thread_function(
+    thread_context& context, std::vector<std::pair<SOCKET, SOCKET>>& open_connections, uint64_t& connection_count)
+{
+    SOCKET listen_socket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+    REQUIRE(listen_socket != INVALID_SOCKET);
+
+    SOCKADDR_STORAGE local_endpoint{};
+    local_endpoint.ss_family = AF_INET6;
+    INETADDR_SETLOOPBACK(reinterpret_cast<PSOCKADDR>(&local_endpoint));
+    uint16_t local_port = SOCKET_TEST_PORT + static_cast<uint16_t>(context.thread_index);
+    (reinterpret_cast<PSOCKADDR_IN6>(&local_endpoint))->sin6_port = htons(local_port);
+    REQUIRE(
+        bind(listen_socket, reinterpret_cast<SOCKADDR*>(&local_endpoint), static_cast<int>(sizeof(local_endpoint))) ==
+        0);
+    REQUIRE(listen(listen_socket, SOMAXCONN) == 0);
+
+    // Keep a window of connections open so that flow establishment and flow deletion are interleaved, and so that the
+    // program detach at the end of the test has live flows to clean up.
+    size_t next_slot = 0;
+    using sc = std::chrono::steady_clock;
+    auto endtime = sc::now() + std::chrono::minutes(context.duration_minutes);
+    while (sc::now() < endtime) {
+        auto& connection = open_connections[next_slot];
+        next_slot = (next_slot + 1) % open_connections.size();
+        _close_socket_pair(connection);
+
+        connection.first = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+        REQUIRE(connection.first != INVALID_SOCKET);
+        if (connect(
+                connection.first,
+                reinterpret_cast<SOCKADDR*>(&local_endpoint),
+                static_cast<int>(sizeof(local_endpoint))) != 0) {
+            LOG_VERBOSE("Thread[{}] connect failed. error:{}", context.thread_index, WSAGetLastError());
+            _close_socket_pair(connection);
+            continue;
+        }
+        connection.second = accept(listen_socket, nullptr, nullptr);
+        REQUIRE(connection.second != INVALID_SOCKET);
+        connection_count++;
+    }
+    closesocket(listen_socket);
+    LOG_VERBOSE("Thread[{}] Done. connections:{}", context.thread_index, connection_count);
+}
+
+static void
+_mt_sock_ops_connection_churn_test(const test_control_info& test_control_info)
+{
+    WSAData data{};
+    auto error = WSAStartup(MAKEWORD(2, 2), &data);
+    REQUIRE(error == 0);
+
+    auto [program_object, _] = _load_attach_program({"sockops.sys"}, BPF_CGROUP_SOCK_OPS, 0);
+
+    // Not used, needed for thread_context initialization.
+    std::vector<object_table_entry> dummy_table(1);
+
+    constexpr size_t OPEN_CONNECTIONS_PER_THREAD = 64;
+    size_t total_threads = test_control_info.threads_count;
+    std::vector<thread_context> thread_context_table(
+        total_threads, {{}, {}, false, {}, thread_role_type::ROLE_NOT_SET, 0, 0, 0, false, 0, 0, dummy_table});
+    std::vector<std::vector<std::pair<SOCKET, SOCKET>>> open_connections_table(
+        total_threads,
+        std::vector<std::pair<SOCKET, SOCKET>>(OPEN_CONNECTIONS_PER_THREAD, {INVALID_SOCKET, INVALID_SOCKET}));
+    std::vector<uint64_t> connection_count_table(total_threads, 0);
+    std::vector<std::thread> test_thread_table(total_threads);
+    auto start_time = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < total_threads; i++) {
+
+        // First, prepare the context for this thread.
+        auto& context_entry = thread_context_table[i];
+        context_entry.is_native_program = true;
+        context_entry.role = thread_role_type::MONITOR_IPV6;
+        context_entry.thread_index = i;
+        context_entry.duration_minutes = test_control_info.duration_minutes;
+        context_entry.extension_restart_enabled = test_control_info.extension_restart_enabled;
+
+        // Now create the thread.
+        auto& thread_entry = test_thread_table[i];
+        thread_entry = std::move(std::thread(
+            _invoke_mt_sock_ops_connection_churn_thread_function,
+            std::ref(context_entry),
+            std::ref(open_connections_table[i]),
+            std::ref(connection_count_table[i])));
+    }
+
+    // Another table for the 'extension restart' threads.
+    std::vector<std::thread> extension_restart_thread_table{};
+
+    // If requested, start the 'extension stop-and-restart' thread for extension for this program type.
+    std::string extension_name = {"netebpfext"};
+    if (test_control_info.extension_restart_enabled) {
+        auto restart_thread = _start_extension_restart_thread(
+            std::ref(extension_name), test_control_info.extension_restart_delay_ms, test_control_info.duration_minutes);
+        extension_restart_thread_table.push_back(std::move(restart_thread));
+    }
+
+    // Wait for threads to terminate.
+    LOG_INFO("waiting on {} test threads...", test_thread_table.size());
+    for (auto& t : test_thread_table) {
+        t.join();
+    }
+    std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start_time;
+    double elapsed_seconds = elapsed_time.count();
+
+    if (test_control_info.extension_restart_enabled) {
+        LOG_INFO("waiting on {} extension restart threads...", extension_restart_thread_table.size());
+        for (auto& t : extension_restart_thread_table) {
+            t.join();
+        }
+    }
+
+    uint64_t total_connections = 0;
+    for (auto count : connection_count_table) {
+        total_connections += count;
+    }
+    LOG_INFO(
+        "established {} connections in {:.1f} seconds ({:.0f} connections/second)",
+        total_connections,
+        elapsed_seconds,
+        (elapsed_seconds > 0) ? total_connections / elapsed_seconds : 0);
+    REQUIRE(total_connections > 0);
+
+    // Detach the program while connections are still open so that the flow contexts of live flows are cleaned up in
+    // bulk, then close the connections after the program is gone.
+    program_object.reset();
+    for (auto& open_connections : open_connections_table) {
+        for (auto& connection : open_connections) {
+            _close_socket_pair(connection);
+        }
+    }
+}
+
 static void
 _print_test_control_info(const test_control_info& test_control_info)
 {
@@ -1532,6 +1678,32 @@ TEST_CASE("sockaddr_invoke_program_test", "[native_mt_stress_test]")
     _mt_sockaddr_invoke_program_test(local_test_control_info);
 }
 
+TEST_CASE("sock_ops_connection_churn_test", "[native_mt_stress_test]")
+{
+    // Test layout:
+    // 1. Load and attach the "sockops.sys" native ebpf program to CGROUP/SOCK_OPS.
+    //
+    // 2. Create the specified # of threads and for the duration of test, each thread will:
+    //    - Listen on [::1]:<target_port + thread_context.thread_index>.
+    //    - Continuously connect to and accept from that endpoint, keeping a fixed window of connections open and
+    //      closing the oldest connection each time a new one is established.
+    //
+    //    Every established connection creates a sock_ops flow context and every closed connection deletes one, so the
+    //    threads exercise concurrent flow context allocation, tracking and release in netebpfext.
+    //
+    // 3. At the end of the test, detach the program while each thread still holds its window of open connections so
+    //    that the flow contexts of live flows are removed in bulk, and report the connection rate.
+    //
+    // 4. If specified, start the 'extension restart' thread as well to continuously restart the netebpf extension.
+
+    _km_test_init();
+    LOG_INFO("\nStarting test *** sock_ops_connection_churn_test ***");
+    test_control_info local_test_control_info = _global_test_control_info;
+
+    _print_test_control_info(local_test_control_info);
+    _mt_sock_ops_connection_churn_test(local_test_control_info);
+}
+
 // The following test is currently disabled due to a potential WFP bug exposed while investigating Issue #3337.
 #if (defined ENABLE_TAIL_CALL_STRESS_TEST)
 TEST_CASE("bindmonitor_tail_call_invoke_program_test", "[native_mt_stress_test]")
@@ -6,6 +6,8 @@
 #include "catch_wrapper.hpp"
 #include "export_program_info.cpp"
 
+#include <chrono>
+
 static void
 _populate_ebpf_store()
 {
@@ -21,3 +23,232 @@ TEST_CASE("export_program_info", "[end_to_end]")
     // Re-populate the ebpf store.
     _populate_ebpf_store();
 }
+
+/**
+ * @brief Program, section and global helper information loaded from the eBPF store.
+ */
+typedef struct _loaded_store_information
+{
+    ebpf_program_info_t** program_info = nullptr;
+    uint32_t program_info_count = 0;
+    ebpf_section_definition_t** section_info = nullptr;
+    uint32_t section_info_count = 0;
+    ebpf_helper_function_prototype_t* helper_info = nullptr;
+    uint32_t helper_info_count = 0;
+
+    void
+    load()
+    {
+        REQUIRE(ebpf_store_load_program_data(&program_info, &program_info_count) == EBPF_SUCCESS);
+        REQUIRE(ebpf_store_load_section_information(&section_info, &section_info_count) == EBPF_SUCCESS);
+        REQUIRE(ebpf_store_load_global_helper_information(&helper_info, &helper_info_count) == EBPF_SUCCESS);
+    }
+
+    void
+    release()
+    {
+        for (uint32_t index = 0; index < program_info_count; index++) {
+            ebpf_program_info_free(program_info[index]);
+        }
+        ebpf_free(program_info);
+        program_info = nullptr;
+        program_info_count = 0;
+
+        for (uint32_t index = 0; index < section_info_count; index++) {
+            ebpf_free(section_info[index]->program_type);
+            ebpf_free(section_info[index]->attach_type);
+            ebpf_free((void*)section_info[index]->section_prefix);
+            ebpf_free(section_info[index]);
+        }
+        ebpf_free(section_info);
+        section_info = nullptr;
+        section_info_count = 0;
+
+        for (uint32_t index = 0; index < helper_info_count; index++) {
+            ebpf_free((void*)helper_info[index].name);
+        }
+        ebpf_free(helper_info);
+        helper_info = nullptr;
+        helper_info_count = 0;
+    }
+
+    ~_loaded_store_information() { release(); }
+} loaded_store_information_t;
+
+static std::vector<uint8_t>
+_read_store_snapshot()
+{
+    unsigned long size = 0;
+    if (RegGetValue(
+            HKEY_CURRENT_USER,
+            EBPF_STORE_REGISTRY_PATH,
+            EBPF_STORE_SNAPSHOT,
+            RRF_RT_REG_BINARY,
+            nullptr,
+            nullptr,
+            &size) != ERROR_SUCCESS) {
+        return {};
+    }
+    std::vector<uint8_t> snapshot(size);
+    REQUIRE(
+        RegGetValue(
+            HKEY_CURRENT_USER,
+            EBPF_STORE_REGISTRY_PATH,
+            EBPF_STORE_SNAPSHOT,
+            RRF_RT_REG_BINARY,
+            nullptr,
+            snapshot.data(),
+            &size) == ERROR_SUCCESS);
+    return snapshot;
+}
+
+static void
+_write_store_snapshot(const std::vector<uint8_t>& snapshot)
+{
+    REQUIRE(
+        RegSetKeyValue(
+            HKEY_CURRENT_USER,
+            EBPF_STORE_REGISTRY_PATH,
+            EBPF_STORE_SNAPSHOT,
+            REG_BINARY,
+            snapshot.data(),
+            (unsigned long)snapshot.size()) == ERROR_SUCCESS);
+}
+
+static void
+_verify_same_store_information(const loaded_store_information_t& expected, const loaded_store_information_t& actual)
+{
+    REQUIRE(actual.program_info_count == expected.program_info_count);
+    for (uint32_t index = 0; index < expected.program_info_count; index++) {
+        const ebpf_program_type_descriptor_t* expected_descriptor =
+            expected.program_info[index]->program_type_descriptor;
+        const ebpf_program_info_t* match = nullptr;
+        for (uint32_t actual_index = 0; actual_index < actual.program_info_count; actual_index++) {
+            if (IsEqualGUID(
+                    actual.program_info[actual_index]->program_type_descriptor->program_type,
+                    expected_descriptor->program_type)) {
+                match = actual.program_info[actual_index];
+            }
+        }
+        REQUIRE(match != nullptr);
+        REQUIRE(std::string(match->program_type_descriptor->name) == expected_descriptor->name);
+        REQUIRE(match->program_type_descriptor->bpf_prog_type == expected_descriptor->bpf_prog_type);
+        REQUIRE(match->program_type_descriptor->is_privileged == expected_descriptor->is_privileged);
+        REQUIRE(
+            memcmp(
+                match->program_type_descriptor->context_descriptor,
+                expected_descriptor->context_descriptor,
+                sizeof(ebpf_context_descriptor_t)) == 0);
+        REQUIRE(
+            match->count_of_program_type_specific_helpers ==
+            expected.program_info[index]->count_of_program_type_specific_helpers);
+    }
+
+    REQUIRE(actual.section_info_count == expected.section_info_count);
+    for (uint32_t index = 0; index < expected.section_info_count; index++) {
+        const ebpf_section_definition_t* expected_section = expected.section_info[index];
+        const ebpf_section_definition_t* match = nullptr;
+        for (uint32_t actual_index = 0; actual_index < actual.section_info_count; actual_index++) {
+            if (std::string(actual.section_info[actual_index]->section_prefix) == expected_section->section_prefix) {
+                match = actual.section_info[actual_index];
+            }
+        }
+        REQUIRE(match != nullptr);
+        REQUIRE(IsEqualGUID(*match->program_type, *expected_section->program_type));
+        REQUIRE(IsEqualGUID(*match->attach_type, *expected_section->attach_type));
+        REQUIRE(match->bpf_prog_type == expected_section->bpf_prog_type);
+        REQUIRE(match->bpf_attach_type == expected_section->bpf_attach_type);
+    }
+
+    REQUIRE(actual.helper_info_count == expected.helper_info_count);
+    for (uint32_t index = 0; index < expected.helper_info_count; index++) {
+        const ebpf_helper_function_prototype_t* expected_helper = &expected.helper_info[index];
+        const ebpf_helper_function_prototype_t* match = nullptr;
+        for (uint32_t actual_index = 0; actual_index < actual.helper_info_count; actual_index++) {
+            if (actual.helper_info[actual_index].helper_id == expected_helper->helper_id) {
+                match = &actual.helper_info[actual_index];
+            }
+        }
+        REQUIRE(match != nullptr);
+        REQUIRE(std::string(match->name) == expected_helper->name);
+        REQUIRE(match->return_type == expected_helper->return_type);
+        REQUIRE(memcmp(match->arguments, expected_helper->arguments, sizeof(match->arguments)) == 0);
+        REQUIRE(match->flags.reallocate_packet == expected_helper->flags.reallocate_packet);
+    }
+}
+
+TEST_CASE("export_program_info_snapshot", "[end_to_end]")
+{
+    REQUIRE(clear_ebpf_store() == 0);
+    _populate_ebpf_store();
+    REQUIRE(_read_store_snapshot().empty());
+
+    // Load from the per-key layout.
+    loaded_store_information_t per_key_information;
+    per_key_information.load();
+    REQUIRE(per_key_information.program_info_count > 0);
+    REQUIRE(per_key_information.section_info_count > 0);
+    REQUIRE(per_key_information.helper_info_count > 0);
+
+    // Load from the snapshot.
+    REQUIRE(export_program_information_snapshot() == 0);
+    std::vector<uint8_t> snapshot = _read_store_snapshot();
+    REQUIRE(snapshot.size() > sizeof(ebpf_store_snapshot_header_t));
+    {
+        loaded_store_information_t snapshot_information;
+        snapshot_information.load();
+        _verify_same_store_information(per_key_information, snapshot_information);
+    }
+
+    // A corrupt snapshot fails hash validation and the per-key layout is used instead.
+    snapshot[snapshot.size() / 2] ^= 0xFF;
+    _write_store_snapshot(snapshot);
+    {
+        loaded_store_information_t fallback_information;
+        fallback_information.load();
+        _verify_same_store_information(per_key_information, fallback_information);
+    }
+
+    // A snapshot with an unknown version is ignored.
+    snapshot[snapshot.size() / 2] ^= 0xFF;
+    reinterpret_cast<ebpf_store_snapshot_header_t*>(snapshot.data())->version = EBPF_STORE_SNAPSHOT_CURRENT_VERSION + 1;
+    _write_store_snapshot(snapshot);
+    {
+        loaded_store_information_t fallback_information;
+        fallback_information.load();
+        _verify_same_store_information(per_key_information, fallback_information);
+    }
+
+    // Updating the per-key layout deletes the snapshot.
+    REQUIRE(export_program_information_snapshot() == 0);
+    REQUIRE(!_read_store_snapshot().empty());
+    REQUIRE(export_all_section_information() == 0);
+    REQUIRE(_read_store_snapshot().empty());
+}
+
+TEST_CASE("export_program_info_snapshot_load_time", "[end_to_end]")
+{
+    const size_t iterations = 100;
+    REQUIRE(clear_ebpf_store() == 0);
+    _populate_ebpf_store();
+
+    auto measure = [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t iteration = 0; iteration < iterations; iteration++) {
+            loaded_store_information_t information;
+            information.load();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / (double)iterations;
+    };
+
+    double per_key_load_time = measure();
+    REQUIRE(export_program_information_snapshot() == 0);
+    double snapshot_load_time = measure();
+
+    // Leave the store as the other tests expect it.
+    REQUIRE(ebpf_store_delete_snapshot() == EBPF_SUCCESS);
+
+    printf("store_load,per_key_us,snapshot_us\n");
+    printf("store_load,%.0f,%.0f\n", per_key_load_time, snapshot_load_time);
+}
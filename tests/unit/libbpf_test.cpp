@@ -17,6 +17,7 @@
 #include "program_helper.h"
 #include "test_helper.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <stop_token>
@@ -1574,6 +1575,206 @@ _test_bind_fd_to_prog_array(ebpf_execution_type_t execution_type)
 
 DECLARE_ALL_TEST_CASES("disallow setting bind fd in sample prog array", "[libbpf]", _test_bind_fd_to_prog_array);
 
+static uint32_t
+_get_program_link_count(int program_fd)
+{
+    bpf_prog_info program_info = {};
+    uint32_t program_info_size = sizeof(program_info);
+    REQUIRE(bpf_obj_get_info_by_fd(program_fd, &program_info, &program_info_size) == 0);
+    return program_info.link_count;
+}
+
+static void
+_test_link_update(ebpf_execution_type_t execution_type)
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+    single_instance_hook_t hook(EBPF_PROGRAM_TYPE_SAMPLE, EBPF_ATTACH_TYPE_SAMPLE);
+    REQUIRE(hook.initialize() == EBPF_SUCCESS);
+    program_info_provider_t bind_program_info;
+    REQUIRE(bind_program_info.initialize(EBPF_PROGRAM_TYPE_BIND) == EBPF_SUCCESS);
+    program_info_provider_t sample_program_info;
+    REQUIRE(sample_program_info.initialize(EBPF_PROGRAM_TYPE_SAMPLE) == EBPF_SUCCESS);
+
+    // The prog array is left empty, so "caller" returns 6 and "callee" returns 42.
+    const char* file_name = (execution_type == EBPF_EXECUTION_NATIVE ? "tail_call_um.dll" : "tail_call.o");
+    struct bpf_object* sample_object = bpf_object__open(file_name);
+    REQUIRE(sample_object != nullptr);
+    REQUIRE(bpf_object__load(sample_object) == 0);
+
+    struct bpf_program* caller = bpf_object__find_program_by_name(sample_object, "caller");
+    REQUIRE(caller != nullptr);
+    struct bpf_program* callee = bpf_object__find_program_by_name(sample_object, "callee");
+    REQUIRE(callee != nullptr);
+    int caller_fd = bpf_program__fd(caller);
+    int callee_fd = bpf_program__fd(callee);
+
+    const char* another_file_name = (execution_type == EBPF_EXECUTION_NATIVE ? "bindmonitor_um.dll" : "bindmonitor.o");
+    struct bpf_object* bind_object = bpf_object__open(another_file_name);
+    REQUIRE(bind_object != nullptr);
+    REQUIRE(bpf_object__load(bind_object) == 0);
+    struct bpf_program* bind_program = bpf_object__find_program_by_name(bind_object, "BindMonitor");
+    REQUIRE(bind_program != nullptr);
+
+    bpf_link_ptr link(bpf_program__attach(caller));
+    REQUIRE(link != nullptr);
+    int link_fd = bpf_link__fd(link.get());
+
+    sample_program_context_t ctx{0};
+    uint32_t result;
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 6);
+
+    // Swap to the callee without detaching the link.
+    REQUIRE(bpf_link_update(link_fd, callee_fd, nullptr) == 0);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 42);
+    REQUIRE(_get_program_link_count(caller_fd) == 0);
+    REQUIRE(_get_program_link_count(callee_fd) == 1);
+
+    bpf_prog_info program_info = {};
+    uint32_t program_info_size = sizeof(program_info);
+    REQUIRE(bpf_obj_get_info_by_fd(callee_fd, &program_info, &program_info_size) == 0);
+    bpf_link_info link_info = {};
+    uint32_t link_info_size = sizeof(link_info);
+    REQUIRE(bpf_obj_get_info_by_fd(link_fd, &link_info, &link_info_size) == 0);
+    REQUIRE(link_info.prog_id == program_info.id);
+
+    // The update fails if the link is not attached to the expected program.
+    struct bpf_link_update_opts opts = {.sz = sizeof(opts), .flags = BPF_F_REPLACE, .old_prog_fd = (uint32_t)caller_fd};
+    REQUIRE(bpf_link_update(link_fd, caller_fd, &opts) < 0);
+    REQUIRE(errno == EINVAL);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 42);
+
+    // Swap back to the caller via bpf().
+    union bpf_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.link_update.link_fd = link_fd;
+    attr.link_update.new_prog_fd = caller_fd;
+    attr.link_update.flags = BPF_F_REPLACE;
+    attr.link_update.old_prog_fd = callee_fd;
+    REQUIRE(bpf(BPF_LINK_UPDATE, &attr, sizeof(attr)) == 0);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 6);
+    REQUIRE(_get_program_link_count(caller_fd) == 1);
+    REQUIRE(_get_program_link_count(callee_fd) == 0);
+
+    // Unknown flags are rejected.
+    opts.flags = 1;
+    REQUIRE(bpf_link_update(link_fd, callee_fd, &opts) < 0);
+    REQUIRE(errno == EINVAL);
+
+    // A program of a different type can't be attached to the link.
+    REQUIRE(bpf_link__update_program(link.get(), bind_program) < 0);
+    REQUIRE(errno == EINVAL);
+
+    // Neither can a program of the same type that was loaded for a different attach type. Native programs have
+    // their attach type fixed at compile time, so this is only checked for the other execution types.
+    if (execution_type != EBPF_EXECUTION_NATIVE) {
+        struct bpf_object* other_object = bpf_object__open(file_name);
+        REQUIRE(other_object != nullptr);
+        struct bpf_program* other_callee = bpf_object__find_program_by_name(other_object, "callee");
+        REQUIRE(other_callee != nullptr);
+        REQUIRE(bpf_program__set_expected_attach_type(other_callee, BPF_ATTACH_TYPE_BIND) == 0);
+        REQUIRE(bpf_object__load(other_object) == 0);
+        REQUIRE(bpf_link__update_program(link.get(), other_callee) < 0);
+        REQUIRE(errno == EINVAL);
+        REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+        REQUIRE(result == 6);
+        bpf_object__close(other_object);
+    }
+
+    REQUIRE(bpf_link__update_program(link.get(), callee) == 0);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 42);
+    REQUIRE(_get_program_link_count(caller_fd) == 0);
+    REQUIRE(_get_program_link_count(callee_fd) == 1);
+
+    // A detached link can't be updated.
+    REQUIRE(bpf_link_detach(link_fd) == 0);
+    REQUIRE(bpf_link_update(link_fd, caller_fd, nullptr) < 0);
+    REQUIRE(errno == EINVAL);
+
+    REQUIRE(bpf_link_update(ebpf_fd_invalid, caller_fd, nullptr) < 0);
+    REQUIRE(errno == EBADF);
+
+    REQUIRE(bpf_link__destroy(link.release()) == 0);
+    bpf_object__close(bind_object);
+    bpf_object__close(sample_object);
+}
+
+DECLARE_ALL_TEST_CASES("libbpf link update", "[libbpf]", _test_link_update);
+
+static void
+_test_link_update_close_old_program(ebpf_execution_type_t execution_type)
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+    single_instance_hook_t hook(EBPF_PROGRAM_TYPE_SAMPLE, EBPF_ATTACH_TYPE_SAMPLE);
+    REQUIRE(hook.initialize() == EBPF_SUCCESS);
+    program_info_provider_t sample_program_info;
+    REQUIRE(sample_program_info.initialize(EBPF_PROGRAM_TYPE_SAMPLE) == EBPF_SUCCESS);
+
+    // Load the two programs from separate objects so that the old one can be closed on its own.
+    struct bpf_object* old_object = bpf_object__open("tail_call.o");
+    REQUIRE(old_object != nullptr);
+    struct bpf_program* caller = bpf_object__find_program_by_name(old_object, "caller");
+    REQUIRE(caller != nullptr);
+    REQUIRE(ebpf_object_set_execution_type(old_object, execution_type) == EBPF_SUCCESS);
+    REQUIRE(bpf_object__load(old_object) == 0);
+    int caller_fd = bpf_program__fd(caller);
+
+    struct bpf_object* new_object = bpf_object__open("tail_call.o");
+    REQUIRE(new_object != nullptr);
+    REQUIRE(ebpf_object_set_execution_type(new_object, execution_type) == EBPF_SUCCESS);
+    REQUIRE(bpf_object__load(new_object) == 0);
+    struct bpf_program* callee = bpf_object__find_program_by_name(new_object, "callee");
+    REQUIRE(callee != nullptr);
+    int callee_fd = bpf_program__fd(callee);
+
+    bpf_link_ptr link(bpf_program__attach(caller));
+    REQUIRE(link != nullptr);
+    int link_fd = bpf_link__fd(link.get());
+
+    // Swap A -> B -> A -> B, checking that each program tracks the link exactly when it is attached to it.
+    for (int i = 0; i < 3; i++) {
+        bool to_callee = (i % 2 == 0);
+        REQUIRE(bpf_link_update(link_fd, to_callee ? callee_fd : caller_fd, nullptr) == 0);
+        REQUIRE(_get_program_link_count(caller_fd) == (to_callee ? 0u : 1u));
+        REQUIRE(_get_program_link_count(callee_fd) == (to_callee ? 1u : 0u));
+    }
+
+    sample_program_context_t ctx{0};
+    uint32_t result;
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 42);
+
+    // Freeing the old program must not touch the link that moved away from it.
+    bpf_object__close(old_object);
+    REQUIRE(hook.fire(&ctx, &result) == EBPF_SUCCESS);
+    REQUIRE(result == 42);
+
+    bpf_prog_info program_info = {};
+    uint32_t program_info_size = sizeof(program_info);
+    REQUIRE(bpf_obj_get_info_by_fd(callee_fd, &program_info, &program_info_size) == 0);
+    REQUIRE(program_info.link_count == 1);
+    bpf_link_info link_info = {};
+    uint32_t link_info_size = sizeof(link_info);
+    REQUIRE(bpf_obj_get_info_by_fd(link_fd, &link_info, &link_info_size) == 0);
+    REQUIRE(link_info.prog_id == program_info.id);
+
+    REQUIRE(bpf_link_detach(link_fd) == 0);
+    REQUIRE(_get_program_link_count(callee_fd) == 0);
+    REQUIRE(bpf_link__destroy(link.release()) == 0);
+    bpf_object__close(new_object);
+}
+
+// A native module can only be loaded once, so the two objects this test needs are only available in the other
+// execution types.
+DECLARE_JIT_TEST("libbpf link update close old program", "[libbpf]", _test_link_update_close_old_program);
+DECLARE_INTERPRET_TEST("libbpf link update close old program", "[libbpf]", _test_link_update_close_old_program);
+
 static void
 _load_inner_map(ebpf_execution_type_t execution_type)
 {
@@ -2002,6 +2203,67 @@ TEST_CASE("enumerate map IDs", "[libbpf]")
     Platform::_close(fd2);
 }
 
+TEST_CASE("enumerate map info in batches", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    struct bpf_map_info infos[2];
+    uint32_t count = _countof(infos);
+    ebpf_id_t next_id;
+
+    // Verify the enumeration is empty.
+    REQUIRE(ebpf_get_map_info_batch(0, infos, &count, &next_id) == EBPF_NO_MORE_KEYS);
+
+    // Create more maps than fit in a single batch.
+    std::vector<ebpf_id_t> map_ids;
+    std::vector<fd_t> map_fds;
+    for (uint32_t i = 0; i < 5; i++) {
+        fd_t map_fd = bpf_map_create(BPF_MAP_TYPE_ARRAY, nullptr, sizeof(__u32), sizeof(__u32), i + 1, nullptr);
+        REQUIRE(map_fd > 0);
+        map_fds.push_back(map_fd);
+
+        struct bpf_map_info info;
+        uint32_t info_size = sizeof(info);
+        REQUIRE(bpf_obj_get_info_by_fd(map_fd, &info, &info_size) == 0);
+        map_ids.push_back(info.id);
+    }
+
+    // A zero-sized batch is rejected.
+    count = 0;
+    REQUIRE(ebpf_get_map_info_batch(0, infos, &count, &next_id) == EBPF_INVALID_ARGUMENT);
+
+    // Enumerate the maps two at a time and verify the records come back in ID order.
+    std::vector<ebpf_id_t> enumerated_ids;
+    ebpf_id_t start_id = 0;
+    for (;;) {
+        count = _countof(infos);
+        ebpf_result_t result = ebpf_get_map_info_batch(start_id, infos, &count, &next_id);
+        if (result == EBPF_NO_MORE_KEYS) {
+            break;
+        }
+        REQUIRE(result == EBPF_SUCCESS);
+        REQUIRE(count <= _countof(infos));
+        REQUIRE(next_id > start_id);
+        for (uint32_t i = 0; i < count; i++) {
+            REQUIRE(infos[i].type == BPF_MAP_TYPE_ARRAY);
+            REQUIRE(infos[i].max_entries == (uint32_t)enumerated_ids.size() + 1);
+            enumerated_ids.push_back(infos[i].id);
+        }
+        start_id = next_id;
+    }
+    REQUIRE(enumerated_ids == map_ids);
+
+    // Programs and links are not returned as maps.
+    count = _countof(infos);
+    struct bpf_prog_info program_infos[2];
+    REQUIRE(ebpf_get_program_info_batch(0, program_infos, &count, &next_id) == EBPF_NO_MORE_KEYS);
+
+    for (fd_t map_fd : map_fds) {
+        Platform::_close(map_fd);
+    }
+}
+
 #if !defined(CONFIG_BPF_JIT_DISABLED)
 TEST_CASE("enumerate link IDs", "[libbpf]")
 {
@@ -3565,6 +3827,521 @@ TEST_CASE("libbpf hash map batch", "[libbpf]") { _test_maps_batch(BPF_MAP_TYPE_H
 
 TEST_CASE("libbpf lru hash map batch", "[libbpf]") { _test_maps_batch(BPF_MAP_TYPE_LRU_HASH); }
 
+TEST_CASE("libbpf map lookup by keys", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    const uint32_t max_entries = 40000;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+
+    // Populate the even keys only, so that the odd keys are reported as not found.
+    for (uint32_t key = 0; key < max_entries; key += 2) {
+        uint64_t value = static_cast<uint64_t>(key) * 3;
+        REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    }
+
+    // Use more keys than fit in a single request.
+    std::vector<uint32_t> keys(max_entries);
+    for (uint32_t i = 0; i < max_entries; i++) {
+        keys[i] = max_entries - 1 - i;
+    }
+    std::vector<uint64_t> values(max_entries, UINT64_MAX);
+    std::vector<ebpf_result_t> results(max_entries, EBPF_FAILED);
+    REQUIRE(
+        ebpf_map_lookup_elements_by_keys(map_fd, keys.data(), values.data(), results.data(), max_entries, 0) ==
+        EBPF_SUCCESS);
+    for (uint32_t i = 0; i < max_entries; i++) {
+        if (keys[i] % 2 == 0) {
+            REQUIRE(results[i] == EBPF_SUCCESS);
+            REQUIRE(values[i] == static_cast<uint64_t>(keys[i]) * 3);
+        } else {
+            REQUIRE(results[i] == EBPF_OBJECT_NOT_FOUND);
+            REQUIRE(values[i] == 0);
+        }
+    }
+
+    // Look up and delete the first few keys.
+    const uint32_t delete_count = 10;
+    REQUIRE(
+        ebpf_map_lookup_and_delete_elements_by_keys(
+            map_fd, keys.data(), values.data(), results.data(), delete_count, 0) == EBPF_SUCCESS);
+    for (uint32_t i = 0; i < delete_count; i++) {
+        uint64_t value;
+        REQUIRE(results[i] == ((keys[i] % 2 == 0) ? EBPF_SUCCESS : EBPF_OBJECT_NOT_FOUND));
+        REQUIRE(bpf_map_lookup_elem(map_fd, &keys[i], &value) == -ENOENT);
+    }
+
+    // Negative tests.
+    REQUIRE(
+        ebpf_map_lookup_elements_by_keys(map_fd, keys.data(), values.data(), results.data(), 0, 0) ==
+        EBPF_INVALID_ARGUMENT);
+    REQUIRE(
+        ebpf_map_lookup_elements_by_keys(map_fd, keys.data(), values.data(), results.data(), 1, 0x100) ==
+        EBPF_INVALID_ARGUMENT);
+    REQUIRE(
+        ebpf_map_lookup_elements_by_keys(0x10000000, keys.data(), values.data(), results.data(), 1, 0) ==
+        EBPF_INVALID_FD);
+
+    Platform::_close(map_fd);
+}
+
+TEST_CASE("libbpf map lookup by keys all present", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    // Enough keys to fill at least one maximum sized request, all of which are present, so that every result and
+    // value slot in the reply is written while the request keys that share the same buffer are still being read.
+    const uint32_t max_entries = 8192;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+
+    for (uint32_t key = 0; key < max_entries; key++) {
+        uint64_t value = (static_cast<uint64_t>(key) << 32) | (key ^ 0x5a5a5a5a);
+        REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    }
+
+    std::vector<uint32_t> keys(max_entries);
+    for (uint32_t i = 0; i < max_entries; i++) {
+        keys[i] = (i * 7919) % max_entries;
+    }
+    std::vector<uint64_t> values(max_entries, UINT64_MAX);
+    std::vector<ebpf_result_t> results(max_entries, EBPF_FAILED);
+    REQUIRE(
+        ebpf_map_lookup_elements_by_keys(map_fd, keys.data(), values.data(), results.data(), max_entries, 0) ==
+        EBPF_SUCCESS);
+    for (uint32_t i = 0; i < max_entries; i++) {
+        REQUIRE(results[i] == EBPF_SUCCESS);
+        REQUIRE(values[i] == ((static_cast<uint64_t>(keys[i]) << 32) | (keys[i] ^ 0x5a5a5a5a)));
+    }
+
+    // Look up and delete every key, and check that each deleted value matches its key.
+    values.assign(max_entries, UINT64_MAX);
+    results.assign(max_entries, EBPF_FAILED);
+    REQUIRE(
+        ebpf_map_lookup_and_delete_elements_by_keys(
+            map_fd, keys.data(), values.data(), results.data(), max_entries, 0) == EBPF_SUCCESS);
+    for (uint32_t i = 0; i < max_entries; i++) {
+        uint64_t value;
+        REQUIRE(results[i] == EBPF_SUCCESS);
+        REQUIRE(values[i] == ((static_cast<uint64_t>(keys[i]) << 32) | (keys[i] ^ 0x5a5a5a5a)));
+        REQUIRE(bpf_map_lookup_elem(map_fd, &keys[i], &value) == -ENOENT);
+    }
+
+    Platform::_close(map_fd);
+}
+
+TEST_CASE("libbpf per-cpu map lookup by keys", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    const uint32_t max_entries = 16;
+    int map_fd =
+        bpf_map_create(BPF_MAP_TYPE_PERCPU_HASH, nullptr, sizeof(uint32_t), sizeof(uint32_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+
+    // Per-cpu values are padded to 8 bytes.
+    int cpu_count = libbpf_num_possible_cpus();
+    REQUIRE(cpu_count > 0);
+    std::vector<uint64_t> per_cpu_value(cpu_count);
+    for (uint32_t key = 0; key < max_entries; key++) {
+        for (int cpu = 0; cpu < cpu_count; cpu++) {
+            per_cpu_value[cpu] = static_cast<uint64_t>(key) * 100 + cpu;
+        }
+        REQUIRE(bpf_map_update_elem(map_fd, &key, per_cpu_value.data(), BPF_ANY) == 0);
+    }
+
+    std::vector<uint32_t> keys = {3, max_entries, 7};
+    std::vector<uint64_t> values(keys.size() * cpu_count);
+    std::vector<ebpf_result_t> results(keys.size());
+    REQUIRE(
+        ebpf_map_lookup_elements_by_keys(
+            map_fd, keys.data(), values.data(), results.data(), static_cast<uint32_t>(keys.size()), 0) ==
+        EBPF_SUCCESS);
+    REQUIRE(results[0] == EBPF_SUCCESS);
+    REQUIRE(results[1] == EBPF_OBJECT_NOT_FOUND);
+    REQUIRE(results[2] == EBPF_SUCCESS);
+    for (int cpu = 0; cpu < cpu_count; cpu++) {
+        REQUIRE(static_cast<uint32_t>(values[cpu]) == 300u + cpu);
+        REQUIRE(values[cpu_count + cpu] == 0);
+        REQUIRE(static_cast<uint32_t>(values[2 * cpu_count + cpu]) == 700u + cpu);
+    }
+
+    Platform::_close(map_fd);
+}
+
+TEST_CASE("libbpf map lookup by keys throughput", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    const uint32_t max_entries = 4096;
+    const size_t iterations = 20;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+
+    std::vector<uint32_t> keys(max_entries);
+    for (uint32_t key = 0; key < max_entries; key++) {
+        uint64_t value = key;
+        keys[key] = key;
+        REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    }
+    std::vector<uint64_t> values(max_entries);
+    std::vector<ebpf_result_t> results(max_entries);
+
+    // Poll all keys with one lookup per key.
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        for (uint32_t i = 0; i < max_entries; i++) {
+            REQUIRE(bpf_map_lookup_elem(map_fd, &keys[i], &values[i]) == 0);
+        }
+    }
+    auto per_key_elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    // Poll all keys with one batched lookup.
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        REQUIRE(
+            ebpf_map_lookup_elements_by_keys(map_fd, keys.data(), values.data(), results.data(), max_entries, 0) ==
+            EBPF_SUCCESS);
+    }
+    auto batch_elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    for (uint32_t i = 0; i < max_entries; i++) {
+        REQUIRE(results[i] == EBPF_SUCCESS);
+        REQUIRE(values[i] == i);
+    }
+
+    double lookups = static_cast<double>(iterations) * max_entries;
+    printf("map_lookup_per_key,%.0f\n", lookups * 1e9 / static_cast<double>(per_key_elapsed.count()));
+    printf("map_lookup_by_keys,%.0f\n", lookups * 1e9 / static_cast<double>(batch_elapsed.count()));
+
+    Platform::_close(map_fd);
+}
+
+TEST_CASE("libbpf map replace contents", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    // Use more entries than fit in a single staging request.
+    const uint32_t max_entries = 10000;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+
+    for (uint32_t key = 0; key < max_entries; key += 2) {
+        uint64_t value = key;
+        REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    }
+
+    // Replace the even keys with the odd keys.
+    std::vector<uint32_t> keys;
+    std::vector<uint64_t> values;
+    for (uint32_t key = 1; key < max_entries; key += 2) {
+        keys.push_back(key);
+        values.push_back(static_cast<uint64_t>(key) * 5);
+    }
+    REQUIRE(
+        ebpf_map_replace_contents(map_fd, keys.data(), values.data(), static_cast<uint32_t>(keys.size()), 0) ==
+        EBPF_SUCCESS);
+    for (uint32_t key = 0; key < max_entries; key++) {
+        uint64_t value;
+        if (key % 2 == 0) {
+            REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == -ENOENT);
+        } else {
+            REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == 0);
+            REQUIRE(value == static_cast<uint64_t>(key) * 5);
+        }
+    }
+
+    // The replaced map can still be updated.
+    uint32_t key = 0;
+    uint64_t value = 1;
+    REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_NOEXIST) == 0);
+
+    // Replacing with no entries empties the map.
+    REQUIRE(ebpf_map_replace_contents(map_fd, nullptr, nullptr, 0, 0) == EBPF_SUCCESS);
+    uint32_t next_key;
+    REQUIRE(bpf_map_get_next_key(map_fd, nullptr, &next_key) == -ENOENT);
+
+    // Negative tests.
+    keys.resize(max_entries + 1);
+    values.resize(max_entries + 1);
+    REQUIRE(
+        ebpf_map_replace_contents(map_fd, keys.data(), values.data(), max_entries + 1, 0) == EBPF_OUT_OF_SPACE);
+    REQUIRE(ebpf_map_replace_contents(map_fd, keys.data(), values.data(), 1, 0x100) == EBPF_INVALID_ARGUMENT);
+    REQUIRE(ebpf_map_replace_contents(map_fd, nullptr, nullptr, 1, 0) == EBPF_INVALID_ARGUMENT);
+    REQUIRE(ebpf_map_replace_contents(0x10000000, keys.data(), values.data(), 1, 0) == EBPF_INVALID_FD);
+    Platform::_close(map_fd);
+
+    // Array maps are replaced with the given entries, and all other entries become zero.
+    map_fd = bpf_map_create(BPF_MAP_TYPE_ARRAY, nullptr, sizeof(uint32_t), sizeof(uint64_t), 4, nullptr);
+    REQUIRE(map_fd > 0);
+    for (key = 0; key < 4; key++) {
+        value = 100 + key;
+        REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    }
+    uint32_t array_keys[] = {3, 1};
+    uint64_t array_values[] = {33, 11};
+    REQUIRE(ebpf_map_replace_contents(map_fd, array_keys, array_values, 2, 0) == EBPF_SUCCESS);
+    uint64_t expected_values[] = {0, 11, 0, 33};
+    for (key = 0; key < 4; key++) {
+        REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == 0);
+        REQUIRE(value == expected_values[key]);
+    }
+    array_keys[0] = 4;
+    REQUIRE(ebpf_map_replace_contents(map_fd, array_keys, array_values, 2, 0) == EBPF_INVALID_ARGUMENT);
+    Platform::_close(map_fd);
+
+    // LRU maps track key history and are not supported.
+    map_fd = bpf_map_create(BPF_MAP_TYPE_LRU_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), 4, nullptr);
+    REQUIRE(map_fd > 0);
+    REQUIRE(ebpf_map_replace_contents(map_fd, array_keys, array_values, 2, 0) == EBPF_OPERATION_NOT_SUPPORTED);
+    Platform::_close(map_fd);
+}
+
+TEST_CASE("libbpf lpm map replace contents", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    typedef struct _lpm_key
+    {
+        uint32_t prefix_length;
+        uint8_t address[4];
+    } lpm_key_t;
+
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_LPM_TRIE, nullptr, sizeof(lpm_key_t), sizeof(uint32_t), 16, nullptr);
+    REQUIRE(map_fd > 0);
+
+    lpm_key_t key = {8, {10, 0, 0, 0}};
+    uint32_t value = 8;
+    REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+
+    std::vector<lpm_key_t> keys = {{16, {192, 168, 0, 0}}, {24, {192, 168, 1, 0}}};
+    std::vector<uint32_t> values = {16, 24};
+    REQUIRE(ebpf_map_replace_contents(map_fd, keys.data(), values.data(), 2, 0) == EBPF_SUCCESS);
+
+    // Lookups use the longest prefix of the new contents only.
+    lpm_key_t lookup_key = {32, {192, 168, 1, 1}};
+    REQUIRE(bpf_map_lookup_elem(map_fd, &lookup_key, &value) == 0);
+    REQUIRE(value == 24);
+    lookup_key = {32, {192, 168, 2, 1}};
+    REQUIRE(bpf_map_lookup_elem(map_fd, &lookup_key, &value) == 0);
+    REQUIRE(value == 16);
+    lookup_key = {32, {10, 0, 0, 1}};
+    REQUIRE(bpf_map_lookup_elem(map_fd, &lookup_key, &value) == -ENOENT);
+
+    // Prefix lengths must fit the key.
+    keys[0].prefix_length = 33;
+    REQUIRE(ebpf_map_replace_contents(map_fd, keys.data(), values.data(), 2, 0) == EBPF_INVALID_ARGUMENT);
+
+    Platform::_close(map_fd);
+}
+
+TEST_CASE("libbpf map replace contents throughput", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    const uint32_t max_entries = 1000000;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+
+    std::vector<uint32_t> keys(max_entries);
+    std::vector<uint64_t> values(max_entries);
+    for (uint32_t key = 0; key < max_entries; key++) {
+        keys[key] = key;
+        values[key] = key;
+    }
+
+    // Overwrite every entry of a full map with batched updates.
+    uint32_t update_batch_size = max_entries;
+    REQUIRE(bpf_map_update_batch(map_fd, keys.data(), values.data(), &update_batch_size, nullptr) == 0);
+    auto start = std::chrono::high_resolution_clock::now();
+    update_batch_size = max_entries;
+    REQUIRE(bpf_map_update_batch(map_fd, keys.data(), values.data(), &update_batch_size, nullptr) == 0);
+    auto update_elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    // Replace the whole map at once.
+    start = std::chrono::high_resolution_clock::now();
+    REQUIRE(ebpf_map_replace_contents(map_fd, keys.data(), values.data(), max_entries, 0) == EBPF_SUCCESS);
+    auto replace_elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    uint32_t key = max_entries - 1;
+    uint64_t value;
+    REQUIRE(bpf_map_lookup_elem(map_fd, &key, &value) == 0);
+    REQUIRE(value == key);
+
+    printf("map_update_batch_1m_ms,%.2f\n", static_cast<double>(update_elapsed.count()) / 1e6);
+    printf("map_replace_contents_1m_ms,%.2f\n", static_cast<double>(replace_elapsed.count()) / 1e6);
+
+    Platform::_close(map_fd);
+}
+
+TEST_CASE("libbpf map statistics", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    const uint32_t max_entries = 16;
+    bpf_map_create_opts opts = {0};
+    opts.map_flags = BPF_F_STATISTICS;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, &opts);
+    REQUIRE(map_fd > 0);
+
+    for (uint32_t key = 0; key < max_entries; key++) {
+        uint64_t value = key;
+        REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    }
+    for (uint32_t key = 0; key < 2 * max_entries; key++) {
+        uint64_t value;
+        (void)bpf_map_lookup_elem(map_fd, &key, &value);
+    }
+    uint32_t key = 0;
+    REQUIRE(bpf_map_delete_elem(map_fd, &key) == 0);
+
+    bpf_map_info info;
+    uint32_t info_size = sizeof(info);
+    REQUIRE(bpf_obj_get_info_by_fd(map_fd, &info, &info_size) == 0);
+    REQUIRE((info.map_flags & BPF_F_STATISTICS) != 0);
+    REQUIRE(info.entry_count == max_entries - 1);
+    REQUIRE(info.longest_bucket_length > 0);
+    REQUIRE(info.longest_bucket_length <= max_entries);
+    REQUIRE(info.lookup_count == 2 * max_entries);
+    REQUIRE(info.lookup_miss_count == max_entries);
+    REQUIRE(info.update_count == max_entries);
+    REQUIRE(info.delete_count == 1);
+    REQUIRE(info.eviction_count == 0);
+    REQUIRE(info.allocation_failure_count == 0);
+
+    // Disabling statistics discards the counts.
+    REQUIRE(ebpf_map_set_statistics(map_fd, false) == EBPF_SUCCESS);
+    REQUIRE(bpf_obj_get_info_by_fd(map_fd, &info, &info_size) == 0);
+    REQUIRE((info.map_flags & BPF_F_STATISTICS) == 0);
+    REQUIRE(info.lookup_count == 0);
+    REQUIRE(info.entry_count == 0);
+    Platform::_close(map_fd);
+
+    // Statistics can be enabled on an existing map, and count LRU evictions.
+    map_fd = bpf_map_create(BPF_MAP_TYPE_LRU_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+    REQUIRE(ebpf_map_set_statistics(map_fd, true) == EBPF_SUCCESS);
+    REQUIRE(ebpf_map_set_statistics(map_fd, true) == EBPF_SUCCESS);
+    for (key = 0; key < 4 * max_entries; key++) {
+        uint64_t value = key;
+        REQUIRE(bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) == 0);
+    }
+    REQUIRE(bpf_obj_get_info_by_fd(map_fd, &info, &info_size) == 0);
+    REQUIRE((info.map_flags & BPF_F_STATISTICS) != 0);
+    REQUIRE(info.update_count == 4 * max_entries);
+    REQUIRE(info.eviction_count >= 3 * max_entries);
+    REQUIRE(info.entry_count <= max_entries);
+    Platform::_close(map_fd);
+
+    // Negative tests.
+    REQUIRE(ebpf_map_set_statistics(0x10000000, true) == EBPF_INVALID_FD);
+    opts.map_flags = 0x1;
+    REQUIRE(bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), 1, &opts) < 0);
+}
+
+TEST_CASE("libbpf map element operations after fd reuse", "[libbpf]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    // Populate the per-fd map properties cache with a small-valued array map.
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_ARRAY, nullptr, sizeof(uint32_t), sizeof(uint32_t), 4, nullptr);
+    REQUIRE(map_fd > 0);
+    uint32_t key = 1;
+    uint32_t small_value = 42;
+    REQUIRE(bpf_map_update_elem(map_fd, &key, &small_value, 0) == 0);
+    REQUIRE(bpf_map_lookup_elem(map_fd, &key, &small_value) == 0);
+    REQUIRE(small_value == 42);
+    Platform::_close(map_fd);
+
+    // The next map is likely to reuse the fd. Verify that element operations use the properties of the new map
+    // rather than stale cached ones.
+    int reused_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint64_t), sizeof(uint64_t), 4, nullptr);
+    REQUIRE(reused_fd > 0);
+
+    uint64_t large_key = 0x1234567812345678;
+    uint64_t large_value = 0xabcdefabcdefabcd;
+    REQUIRE(bpf_map_update_elem(reused_fd, &large_key, &large_value, 0) == 0);
+    large_value = 0;
+    REQUIRE(bpf_map_lookup_elem(reused_fd, &large_key, &large_value) == 0);
+    REQUIRE(large_value == 0xabcdefabcdefabcd);
+    REQUIRE(bpf_map_delete_elem(reused_fd, &large_key) == 0);
+    REQUIRE(bpf_map_lookup_elem(reused_fd, &large_key, &large_value) < 0);
+    REQUIRE(errno == ENOENT);
+
+    Platform::_close(reused_fd);
+}
+
+static void
+_test_map_element_throughput(_In_z_ const char* test_name, int map_fd, uint32_t max_entries)
+{
+    const size_t iterations = 10000;
+    uint32_t thread_count = ebpf_get_cpu_count() * 2;
+    std::vector<std::jthread> threads;
+    std::atomic<size_t> failures = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < thread_count; i++) {
+        threads.emplace_back([&, i]() {
+            uint32_t key = i % max_entries;
+            uint64_t value = 0;
+            for (size_t iteration = 0; iteration < iterations; iteration++) {
+                value = iteration;
+                if (bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) != 0 ||
+                    bpf_map_lookup_elem(map_fd, &key, &value) != 0) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    REQUIRE(failures == 0);
+    double operations = static_cast<double>(thread_count) * iterations * 2;
+    WARN(
+        test_name << ": " << thread_count << " threads, "
+                  << static_cast<uint64_t>(operations * 1e9 / static_cast<double>(elapsed.count())) << " operations/s");
+}
+
+TEST_CASE("libbpf map element operations throughput", "[.][libbpf][performance]")
+{
+    _test_helper_end_to_end test_helper;
+    test_helper.initialize();
+
+    const uint32_t max_entries = 1024;
+    int map_fd = bpf_map_create(BPF_MAP_TYPE_HASH, nullptr, sizeof(uint32_t), sizeof(uint64_t), max_entries, nullptr);
+    REQUIRE(map_fd > 0);
+    _test_map_element_throughput("map_element_operations_created_fd", map_fd, max_entries);
+
+    // A map fd obtained by ID is not backed by a bpf_object, so its properties come from the execution context.
+    bpf_map_info info;
+    uint32_t info_size = sizeof(info);
+    REQUIRE(bpf_obj_get_info_by_fd(map_fd, &info, &info_size) == 0);
+    int map_fd_by_id = bpf_map_get_fd_by_id(info.id);
+    REQUIRE(map_fd_by_id > 0);
+    _test_map_element_throughput("map_element_operations_fd_by_id", map_fd_by_id, max_entries);
+
+    Platform::_close(map_fd_by_id);
+    Platform::_close(map_fd);
+}
+
 void
 _hash_of_map_initial_value_test(ebpf_execution_type_t execution_type)
 {
@@ -4,6 +4,8 @@
 // This module facilitates testing various XDP scenarios by sending traffic to a remote system
 // running XDP eBPF hook and an attached XDP program.
 // For the reflection test, reflect_packet.o needs to be loaded on the remote host.
+// The round trip time test works with either reflect_packet.o or reflect_packet_parsed.o on the remote host; running it
+// against both compares parsing the headers in the program with the bpf_xdp_parse_headers helper.
 
 #define CATCH_CONFIG_RUNNER
 
@@ -13,6 +15,8 @@
 #include "watchdog.h"
 #include "xdp_tests_common.h"
 
+#include <chrono>
+
 CATCH_REGISTER_LISTENER(_watchdog)
 
 std::string _remote_ip;
@@ -93,6 +97,34 @@ TEST_CASE("xdp_reflect_test", "[xdp_tests]")
     REQUIRE(memcmp(received_message, message, strlen(message)) == 0);
 }
 
+TEST_CASE("xdp_reflect_round_trip_time", "[xdp_tests]")
+{
+    const uint32_t iterations = 1000;
+    // Initialize the remote address.
+    struct sockaddr_storage remote_address = {};
+    get_address_from_string(_remote_ip, remote_address, true);
+    const char* message = "Bo!ng";
+    datagram_client_socket_t sender_receiver_socket(SOCK_DGRAM, IPPROTO_UDP, 0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        // Post the receive first so that the reflected packet is never waiting on the socket.
+        sender_receiver_socket.post_async_receive();
+        sender_receiver_socket.send_message_to_remote_host(message, remote_address, REFLECTION_TEST_PORT);
+        sender_receiver_socket.complete_async_send(1000, expected_result_t::SUCCESS);
+        sender_receiver_socket.complete_async_receive(2000, false);
+
+        uint32_t bytes_received = 0;
+        char* received_message = nullptr;
+        sender_receiver_socket.get_received_message(bytes_received, received_message);
+        REQUIRE(bytes_received == strlen(message));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("Average round trip time over %u packets: %.2f us\n", iterations, (double)elapsed / iterations);
+}
+
 int
 main(int argc, char* argv[])
 {
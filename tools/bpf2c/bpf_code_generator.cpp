@@ -39,6 +39,12 @@
 
 #define EBPF_MODE_ATOMIC 0xc0
 
+// Value of the src field of a call instruction that targets a local function rather than a helper.
+#define EBPF_CALL_LOCAL 0x01
+
+// Stack size available to each function, matching UBPF_STACK_SIZE in bpf2c.h.
+#define EBPF_STACK_SIZE 512
+
 #define EBPF_ATOMIC_FETCH 0x01
 #define EBPF_ATOMIC_ADD 0x00
 #define EBPF_ATOMIC_ADD_FETCH (0x00 | EBPF_ATOMIC_FETCH)
@@ -189,7 +195,11 @@ bpf_code_generator::get_register_name(uint8_t id)
     if (id >= _countof(_register_names)) {
         throw bpf_code_generator_exception("invalid register id");
     } else {
-        current_program->referenced_registers.insert(_register_names[id]);
+        if (current_subprogram != nullptr) {
+            current_subprogram->referenced_registers.insert(_register_names[id]);
+        } else {
+            current_program->referenced_registers.insert(_register_names[id]);
+        }
         return _register_names[id];
     }
 }
@@ -324,6 +334,7 @@ bpf_code_generator::generate(
     current_program = &programs[program_name];
 
     generate_labels();
+    identify_subprograms(section_name);
     build_function_table();
     encode_instructions(section_name);
 }
@@ -726,13 +737,53 @@ bpf_code_generator::extract_relocations_and_maps(const bpf_code_generator::unsaf
 {
     auto map_section = get_optional_section("maps");
     ELFIO::const_symbol_section_accessor symbols{reader, get_required_section(".symtab")};
+    auto& program_output = current_program->output;
 
-    auto relocations = get_optional_section(".rel" + section_name);
-    if (!relocations) {
-        relocations = get_optional_section(".rela" + section_name);
+    // The verifier appends the subprograms a program calls, and the ones they call in turn, after the program's own
+    // instructions. Each of them starts at a local call target and is followed by the next, so the output is a
+    // sequence of functions, each copied from its own section. Map each one back to its origin to apply the
+    // relocations of that section to it.
+    std::set<size_t> function_starts{0};
+    for (size_t i = 0; i < program_output.size(); i++) {
+        auto& inst = program_output[i].instruction;
+        int64_t target = static_cast<int64_t>(i) + inst.imm + 1;
+        if (inst.opcode == INST_OP_CALL && inst.src == EBPF_CALL_LOCAL && target > 0 &&
+            target < static_cast<int64_t>(program_output.size())) {
+            function_starts.insert(static_cast<size_t>(target));
+        }
     }
 
-    if (relocations) {
+    // Map from the first instruction of each function to the section and byte offset it was copied from.
+    std::map<size_t, std::pair<unsafe_string, size_t>> function_origins;
+    function_origins[0] = {section_name, current_program->offset_in_section};
+
+    // Calls only target functions appended after the caller, so each origin is known before it is needed.
+    for (auto function_start = function_starts.begin(); function_start != function_starts.end(); function_start++) {
+        auto next_function_start = std::next(function_start);
+        size_t start = *function_start;
+        size_t end = (next_function_start != function_starts.end()) ? *next_function_start : program_output.size();
+
+        auto origin = function_origins.find(start);
+        if (origin == function_origins.end()) {
+            throw bpf_code_generator_exception("can't locate subprogram", program_output[start].instruction_offset);
+        }
+        auto [origin_section_name, origin_offset] = origin->second;
+        auto origin_section = get_required_section(origin_section_name);
+        if (start != 0) {
+            for (size_t i = start; i < end; i++) {
+                program_output[i].origin_section_name = origin_section_name;
+                program_output[i].origin_offset = origin_offset / sizeof(ebpf_inst) + (i - start);
+            }
+        }
+
+        auto relocations = get_optional_section(".rel" + origin_section_name);
+        if (!relocations) {
+            relocations = get_optional_section(".rela" + origin_section_name);
+        }
+        if (!relocations) {
+            continue;
+        }
+
         ELFIO::const_relocation_section_accessor relocation_reader{reader, relocations};
         ELFIO::Elf_Xword relocation_count = relocation_reader.get_entries_num();
         for (ELFIO::Elf_Xword index = 0; index < relocation_count; index++) {
@@ -752,19 +803,33 @@ bpf_code_generator::extract_relocations_and_maps(const bpf_code_generator::unsaf
                 if (!symbols.get_symbol(symbol, unsafe_name, value, size, bind, symbol_type, section_index, other)) {
                     throw bpf_code_generator_exception("Can't perform relocation at offset ", offset);
                 }
-                if (offset < current_program->offset_in_section ||
-                    offset >= current_program->offset_in_section + current_program->output.size() * sizeof(ebpf_inst)) {
-                    // Relocation is for a different program.
+                if (offset < origin_offset || offset >= origin_offset + (end - start) * sizeof(ebpf_inst)) {
+                    // Relocation is for a different function.
                     continue;
                 }
-                current_program->output[(offset - current_program->offset_in_section) / sizeof(ebpf_inst)].relocation =
-                    unsafe_name;
+                size_t instruction_index = start + (offset - origin_offset) / sizeof(ebpf_inst);
+                auto& output = program_output[instruction_index];
+                output.relocation = unsafe_name;
                 if (map_section && section_index == map_section->get_index()) {
                     // Check that the map exists in the list of map definitions.
                     if (map_definitions.find(unsafe_name) == map_definitions.end()) {
                         throw bpf_code_generator_exception("map not found in map definitions: " + unsafe_name);
                     }
                 }
+
+                // A local call is relocated against either the callee or the start of its section, with the
+                // original immediate holding the callee's instruction offset minus one.
+                if (output.instruction.opcode == INST_OP_CALL && output.instruction.src == EBPF_CALL_LOCAL) {
+                    if (section_index >= reader.sections.size() ||
+                        offset + sizeof(ebpf_inst) > origin_section->get_size()) {
+                        throw bpf_code_generator_exception("Can't perform relocation at offset ", offset);
+                    }
+                    auto original = reinterpret_cast<const ebpf_inst*>(origin_section->get_data() + offset);
+                    size_t target = instruction_index + output.instruction.imm + 1;
+                    size_t target_offset = value + (static_cast<int64_t>(original->imm) + 1) * sizeof(ebpf_inst);
+                    unsafe_string target_section_name = reader.sections[section_index]->get_name();
+                    function_origins.emplace(target, std::make_pair(target_section_name, target_offset));
+                }
             }
         }
     }
@@ -837,6 +902,92 @@ bpf_code_generator::generate_labels()
     }
 }
 
+void
+bpf_code_generator::identify_subprograms(const bpf_code_generator::unsafe_string& section_name)
+{
+    std::vector<output_instruction_t>& program_output = current_program->output;
+    auto program_name = !current_program->program_name.empty() ? current_program->program_name : section_name;
+    auto& subprograms = current_program->subprograms;
+
+    // Each target of a local call is the start of a subprogram.
+    for (size_t i = 0; i < program_output.size(); i++) {
+        auto& inst = program_output[i].instruction;
+        if (inst.opcode != INST_OP_CALL || inst.src != EBPF_CALL_LOCAL) {
+            continue;
+        }
+        int64_t target = static_cast<int64_t>(i) + inst.imm + 1;
+        if (target <= 0 || target >= static_cast<int64_t>(program_output.size())) {
+            throw bpf_code_generator_exception("invalid call target", program_output[i].instruction_offset);
+        }
+        subprograms[static_cast<size_t>(target)].start = static_cast<size_t>(target);
+    }
+
+    if (subprograms.empty()) {
+        return;
+    }
+
+    // A subprogram extends up to the start of the next one, and the main program ends where the first one starts.
+    for (auto it = subprograms.begin(); it != subprograms.end(); it++) {
+        auto next = std::next(it);
+        auto& subprogram = it->second;
+        subprogram.end = (next != subprograms.end()) ? next->first : program_output.size();
+        subprogram.name = program_name.c_identifier() + "_subprogram_" + std::to_string(subprogram.start);
+    }
+
+    auto function_start = [&](size_t index) -> size_t {
+        auto it = subprograms.upper_bound(index);
+        return (it == subprograms.begin()) ? 0 : std::prev(it)->first;
+    };
+
+    for (size_t i = 0; i < program_output.size(); i++) {
+        auto& output = program_output[i];
+        auto& inst = output.instruction;
+        size_t start = function_start(i);
+
+        // Jumps may not leave the function they are in.
+        if (IS_JMP_CLASS_OPCODE(inst.opcode) && inst.opcode != INST_OP_CALL && inst.opcode != INST_OP_EXIT) {
+            int32_t offset = (inst.opcode == INST_OP_JA32) ? inst.imm : inst.offset;
+            if (function_start(i + offset + 1) != start) {
+                throw bpf_code_generator_exception("invalid jump target", output.instruction_offset);
+            }
+        }
+
+        // A tail call unwinds the whole program, which can't be expressed from inside a C function.
+        if (start != 0 && inst.opcode == INST_OP_CALL && inst.src != EBPF_CALL_LOCAL &&
+            (output.relocation.empty() ? inst.imm == BPF_FUNC_tail_call : output.relocation == "bpf_tail_call")) {
+            throw bpf_code_generator_exception(
+                "tail calls from subprograms are not supported", output.instruction_offset);
+        }
+    }
+
+    // Size each subprogram's stack frame. If the frame pointer is only used as the base of loads and stores, the
+    // frame only needs to cover the deepest access. Otherwise its address escapes and the full stack is reserved.
+    for (auto& [start, subprogram] : subprograms) {
+        size_t stack_size = 0;
+        for (size_t i = subprogram.start; i < subprogram.end; i++) {
+            auto& inst = program_output[i].instruction;
+            if (inst.opcode == INST_OP_LDDW_IMM) {
+                i++;
+                if (inst.dst != 10) {
+                    continue;
+                }
+            }
+            uint8_t instruction_class = inst.opcode & INST_CLS_MASK;
+            bool is_load = instruction_class == INST_CLS_LDX;
+            bool is_store = instruction_class == INST_CLS_ST || instruction_class == INST_CLS_STX;
+            bool stack_access =
+                (is_load && inst.src == 10 && inst.dst != 10) || (is_store && inst.dst == 10 && inst.src != 10);
+            if (stack_access && inst.offset < 0) {
+                stack_size = std::max(stack_size, static_cast<size_t>(-inst.offset));
+            } else if (inst.dst == 10 || inst.src == 10) {
+                stack_size = EBPF_STACK_SIZE;
+                break;
+            }
+        }
+        subprogram.stack_size = std::min<size_t>((stack_size + 7) & ~static_cast<size_t>(7), EBPF_STACK_SIZE);
+    }
+}
+
 void
 bpf_code_generator::build_function_table()
 {
@@ -845,7 +996,7 @@ bpf_code_generator::build_function_table()
     // Gather helper_functions
     size_t index = 0;
     for (auto& output : program_output) {
-        if (output.instruction.opcode != INST_OP_CALL) {
+        if (output.instruction.opcode != INST_OP_CALL || output.instruction.src == EBPF_CALL_LOCAL) {
             continue;
         }
         bpf_code_generator::unsafe_string name;
@@ -874,6 +1025,11 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
         auto& output = program_output[i];
         auto& inst = output.instruction;
 
+        // Attribute register usage to the function the instruction belongs to.
+        auto subprogram = current_program->subprograms.upper_bound(i);
+        current_subprogram =
+            (subprogram == current_program->subprograms.begin()) ? nullptr : &std::prev(subprogram)->second;
+
         switch (inst.opcode & INST_CLS_MASK) {
         case INST_CLS_ALU:
         case INST_CLS_ALU64: {
@@ -1291,6 +1447,12 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
             } else if (inst.opcode == INST_OP_JA32) {
                 std::string target = program_output[i + inst.imm + 1].label;
                 output.lines.push_back("goto " + target + ";");
+            } else if (inst.opcode == INST_OP_CALL && inst.src == EBPF_CALL_LOCAL) {
+                auto& subprogram = current_program->subprograms[i + inst.imm + 1];
+                output.lines.push_back(
+                    get_register_name(0) + " = " + subprogram.name + "(" + get_register_name(1) + ", " +
+                    get_register_name(2) + ", " + get_register_name(3) + ", " + get_register_name(4) + ", " +
+                    get_register_name(5) + ");");
             } else if (inst.opcode == INST_OP_CALL) {
                 std::string function_name;
                 if (output.relocation.empty()) {
@@ -1332,6 +1494,47 @@ bpf_code_generator::encode_instructions(const bpf_code_generator::unsafe_string&
             throw bpf_code_generator_exception("invalid operand", output.instruction_offset);
         }
     }
+    current_subprogram = nullptr;
+}
+
+void
+bpf_code_generator::emit_instructions(
+    std::ostream& output_stream, const program_t& program, size_t start, size_t end, std::string& prolog_line_info)
+{
+    for (size_t i = start; i < end; i++) {
+        const auto& output = program.output[i];
+        if (output.lines.empty()) {
+            continue;
+        }
+        if (!output.label.empty()) {
+            output_stream << output.label << ":" << std::endl;
+        }
+        // Instructions of subprograms appended from another section take their line info from that section.
+        bool copied = !output.origin_section_name.empty();
+        auto& line_info = section_line_info[copied ? output.origin_section_name : program.elf_section_name];
+        auto current_line = line_info.find(copied ? output.origin_offset : output.instruction_offset);
+        if (current_line != line_info.end() && !current_line->second.file_name.empty() &&
+            current_line->second.line_number != 0) {
+            prolog_line_info = std::format(
+                "#line {} {}\n",
+                std::to_string(current_line->second.line_number),
+                current_line->second.file_name.quoted_filename());
+        }
+#if defined(_DEBUG) || defined(BPF2C_VERBOSE)
+        output_stream << INDENT "// " << _opcode_name_strings[output.instruction.opcode];
+        if (IS_ATOMIC_OPCODE(output.instruction.opcode)) {
+            output_stream << "_" << _atomic_opcode_name_strings[output.instruction.imm];
+        }
+        output_stream << " pc=" << output.instruction_offset << " dst=r" << std::to_string(output.instruction.dst)
+                      << " src=r" << std::to_string(output.instruction.src)
+                      << " offset=" << std::to_string(output.instruction.offset)
+                      << " imm=" << std::to_string(output.instruction.imm) << std::endl;
+
+#endif
+        for (const auto& line : output.lines) {
+            output_stream << prolog_line_info << INDENT "" << line << std::endl;
+        }
+    }
 }
 
 void
@@ -1546,6 +1749,12 @@ bpf_code_generator::emit_c_code(std::ostream& output_stream)
 
         // Emit entry point
         output_stream << "#pragma code_seg(push, " << program.pe_section_name.quoted() << ")" << std::endl;
+        std::string subprogram_signature =
+            "static uint64_t\n{}(uint64_t r1, uint64_t r2, uint64_t r3, uint64_t r4, uint64_t r5)";
+        for (const auto& [start, subprogram] : program.subprograms) {
+            output_stream << std::vformat(subprogram_signature, make_format_args(subprogram.name)) << ";" << std::endl
+                          << std::endl;
+        }
         output_stream << std::format("static uint64_t\n{}(void* context)", program_name.c_identifier()) << std::endl;
         output_stream << prolog_line_info << "{" << std::endl;
 
@@ -1566,38 +1775,49 @@ bpf_code_generator::emit_c_code(std::ostream& output_stream)
         output_stream << std::endl;
 
         // Emit encoded instructions.
-        for (const auto& output : program.output) {
-            if (output.lines.empty()) {
-                continue;
+        size_t main_end = program.subprograms.empty() ? program.output.size() : program.subprograms.begin()->first;
+        emit_instructions(output_stream, program, 0, main_end, prolog_line_info);
+
+        // Emit epilogue
+        output_stream << prolog_line_info << "}" << std::endl;
+
+        // Emit local functions invoked via BPF-to-BPF calls.
+        for (const auto& [start, subprogram] : program.subprograms) {
+            output_stream << std::endl;
+            output_stream << std::vformat(subprogram_signature, make_format_args(subprogram.name)) << std::endl;
+            output_stream << prolog_line_info << "{" << std::endl;
+
+            // Emit prologue. Arguments are passed in r1-r5 and r6-r9 are private to each function.
+            output_stream << prolog_line_info << INDENT "// Prologue" << std::endl;
+            if (subprogram.stack_size > 0) {
+                output_stream << prolog_line_info
+                              << std::format(INDENT "uint64_t stack[{}];", subprogram.stack_size / sizeof(uint64_t))
+                              << std::endl;
             }
-            if (!output.label.empty()) {
-                output_stream << output.label << ":" << std::endl;
+            auto& registers = subprogram.referenced_registers;
+            for (size_t r = 0; r < _countof(_register_names); r++) {
+                // Skip unused registers and arguments.
+                if ((r >= 1 && r <= 5) || registers.find(_register_names[r]) == registers.end()) {
+                    continue;
+                }
+                output_stream << prolog_line_info << INDENT "register uint64_t " << _register_names[r] << " = 0;"
+                              << std::endl;
             }
-            auto current_line = line_info.find(output.instruction_offset);
-            if (current_line != line_info.end() && !current_line->second.file_name.empty() &&
-                current_line->second.line_number != 0) {
-                prolog_line_info = std::format(
-                    "#line {} {}\n",
-                    std::to_string(current_line->second.line_number),
-                    current_line->second.file_name.quoted_filename());
+            for (size_t r = 1; r <= 5; r++) {
+                if (registers.find(_register_names[r]) == registers.end()) {
+                    output_stream << prolog_line_info << INDENT "(void)" << _register_names[r] << ";" << std::endl;
+                }
             }
-#if defined(_DEBUG) || defined(BPF2C_VERBOSE)
-            output_stream << INDENT "// " << _opcode_name_strings[output.instruction.opcode];
-            if (IS_ATOMIC_OPCODE(output.instruction.opcode)) {
-                output_stream << "_" << _atomic_opcode_name_strings[output.instruction.imm];
+            output_stream << std::endl;
+            if (registers.find(_register_names[10]) != registers.end()) {
+                output_stream << prolog_line_info << INDENT "r10 = (uintptr_t)((uint8_t*)stack + sizeof(stack));"
+                              << std::endl;
+                output_stream << std::endl;
             }
-            output_stream << " pc=" << output.instruction_offset << " dst=r" << std::to_string(output.instruction.dst)
-                          << " src=r" << std::to_string(output.instruction.src)
-                          << " offset=" << std::to_string(output.instruction.offset)
-                          << " imm=" << std::to_string(output.instruction.imm) << std::endl;
 
-#endif
-            for (const auto& line : output.lines) {
-                output_stream << prolog_line_info << INDENT "" << line << std::endl;
-            }
+            emit_instructions(output_stream, program, subprogram.start, subprogram.end, prolog_line_info);
+            output_stream << prolog_line_info << "}" << std::endl;
         }
-        // Emit epilogue
-        output_stream << prolog_line_info << "}" << std::endl;
         output_stream << "#pragma code_seg(pop)" << std::endl;
         output_stream << "#line __LINE__ __FILE__" << std::endl << std::endl;
     }
@@ -309,8 +309,19 @@ class bpf_code_generator
         std::string label;
         std::vector<std::string> lines;
         unsafe_string relocation;
+        unsafe_string origin_section_name; // Section a subprogram instruction was copied from, if not the program's.
+        size_t origin_offset = 0;          // Instruction offset in origin_section_name.
     } output_instruction_t;
 
+    typedef struct _subprogram
+    {
+        std::string name;
+        size_t start;                               // Index of the first instruction.
+        size_t end;                                 // Index one past the last instruction.
+        std::set<std::string> referenced_registers; // Registers used by this subprogram.
+        size_t stack_size;                          // Bytes of stack used, 0 if the frame pointer is unused.
+    } subprogram_t;
+
     typedef struct _program
     {
         std::vector<output_instruction_t> output;
@@ -328,6 +339,8 @@ class bpf_code_generator
         std::map<unsafe_string, helper_function_t> helper_functions;
         std::string program_info_hash_type{};
         ebpf_program_info_t* program_info = nullptr;
+        // Local functions invoked via BPF-to-BPF calls, indexed by the first instruction.
+        std::map<size_t, subprogram_t> subprograms;
     } program_t;
 
     typedef struct _line_info
@@ -366,7 +379,8 @@ class bpf_code_generator
         const GUID& program_type, const GUID& attach_type, const std::string& program_info_hash_type);
 
     /**
-     * @brief Extract the helper function and map relocation data from the eBPF file.
+     * @brief Extract the helper function and map relocation data from the eBPF file,
+     * including the relocations of subprograms appended from other sections.
      *
      */
     void
@@ -386,6 +400,15 @@ class bpf_code_generator
     void
     generate_labels();
 
+    /**
+     * @brief Find the local functions invoked via BPF-to-BPF calls and compute
+     * the instruction range and stack usage of each.
+     *
+     * @param[in] program_name Name of the program the subprograms belong to.
+     */
+    void
+    identify_subprograms(const unsafe_string& program_name);
+
     /**
      * @brief Extract list of helper functions called by this program.
      *
@@ -429,6 +452,19 @@ class bpf_code_generator
     std::string
     get_register_name(uint8_t id);
 
+    /**
+     * @brief Emit the C code for a range of encoded instructions.
+     *
+     * @param[in] output_stream Output stream to write code to.
+     * @param[in] program Program containing the instructions.
+     * @param[in] start Index of the first instruction to emit.
+     * @param[in] end Index one past the last instruction to emit.
+     * @param[in,out] prolog_line_info Current #line directive, updated as instructions are emitted.
+     */
+    void
+    emit_instructions(
+        std::ostream& output_stream, const program_t& program, size_t start, size_t end, std::string& prolog_line_info);
+
     ELFIO::section*
     get_required_section(const unsafe_string& name);
 
@@ -449,6 +485,7 @@ class bpf_code_generator
     int pe_section_name_counter{};
     std::map<unsafe_string, program_t> programs;
     program_t* current_program;
+    subprogram_t* current_subprogram = nullptr;
     ELFIO::elfio reader;
     std::map<unsafe_string, map_entry_t> map_definitions;
     unsafe_string c_name;
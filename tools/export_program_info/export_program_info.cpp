@@ -93,6 +93,33 @@ export_global_helper_information()
         ebpf_core_helper_function_prototype, ebpf_core_helper_functions_count);
 }
 
+uint32_t
+export_program_information_snapshot()
+{
+    std::vector<ebpf_program_info_t> program_information;
+    std::vector<ebpf_program_section_info_t> section_information;
+
+    try {
+        for (const auto& program : _program_information_array) {
+            program_information.push_back(*program);
+        }
+        for (const auto& section : _section_information) {
+            section_information.insert(
+                section_information.end(), section.section_info, section.section_info + section.section_info_count);
+        }
+    } catch (const std::bad_alloc&) {
+        return EBPF_NO_MEMORY;
+    }
+
+    return ebpf_store_update_snapshot(
+        program_information.data(),
+        (uint32_t)program_information.size(),
+        section_information.data(),
+        (uint32_t)section_information.size(),
+        ebpf_core_helper_function_prototype,
+        ebpf_core_helper_functions_count);
+}
+
 uint32_t
 clear_ebpf_store()
 {
@@ -49,6 +49,13 @@ main(int argc, char** argv)
             std::cout << "Failed export_global_helper_information() - ERROR #" << status << std::endl;
             return 1;
         }
+
+        std::cout << "Exporting program information snapshot." << std::endl;
+        status = export_program_information_snapshot();
+        if (status != ERROR_SUCCESS) {
+            std::cout << "Failed export_program_information_snapshot() - ERROR #" << status << std::endl;
+            return 1;
+        }
     } else {
         std::cout << "Clearing eBPF store." << std::endl;
         status = clear_ebpf_store();